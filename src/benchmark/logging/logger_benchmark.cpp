@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "concurrency/transaction_context.hpp"
+#include "concurrency/transaction_manager.hpp"
+#include "logging/logger.hpp"
+#include "operators/insert.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+/**
+ * Measures the commit throughput of single-row insert transactions with the write-ahead log enabled. The first
+ * argument is the number of concurrently committing threads, the second one the flush interval in milliseconds.
+ * With more concurrent committers, more commits share an fsync. The average number of commits per fsync is reported
+ * as the batch_size counter.
+ */
+static void BM_LoggerGroupCommit(benchmark::State& state) {  // NOLINT
+  const auto committer_count = static_cast<size_t>(state.range(0));
+  const auto flush_interval = std::chrono::milliseconds{state.range(1)};
+  constexpr auto COMMITS_PER_COMMITTER = size_t{50};
+
+  const auto table_name = std::string{"logger_benchmark_table"};
+  const auto log_file_path = std::string{"logger_benchmark.log"};
+  const auto column_definitions = TableColumnDefinitions{{"a", DataType::Int, false}};
+
+  StorageManager::get().add_table(table_name, std::make_shared<Table>(column_definitions, TableType::Data));
+  std::remove(log_file_path.c_str());
+  Logger::get().enable(log_file_path, flush_interval);
+
+  auto values = std::make_shared<Table>(column_definitions, TableType::Data);
+  values->append({42});
+  const auto table_wrapper = std::make_shared<TableWrapper>(values);
+  table_wrapper->execute();
+
+  while (state.KeepRunning()) {
+    auto committers = std::vector<std::thread>{};
+    for (auto committer_idx = size_t{0}; committer_idx < committer_count; ++committer_idx) {
+      committers.emplace_back([&]() {
+        for (auto commit_idx = size_t{0}; commit_idx < COMMITS_PER_COMMITTER; ++commit_idx) {
+          const auto transaction_context = TransactionManager::get().new_transaction_context();
+          const auto insert = std::make_shared<Insert>(table_name, table_wrapper);
+          insert->set_transaction_context(transaction_context);
+          insert->execute();
+          transaction_context->commit();
+        }
+      });
+    }
+
+    for (auto& committer : committers) {
+      committer.join();
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * committer_count * COMMITS_PER_COMMITTER);
+  state.counters["batch_size"] = static_cast<double>(Logger::get().flushed_commit_count()) /
+                                 static_cast<double>(std::max(Logger::get().flush_count(), size_t{1}));
+
+  Logger::reset();
+  std::remove(log_file_path.c_str());
+  StorageManager::reset();
+  TransactionManager::reset();
+}
+
+BENCHMARK(BM_LoggerGroupCommit)->UseRealTime()->Ranges({{1, 16}, {1, 4}});
+
+}  // namespace opossum
@@ -5,6 +5,10 @@
 #include "benchmark/benchmark.h"
 #include "operators/aggregate.hpp"
 #include "operators/table_wrapper.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
+#include "table_generator.hpp"
 #include "types.hpp"
 
 namespace opossum {
@@ -24,4 +28,45 @@ BENCHMARK_F(BenchmarkBasicFixture, BM_Aggregate)(benchmark::State& state) {
   }
 }
 
+/**
+ * Measures how the Aggregate scales with the number of cores. The arguments are the number of cores used by the
+ * scheduler and the number of groups. Few groups are dominated by the pre-aggregation, many groups by the merge.
+ */
+static void BM_AggregateScaling(benchmark::State& state) {  // NOLINT
+  const auto num_cores = static_cast<uint32_t>(state.range(0));
+  const auto num_groups = static_cast<double>(state.range(1));
+
+  const auto column_data_distributions =
+      std::vector<ColumnDataDistribution>{ColumnDataDistribution::make_uniform_config(0.0, num_groups),
+                                          ColumnDataDistribution::make_uniform_config(0.0, 10'000.0)};
+  const auto table = TableGenerator{}.generate_table(column_data_distributions, 4'000'000, 100'000);
+  const auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  Topology::use_non_numa_topology(num_cores);
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  const auto aggregates = std::vector<AggregateColumnDefinition>{{ColumnID{1}, AggregateFunction::Sum},
+                                                                 {std::nullopt, AggregateFunction::Count}};
+  const auto groupby = std::vector<ColumnID>{ColumnID{0}};
+
+  while (state.KeepRunning()) {
+    auto aggregate = std::make_shared<Aggregate>(table_wrapper, aggregates, groupby);
+    aggregate->execute();
+  }
+
+  CurrentScheduler::get()->finish();
+  CurrentScheduler::set(nullptr);
+}
+
+static void AggregateScalingArguments(benchmark::internal::Benchmark* benchmark) {
+  for (const auto num_groups : {100, 1'000'000}) {
+    for (const auto num_cores : {1, 2, 4, 8, 16}) {
+      benchmark->Args({num_cores, num_groups});
+    }
+  }
+}
+
+BENCHMARK(BM_AggregateScaling)->Apply(AggregateScalingArguments)->UseRealTime();
+
 }  // namespace opossum
@@ -59,17 +59,17 @@ std::shared_ptr<TableWrapper> generate_table(const size_t number_of_rows) {
 
 template <class C>
 void bm_join_impl(benchmark::State& state, std::shared_ptr<TableWrapper> table_wrapper_left,
-                  std::shared_ptr<TableWrapper> table_wrapper_right) {
+                  std::shared_ptr<TableWrapper> table_wrapper_right, const JoinMode mode = JoinMode::Inner) {
   clear_cache();
 
-  auto warm_up =
-      std::make_shared<C>(table_wrapper_left, table_wrapper_right, JoinMode::Inner,
-                          std::pair<ColumnID, ColumnID>{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals);
+  auto warm_up = std::make_shared<C>(table_wrapper_left, table_wrapper_right, mode,
+                                     std::pair<ColumnID, ColumnID>{ColumnID{0}, ColumnID{0}},
+                                     PredicateCondition::Equals);
   warm_up->execute();
   while (state.KeepRunning()) {
-    auto join =
-        std::make_shared<C>(table_wrapper_left, table_wrapper_right, JoinMode::Inner,
-                            std::pair<ColumnID, ColumnID>(ColumnID{0}, ColumnID{0}), PredicateCondition::Equals);
+    auto join = std::make_shared<C>(table_wrapper_left, table_wrapper_right, mode,
+                                    std::pair<ColumnID, ColumnID>(ColumnID{0}, ColumnID{0}),
+                                    PredicateCondition::Equals);
     join->execute();
   }
 
@@ -100,6 +100,15 @@ void BM_Join_MediumAndMedium(benchmark::State& state) {  // NOLINT 100,000 x 100
   bm_join_impl<C>(state, table_wrapper_left, table_wrapper_right);
 }
 
+// Runs the join in the given mode. Used to compare the probe paths of the different join modes.
+template <class C, JoinMode mode>
+void BM_Join_MediumAndBig(benchmark::State& state) {  // NOLINT 100,000 x 10,000,000
+  auto table_wrapper_left = generate_table(TABLE_SIZE_MEDIUM);
+  auto table_wrapper_right = generate_table(TABLE_SIZE_BIG);
+
+  bm_join_impl<C>(state, table_wrapper_left, table_wrapper_right, mode);
+}
+
 BENCHMARK_TEMPLATE(BM_Join_SmallAndSmall, JoinNestedLoop);
 
 BENCHMARK_TEMPLATE(BM_Join_SmallAndSmall, JoinIndex);
@@ -109,6 +118,10 @@ BENCHMARK_TEMPLATE(BM_Join_MediumAndMedium, JoinIndex);
 BENCHMARK_TEMPLATE(BM_Join_SmallAndSmall, JoinHash);
 BENCHMARK_TEMPLATE(BM_Join_SmallAndBig, JoinHash);
 BENCHMARK_TEMPLATE(BM_Join_MediumAndMedium, JoinHash);
+BENCHMARK_TEMPLATE2(BM_Join_MediumAndBig, JoinHash, JoinMode::Inner);
+BENCHMARK_TEMPLATE2(BM_Join_MediumAndBig, JoinHash, JoinMode::Left);
+BENCHMARK_TEMPLATE2(BM_Join_MediumAndBig, JoinHash, JoinMode::Semi);
+BENCHMARK_TEMPLATE2(BM_Join_MediumAndBig, JoinHash, JoinMode::Anti);
 
 BENCHMARK_TEMPLATE(BM_Join_SmallAndSmall, JoinSortMerge);
 BENCHMARK_TEMPLATE(BM_Join_SmallAndBig, JoinSortMerge);
@@ -1,4 +1,5 @@
 #include <memory>
+#include <vector>
 
 #include "benchmark/benchmark.h"
 
@@ -19,4 +20,36 @@ BENCHMARK_F(BenchmarkBasicFixture, BM_Sort)(benchmark::State& state) {
   }
 }
 
+BENCHMARK_F(BenchmarkBasicFixture, BM_SortMultipleColumns)(benchmark::State& state) {
+  _clear_cache();
+
+  const auto sort_definitions = std::vector<SortColumnDefinition>{
+      SortColumnDefinition{ColumnID{0} /* "a" */, OrderByMode::Ascending},
+      SortColumnDefinition{ColumnID{1} /* "b" */, OrderByMode::Descending}};
+
+  auto warm_up = std::make_shared<Sort>(_table_wrapper_a, sort_definitions);
+  warm_up->execute();
+  while (state.KeepRunning()) {
+    auto sort = std::make_shared<Sort>(_table_wrapper_a, sort_definitions);
+    sort->execute();
+  }
+}
+
+BENCHMARK_F(BenchmarkBasicFixture, BM_SortMultipleColumnsReferenceOutput)(benchmark::State& state) {
+  _clear_cache();
+
+  const auto sort_definitions = std::vector<SortColumnDefinition>{
+      SortColumnDefinition{ColumnID{0} /* "a" */, OrderByMode::Ascending},
+      SortColumnDefinition{ColumnID{1} /* "b" */, OrderByMode::Descending}};
+
+  auto warm_up =
+      std::make_shared<Sort>(_table_wrapper_a, sort_definitions, Chunk::MAX_SIZE, Sort::OutputMode::References);
+  warm_up->execute();
+  while (state.KeepRunning()) {
+    auto sort =
+        std::make_shared<Sort>(_table_wrapper_a, sort_definitions, Chunk::MAX_SIZE, Sort::OutputMode::References);
+    sort->execute();
+  }
+}
+
 }  // namespace opossum
@@ -1,9 +1,11 @@
 #include <memory>
+#include <vector>
 
 #include "../benchmark_basic_fixture.hpp"
 #include "benchmark/benchmark.h"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "storage/chunk_encoder.hpp"
 #include "table_generator.hpp"
 #include "utils/load_table.hpp"
 
@@ -42,6 +44,39 @@ BENCHMARK_F(BenchmarkBasicFixture, BM_TableScanVariable_OnDict)(benchmark::State
   benchmark_tablescan_impl(state, _table_dict_wrapper, ColumnID{0}, PredicateCondition::GreaterThanEquals, ColumnID{1});
 }
 
+/**
+ * Scans dictionary segments of 100'000 rows whose attribute vectors store 8, 16, or 32 bit ValueIDs, depending on the
+ * number of distinct values in the scanned column (first argument). The attribute vectors are either compressed with
+ * FixedSizeByteAligned (second argument 0) or with SimdBp128 (second argument 1).
+ */
+void BM_TableScanConstant_OnDictValueIDWidths(benchmark::State& state) {  // NOLINT
+  const auto column_id = ColumnID{static_cast<ColumnID::base_type>(state.range(0))};
+  const auto vector_compression_type =
+      state.range(1) == 0 ? VectorCompressionType::FixedSizeByteAligned : VectorCompressionType::SimdBp128;
+
+  const auto column_data_distributions = std::vector<ColumnDataDistribution>{
+      ColumnDataDistribution::make_uniform_config(0.0, 200.0),
+      ColumnDataDistribution::make_uniform_config(0.0, 20'000.0),
+      ColumnDataDistribution::make_uniform_config(0.0, 2'000'000.0)};
+
+  const auto table = TableGenerator{}.generate_table(column_data_distributions, 1'000'000, 100'000);
+  ChunkEncoder::encode_all_chunks(table, SegmentEncodingSpec{EncodingType::Dictionary, vector_compression_type});
+  const auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  // Selects about half of the rows
+  const auto max_value = column_data_distributions[column_id].max_value;
+  benchmark_tablescan_impl(state, table_wrapper, column_id, PredicateCondition::LessThan,
+                           static_cast<int>(max_value / 2));
+}
+BENCHMARK(BM_TableScanConstant_OnDictValueIDWidths)
+    ->Args({0, 0})
+    ->Args({1, 0})
+    ->Args({2, 0})
+    ->Args({0, 1})
+    ->Args({1, 1})
+    ->Args({2, 1});
+
 BENCHMARK_F(BenchmarkBasicFixture, BM_TableScan_Like)(benchmark::State& state) {
   const auto lineitem_table = load_table("src/test/tables/tpch/sf-0.001/lineitem.tbl");
 
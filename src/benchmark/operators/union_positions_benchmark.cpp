@@ -78,9 +78,14 @@ std::shared_ptr<Table> create_reference_table(std::shared_ptr<Table> referenced_
   return table;
 }
 
+/**
+ * Parameterized with the number of rows and the number of columns of the input tables. With one column, each input
+ * row is a single RowID and the operator is dominated by sorting. With more columns, the ReferenceMatrix has more
+ * columns that need to be compared for rows that are equal in the first column.
+ */
 void BM_UnionPositions(::benchmark::State& state) {  // NOLINT
-  const auto num_rows = 500000;
-  const auto num_columns = 5;
+  const auto num_rows = static_cast<size_t>(state.range(0));
+  const auto num_columns = static_cast<size_t>(state.range(1));
 
   /**
    * Create the referenced table, that doesn't actually contain any data - but UnionPositions won't care, it just
@@ -88,7 +93,7 @@ void BM_UnionPositions(::benchmark::State& state) {  // NOLINT
    */
   TableColumnDefinitions column_definitions;
 
-  for (auto column_idx = 0; column_idx < num_columns; ++column_idx) {
+  for (size_t column_idx = 0; column_idx < num_columns; ++column_idx) {
     column_definitions.emplace_back("c" + std::to_string(column_idx), DataType::Int);
   }
   auto referenced_table = std::make_shared<Table>(column_definitions, TableType::Data);
@@ -108,7 +113,7 @@ void BM_UnionPositions(::benchmark::State& state) {  // NOLINT
     set_union->execute();
   }
 }
-BENCHMARK(BM_UnionPositions);
+BENCHMARK(BM_UnionPositions)->Args({500'000, 5})->Args({500'000, 1})->Args({5'000'000, 1})->Args({5'000'000, 5});
 
 /**
  * Measure what sorting and merging two pos lists would cost - that's the core of the UnionPositions implementation and sets
@@ -0,0 +1,47 @@
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
+
+namespace opossum {
+
+/**
+ * Measures the time from scheduling a task until it starts executing, when all workers of the scheduler are idle.
+ * The argument is the time (in microseconds) that the workers are idle before the task is scheduled. Short idle times
+ * measure the latency of spinning workers, long ones that of blocked workers.
+ */
+static void BM_SchedulerWakeUpLatency(benchmark::State& state) {  // NOLINT
+  Topology::use_non_numa_topology();
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  const auto idle_time = std::chrono::microseconds{state.range(0)};
+
+  while (state.KeepRunning()) {
+    std::this_thread::sleep_for(idle_time);
+
+    auto start_time = std::chrono::steady_clock::now();
+    auto execution_time = std::chrono::steady_clock::time_point{};
+
+    auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+    jobs.emplace_back(std::make_shared<JobTask>([&]() { execution_time = std::chrono::steady_clock::now(); }));
+    jobs.back()->schedule();
+    CurrentScheduler::wait_for_tasks(jobs);
+
+    state.SetIterationTime(std::chrono::duration<double>(execution_time - start_time).count());
+  }
+
+  CurrentScheduler::get()->finish();
+  CurrentScheduler::set(nullptr);
+}
+
+BENCHMARK(BM_SchedulerWakeUpLatency)->UseManualTime()->Arg(0)->Arg(100)->Arg(10'000);
+
+}  // namespace opossum
@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "benchmark_basic_fixture.hpp"
+#include "statistics/column_statistics.hpp"
+#include "statistics/generate_column_statistics.hpp"
+#include "storage/table.hpp"
+#include "tpch/tpch_db_generator.hpp"
+
+namespace opossum {
+
+namespace {
+
+// The factor by which an estimated cardinality is off, with both cardinalities being at least one row
+float q_error(const float estimated_row_count, const float actual_row_count) {
+  const auto estimated = std::max(estimated_row_count, 1.0f);
+  const auto actual = std::max(actual_row_count, 1.0f);
+  return std::max(estimated / actual, actual / estimated);
+}
+
+}  // namespace
+
+/**
+ * Measures the estimation error of ColumnStatistics on a skewed TPC-H: The customer keys of the orders follow a Zipf
+ * distribution, so that a few customers place most of the orders. The benchmark estimates equality and range
+ * predicates on o_custkey as well as the join of orders and customer, and reports the mean and maximum q-error (i.e.,
+ * the factor by which an estimation is off) as counters. The argument selects the statistics: 0 assumes a uniform
+ * distribution between min and max, 1 uses histograms. As join orders are chosen based on these estimations, the
+ * q-error of the join is a proxy for the quality of the resulting plans.
+ */
+BENCHMARK_DEFINE_F(BenchmarkBasicFixture, BM_CardinalityEstimation_SkewedTPCH)(benchmark::State& state) {
+  const auto use_histograms = state.range(0) != 0;
+
+  const auto tables = TpchDbGenerator{0.01f}.generate();
+  const auto customer_table = tables.at(TpchTable::Customer);
+  const auto orders_row_count = tables.at(TpchTable::Orders)->row_count();
+  const auto customer_count = static_cast<int32_t>(customer_table->row_count());
+
+  // Replace o_custkey by Zipf-distributed customer keys (c_custkey is 1..customer_count)
+  auto weights = std::vector<double>(customer_count);
+  for (auto customer_index = 0; customer_index < customer_count; ++customer_index) {
+    weights[customer_index] = 1.0 / (customer_index + 1);
+  }
+  auto random_engine = std::mt19937{42};
+  auto distribution = std::discrete_distribution<int32_t>{weights.begin(), weights.end()};
+
+  auto orders_table =
+      std::make_shared<Table>(TableColumnDefinitions{{"o_custkey", DataType::Int, false}}, TableType::Data);
+  auto actual_counts = std::vector<size_t>(customer_count + 1);
+  for (auto row_id = size_t{0}; row_id < orders_row_count; ++row_id) {
+    const auto custkey = distribution(random_engine) + 1;
+    orders_table->append({custkey});
+    ++actual_counts[custkey];
+  }
+
+  const auto statistics = [&](const Table& table, const ColumnID column_id) {
+    const auto column_statistics =
+        std::static_pointer_cast<ColumnStatistics<int32_t>>(generate_column_statistics<int32_t>(table, column_id));
+    if (use_histograms) return column_statistics;
+    return std::make_shared<ColumnStatistics<int32_t>>(column_statistics->null_value_ratio(),
+                                                       column_statistics->distinct_count(), column_statistics->min(),
+                                                       column_statistics->max());
+  };
+
+  const auto orders_statistics = statistics(*orders_table, ColumnID{0});
+  const auto customer_statistics = statistics(*customer_table, customer_table->column_id_by_name("c_custkey"));
+
+  // The most common, some frequent, and some rare customers
+  const auto custkeys = std::vector<int32_t>{1, 2, 10, 100, customer_count / 2, customer_count};
+
+  auto q_errors = std::vector<float>{};
+  auto join_q_error = 0.0f;
+
+  while (state.KeepRunning()) {
+    q_errors.clear();
+
+    for (const auto custkey : custkeys) {
+      const auto equals_estimate =
+          orders_statistics->estimate_predicate_with_value(PredicateCondition::Equals, custkey);
+      q_errors.emplace_back(q_error(equals_estimate.selectivity * orders_row_count, actual_counts[custkey]));
+
+      const auto range_estimate =
+          orders_statistics->estimate_predicate_with_value(PredicateCondition::LessThanEquals, custkey);
+      const auto actual_range_row_count =
+          std::accumulate(actual_counts.begin(), actual_counts.begin() + custkey + 1, size_t{0});
+      q_errors.emplace_back(q_error(range_estimate.selectivity * orders_row_count, actual_range_row_count));
+    }
+
+    // Every order has exactly one customer
+    const auto join_estimate =
+        orders_statistics->estimate_predicate_with_column(PredicateCondition::Equals, *customer_statistics);
+    join_q_error = q_error(join_estimate.selectivity * orders_row_count * customer_count, orders_row_count);
+    q_errors.emplace_back(join_q_error);
+
+    benchmark::DoNotOptimize(q_errors.data());
+  }
+
+  state.counters["mean_q_error"] = std::accumulate(q_errors.begin(), q_errors.end(), 0.0f) / q_errors.size();
+  state.counters["max_q_error"] = *std::max_element(q_errors.begin(), q_errors.end());
+  state.counters["join_q_error"] = join_q_error;
+}
+
+BENCHMARK_REGISTER_F(BenchmarkBasicFixture, BM_CardinalityEstimation_SkewedTPCH)->Arg(0)->Arg(1);
+
+}  // namespace opossum
@@ -3,14 +3,21 @@
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
+#include <optional>
+#include <string>
 
+#include "logging/checkpoint.hpp"
+#include "logging/logger.hpp"
 #include "scheduler/current_scheduler.hpp"
 #include "scheduler/node_queue_scheduler.hpp"
 #include "scheduler/topology.hpp"
 #include "server/server.hpp"
 #include "storage/storage_manager.hpp"
+#include "utils/filesystem.hpp"
 #include "utils/load_table.hpp"
 
+// Usage: hyriseServer [port] [data directory]
+
 int main(int argc, char* argv[]) {
   try {
     uint16_t port = 5432;
@@ -23,6 +30,21 @@ int main(int argc, char* argv[]) {
       port = static_cast<uint16_t>(port_long);
     }
 
+    // With a data directory, the tables are restored from the last checkpoint and the log, and all changes are logged
+    if (argc >= 3) {
+      const auto data_directory = std::string{argv[2]};
+      filesystem::create_directories(data_directory);
+      const auto checkpoint_file_path = data_directory + "/hyrise.checkpoint";
+      const auto log_file_path = data_directory + "/hyrise.log";
+
+      auto checkpoint_id = std::optional<opossum::CheckpointID>{};
+      if (filesystem::exists(checkpoint_file_path)) checkpoint_id = opossum::Checkpoint::load(checkpoint_file_path);
+      opossum::Logger::get().enable(log_file_path, opossum::Logger::DEFAULT_FLUSH_INTERVAL, checkpoint_id);
+
+      // Truncates the log, so that the next restart does not have to replay it again
+      opossum::Checkpoint::write(checkpoint_file_path);
+    }
+
     // Set scheduler so that the server can execute the tasks on separate threads.
     opossum::CurrentScheduler::set(std::make_shared<opossum::NodeQueueScheduler>());
 
@@ -9,10 +9,14 @@ CommitContext::CommitContext(const CommitID commit_id) : _commit_id{commit_id},
 
 CommitID CommitContext::commit_id() const { return _commit_id; }
 
+TransactionID CommitContext::transaction_id() const { return _transaction_id; }
+
 bool CommitContext::is_pending() const { return _pending; }
 
 void CommitContext::make_pending(const TransactionID transaction_id,
                                  const std::function<void(TransactionID)>& callback) {
+  _transaction_id = transaction_id;
+
   if (callback) {
     _callback = [callback, transaction_id]() { callback(transaction_id); };
   }
@@ -21,6 +21,11 @@ class CommitContext : private Noncopyable {
 
   CommitID commit_id() const;
 
+  /**
+   * The id of the transaction that owns this context. Only available once the context is pending.
+   */
+  TransactionID transaction_id() const;
+
   bool is_pending() const;
 
   /**
@@ -50,6 +55,7 @@ class CommitContext : private Noncopyable {
 
  private:
   const CommitID _commit_id;
+  TransactionID _transaction_id{0};
   std::atomic<bool> _pending;  // true if context is waiting to be committed
   std::shared_ptr<CommitContext> _next;
   std::function<void()> _callback;
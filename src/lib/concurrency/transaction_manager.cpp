@@ -1,8 +1,14 @@
 #include "transaction_manager.hpp"
 
+#include <algorithm>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
 
 #include "commit_context.hpp"
+#include "logging/logger.hpp"
 #include "transaction_context.hpp"
 #include "utils/assert.hpp"
 
@@ -18,17 +24,113 @@ void TransactionManager::reset() {
   manager._next_transaction_id = INITIAL_TRANSACTION_ID;
   manager._last_commit_id = INITIAL_COMMIT_ID;
   manager._last_commit_context = std::make_shared<CommitContext>(INITIAL_COMMIT_ID);
+
+  ++manager._snapshot_generation;
+  for (auto& slot : manager._snapshot_slots) slot.commit_id = FREE_SNAPSHOT_SLOT;
+
+  const auto lock = std::lock_guard<std::mutex>{manager._overflow_snapshots_mutex};
+  manager._overflow_snapshot_commit_ids.clear();
+  manager._overflow_snapshot_count = 0;
 }
 
 TransactionManager::TransactionManager()
     : _next_transaction_id{INITIAL_TRANSACTION_ID},
       _last_commit_id{INITIAL_COMMIT_ID},
-      _last_commit_context{std::make_shared<CommitContext>(INITIAL_COMMIT_ID)} {}
+      _last_commit_context{std::make_shared<CommitContext>(INITIAL_COMMIT_ID)} {
+  for (auto& slot : _snapshot_slots) slot.commit_id = FREE_SNAPSHOT_SLOT;
+}
 
 CommitID TransactionManager::last_commit_id() const { return _last_commit_id; }
 
+CommitID TransactionManager::lowest_active_snapshot_commit_id() const {
+  // The last commit id has to be read before the slots, see _register_snapshot_commit_id()
+  auto lowest_commit_id = _last_commit_id.load();
+
+  for (const auto& slot : _snapshot_slots) {
+    lowest_commit_id = std::min(lowest_commit_id, slot.commit_id.load());
+  }
+
+  if (_overflow_snapshot_count > 0) {
+    const auto lock = std::lock_guard<std::mutex>{_overflow_snapshots_mutex};
+    if (!_overflow_snapshot_commit_ids.empty()) {
+      lowest_commit_id = std::min(lowest_commit_id, *_overflow_snapshot_commit_ids.begin());
+    }
+  }
+
+  return lowest_commit_id;
+}
+
 std::shared_ptr<TransactionContext> TransactionManager::new_transaction_context() {
-  return std::make_shared<TransactionContext>(_next_transaction_id++, _last_commit_id);
+  const auto generation = _snapshot_generation.load();
+  const auto [snapshot_commit_id, slot] = _register_snapshot_commit_id();
+
+  // The snapshot is released when the context is destroyed, as results of the transaction might still be in use after
+  // it committed
+  return std::shared_ptr<TransactionContext>(
+      new TransactionContext(_next_transaction_id++, snapshot_commit_id),
+      [slot = slot, snapshot_commit_id = snapshot_commit_id, generation](TransactionContext* transaction_context) {
+        delete transaction_context;
+        get()._release_snapshot_commit_id(slot, snapshot_commit_id, generation);
+      });
+}
+
+/**
+ * Registering a snapshot must not race with lowest_active_snapshot_commit_id(): It must never return a commit id that
+ * is higher than the snapshot of a transaction. Thus, the snapshot is published in the slot first and the last commit
+ * id is read again afterwards. If it has changed in between, the newer commit id is published and checked instead.
+ * Once both match, any concurrent call of lowest_active_snapshot_commit_id() either sees the slot or has read a last
+ * commit id that is not higher than the snapshot (all operations are sequentially consistent).
+ */
+std::pair<CommitID, size_t> TransactionManager::_register_snapshot_commit_id() {
+  static thread_local const auto first_slot = std::hash<std::thread::id>{}(std::this_thread::get_id());
+
+  for (auto slot_offset = size_t{0}; slot_offset < SNAPSHOT_SLOT_COUNT; ++slot_offset) {
+    const auto slot = (first_slot + slot_offset) % SNAPSHOT_SLOT_COUNT;
+    auto& slot_commit_id = _snapshot_slots[slot].commit_id;
+    if (slot_commit_id.load() != FREE_SNAPSHOT_SLOT) continue;
+
+    auto expected = FREE_SNAPSHOT_SLOT;
+    auto snapshot_commit_id = _last_commit_id.load();
+    if (!slot_commit_id.compare_exchange_strong(expected, snapshot_commit_id)) continue;
+
+    for (auto last_commit_id = _last_commit_id.load(); last_commit_id != snapshot_commit_id;
+         last_commit_id = _last_commit_id.load()) {
+      snapshot_commit_id = last_commit_id;
+      slot_commit_id = snapshot_commit_id;
+    }
+
+    return {snapshot_commit_id, slot};
+  }
+
+  // All slots are occupied. The counter is incremented before the last commit id is read, for the reason given above.
+  const auto lock = std::lock_guard<std::mutex>{_overflow_snapshots_mutex};
+  ++_overflow_snapshot_count;
+  const auto snapshot_commit_id = _last_commit_id.load();
+  _overflow_snapshot_commit_ids.emplace(snapshot_commit_id);
+
+  return {snapshot_commit_id, OVERFLOW_SNAPSHOT_SLOT};
+}
+
+void TransactionManager::_release_snapshot_commit_id(const size_t slot, const CommitID snapshot_commit_id,
+                                                     const uint32_t generation) {
+  // The snapshot has already been discarded by reset()
+  if (generation != _snapshot_generation) return;
+
+  if (slot != OVERFLOW_SNAPSHOT_SLOT) {
+    _snapshot_slots[slot].commit_id = FREE_SNAPSHOT_SLOT;
+    return;
+  }
+
+  const auto lock = std::lock_guard<std::mutex>{_overflow_snapshots_mutex};
+  const auto snapshot_iter = _overflow_snapshot_commit_ids.find(snapshot_commit_id);
+  if (snapshot_iter == _overflow_snapshot_commit_ids.end()) return;
+
+  _overflow_snapshot_commit_ids.erase(snapshot_iter);
+  --_overflow_snapshot_count;
+}
+
+std::unique_lock<std::mutex> TransactionManager::acquire_commit_log_mutex() {
+  return std::unique_lock<std::mutex>{_commit_log_mutex};
 }
 
 /**
@@ -77,9 +179,22 @@ void TransactionManager::_try_increment_last_commit_id(const std::shared_ptr<Com
   while (current_context->is_pending()) {
     auto expected_last_commit_id = current_context->commit_id() - 1;
 
-    if (!_last_commit_id.compare_exchange_strong(expected_last_commit_id, current_context->commit_id())) return;
+    if (Logger::get().is_enabled()) {
+      // Publishing the commit id and appending the commit record happen atomically, so that the commit records are
+      // logged in commit id order. Otherwise, a transaction could become durable before one that it depends on.
+      const auto lock = std::lock_guard<std::mutex>{_commit_log_mutex};
 
-    current_context->fire_callback();
+      if (!_last_commit_id.compare_exchange_strong(expected_last_commit_id, current_context->commit_id())) return;
+
+      // The callback is delayed until the commit record has been flushed together with those of concurrent
+      // transactions (group commit)
+      Logger::get().log_commit(current_context->transaction_id(),
+                               [current_context]() { current_context->fire_callback(); });
+    } else {
+      if (!_last_commit_id.compare_exchange_strong(expected_last_commit_id, current_context->commit_id())) return;
+
+      current_context->fire_callback();
+    }
 
     if (!current_context->has_next()) return;
 
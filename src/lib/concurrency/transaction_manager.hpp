@@ -1,8 +1,13 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <functional>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
 
 #include "types.hpp"
 
@@ -52,11 +57,24 @@ class TransactionManager : private Noncopyable {
 
   CommitID last_commit_id() const;
 
+  /**
+   * Returns the lowest snapshot commit id of all transaction contexts that still exist, or the last commit id if there
+   * are none. Rows that have been invalidated at or before this commit id are invisible to all current and future
+   * transactions and can be garbage collected. Does not take any lock.
+   */
+  CommitID lowest_active_snapshot_commit_id() const;
+
   /**
    * Creates a new transaction context
    */
   std::shared_ptr<TransactionContext> new_transaction_context();
 
+  /**
+   * While the returned lock is held, no commit id is published if the Logger is enabled. Used to mark a consistent
+   * snapshot in the log, see Checkpoint::write().
+   */
+  std::unique_lock<std::mutex> acquire_commit_log_mutex();
+
   // TransactionID = 0 means "not set" in the MVCC data. This is the case if the row has (a) just been reserved, but
   // not yet filled with content, (b) been inserted, committed and not marked for deletion, or (c) inserted but
   // deleted in the same transaction (which has not yet committed)
@@ -74,6 +92,10 @@ class TransactionManager : private Noncopyable {
   std::shared_ptr<CommitContext> _new_commit_context();
   void _try_increment_last_commit_id(const std::shared_ptr<CommitContext>& context);
 
+  // Returns the snapshot commit id and the slot it has been registered in
+  std::pair<CommitID, size_t> _register_snapshot_commit_id();
+  void _release_snapshot_commit_id(const size_t slot, const CommitID snapshot_commit_id, const uint32_t generation);
+
  private:
   std::atomic<TransactionID> _next_transaction_id;
 
@@ -83,5 +105,31 @@ class TransactionManager : private Noncopyable {
   static constexpr auto INITIAL_COMMIT_ID = CommitID{1};
 
   std::shared_ptr<CommitContext> _last_commit_context;
+
+  /**
+   * Snapshot commit ids of all transaction contexts handed out by new_transaction_context() that still exist. Each
+   * transaction occupies a slot, which it claims with a compare-and-swap. Threads start searching for a free slot at
+   * different positions, and each slot has its own cache line, so that concurrent transactions rarely touch the same
+   * memory. Only if all slots are occupied, snapshots are registered in the mutex-protected overflow set.
+   */
+  struct alignas(64) SnapshotSlot {
+    std::atomic<CommitID> commit_id;
+  };
+
+  static constexpr auto SNAPSHOT_SLOT_COUNT = size_t{256};
+  static constexpr auto FREE_SNAPSHOT_SLOT = std::numeric_limits<CommitID>::max();
+  static constexpr auto OVERFLOW_SNAPSHOT_SLOT = SNAPSHOT_SLOT_COUNT;
+
+  std::array<SnapshotSlot, SNAPSHOT_SLOT_COUNT> _snapshot_slots;
+
+  std::atomic<size_t> _overflow_snapshot_count{0};
+  mutable std::mutex _overflow_snapshots_mutex;
+  std::multiset<CommitID> _overflow_snapshot_commit_ids;
+
+  // Incremented by reset(), so that transaction contexts that survive it do not release the slots of newer ones
+  std::atomic<uint32_t> _snapshot_generation{0};
+
+  // Only used if the Logger is enabled, see _try_increment_last_commit_id()
+  std::mutex _commit_log_mutex;
 };
 }  // namespace opossum
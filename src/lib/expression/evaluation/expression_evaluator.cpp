@@ -1,8 +1,14 @@
 #include "expression_evaluator.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <iterator>
 #include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "boost/functional/hash.hpp"
 #include "boost/lexical_cast.hpp"
 #include "boost/variant/apply_visitor.hpp"
 
@@ -30,14 +36,59 @@
 #include "scheduler/current_scheduler.hpp"
 #include "sql/sql_query_plan.hpp"
 #include "storage/materialize.hpp"
+#include "storage/table.hpp"
 #include "storage/value_segment.hpp"
 #include "utils/assert.hpp"
 
 using namespace std::string_literals;            // NOLINT
 using namespace opossum::expression_functional;  // NOLINT
 
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Number of distinct parameter value combinations of a correlated select that are executed in parallel at a time
+constexpr auto MAX_CONCURRENT_SELECT_EXECUTIONS = size_t{256};
+
+std::atomic<size_t> correlated_select_cache_budget_bytes{ExpressionEvaluator::DEFAULT_CORRELATED_SELECT_CACHE_BUDGET};
+
+// Hashes and compares the parameter values of a select. Other than for AllTypeVariant::operator==, NULLs are equal,
+// as they lead to the same result of the select.
+struct SelectParameterValuesHash {
+  size_t operator()(const std::vector<AllTypeVariant>& parameter_values) const {
+    auto hash = size_t{0};
+    for (const auto& value : parameter_values) {
+      boost::hash_combine(hash, std::hash<AllTypeVariant>{}(value));
+    }
+    return hash;
+  }
+};
+
+struct SelectParameterValuesEqual {
+  bool operator()(const std::vector<AllTypeVariant>& lhs, const std::vector<AllTypeVariant>& rhs) const {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](const auto& lhs_value, const auto& rhs_value) {
+      if (variant_is_null(lhs_value) || variant_is_null(rhs_value)) {
+        return variant_is_null(lhs_value) && variant_is_null(rhs_value);
+      }
+      return lhs_value == rhs_value;
+    });
+  }
+};
+
+template <typename Value>
+using SelectParameterValuesMap =
+    std::unordered_map<std::vector<AllTypeVariant>, Value, SelectParameterValuesHash, SelectParameterValuesEqual>;
+
+}  // namespace
+
 namespace opossum {
 
+void ExpressionEvaluator::set_correlated_select_cache_budget(const size_t bytes) {
+  correlated_select_cache_budget_bytes = bytes;
+}
+
+size_t ExpressionEvaluator::correlated_select_cache_budget() { return correlated_select_cache_budget_bytes; }
+
 ExpressionEvaluator::ExpressionEvaluator(
     const std::shared_ptr<const Table>& table, const ChunkID chunk_id,
     const std::shared_ptr<const UncorrelatedSelectResults>& uncorrelated_select_results)
@@ -46,6 +97,26 @@ ExpressionEvaluator::ExpressionEvaluator(
   _segment_materializations.resize(_chunk->column_count());
 }
 
+template <typename T>
+std::vector<T> ExpressionEvaluator::_acquire_vector(const size_t size) const {
+  auto vector = _result_pool->acquire<T>();
+  vector.resize(size);
+  return vector;
+}
+
+template <typename Result>
+std::shared_ptr<ExpressionResult<Result>> ExpressionEvaluator::_make_result(std::vector<Result>&& values,
+                                                                            std::vector<bool>&& nulls) const {
+  // The deleter holds a reference to the pool, as the result might outlive this evaluator
+  return std::shared_ptr<ExpressionResult<Result>>(
+      new ExpressionResult<Result>(std::move(values), std::move(nulls)),
+      [result_pool = _result_pool](ExpressionResult<Result>* result) {
+        result_pool->release(std::move(result->values));
+        result_pool->release(std::move(result->nulls));
+        delete result;
+      });
+}
+
 template <typename Result>
 std::shared_ptr<ExpressionResult<Result>> ExpressionEvaluator::evaluate_expression_to_result(
     const AbstractExpression& expression) {
@@ -166,7 +237,7 @@ ExpressionEvaluator::_evaluate_like_expression<ExpressionEvaluator::Bool>(const
   const auto invert_results = expression.predicate_condition == PredicateCondition::NotLike;
 
   const auto result_size = _result_size(left_results->size(), right_results->size());
-  auto result_values = std::vector<ExpressionEvaluator::Bool>(result_size, 0);
+  auto result_values = _acquire_vector<ExpressionEvaluator::Bool>(result_size);
 
   /**
    * Three different kinds of LIKE are considered for performance reasons and avoid redundant creation of the
@@ -203,8 +274,7 @@ ExpressionEvaluator::_evaluate_like_expression<ExpressionEvaluator::Bool>(const
 
   auto result_nulls = _evaluate_default_null_logic(left_results->nulls, right_results->nulls);
 
-  return std::make_shared<ExpressionResult<ExpressionEvaluator::Bool>>(std::move(result_values),
-                                                                       std::move(result_nulls));
+  return _make_result(std::move(result_values), std::move(result_nulls));
 }
 
 template <typename Result>
@@ -216,7 +286,7 @@ std::shared_ptr<ExpressionResult<Result>> ExpressionEvaluator::_evaluate_like_ex
 template <>
 std::shared_ptr<ExpressionResult<ExpressionEvaluator::Bool>>
 ExpressionEvaluator::_evaluate_is_null_expression<ExpressionEvaluator::Bool>(const IsNullExpression& expression) {
-  std::vector<ExpressionEvaluator::Bool> result_values;
+  auto result_values = _result_pool->acquire<ExpressionEvaluator::Bool>();
 
   _resolve_to_expression_result_view(*expression.operand(), [&](const auto& view) {
     result_values.resize(view.size());
@@ -232,7 +302,7 @@ ExpressionEvaluator::_evaluate_is_null_expression<ExpressionEvaluator::Bool>(con
     }
   });
 
-  return std::make_shared<ExpressionResult<ExpressionEvaluator::Bool>>(std::move(result_values));
+  return _make_result(std::move(result_values));
 }
 
 template <typename Result>
@@ -437,8 +507,8 @@ std::shared_ptr<ExpressionResult<Result>> ExpressionEvaluator::_evaluate_case_ex
         using ElseResultType = typename std::decay_t<decltype(else_result)>::Type;
 
         const auto result_size = _result_size(when->size(), then_result.size(), else_result.size());
-        std::vector<Result> values(result_size);
-        std::vector<bool> nulls(result_size);
+        auto values = _acquire_vector<Result>(result_size);
+        auto nulls = _acquire_vector<bool>(result_size);
 
         // clang-format off
       if constexpr (CaseEvaluator::template supports<Result, ThenResultType, ElseResultType>::value) {
@@ -457,7 +527,7 @@ std::shared_ptr<ExpressionResult<Result>> ExpressionEvaluator::_evaluate_case_ex
       }
         // clang-format on
 
-        result = std::make_shared<ExpressionResult<Result>>(std::move(values), std::move(nulls));
+        result = _make_result(std::move(values), std::move(nulls));
       });
 
   return result;
@@ -474,8 +544,8 @@ std::shared_ptr<ExpressionResult<Result>> ExpressionEvaluator::_evaluate_cast_ex
    *    NULL -> Any type                    A nulled value of the requested type is returned.
    */
 
-  auto values = std::vector<Result>{};
-  auto nulls = std::vector<bool>{};
+  auto values = _result_pool->acquire<Result>();
+  auto nulls = _result_pool->acquire<bool>();
 
   _resolve_to_expression_result(*cast_expression.argument(), [&](const auto& argument_result) {
     using ArgumentDataType = typename std::decay_t<decltype(argument_result)>::Type;
@@ -509,10 +579,10 @@ std::shared_ptr<ExpressionResult<Result>> ExpressionEvaluator::_evaluate_cast_ex
       }
     }
 
-    nulls = argument_result.nulls;
+    nulls.assign(argument_result.nulls.begin(), argument_result.nulls.end());
   });
 
-  return std::make_shared<ExpressionResult<Result>>(std::move(values), std::move(nulls));
+  return _make_result(std::move(values), std::move(nulls));
 }
 
 template <>
@@ -705,10 +775,56 @@ std::vector<std::shared_ptr<const Table>> ExpressionEvaluator::_evaluate_select_
     _materialize_segment_if_not_yet_materialized(parameter.second);
   }
 
+  /**
+   * Rows with the same parameter values yield the same result, so the select is executed only once per distinct
+   * combination of parameter values. The rows are processed in batches: The combinations of a batch that were not seen
+   * in previous batches are executed in parallel. Their results are then cached for the following batches, as long as
+   * the cache stays within its budget.
+   */
+  const auto cache_budget = correlated_select_cache_budget();
+  auto cache = SelectParameterValuesMap<std::shared_ptr<const Table>>{};
+  auto cache_size = size_t{0};
+
   std::vector<std::shared_ptr<const Table>> results(_output_row_count);
 
-  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < _output_row_count; ++chunk_offset) {
-    results[chunk_offset] = _evaluate_select_expression_for_row(expression, chunk_offset);
+  auto chunk_offset = ChunkOffset{0};
+  while (chunk_offset < _output_row_count) {
+    auto batch_parameter_values = std::vector<SelectParameterValues>{};
+    auto batch_value_ids = SelectParameterValuesMap<size_t>{};
+
+    // Rows of the batch that are not cached, and the index of their parameter values in batch_parameter_values
+    auto batch_rows = std::vector<std::pair<ChunkOffset, size_t>>{};
+
+    for (; chunk_offset < _output_row_count && batch_parameter_values.size() < MAX_CONCURRENT_SELECT_EXECUTIONS;
+         ++chunk_offset) {
+      auto parameter_values = _select_parameter_values_for_row(expression, chunk_offset);
+
+      const auto cache_iter = cache.find(parameter_values);
+      if (cache_iter != cache.end()) {
+        results[chunk_offset] = cache_iter->second;
+        continue;
+      }
+
+      const auto [value_id_iter, inserted] =
+          batch_value_ids.try_emplace(parameter_values, batch_parameter_values.size());
+      if (inserted) batch_parameter_values.emplace_back(std::move(parameter_values));
+
+      batch_rows.emplace_back(chunk_offset, value_id_iter->second);
+    }
+
+    const auto batch_results = _evaluate_select_expression_for_parameter_values(expression, batch_parameter_values);
+
+    for (const auto& [row, value_id] : batch_rows) {
+      results[row] = batch_results[value_id];
+    }
+
+    for (auto value_id = size_t{0}; value_id < batch_parameter_values.size(); ++value_id) {
+      const auto result_size = batch_results[value_id]->estimate_memory_usage();
+      if (cache_size + result_size > cache_budget) continue;
+
+      cache_size += result_size;
+      cache.emplace(std::move(batch_parameter_values[value_id]), batch_results[value_id]);
+    }
   }
 
   return results;
@@ -722,14 +838,49 @@ std::shared_ptr<const Table> ExpressionEvaluator::evaluate_uncorrelated_select_e
 
 std::shared_ptr<const Table> ExpressionEvaluator::_evaluate_select_expression_for_row(
     const PQPSelectExpression& expression, const ChunkOffset chunk_offset) {
+  const auto parameter_values =
+      std::vector<SelectParameterValues>{_select_parameter_values_for_row(expression, chunk_offset)};
+  return _evaluate_select_expression_for_parameter_values(expression, parameter_values).front();
+}
+
+std::vector<std::shared_ptr<const Table>> ExpressionEvaluator::_evaluate_select_expression_for_parameter_values(
+    const PQPSelectExpression& expression, const std::vector<SelectParameterValues>& parameter_values) {
+  // All executions go into the same SQLQueryPlan, so that the scheduler can run them in parallel
+  SQLQueryPlan query_plan{CleanupTemporaries::Yes};
+
+  for (const auto& values : parameter_values) {
+    std::unordered_map<ParameterID, AllTypeVariant> parameters;
+    for (auto parameter_idx = size_t{0}; parameter_idx < expression.parameters.size(); ++parameter_idx) {
+      parameters.emplace(expression.parameters[parameter_idx].first, values[parameter_idx]);
+    }
+
+    // TODO(moritz) deep_copy() shouldn't be necessary for every row if we could re-execute PQPs...
+    auto pqp = expression.pqp->deep_copy();
+    pqp->set_parameters(parameters);
+    query_plan.add_tree_by_root(pqp);
+  }
+
+  const auto tasks = query_plan.create_tasks();
+  CurrentScheduler::schedule_and_wait_for_tasks(tasks);
+
+  std::vector<std::shared_ptr<const Table>> results;
+  results.reserve(parameter_values.size());
+  for (const auto& pqp : query_plan.tree_roots()) {
+    results.emplace_back(pqp->get_output());
+  }
+
+  return results;
+}
+
+ExpressionEvaluator::SelectParameterValues ExpressionEvaluator::_select_parameter_values_for_row(
+    const PQPSelectExpression& expression, const ChunkOffset chunk_offset) const {
   Assert(expression.parameters.empty() || _chunk,
          "Sub-SELECT references external Columns but Expression doesn't operate on a Table/Chunk");
 
-  std::unordered_map<ParameterID, AllTypeVariant> parameters;
+  auto parameter_values = SelectParameterValues{};
+  parameter_values.reserve(expression.parameters.size());
 
-  for (auto parameter_idx = size_t{0}; parameter_idx < expression.parameters.size(); ++parameter_idx) {
-    const auto& parameter_id_column_id = expression.parameters[parameter_idx];
-    const auto parameter_id = parameter_id_column_id.first;
+  for (const auto& parameter_id_column_id : expression.parameters) {
     const auto column_id = parameter_id_column_id.second;
     const auto& segment = *_chunk->get_segment(column_id);
 
@@ -740,23 +891,14 @@ std::shared_ptr<const Table> ExpressionEvaluator::_evaluate_select_expression_fo
           std::dynamic_pointer_cast<ExpressionResult<ColumnDataType>>(_segment_materializations[column_id]);
 
       if (segment_materialization->is_null(chunk_offset)) {
-        parameters.emplace(parameter_id, NullValue{});
+        parameter_values.emplace_back(NullValue{});
       } else {
-        parameters.emplace(parameter_id, segment_materialization->value(chunk_offset));
+        parameter_values.emplace_back(segment_materialization->value(chunk_offset));
       }
     });
   }
 
-  // TODO(moritz) deep_copy() shouldn't be necessary for every row if we could re-execute PQPs...
-  auto row_pqp = expression.pqp->deep_copy();
-  row_pqp->set_parameters(parameters);
-
-  SQLQueryPlan query_plan{CleanupTemporaries::Yes};
-  query_plan.add_tree_by_root(row_pqp);
-  const auto tasks = query_plan.create_tasks();
-  CurrentScheduler::schedule_and_wait_for_tasks(tasks);
-
-  return row_pqp->get_output();
+  return parameter_values;
 }
 
 std::shared_ptr<BaseSegment> ExpressionEvaluator::evaluate_expression_to_segment(const AbstractExpression& expression) {
@@ -827,7 +969,7 @@ std::shared_ptr<ExpressionResult<Result>> ExpressionEvaluator::_evaluate_binary_
       auto nulls = _evaluate_default_null_logic(left.nulls, right.nulls);
 
       // Using three different branches instead of views, which would generate 9 cases.
-      std::vector<Result> values(result_size);
+      auto values = _acquire_vector<Result>(result_size);
       if (left.is_literal() == right.is_literal()) {
         for (auto row_idx = ChunkOffset{0}; row_idx < result_size; ++row_idx) {
           Functor{}(values[row_idx], left.values[row_idx], right.values[row_idx]);
@@ -842,7 +984,7 @@ std::shared_ptr<ExpressionResult<Result>> ExpressionEvaluator::_evaluate_binary_
         }
       }
 
-      result = std::make_shared<ExpressionResult<Result>>(std::move(values), std::move(nulls));
+      result = _make_result(std::move(values), std::move(nulls));
     } else {
       Fail("BinaryOperation not supported on the requested DataTypes");
     }
@@ -863,8 +1005,8 @@ std::shared_ptr<ExpressionResult<Result>> ExpressionEvaluator::_evaluate_binary_
     if constexpr (Functor::template supports<Result, LeftDataType, RightDataType>::value) {
       const auto result_row_count = _result_size(left.size(), right.size());
 
-      std::vector<bool> nulls(result_row_count);
-      std::vector<Result> values(result_row_count);
+      auto nulls = _acquire_vector<bool>(result_row_count);
+      auto values = _acquire_vector<Result>(result_row_count);
 
       for (auto row_idx = ChunkOffset{0}; row_idx < result_row_count; ++row_idx) {
         bool null;
@@ -873,7 +1015,7 @@ std::shared_ptr<ExpressionResult<Result>> ExpressionEvaluator::_evaluate_binary_
         nulls[row_idx] = null;
       }
 
-      result = std::make_shared<ExpressionResult<Result>>(std::move(values), std::move(nulls));
+      result = _make_result(std::move(values), std::move(nulls));
 
     } else {
       Fail("BinaryOperation not supported on the requested DataTypes");
@@ -951,7 +1093,7 @@ ChunkOffset ExpressionEvaluator::_result_size(const RowCounts... row_counts) {
 std::vector<bool> ExpressionEvaluator::_evaluate_default_null_logic(const std::vector<bool>& left,
                                                                     const std::vector<bool>& right) const {
   if (left.size() == right.size()) {
-    std::vector<bool> nulls(left.size());
+    auto nulls = _acquire_vector<bool>(left.size());
     std::transform(left.begin(), left.end(), right.begin(), nulls.begin(), [](auto l, auto r) { return l || r; });
     return nulls;
   } else if (left.size() > right.size()) {
@@ -961,7 +1103,9 @@ std::vector<bool> ExpressionEvaluator::_evaluate_default_null_logic(const std::v
     if (!right.empty() && right.front()) {
       return std::vector<bool>({true});
     } else {
-      return left;
+      auto nulls = _result_pool->acquire<bool>();
+      nulls.assign(left.begin(), left.end());
+      return nulls;
     }
   } else {
     DebugAssert(left.size() <= 1,
@@ -970,7 +1114,9 @@ std::vector<bool> ExpressionEvaluator::_evaluate_default_null_logic(const std::v
     if (!left.empty() && left.front()) {
       return std::vector<bool>({true});
     } else {
-      return right;
+      auto nulls = _result_pool->acquire<bool>();
+      nulls.assign(right.begin(), right.end());
+      return nulls;
     }
   }
 }
@@ -985,17 +1131,16 @@ void ExpressionEvaluator::_materialize_segment_if_not_yet_materialized(const Col
   resolve_data_type(segment.data_type(), [&](const auto column_data_type_t) {
     using ColumnDataType = typename decltype(column_data_type_t)::type;
 
-    std::vector<ColumnDataType> values;
+    auto values = _result_pool->acquire<ColumnDataType>();
     materialize_values(segment, values);
 
     if (_table->column_is_nullable(column_id)) {
-      std::vector<bool> nulls;
+      auto nulls = _result_pool->acquire<bool>();
       materialize_nulls<ColumnDataType>(segment, nulls);
-      _segment_materializations[column_id] =
-          std::make_shared<ExpressionResult<ColumnDataType>>(std::move(values), std::move(nulls));
+      _segment_materializations[column_id] = _make_result(std::move(values), std::move(nulls));
 
     } else {
-      _segment_materializations[column_id] = std::make_shared<ExpressionResult<ColumnDataType>>(std::move(values));
+      _segment_materializations[column_id] = _make_result(std::move(values));
     }
   });
 }
@@ -9,6 +9,7 @@
 #include "expression/logical_expression.hpp"
 #include "expression/pqp_select_expression.hpp"
 #include "expression_result.hpp"
+#include "expression_result_pool.hpp"
 #include "null_value.hpp"
 #include "types.hpp"
 
@@ -67,7 +68,20 @@ class ExpressionEvaluator final {
   // Utility to populate a cache of UncorrelatedSelectResults
   std::shared_ptr<const Table> evaluate_uncorrelated_select_expression(const PQPSelectExpression& expression);
 
+  /**
+   * Correlated PQPSelectExpressions are executed once for each distinct combination of parameter values in the
+   * evaluated rows. While an expression is evaluated, these results are cached for subsequent rows as long as the
+   * cached tables (as estimated by Table::estimate_memory_usage()) fit into this budget. A budget of 0 disables the
+   * cache, so that only rows evaluated in the same batch share results.
+   */
+  static constexpr auto DEFAULT_CORRELATED_SELECT_CACHE_BUDGET = size_t{128 * 1024 * 1024};
+  static void set_correlated_select_cache_budget(const size_t bytes);
+  static size_t correlated_select_cache_budget();
+
  private:
+  // The values of the parameters of a PQPSelectExpression, in the order of PQPSelectExpression::parameters
+  using SelectParameterValues = std::vector<AllTypeVariant>;
+
   template <typename Result>
   std::shared_ptr<ExpressionResult<Result>> _evaluate_arithmetic_expression(const ArithmeticExpression& expression);
 
@@ -100,6 +114,13 @@ class ExpressionEvaluator final {
   std::shared_ptr<const Table> _evaluate_select_expression_for_row(const PQPSelectExpression& expression,
                                                                    const ChunkOffset chunk_offset);
 
+  // Executes the PQP of expression once for each entry in parameter_values, in parallel
+  std::vector<std::shared_ptr<const Table>> _evaluate_select_expression_for_parameter_values(
+      const PQPSelectExpression& expression, const std::vector<SelectParameterValues>& parameter_values);
+
+  SelectParameterValues _select_parameter_values_for_row(const PQPSelectExpression& expression,
+                                                         const ChunkOffset chunk_offset) const;
+
   template <typename Result>
   std::shared_ptr<ExpressionResult<Result>> _evaluate_column_expression(const PQPColumnExpression& column_expression);
 
@@ -170,6 +191,15 @@ class ExpressionEvaluator final {
 
   void _materialize_segment_if_not_yet_materialized(const ColumnID column_id);
 
+  // Returns a value-initialized vector of `size` elements, recycled from _result_pool if possible
+  template <typename T>
+  std::vector<T> _acquire_vector(const size_t size) const;
+
+  // Creates an ExpressionResult that returns its vectors to _result_pool once it is destroyed
+  template <typename Result>
+  std::shared_ptr<ExpressionResult<Result>> _make_result(std::vector<Result>&& values,
+                                                         std::vector<bool>&& nulls = {}) const;
+
   std::shared_ptr<ExpressionResult<std::string>> _evaluate_substring(
       const std::vector<std::shared_ptr<AbstractExpression>>& arguments);
   std::shared_ptr<ExpressionResult<std::string>> _evaluate_concatenate(
@@ -187,6 +217,9 @@ class ExpressionEvaluator final {
   std::vector<std::shared_ptr<BaseExpressionResult>> _segment_materializations;
 
   const std::shared_ptr<const UncorrelatedSelectResults> _uncorrelated_select_results;
+
+  // Scratch memory of the current thread, so that consecutive evaluators on a worker reuse each other's vectors
+  const std::shared_ptr<ExpressionResultPool> _result_pool{ExpressionResultPool::thread_local_pool()};
 };
 
 }  // namespace opossum
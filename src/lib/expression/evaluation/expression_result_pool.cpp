@@ -0,0 +1,12 @@
+#include "expression_result_pool.hpp"
+
+#include <memory>
+
+namespace opossum {
+
+const std::shared_ptr<ExpressionResultPool>& ExpressionResultPool::thread_local_pool() {
+  thread_local const auto pool = std::make_shared<ExpressionResultPool>();
+  return pool;
+}
+
+}  // namespace opossum
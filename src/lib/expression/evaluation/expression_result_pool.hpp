@@ -0,0 +1,63 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "null_value.hpp"
+
+namespace opossum {
+
+/**
+ * Recycles the vectors backing ExpressionResults. For every chunk, the ExpressionEvaluator allocates a values (and
+ * possibly a nulls) vector per sub-expression, all of them with about the same size. Instead of freeing these vectors
+ * once an ExpressionResult is no longer needed, they are returned to the pool and handed out again, with their
+ * capacity intact, to the evaluation of the next chunk.
+ *
+ * There is one pool per thread (see thread_local_pool()), so that workers evaluating different chunks do not compete
+ * for the same vectors. An ExpressionResult might outlive its evaluator and be destroyed by another thread, which is
+ * why acquire() and release() are nevertheless synchronized.
+ */
+class ExpressionResultPool final {
+ public:
+  // The number of vectors of each type that are kept for reuse. Further released vectors are freed.
+  static constexpr size_t MAX_POOLED_VECTOR_COUNT = 8;
+
+  static const std::shared_ptr<ExpressionResultPool>& thread_local_pool();
+
+  // Returns an empty vector, whose capacity might be non-zero if it was recycled
+  template <typename T>
+  std::vector<T> acquire() {
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+
+    auto& free_vectors = std::get<std::vector<std::vector<T>>>(_free_vectors);
+    if (free_vectors.empty()) return {};
+
+    auto vector = std::move(free_vectors.back());
+    free_vectors.pop_back();
+    return vector;
+  }
+
+  template <typename T>
+  void release(std::vector<T>&& vector) {
+    if (vector.capacity() == 0) return;
+    vector.clear();
+
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+
+    auto& free_vectors = std::get<std::vector<std::vector<T>>>(_free_vectors);
+    if (free_vectors.size() < MAX_POOLED_VECTOR_COUNT) free_vectors.emplace_back(std::move(vector));
+  }
+
+ private:
+  std::mutex _mutex;
+
+  std::tuple<std::vector<std::vector<int32_t>>, std::vector<std::vector<int64_t>>, std::vector<std::vector<float>>,
+             std::vector<std::vector<double>>, std::vector<std::vector<std::string>>,
+             std::vector<std::vector<NullValue>>, std::vector<std::vector<bool>>>
+      _free_vectors;
+};
+
+}  // namespace opossum
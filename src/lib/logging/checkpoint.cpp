@@ -0,0 +1,515 @@
+#include "checkpoint.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "concurrency/transaction_manager.hpp"
+#include "import_export/binary.hpp"
+#include "resolve_type.hpp"
+#include "statistics/chunk_statistics/chunk_statistics.hpp"
+#include "statistics/chunk_statistics/segment_statistics.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/fixed_string_dictionary_segment.hpp"
+#include "storage/frame_of_reference_segment.hpp"
+#include "storage/mvcc_data.hpp"
+#include "storage/run_length_segment.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "storage/vector_compression/resolve_compressed_vector_type.hpp"
+#include "utils/assert.hpp"
+#include "utils/filesystem.hpp"
+
+namespace opossum {
+
+namespace {
+
+// "HYRISECP", identifies checkpoint files
+constexpr auto CHECKPOINT_MAGIC = uint64_t{0x5043455349525948};
+
+// Vectors start at multiples of this, so that they can be read from the mapped file in place (see uint128_t)
+constexpr auto VECTOR_ALIGNMENT = size_t{16};
+
+class CheckpointWriter {
+ public:
+  explicit CheckpointWriter(const std::string& file_path)
+      : _file_path(file_path), _file(file_path, std::ios::binary | std::ios::trunc) {
+    Assert(_file.is_open(), "Cannot open checkpoint file " + _file_path);
+    _file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+  }
+
+  template <typename T>
+  void write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written directly");
+    _write(&value, sizeof(T));
+  }
+
+  void write_string(const std::string& value) {
+    write(static_cast<uint32_t>(value.size()));
+    _write(value.data(), value.size());
+  }
+
+  // Strings are written as an array of offsets into an array of their characters, bools as one byte each
+  template <typename T, typename Allocator>
+  void write_values(const std::vector<T, Allocator>& values) {
+    write(static_cast<uint64_t>(values.size()));
+
+    if constexpr (std::is_same_v<T, std::string>) {
+      auto offsets = std::vector<uint64_t>{};
+      offsets.reserve(values.size() + 1);
+      auto characters = std::vector<char>{};
+
+      for (const auto& value : values) {
+        offsets.emplace_back(characters.size());
+        characters.insert(characters.end(), value.begin(), value.end());
+      }
+      offsets.emplace_back(characters.size());
+
+      _write_vector(offsets.data(), offsets.size());
+      _write_vector(characters.data(), characters.size());
+    } else if constexpr (std::is_same_v<T, bool>) {
+      const auto bytes = std::vector<BoolAsByteType>(values.begin(), values.end());
+      _write_vector(bytes.data(), bytes.size());
+    } else {
+      _write_vector(values.data(), values.size());
+    }
+  }
+
+  // Makes sure that the checkpoint is durable
+  void sync() {
+    _file.close();
+
+    const auto file_descriptor = open(_file_path.c_str(), O_RDONLY);
+    Assert(file_descriptor != -1, "Cannot open checkpoint file " + _file_path + ": " + std::strerror(errno));
+    const auto sync_result = fsync(file_descriptor);
+    close(file_descriptor);
+    Assert(sync_result == 0, "Cannot sync checkpoint file " + _file_path + ": " + std::strerror(errno));
+  }
+
+ private:
+  template <typename T>
+  void _write_vector(const T* values, const size_t count) {
+    static const auto padding = std::vector<char>(VECTOR_ALIGNMENT, '\0');
+    _write(padding.data(), (VECTOR_ALIGNMENT - _position % VECTOR_ALIGNMENT) % VECTOR_ALIGNMENT);
+    _write(values, count * sizeof(T));
+  }
+
+  void _write(const void* data, const size_t size) {
+    _file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    _position += size;
+  }
+
+  const std::string _file_path;
+  std::ofstream _file;
+  size_t _position{0};
+};
+
+// Maps a checkpoint file into memory and reads the values written by the CheckpointWriter from it
+class CheckpointReader : private Noncopyable {
+ public:
+  explicit CheckpointReader(const std::string& file_path) {
+    const auto file_descriptor = open(file_path.c_str(), O_RDONLY);
+    Assert(file_descriptor != -1, "Cannot open checkpoint file " + file_path + ": " + std::strerror(errno));
+
+    struct stat file_status {};
+    const auto stat_result = fstat(file_descriptor, &file_status);
+    Assert(stat_result == 0 && file_status.st_size > 0, "Cannot read checkpoint file " + file_path);
+    _size = static_cast<size_t>(file_status.st_size);
+
+    auto* const mapping = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    close(file_descriptor);
+    Assert(mapping != MAP_FAILED, "Cannot map checkpoint file " + file_path + ": " + std::strerror(errno));
+    _data = static_cast<const char*>(mapping);
+
+    // The checkpoint is read from front to back exactly once
+    madvise(mapping, _size, MADV_SEQUENTIAL);
+  }
+
+  ~CheckpointReader() { munmap(const_cast<char*>(_data), _size); }
+
+  template <typename T>
+  T read() {
+    auto value = T{};
+    std::memcpy(&value, _read(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  std::string read_string() {
+    const auto size = read<uint32_t>();
+    const auto* const characters = _read(size);
+    return std::string{characters, characters + size};
+  }
+
+  // Reads values written by CheckpointWriter::write_values() into a (possibly different) container
+  template <typename Container>
+  Container read_values() {
+    using T = typename Container::value_type;
+
+    const auto count = static_cast<size_t>(read<uint64_t>());
+
+    if constexpr (std::is_same_v<T, std::string>) {
+      const auto* const offsets = _read_vector<uint64_t>(count + 1);
+      const auto* const characters = _read_vector<char>(offsets[count]);
+
+      auto values = Container(count);
+      for (auto value_idx = size_t{0}; value_idx < count; ++value_idx) {
+        values[value_idx] = std::string{characters + offsets[value_idx], characters + offsets[value_idx + 1]};
+      }
+      return values;
+    } else if constexpr (std::is_same_v<T, bool>) {
+      const auto* const bytes = _read_vector<BoolAsByteType>(count);
+      return Container(bytes, bytes + count);
+    } else {
+      const auto* const values = _read_vector<T>(count);
+      return Container(values, values + count);
+    }
+  }
+
+ private:
+  template <typename T>
+  const T* _read_vector(const size_t count) {
+    _read((VECTOR_ALIGNMENT - _position % VECTOR_ALIGNMENT) % VECTOR_ALIGNMENT);
+    return reinterpret_cast<const T*>(_read(count * sizeof(T)));
+  }
+
+  const char* _read(const size_t size) {
+    Assert(_position + size <= _size, "Checkpoint file is shorter than expected");
+    const auto* const data = _data + _position;
+    _position += size;
+    return data;
+  }
+
+  const char* _data{nullptr};
+  size_t _size{0};
+  size_t _position{0};
+};
+
+void write_compressed_vector(CheckpointWriter& writer, const BaseCompressedVector& vector) {
+  writer.write(vector.type());
+
+  resolve_compressed_vector_type(vector, [&](const auto& typed_vector) {
+    using VectorType = std::decay_t<decltype(typed_vector)>;
+
+    if constexpr (std::is_same_v<VectorType, SimdBp128Vector>) {
+      writer.write(static_cast<uint64_t>(typed_vector.size()));
+    }
+    writer.write_values(typed_vector.data());
+  });
+}
+
+std::unique_ptr<const BaseCompressedVector> read_compressed_vector(CheckpointReader& reader) {
+  const auto type = reader.read<CompressedVectorType>();
+
+  switch (type) {
+    case CompressedVectorType::FixedSize4ByteAligned:
+      return std::make_unique<FixedSizeByteAlignedVector<uint32_t>>(reader.read_values<pmr_vector<uint32_t>>());
+    case CompressedVectorType::FixedSize2ByteAligned:
+      return std::make_unique<FixedSizeByteAlignedVector<uint16_t>>(reader.read_values<pmr_vector<uint16_t>>());
+    case CompressedVectorType::FixedSize1ByteAligned:
+      return std::make_unique<FixedSizeByteAlignedVector<uint8_t>>(reader.read_values<pmr_vector<uint8_t>>());
+    case CompressedVectorType::SimdBp128: {
+      const auto size = static_cast<size_t>(reader.read<uint64_t>());
+      return std::make_unique<SimdBp128Vector>(reader.read_values<pmr_vector<uint128_t>>(), size);
+    }
+    default:
+      Fail("Invalid compressed vector type in checkpoint");
+  }
+}
+
+template <typename T>
+void write_segment(CheckpointWriter& writer, const BaseSegment& segment, const ChunkOffset row_count) {
+  resolve_segment_type<T>(segment, [&](const auto& typed_segment) {
+    using SegmentType = std::decay_t<decltype(typed_segment)>;
+
+    if constexpr (std::is_same_v<SegmentType, ValueSegment<T>>) {
+      writer.write(EncodingType::Unencoded);
+
+      // Rows that were appended after the chunk sizes were determined are not part of the checkpoint
+      const auto& values = typed_segment.values();
+      writer.write_values(std::vector<T>(values.begin(), values.begin() + row_count));
+
+      if (typed_segment.is_nullable()) {
+        const auto& null_values = typed_segment.null_values();
+        writer.write_values(std::vector<bool>(null_values.begin(), null_values.begin() + row_count));
+      }
+    } else if constexpr (std::is_same_v<SegmentType, DictionarySegment<T>>) {
+      writer.write(EncodingType::Dictionary);
+      writer.write_values(*typed_segment.dictionary());
+      writer.write(static_cast<ValueID::base_type>(typed_segment.null_value_id()));
+      write_compressed_vector(writer, *typed_segment.attribute_vector());
+    } else if constexpr (std::is_same_v<SegmentType, FixedStringDictionarySegment<T>>) {
+      const auto& dictionary = *typed_segment.fixed_string_dictionary();
+
+      writer.write(EncodingType::FixedStringDictionary);
+      writer.write(static_cast<uint64_t>(dictionary.string_length()));
+      writer.write_values(dictionary.chars());
+      writer.write(static_cast<ValueID::base_type>(typed_segment.null_value_id()));
+      write_compressed_vector(writer, *typed_segment.attribute_vector());
+    } else if constexpr (std::is_same_v<SegmentType, RunLengthSegment<T>>) {
+      writer.write(EncodingType::RunLength);
+      writer.write_values(*typed_segment.values());
+      writer.write_values(*typed_segment.null_values());
+      writer.write_values(*typed_segment.end_positions());
+    } else if constexpr (std::is_same_v<SegmentType, ReferenceSegment>) {
+      Fail("Checkpoints can only contain data segments");
+    } else {
+      // FrameOfReferenceSegment, which cannot be named for all T
+      writer.write(EncodingType::FrameOfReference);
+      writer.write_values(typed_segment.block_minima());
+      writer.write_values(typed_segment.null_values());
+      write_compressed_vector(writer, typed_segment.offset_values());
+    }
+  });
+}
+
+template <typename T>
+std::shared_ptr<BaseSegment> read_segment(CheckpointReader& reader, const bool is_nullable) {
+  const auto encoding_type = reader.read<EncodingType>();
+
+  switch (encoding_type) {
+    case EncodingType::Unencoded: {
+      auto values = reader.read_values<pmr_concurrent_vector<T>>();
+      if (!is_nullable) return std::make_shared<ValueSegment<T>>(std::move(values));
+
+      auto null_values = reader.read_values<pmr_concurrent_vector<bool>>();
+      return std::make_shared<ValueSegment<T>>(std::move(values), std::move(null_values));
+    }
+
+    case EncodingType::Dictionary: {
+      const auto dictionary = std::make_shared<pmr_vector<T>>(reader.read_values<pmr_vector<T>>());
+      const auto null_value_id = ValueID{reader.read<ValueID::base_type>()};
+      const auto attribute_vector = std::shared_ptr<const BaseCompressedVector>{read_compressed_vector(reader)};
+      return std::make_shared<DictionarySegment<T>>(dictionary, attribute_vector, null_value_id);
+    }
+
+    case EncodingType::FixedStringDictionary:
+      if constexpr (std::is_same_v<T, std::string>) {
+        const auto string_length = static_cast<size_t>(reader.read<uint64_t>());
+        const auto dictionary =
+            std::make_shared<FixedStringVector>(reader.read_values<pmr_vector<char>>(), string_length);
+        const auto null_value_id = ValueID{reader.read<ValueID::base_type>()};
+        const auto attribute_vector = std::shared_ptr<const BaseCompressedVector>{read_compressed_vector(reader)};
+        return std::make_shared<FixedStringDictionarySegment<T>>(dictionary, attribute_vector, null_value_id);
+      }
+      break;
+
+    case EncodingType::RunLength: {
+      const auto values = std::make_shared<pmr_vector<T>>(reader.read_values<pmr_vector<T>>());
+      const auto null_values = std::make_shared<pmr_vector<bool>>(reader.read_values<pmr_vector<bool>>());
+      const auto end_positions =
+          std::make_shared<pmr_vector<ChunkOffset>>(reader.read_values<pmr_vector<ChunkOffset>>());
+      return std::make_shared<RunLengthSegment<T>>(values, null_values, end_positions);
+    }
+
+    case EncodingType::FrameOfReference:
+      if constexpr (std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>) {
+        auto block_minima = reader.read_values<pmr_vector<T>>();
+        auto null_values = reader.read_values<pmr_vector<bool>>();
+        auto offset_values = read_compressed_vector(reader);
+        return std::make_shared<FrameOfReferenceSegment<T>>(std::move(block_minima), std::move(null_values),
+                                                             std::move(offset_values));
+      }
+      break;
+  }
+
+  Fail("Invalid segment in checkpoint");
+}
+
+/**
+ * Table layout:
+ *
+ * Description           | Type
+ * ---------------------------------------------------------------------
+ * Table name            | string
+ * Max chunk size        | uint32_t
+ * Column count          | uint16_t
+ * Column definitions    | (string name, DataType, bool nullable) array
+ * Chunk count           | uint32_t
+ * Chunks                | see below
+ *
+ * Chunk layout:
+ *
+ * Description           | Type
+ * ---------------------------------------------------------------------
+ * Row count             | ChunkOffset
+ * Is mutable            | bool
+ * Invisible rows        | ChunkOffset vector
+ * Segments              | (EncodingType, vectors of the segment) array
+ */
+void write_table(CheckpointWriter& writer, const std::string& table_name, Table& table,
+                 const CommitID snapshot_commit_id) {
+  writer.write_string(table_name);
+  writer.write(table.max_chunk_size());
+
+  writer.write(static_cast<ColumnID::base_type>(table.column_count()));
+  for (const auto& column_definition : table.column_definitions()) {
+    writer.write_string(column_definition.name);
+    writer.write(column_definition.data_type);
+    writer.write(column_definition.nullable);
+  }
+
+  // Inserts into the table might run concurrently, so the chunks are written with the size they have right now
+  auto chunk_sizes = std::vector<ChunkOffset>{};
+  {
+    const auto append_lock = table.acquire_append_mutex();
+    for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      chunk_sizes.emplace_back(static_cast<ChunkOffset>(table.get_chunk(chunk_id)->size()));
+    }
+  }
+
+  writer.write(static_cast<ChunkID::base_type>(chunk_sizes.size()));
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_sizes.size(); ++chunk_id) {
+    const auto chunk = table.get_chunk(chunk_id);
+    const auto row_count = chunk_sizes[chunk_id];
+
+    writer.write(row_count);
+    writer.write(chunk->is_mutable());
+
+    auto invisible_chunk_offsets = std::vector<ChunkOffset>{};
+    {
+      const auto mvcc_data = chunk->get_scoped_mvcc_data_lock();
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+        const auto is_visible = mvcc_data->begin_cids[chunk_offset] <= snapshot_commit_id &&
+                                mvcc_data->end_cids[chunk_offset] > snapshot_commit_id;
+        if (!is_visible) invisible_chunk_offsets.emplace_back(chunk_offset);
+      }
+    }
+    writer.write_values(invisible_chunk_offsets);
+
+    for (auto column_id = ColumnID{0}; column_id < table.column_count(); ++column_id) {
+      resolve_data_type(table.column_data_type(column_id), [&](const auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        write_segment<ColumnDataType>(writer, *chunk->get_segment(column_id), row_count);
+      });
+    }
+  }
+}
+
+std::pair<std::string, std::shared_ptr<Table>> read_table(CheckpointReader& reader) {
+  const auto table_name = reader.read_string();
+  const auto max_chunk_size = reader.read<uint32_t>();
+
+  const auto column_count = reader.read<ColumnID::base_type>();
+  auto column_definitions = TableColumnDefinitions{};
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    const auto column_name = reader.read_string();
+    const auto data_type = reader.read<DataType>();
+    const auto nullable = reader.read<bool>();
+    column_definitions.emplace_back(column_name, data_type, nullable);
+  }
+
+  const auto table = std::make_shared<Table>(column_definitions, TableType::Data, max_chunk_size, UseMvcc::Yes);
+
+  const auto chunk_count = reader.read<ChunkID::base_type>();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto row_count = reader.read<ChunkOffset>();
+    const auto is_mutable = reader.read<bool>();
+    const auto invisible_chunk_offsets = reader.read_values<std::vector<ChunkOffset>>();
+
+    auto segments = Segments{};
+    for (const auto& column_definition : column_definitions) {
+      resolve_data_type(column_definition.data_type, [&](const auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        segments.emplace_back(read_segment<ColumnDataType>(reader, column_definition.nullable));
+      });
+    }
+    Assert(segments.empty() || segments.front()->size() == row_count, "Row count does not match the segments");
+
+    table->append_chunk(segments);
+    const auto chunk = table->get_chunk(chunk_id);
+
+    // Invisible rows are restored like rolled back rows. All other rows are visible for every transaction.
+    if (!invisible_chunk_offsets.empty()) {
+      auto mvcc_data = chunk->get_scoped_mvcc_data_lock();
+      for (const auto chunk_offset : invisible_chunk_offsets) {
+        mvcc_data->begin_cids[chunk_offset] = 0u;
+        mvcc_data->end_cids[chunk_offset] = 0u;
+      }
+    }
+
+    // Same as in the ChunkEncoder
+    if (!is_mutable) {
+      auto segment_statistics = std::vector<std::shared_ptr<SegmentStatistics>>{};
+      for (auto column_id = ColumnID{0}; column_id < chunk->column_count(); ++column_id) {
+        const auto data_type = column_definitions[column_id].data_type;
+        segment_statistics.emplace_back(SegmentStatistics::build_statistics(data_type, chunk->get_segment(column_id)));
+      }
+
+      chunk->mark_immutable();
+      chunk->set_statistics(std::make_shared<ChunkStatistics>(segment_statistics));
+    }
+  }
+
+  return {table_name, table};
+}
+
+}  // namespace
+
+CheckpointID Checkpoint::write(const std::string& file_path) {
+  // Only has to be unique among the checkpoints of a log
+  const auto checkpoint_id = static_cast<CheckpointID>(std::chrono::system_clock::now().time_since_epoch().count());
+
+  // The checkpoint contains all transactions up to the snapshot commit id. In the log, their commit records precede
+  // the checkpoint record, those of all later transactions follow it.
+  auto snapshot_commit_id = CommitID{0};
+  {
+    const auto commit_log_lock = TransactionManager::get().acquire_commit_log_mutex();
+    snapshot_commit_id = TransactionManager::get().last_commit_id();
+    if (Logger::get().is_enabled()) Logger::get().log_checkpoint(checkpoint_id);
+  }
+
+  // Until the new checkpoint is complete, the previous one remains valid
+  const auto temporary_file_path = file_path + ".tmp";
+  {
+    auto writer = CheckpointWriter{temporary_file_path};
+    writer.write(CHECKPOINT_MAGIC);
+    writer.write(checkpoint_id);
+
+    const auto table_names = StorageManager::get().table_names();
+    writer.write(static_cast<uint32_t>(table_names.size()));
+    for (const auto& table_name : table_names) {
+      write_table(writer, table_name, *StorageManager::get().get_table(table_name), snapshot_commit_id);
+    }
+
+    writer.sync();
+  }
+
+  if (Logger::get().is_enabled()) {
+    // The checkpoint record has to be durable before the checkpoint replaces the previous one
+    Logger::get().flush();
+    filesystem::rename(temporary_file_path, file_path);
+    Logger::get().truncate(checkpoint_id);
+  } else {
+    filesystem::rename(temporary_file_path, file_path);
+  }
+
+  return checkpoint_id;
+}
+
+CheckpointID Checkpoint::load(const std::string& file_path) {
+  auto reader = CheckpointReader{file_path};
+  Assert(reader.read<uint64_t>() == CHECKPOINT_MAGIC, file_path + " is not a checkpoint");
+
+  const auto checkpoint_id = reader.read<CheckpointID>();
+
+  const auto table_count = reader.read<uint32_t>();
+  for (auto table_idx = uint32_t{0}; table_idx < table_count; ++table_idx) {
+    auto [table_name, table] = read_table(reader);
+    StorageManager::get().add_table(table_name, table);
+  }
+
+  return checkpoint_id;
+}
+
+}  // namespace opossum
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+
+#include "logging/logger.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * A Checkpoint is a consistent snapshot of all tables in the StorageManager, stored in a single binary file. Together
+ * with the log (see Logger), it allows restarting without importing the tables again and without replaying the whole
+ * history of the log:
+ *
+ *   const auto checkpoint_id = Checkpoint::load("hyrise.checkpoint");
+ *   Logger::get().enable("hyrise.log", Logger::DEFAULT_FLUSH_INTERVAL, checkpoint_id);
+ *
+ * Segments are stored as they are, i.e., encoded segments keep their encoding and their compressed vectors. All
+ * vectors are stored in their in-memory layout, aligned within the file. When loading, the file is mapped into memory
+ * and every vector is restored with a single copy instead of being decoded value by value. Only strings of unencoded
+ * and dictionary segments are constructed one by one. Thus, the restart time depends on the number of chunks and the
+ * size of the data, not on the number of rows.
+ *
+ * The checkpoint contains exactly the rows that are visible at the last commit id when it is started. All other rows
+ * are written as invisible rows, so that rows keep their RowIDs and the log can be replayed on top of the checkpoint.
+ *
+ * Views and indexes are not part of the checkpoint.
+ */
+class Checkpoint final {
+ public:
+  /**
+   * Writes a checkpoint to `file_path`, replacing the previous one, and returns its id. If the Logger is enabled, the
+   * log is truncated to the transactions that are not contained in the checkpoint. Transactions can run while the
+   * checkpoint is written, but tables must not be added or dropped.
+   */
+  static CheckpointID write(const std::string& file_path);
+
+  // Adds all tables of the checkpoint at `file_path` to the StorageManager and returns the id of the checkpoint
+  static CheckpointID load(const std::string& file_path);
+};
+
+}  // namespace opossum
@@ -0,0 +1,534 @@
+#include "logger.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "statistics/table_statistics.hpp"
+#include "storage/mvcc_data.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+#include "utils/filesystem.hpp"
+#include "utils/murmur_hash.hpp"
+#include "utils/pausable_loop_thread.hpp"
+
+namespace opossum {
+
+namespace {
+
+// Record header: type, payload size, and payload checksum
+constexpr auto RECORD_HEADER_SIZE = sizeof(uint8_t) + sizeof(uint32_t) + sizeof(uint32_t);
+
+template <typename T>
+void write_value(std::vector<char>& buffer, const T& value) {
+  const auto* const bytes = reinterpret_cast<const char*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+void write_string(std::vector<char>& buffer, const std::string& value) {
+  write_value(buffer, static_cast<uint32_t>(value.size()));
+  buffer.insert(buffer.end(), value.begin(), value.end());
+}
+
+void write_variant(std::vector<char>& buffer, const AllTypeVariant& value) {
+  const auto data_type = data_type_from_all_type_variant(value);
+  write_value(buffer, static_cast<uint8_t>(data_type));
+
+  if (data_type == DataType::Null) return;
+
+  resolve_data_type(data_type, [&](const auto type) {
+    using ColumnDataType = typename decltype(type)::type;
+
+    if constexpr (std::is_same_v<ColumnDataType, std::string>) {
+      write_string(buffer, boost::get<std::string>(value));
+    } else {
+      write_value(buffer, boost::get<ColumnDataType>(value));
+    }
+  });
+}
+
+// Reads the values written by the functions above from a checksummed record
+class LogReader {
+ public:
+  LogReader(const char* begin, const char* end) : _position(begin), _end(end) {}
+
+  template <typename T>
+  T read() {
+    Assert(_position + sizeof(T) <= _end, "Log record is shorter than expected");
+    auto value = T{};
+    std::memcpy(&value, _position, sizeof(T));
+    _position += sizeof(T);
+    return value;
+  }
+
+  std::string read_string() {
+    const auto size = read<uint32_t>();
+    Assert(_position + size <= _end, "Log record is shorter than expected");
+    auto value = std::string{_position, _position + size};
+    _position += size;
+    return value;
+  }
+
+  AllTypeVariant read_variant() {
+    const auto data_type = static_cast<DataType>(read<uint8_t>());
+    if (data_type == DataType::Null) return NULL_VALUE;
+
+    auto value = AllTypeVariant{};
+    resolve_data_type(data_type, [&](const auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+
+      if constexpr (std::is_same_v<ColumnDataType, std::string>) {
+        value = read_string();
+      } else {
+        value = read<ColumnDataType>();
+      }
+    });
+    return value;
+  }
+
+ private:
+  const char* _position;
+  const char* const _end;
+};
+
+// Makes sure that the row exists in the table, the same way Insert reserves rows
+void reserve_row(Table& table, const RowID& row_id) {
+  while (table.chunk_count() <= row_id.chunk_id) {
+    table.append_mutable_chunk();
+  }
+
+  const auto chunk = table.get_chunk(row_id.chunk_id);
+  const auto old_size = chunk->size();
+  if (row_id.chunk_offset < old_size) return;
+
+  const auto new_size = row_id.chunk_offset + size_t{1};
+
+  // Until a row is replayed, it is invisible, just as it was while its inserting transaction was running
+  chunk->get_scoped_mvcc_data_lock()->grow_by(new_size - old_size, MvccData::MAX_COMMIT_ID);
+
+  for (auto column_id = ColumnID{0}; column_id < chunk->column_count(); ++column_id) {
+    resolve_data_type(table.column_data_type(column_id), [&](const auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+
+      const auto value_segment = std::dynamic_pointer_cast<ValueSegment<ColumnDataType>>(chunk->get_segment(column_id));
+      Assert(value_segment, "Logged rows have to be stored in ValueSegments");
+
+      value_segment->values().resize(new_size);
+      if (value_segment->is_nullable()) value_segment->null_values().resize(new_size);
+    });
+  }
+}
+
+std::shared_ptr<Table> table_of_record(LogReader& reader) {
+  const auto table_name = reader.read_string();
+  Assert(StorageManager::get().has_table(table_name),
+         "Log references table '" + table_name + "', which has to be loaded before the log can be replayed");
+  return StorageManager::get().get_table(table_name);
+}
+
+RowID read_row_id(LogReader& reader) {
+  const auto chunk_id = ChunkID{reader.read<ChunkID::base_type>()};
+  const auto chunk_offset = reader.read<ChunkOffset>();
+  return RowID{chunk_id, chunk_offset};
+}
+
+std::shared_ptr<Table> replay_insert(LogReader& reader) {
+  const auto table = table_of_record(reader);
+  const auto row_count = reader.read<uint32_t>();
+
+  for (auto row_idx = uint32_t{0}; row_idx < row_count; ++row_idx) {
+    const auto row_id = read_row_id(reader);
+    reserve_row(*table, row_id);
+
+    const auto chunk = table->get_chunk(row_id.chunk_id);
+
+    for (auto column_id = ColumnID{0}; column_id < table->column_count(); ++column_id) {
+      const auto value = reader.read_variant();
+
+      resolve_data_type(table->column_data_type(column_id), [&](const auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+
+        const auto value_segment =
+            std::static_pointer_cast<ValueSegment<ColumnDataType>>(chunk->get_segment(column_id));
+        if (variant_is_null(value)) {
+          value_segment->null_values()[row_id.chunk_offset] = true;
+        } else {
+          value_segment->values()[row_id.chunk_offset] = type_cast<ColumnDataType>(value);
+        }
+      });
+    }
+
+    // Replayed rows are visible to all transactions after the recovery. The row might have been written as invisible
+    // to a checkpoint that was taken before the transaction committed, hence the end_cid is reset as well.
+    auto mvcc_data = chunk->get_scoped_mvcc_data_lock();
+    mvcc_data->begin_cids[row_id.chunk_offset] = 0u;
+    mvcc_data->end_cids[row_id.chunk_offset] = MvccData::MAX_COMMIT_ID;
+  }
+
+  return table;
+}
+
+std::shared_ptr<Table> replay_invalidation(LogReader& reader) {
+  const auto table = table_of_record(reader);
+  const auto row_count = reader.read<uint32_t>();
+
+  for (auto row_idx = uint32_t{0}; row_idx < row_count; ++row_idx) {
+    const auto row_id = read_row_id(reader);
+    reserve_row(*table, row_id);
+
+    auto mvcc_data = table->get_chunk(row_id.chunk_id)->get_scoped_mvcc_data_lock();
+    mvcc_data->register_invalidation();
+    mvcc_data->end_cids[row_id.chunk_offset] = 0u;
+  }
+
+  const auto table_statistics = table->table_statistics();
+  if (table_statistics) table_statistics->increase_invalid_row_count(row_count);
+
+  return table;
+}
+
+}  // namespace
+
+Logger& Logger::get() {
+  static Logger instance;
+  return instance;
+}
+
+void Logger::reset() {
+  auto& logger = get();
+  logger.disable();
+  logger._flush_count = 0;
+  logger._flushed_commit_count = 0;
+}
+
+Logger::~Logger() { disable(); }
+
+void Logger::enable(const std::string& file_path, const std::chrono::milliseconds flush_interval,
+                    const std::optional<CheckpointID>& checkpoint_id) {
+  Assert(!_is_enabled, "Logger is already enabled");
+  Assert(flush_interval > std::chrono::milliseconds{0}, "Flush interval has to be positive");
+
+  _file_path = file_path;
+  if (filesystem::exists(_file_path)) _recover(checkpoint_id);
+
+  _file_descriptor = open(_file_path.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+  Assert(_file_descriptor != -1, "Cannot open log file " + _file_path + ": " + std::strerror(errno));
+
+  // Transaction ids restart with every run. The startup record makes sure that records of transactions that did not
+  // commit in a previous run are not attributed to transactions of this run.
+  {
+    const auto lock = std::lock_guard<std::mutex>{_buffer_mutex};
+    _append_record(RecordType::Startup, {});
+  }
+  flush();
+
+  _is_enabled = true;
+
+  _flush_thread = std::make_unique<PausableLoopThread>(flush_interval, [&](size_t) { flush(); });
+  _flush_thread->resume();
+}
+
+void Logger::disable() {
+  if (!_is_enabled) return;
+
+  _flush_thread.reset();
+  flush();
+
+  close(_file_descriptor);
+  _file_descriptor = -1;
+  _is_enabled = false;
+}
+
+bool Logger::is_enabled() const { return _is_enabled; }
+
+void Logger::log_insert(const TransactionID transaction_id, const std::string& table_name, const Table& table,
+                        const PosList& row_ids) {
+  auto payload = std::vector<char>{};
+  write_value(payload, transaction_id);
+  write_string(payload, table_name);
+  write_value(payload, static_cast<uint32_t>(row_ids.size()));
+
+  for (const auto& row_id : row_ids) {
+    write_value(payload, static_cast<ChunkID::base_type>(row_id.chunk_id));
+    write_value(payload, row_id.chunk_offset);
+
+    const auto chunk = table.get_chunk(row_id.chunk_id);
+    for (auto column_id = ColumnID{0}; column_id < table.column_count(); ++column_id) {
+      write_variant(payload, (*chunk->get_segment(column_id))[row_id.chunk_offset]);
+    }
+  }
+
+  const auto lock = std::lock_guard<std::mutex>{_buffer_mutex};
+  _append_record(RecordType::Insert, payload);
+  _transactions_with_records.emplace(transaction_id);
+}
+
+void Logger::log_invalidation(const TransactionID transaction_id, const std::string& table_name,
+                              const PosList& row_ids) {
+  auto payload = std::vector<char>{};
+  write_value(payload, transaction_id);
+  write_string(payload, table_name);
+  write_value(payload, static_cast<uint32_t>(row_ids.size()));
+
+  for (const auto& row_id : row_ids) {
+    write_value(payload, static_cast<ChunkID::base_type>(row_id.chunk_id));
+    write_value(payload, row_id.chunk_offset);
+  }
+
+  const auto lock = std::lock_guard<std::mutex>{_buffer_mutex};
+  _append_record(RecordType::Invalidation, payload);
+  _transactions_with_records.emplace(transaction_id);
+}
+
+void Logger::log_commit(const TransactionID transaction_id, const std::function<void()>& callback) {
+  auto payload = std::vector<char>{};
+  write_value(payload, transaction_id);
+
+  {
+    const auto lock = std::lock_guard<std::mutex>{_buffer_mutex};
+
+    if (_transactions_with_records.erase(transaction_id)) {
+      _append_record(RecordType::Commit, payload);
+      if (callback) _commit_callbacks.emplace_back(callback);
+      return;
+    }
+  }
+
+  // Nothing to make durable
+  if (callback) callback();
+}
+
+void Logger::log_checkpoint(const CheckpointID checkpoint_id) {
+  auto payload = std::vector<char>{};
+  write_value(payload, checkpoint_id);
+
+  const auto lock = std::lock_guard<std::mutex>{_buffer_mutex};
+  _append_record(RecordType::Checkpoint, payload);
+}
+
+void Logger::truncate(const CheckpointID checkpoint_id) {
+  Assert(_is_enabled, "Logger is not enabled");
+
+  // Make sure that the checkpoint record has been written
+  flush();
+
+  const auto flush_lock = std::lock_guard<std::mutex>{_flush_mutex};
+
+  const auto log = _read_log();
+  const auto records = _parse_records(log);
+
+  // Find the checkpoint record and the records of the transactions that had not committed when it was logged
+  auto pending_records = std::unordered_map<TransactionID, std::vector<Record>>{};
+  auto checkpoint_record = std::optional<Record>{};
+
+  for (const auto& record : records) {
+    const auto* const payload = log.data() + record.payload_begin;
+    auto reader = LogReader{payload, payload + record.payload_size};
+
+    if (record.type == RecordType::Startup) {
+      pending_records.clear();
+    } else if (record.type == RecordType::Checkpoint) {
+      if (reader.read<CheckpointID>() != checkpoint_id) continue;
+      checkpoint_record = record;
+      break;
+    } else if (record.type == RecordType::Commit) {
+      pending_records.erase(reader.read<TransactionID>());
+    } else {
+      pending_records[reader.read<TransactionID>()].emplace_back(record);
+    }
+  }
+
+  Assert(checkpoint_record, "Log does not contain checkpoint " + std::to_string(checkpoint_id));
+
+  auto retained_records = std::vector<Record>{};
+  for (const auto& [transaction_id, transaction_records] : pending_records) {
+    retained_records.insert(retained_records.end(), transaction_records.begin(), transaction_records.end());
+  }
+  std::sort(retained_records.begin(), retained_records.end(),
+            [](const auto& left, const auto& right) { return left.begin < right.begin; });
+
+  // The truncated log starts with the checkpoint record, followed by the retained records and all later records
+  auto truncated_log =
+      std::vector<char>{log.begin() + checkpoint_record->begin, log.begin() + checkpoint_record->end()};
+  for (const auto& record : retained_records) {
+    truncated_log.insert(truncated_log.end(), log.begin() + record.begin, log.begin() + record.end());
+  }
+  truncated_log.insert(truncated_log.end(), log.begin() + checkpoint_record->end(), log.end());
+
+  // Replace the log atomically, so that a crash leaves either the old or the truncated log behind
+  const auto truncated_file_path = _file_path + ".truncated";
+  {
+    auto file = std::ofstream{truncated_file_path, std::ios::binary | std::ios::trunc};
+    Assert(file.is_open(), "Cannot open log file " + truncated_file_path);
+    file.write(truncated_log.data(), static_cast<std::streamsize>(truncated_log.size()));
+    file.close();
+    Assert(!file.fail(), "Cannot write log file " + truncated_file_path);
+  }
+
+  const auto truncated_file_descriptor = open(truncated_file_path.c_str(), O_WRONLY | O_APPEND);
+  Assert(truncated_file_descriptor != -1,
+         "Cannot open log file " + truncated_file_path + ": " + std::strerror(errno));
+  const auto sync_result = fsync(truncated_file_descriptor);
+  Assert(sync_result == 0, "Cannot sync log file " + truncated_file_path + ": " + std::strerror(errno));
+
+  filesystem::rename(truncated_file_path, _file_path);
+
+  close(_file_descriptor);
+  _file_descriptor = truncated_file_descriptor;
+}
+
+void Logger::flush() {
+  const auto flush_lock = std::lock_guard<std::mutex>{_flush_mutex};
+
+  auto buffer = std::vector<char>{};
+  auto commit_callbacks = std::vector<std::function<void()>>{};
+  {
+    const auto lock = std::lock_guard<std::mutex>{_buffer_mutex};
+    std::swap(buffer, _buffer);
+    std::swap(commit_callbacks, _commit_callbacks);
+  }
+
+  if (buffer.empty()) return;
+
+  auto bytes_written = size_t{0};
+  while (bytes_written < buffer.size()) {
+    const auto result = write(_file_descriptor, buffer.data() + bytes_written, buffer.size() - bytes_written);
+    if (result == -1 && errno == EINTR) continue;
+    Assert(result != -1, "Cannot write to log file " + _file_path + ": " + std::strerror(errno));
+    bytes_written += static_cast<size_t>(result);
+  }
+  const auto sync_result = fsync(_file_descriptor);
+  Assert(sync_result == 0, "Cannot sync log file " + _file_path + ": " + std::strerror(errno));
+
+  ++_flush_count;
+  _flushed_commit_count += commit_callbacks.size();
+
+  for (const auto& callback : commit_callbacks) {
+    callback();
+  }
+}
+
+size_t Logger::flush_count() const { return _flush_count; }
+
+size_t Logger::flushed_commit_count() const { return _flushed_commit_count; }
+
+void Logger::_append_record(const RecordType record_type, const std::vector<char>& payload) {
+  auto header = std::vector<char>{};
+  header.reserve(RECORD_HEADER_SIZE);
+  write_value(header, static_cast<uint8_t>(record_type));
+  write_value(header, static_cast<uint32_t>(payload.size()));
+  write_value(header, murmur_hash2(payload.data(), payload.size(), static_cast<unsigned int>(record_type)));
+
+  _buffer.insert(_buffer.end(), header.begin(), header.end());
+  _buffer.insert(_buffer.end(), payload.begin(), payload.end());
+}
+
+std::vector<char> Logger::_read_log() const {
+  auto file = std::ifstream{_file_path, std::ios::binary};
+  Assert(file.is_open(), "Cannot open log file " + _file_path);
+  return std::vector<char>{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+std::vector<Logger::Record> Logger::_parse_records(const std::vector<char>& log) {
+  auto records = std::vector<Record>{};
+
+  auto record_begin = size_t{0};
+  while (record_begin + RECORD_HEADER_SIZE <= log.size()) {
+    auto header_reader = LogReader{log.data() + record_begin, log.data() + record_begin + RECORD_HEADER_SIZE};
+    const auto record_type = static_cast<RecordType>(header_reader.read<uint8_t>());
+    const auto payload_size = size_t{header_reader.read<uint32_t>()};
+    const auto checksum = header_reader.read<uint32_t>();
+
+    // Stop at a torn record
+    const auto payload_begin = record_begin + RECORD_HEADER_SIZE;
+    if (payload_begin + payload_size > log.size()) break;
+    if (murmur_hash2(log.data() + payload_begin, payload_size, static_cast<unsigned int>(record_type)) != checksum) {
+      break;
+    }
+
+    records.emplace_back(Record{record_type, record_begin, payload_begin, payload_size});
+    record_begin = payload_begin + payload_size;
+  }
+
+  return records;
+}
+
+void Logger::_recover(const std::optional<CheckpointID>& checkpoint_id) {
+  const auto log = _read_log();
+  const auto records = _parse_records(log);
+
+  // Records of transactions whose commit record has not been read yet
+  auto pending_records = std::unordered_map<TransactionID, std::vector<Record>>{};
+  auto replayed_tables = std::unordered_set<std::shared_ptr<Table>>{};
+
+  // Transactions that committed before the checkpoint record are contained in the checkpoint
+  auto is_after_checkpoint = !checkpoint_id;
+
+  Assert(checkpoint_id || records.empty() || records.front().type != RecordType::Checkpoint,
+         "Log has been truncated to a checkpoint, which has to be loaded before the log can be replayed");
+
+  for (const auto& record : records) {
+    const auto* const payload = log.data() + record.payload_begin;
+    auto reader = LogReader{payload, payload + record.payload_size};
+
+    if (record.type == RecordType::Startup) {
+      pending_records.clear();
+    } else if (record.type == RecordType::Checkpoint) {
+      if (checkpoint_id && reader.read<CheckpointID>() == *checkpoint_id) is_after_checkpoint = true;
+    } else if (record.type == RecordType::Commit) {
+      const auto transaction_id = reader.read<TransactionID>();
+
+      if (is_after_checkpoint) {
+        for (const auto& pending_record : pending_records[transaction_id]) {
+          auto pending_reader = LogReader{log.data() + pending_record.payload_begin,
+                                          log.data() + pending_record.end()};
+          pending_reader.read<TransactionID>();
+
+          if (pending_record.type == RecordType::Insert) {
+            replayed_tables.emplace(replay_insert(pending_reader));
+          } else {
+            replayed_tables.emplace(replay_invalidation(pending_reader));
+          }
+        }
+      }
+      pending_records.erase(transaction_id);
+    } else {
+      pending_records[reader.read<TransactionID>()].emplace_back(record);
+    }
+  }
+
+  Assert(is_after_checkpoint, "Log does not contain checkpoint " + std::to_string(checkpoint_id.value_or(0)));
+
+  const auto valid_log_size = records.empty() ? size_t{0} : records.back().end();
+  if (valid_log_size < log.size()) filesystem::resize_file(_file_path, valid_log_size);
+
+  // Rows that were reserved for transactions that did not commit are invisible for everyone, like rolled back rows
+  for (const auto& table : replayed_tables) {
+    for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+      auto mvcc_data = table->get_chunk(chunk_id)->get_scoped_mvcc_data_lock();
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < mvcc_data->size(); ++chunk_offset) {
+        if (mvcc_data->begin_cids[chunk_offset] != MvccData::MAX_COMMIT_ID) continue;
+        mvcc_data->register_invalidation();
+        mvcc_data->end_cids[chunk_offset] = 0u;
+        mvcc_data->begin_cids[chunk_offset] = 0u;
+      }
+    }
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class Table;
+struct PausableLoopThread;
+
+using CheckpointID = uint64_t;
+
+/**
+ * The Logger is a singleton that makes committed transactions durable by writing a redo log (write-ahead log).
+ *
+ * Insert and Delete append logical records of their changes (the values of inserted rows and the RowIDs of
+ * invalidated rows) when their records are committed. The TransactionManager then appends a commit record for the
+ * transaction, in commit id order. Records are buffered in memory and written to the log file by a background thread
+ * once every flush interval, using a single fsync for all transactions that committed in the meantime (group commit).
+ * A transaction's commit callback (i.e., the return of TransactionContext::commit()) is only invoked once its commit
+ * record is durable. Transactions that have not logged any records (e.g., read-only transactions) do not have to
+ * wait for the log.
+ *
+ * When the Logger is enabled, it first replays an existing log to the tables in the StorageManager: Changes of all
+ * transactions that have a commit record are applied, those of all other transactions are discarded. Rows are
+ * restored at their original RowIDs, so the tables have to be loaded into the StorageManager as they were when the
+ * log was started. A torn record at the end of the log (e.g., because of a crash during a write) is cut off.
+ *
+ * To bound the size of the log and the time needed for recovery, a Checkpoint of all tables can be written. Its
+ * checkpoint record separates the transactions that are contained in the checkpoint from those that are not. Once
+ * the checkpoint is durable, the log is truncated to that record and the records of transactions that had not
+ * committed at that point. When the tables have been restored from a checkpoint, only the transactions that
+ * committed after it are replayed.
+ *
+ * Each record is framed by its type, the length of its payload, and a checksum of the payload.
+ */
+class Logger : private Noncopyable {
+ public:
+  static constexpr auto DEFAULT_FLUSH_INTERVAL = std::chrono::milliseconds{1};
+
+  static Logger& get();
+
+  // Disables the logger, flushing all buffered records. Used especially in tests.
+  static void reset();
+
+  ~Logger();
+
+  /**
+   * Replays the log at `file_path`, if it exists, and appends all further records to it. If the tables have been
+   * restored from a checkpoint, its id has to be passed. Must not be called while transactions are running.
+   */
+  void enable(const std::string& file_path, const std::chrono::milliseconds flush_interval = DEFAULT_FLUSH_INTERVAL,
+              const std::optional<CheckpointID>& checkpoint_id = std::nullopt);
+
+  // Flushes all buffered records and closes the log. Must not be called while transactions are running.
+  void disable();
+
+  bool is_enabled() const;
+
+  /**
+   * @defgroup Records, called by the read/write operators and the TransactionManager
+   * @{
+   */
+  void log_insert(const TransactionID transaction_id, const std::string& table_name, const Table& table,
+                  const PosList& row_ids);
+  void log_invalidation(const TransactionID transaction_id, const std::string& table_name, const PosList& row_ids);
+
+  // Calls `callback` once the commit record is durable
+  void log_commit(const TransactionID transaction_id, const std::function<void()>& callback);
+
+  // Has to be called while no commit ids are published, see Checkpoint::write()
+  void log_checkpoint(const CheckpointID checkpoint_id);
+  /** @} */
+
+  // Removes all records of transactions contained in the checkpoint, which has to be durable, from the log
+  void truncate(const CheckpointID checkpoint_id);
+
+  // Writes all buffered records to the log and invokes the callbacks of the transactions that committed with them
+  void flush();
+
+  // Statistics about the group commit
+  size_t flush_count() const;
+  size_t flushed_commit_count() const;
+
+  Logger(Logger&&) = delete;
+
+ private:
+  Logger() = default;
+
+  enum class RecordType : uint8_t { Startup, Insert, Invalidation, Commit, Checkpoint };
+
+  // A record in the log file
+  struct Record {
+    RecordType type;
+    size_t begin;
+    size_t payload_begin;
+    size_t payload_size;
+
+    size_t end() const { return payload_begin + payload_size; }
+  };
+
+  // Requires _buffer_mutex to be held
+  void _append_record(const RecordType record_type, const std::vector<char>& payload);
+
+  std::vector<char> _read_log() const;
+
+  // Returns the records in `log` up to the first torn record
+  static std::vector<Record> _parse_records(const std::vector<char>& log);
+
+  void _recover(const std::optional<CheckpointID>& checkpoint_id);
+
+  std::atomic_bool _is_enabled{false};
+  std::string _file_path;
+  int _file_descriptor{-1};
+  std::unique_ptr<PausableLoopThread> _flush_thread;
+
+  // Guards the members below, which are filled by concurrent transactions
+  std::mutex _buffer_mutex;
+  std::vector<char> _buffer;
+  std::vector<std::function<void()>> _commit_callbacks;
+  std::unordered_set<TransactionID> _transactions_with_records;
+
+  // Serializes the writes to the log file
+  std::mutex _flush_mutex;
+  std::atomic<size_t> _flush_count{0};
+  std::atomic<size_t> _flushed_commit_count{0};
+};
+
+}  // namespace opossum
@@ -73,6 +73,12 @@ std::shared_ptr<TableStatistics> JoinNode::derive_statistics_from(
     const std::shared_ptr<AbstractLQPNode>& left_input, const std::shared_ptr<AbstractLQPNode>& right_input) const {
   DebugAssert(left_input && right_input, "JoinNode needs left_input and right_input");
 
+  // Semi and anti joins only filter the left input. Without an estimation of the share of matching rows, assume that
+  // the filter is not selective.
+  if (join_mode == JoinMode::Semi || join_mode == JoinMode::Anti) {
+    return left_input->get_statistics();
+  }
+
   const auto cross_join_statistics = std::make_shared<TableStatistics>(
       left_input->get_statistics()->estimate_cross_join(*right_input->get_statistics()));
 
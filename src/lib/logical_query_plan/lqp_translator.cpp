@@ -1,5 +1,7 @@
 #include "lqp_translator.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -34,6 +36,7 @@
 #include "operators/index_scan.hpp"
 #include "operators/insert.hpp"
 #include "operators/join_hash.hpp"
+#include "operators/join_index.hpp"
 #include "operators/join_sort_merge.hpp"
 #include "operators/limit.hpp"
 #include "operators/maintenance/create_view.hpp"
@@ -47,6 +50,7 @@
 #include "operators/sort.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "operators/top_k.hpp"
 #include "operators/union_positions.hpp"
 #include "operators/update.hpp"
 #include "operators/validate.hpp"
@@ -54,6 +58,7 @@
 #include "projection_node.hpp"
 #include "show_columns_node.hpp"
 #include "sort_node.hpp"
+#include "statistics/table_statistics.hpp"
 #include "storage/storage_manager.hpp"
 #include "stored_table_node.hpp"
 #include "union_node.hpp"
@@ -133,6 +138,10 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_stored_table_node(
 
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_predicate_node(
     const std::shared_ptr<AbstractLQPNode>& node) const {
+  if (const auto multi_column_join = _translate_predicate_nodes_to_multi_column_join(node)) {
+    return multi_column_join;
+  }
+
   const auto input_node = node->left_input();
   const auto input_operator = translate_node(input_node);
   const auto predicate_node = std::static_pointer_cast<PredicateNode>(node);
@@ -158,6 +167,79 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_predicate_node(
   return output_operator;
 }
 
+std::shared_ptr<AbstractOperator> LQPTranslator::_translate_predicate_nodes_to_multi_column_join(
+    const std::shared_ptr<AbstractLQPNode>& node) const {
+  /**
+   * Inner joins on multiple column pairs reach the translator as a JoinNode with one of the equi-predicates and
+   * PredicateNodes on top of it for the others (see, e.g., DpCcp or the JoinDetectionRule). Instead of filtering the
+   * potentially large output of the JoinNode with TableScans, these predicates are passed to the JoinHash as secondary
+   * predicates, so that all key columns are joined in a single pass.
+   *
+   * Only the PredicateNode at the top of such a chain is translated this way, all PredicateNodes below it and the
+   * JoinNode must not have other outputs, as they are not translated on their own.
+   */
+  auto predicate_nodes = std::vector<std::shared_ptr<PredicateNode>>{};
+
+  auto current_node = node;
+  while (current_node->type == LQPNodeType::Predicate) {
+    if (!predicate_nodes.empty() && current_node->output_count() > 1) return nullptr;
+
+    const auto predicate_node = std::static_pointer_cast<PredicateNode>(current_node);
+    if (predicate_node->scan_type != ScanType::TableScan) return nullptr;
+
+    predicate_nodes.emplace_back(predicate_node);
+    current_node = current_node->left_input();
+  }
+
+  if (current_node->type != LQPNodeType::Join || current_node->output_count() > 1) return nullptr;
+
+  const auto join_node = std::static_pointer_cast<JoinNode>(current_node);
+  if (join_node->join_mode != JoinMode::Inner) return nullptr;
+
+  const auto& left_input_node = *join_node->left_input();
+  const auto& right_input_node = *join_node->right_input();
+
+  const auto primary_predicate =
+      OperatorJoinPredicate::from_expression(*join_node->join_predicate, left_input_node, right_input_node);
+  if (!primary_predicate || primary_predicate->predicate_condition != PredicateCondition::Equals) return nullptr;
+
+  // Equi-predicates between both inputs become secondary predicates, all others are still executed as TableScans
+  auto secondary_predicates = std::vector<OperatorJoinPredicate>{};
+  auto remaining_predicate_nodes = std::vector<std::shared_ptr<PredicateNode>>{};
+
+  for (const auto& predicate_node : predicate_nodes) {
+    const auto join_predicate =
+        OperatorJoinPredicate::from_expression(*predicate_node->predicate, left_input_node, right_input_node);
+    if (join_predicate && join_predicate->predicate_condition == PredicateCondition::Equals) {
+      secondary_predicates.emplace_back(*join_predicate);
+    } else {
+      remaining_predicate_nodes.emplace_back(predicate_node);
+    }
+  }
+
+  if (secondary_predicates.empty()) return nullptr;
+
+  auto output_operator = std::shared_ptr<AbstractOperator>{std::make_shared<JoinHash>(
+      translate_node(join_node->left_input()), translate_node(join_node->right_input()), JoinMode::Inner,
+      primary_predicate->column_ids, PredicateCondition::Equals, secondary_predicates)};
+
+  // The remaining predicates are applied bottom-up, as they would have been without the multi-column join
+  for (auto predicate_node_iter = remaining_predicate_nodes.rbegin();
+       predicate_node_iter != remaining_predicate_nodes.rend(); ++predicate_node_iter) {
+    const auto& predicate_node = *predicate_node_iter;
+    const auto operator_scan_predicates =
+        OperatorScanPredicate::from_expression(*predicate_node->predicate, *predicate_node);
+    Assert(operator_scan_predicates,
+           "Couldn't translate to OperatorPredicate: "s + predicate_node->predicate->as_column_name());
+
+    for (const auto& operator_scan_predicate : *operator_scan_predicates) {
+      output_operator = _translate_predicate_node_to_table_scan(operator_scan_predicate, output_operator);
+    }
+  }
+
+  return output_operator;
+}
+
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_predicate_node_to_table_scan(
     const OperatorScanPredicate& operator_scan_predicate,
     const std::shared_ptr<AbstractOperator>& input_operator) const {
@@ -273,31 +355,27 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_sort_node(
   const auto sort_node = std::dynamic_pointer_cast<SortNode>(node);
   auto input_operator = translate_node(node->left_input());
 
-  /**
-   * Go through all the order descriptions and create a sort operator for each of them.
-   * Iterate in reverse because the sort operator does not support multiple columns, and instead relies on stable sort.
-   * We therefore sort by the n+1-th column before sorting by the n-th column.
-   */
+  // All ORDER BY columns are sorted by a single Sort operator
+  return std::make_shared<Sort>(input_operator, _translate_sort_definitions(sort_node));
+}
 
-  std::shared_ptr<AbstractOperator> current_pqp = input_operator;
-  const auto& pqp_expressions = _translate_expressions(sort_node->expressions, node->left_input());
-  if (pqp_expressions.size() > 1) {
-    PerformanceWarning("Multiple ORDER BYs are executed one-by-one");
-  }
+std::vector<SortColumnDefinition> LQPTranslator::_translate_sort_definitions(
+    const std::shared_ptr<SortNode>& sort_node) const {
+  const auto& pqp_expressions = _translate_expressions(sort_node->expressions, sort_node->left_input());
 
-  auto pqp_expression_iter = pqp_expressions.rbegin();
-  auto order_by_mode_iter = sort_node->order_by_modes.rbegin();
+  auto sort_definitions = std::vector<SortColumnDefinition>{};
+  sort_definitions.reserve(pqp_expressions.size());
 
-  for (; pqp_expression_iter != pqp_expressions.rend(); ++pqp_expression_iter, ++order_by_mode_iter) {
-    const auto& pqp_expression = *pqp_expression_iter;
+  for (auto expression_idx = size_t{0}; expression_idx < pqp_expressions.size(); ++expression_idx) {
+    const auto& pqp_expression = pqp_expressions[expression_idx];
     const auto pqp_column_expression = std::dynamic_pointer_cast<PQPColumnExpression>(pqp_expression);
     Assert(pqp_column_expression,
            "Sort Expression '"s + pqp_expression->as_column_name() + "' must be available as column, LQP is invalid");
 
-    current_pqp = std::make_shared<Sort>(current_pqp, pqp_column_expression->column_id, *order_by_mode_iter);
+    sort_definitions.emplace_back(pqp_column_expression->column_id, sort_node->order_by_modes[expression_idx]);
   }
 
-  return current_pqp;
+  return sort_definitions;
 }
 
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_join_node(
@@ -324,6 +402,11 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_join_node(
 
   const auto predicate_condition = operator_join_predicate->predicate_condition;
 
+  if (_is_join_index_preferable(*join_node, *operator_join_predicate)) {
+    return std::make_shared<JoinIndex>(input_left_operator, input_right_operator, join_node->join_mode,
+                                       operator_join_predicate->column_ids, predicate_condition);
+  }
+
   if (predicate_condition == PredicateCondition::Equals && join_node->join_mode != JoinMode::Outer) {
     return std::make_shared<JoinHash>(input_left_operator, input_right_operator, join_node->join_mode,
                                       operator_join_predicate->column_ids, predicate_condition);
@@ -333,6 +416,65 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_join_node(
                                          operator_join_predicate->column_ids, predicate_condition);
 }
 
+/**
+ * JoinIndex is used instead of JoinHash if all chunks of the table below the right input have an index on the join
+ * column and if looking up every row of the left input in these indexes is expected to be cheaper than building and
+ * probing a hash table. The right input may only filter the rows of the stored table (i.e., consist of Predicate and
+ * Validate nodes), so that JoinIndex can resolve its ReferenceSegments to the indexed chunks.
+ */
+bool LQPTranslator::_is_join_index_preferable(const JoinNode& join_node,
+                                              const OperatorJoinPredicate& operator_join_predicate) {
+  if (operator_join_predicate.predicate_condition != PredicateCondition::Equals) return false;
+  if (join_node.join_mode != JoinMode::Inner && join_node.join_mode != JoinMode::Left &&
+      join_node.join_mode != JoinMode::Right) {
+    return false;
+  }
+
+  auto stored_table_node = join_node.right_input();
+  while (stored_table_node->type == LQPNodeType::Predicate || stored_table_node->type == LQPNodeType::Validate) {
+    stored_table_node = stored_table_node->left_input();
+  }
+  if (stored_table_node->type != LQPNodeType::StoredTable) return false;
+
+  const auto& right_column_expression =
+      join_node.right_input()->column_expressions().at(operator_join_predicate.column_ids.second);
+  const auto lqp_column_expression = std::dynamic_pointer_cast<LQPColumnExpression>(right_column_expression);
+  if (!lqp_column_expression || lqp_column_expression->column_reference.original_node() != stored_table_node) {
+    return false;
+  }
+
+  const auto indexed_column_ids = std::vector<ColumnID>{lqp_column_expression->column_reference.original_column_id()};
+  const auto table =
+      StorageManager::get().get_table(std::static_pointer_cast<StoredTableNode>(stored_table_node)->table_name);
+
+  const auto index_infos = table->get_indexes();
+  if (std::none_of(index_infos.begin(), index_infos.end(),
+                   [&](const auto& index_info) { return index_info.column_ids == indexed_column_ids; })) {
+    return false;
+  }
+
+  // Chunks without an index, e.g., chunks appended after the index was created, are joined with a nested loop
+  const auto chunk_count = table->chunk_count();
+  if (chunk_count == 0) return false;
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    if (table->get_chunk(chunk_id)->get_indices(indexed_column_ids).empty()) return false;
+  }
+
+  const auto left_row_count = join_node.left_input()->get_statistics()->row_count();
+  const auto right_row_count = join_node.right_input()->get_statistics()->row_count();
+
+  // Both inputs are read once to build and probe the hash table
+  const auto hash_join_cost = left_row_count + right_row_count;
+
+  // Every row of the left input is looked up in the index of every chunk. Filtered right inputs have to be mapped back
+  // to the indexed chunks.
+  const auto rows_per_chunk = std::max(static_cast<float>(table->row_count()) / chunk_count, 2.0f);
+  auto index_join_cost = left_row_count * chunk_count * std::log2(rows_per_chunk);
+  if (join_node.right_input() != stored_table_node) index_join_cost += right_row_count;
+
+  return index_join_cost < hash_join_cost;
+}
+
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_aggregate_node(
     const std::shared_ptr<AbstractLQPNode>& node) const {
   const auto aggregate_node = std::dynamic_pointer_cast<AggregateNode>(node);
@@ -381,10 +523,24 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_aggregate_node(
 
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_limit_node(
     const std::shared_ptr<AbstractLQPNode>& node) const {
-  const auto input_operator = translate_node(node->left_input());
   auto limit_node = std::dynamic_pointer_cast<LimitNode>(node);
-  return std::make_shared<Limit>(input_operator,
-                                 _translate_expressions({limit_node->num_rows_expression}, node->left_input()).front());
+  const auto row_count_expression =
+      _translate_expressions({limit_node->num_rows_expression}, node->left_input()).front();
+
+  /**
+   * If only the first rows of a sorted input are requested and their number is known before execution, a TopK
+   * operator determines them without sorting the entire input. If the sorted input is used by other nodes as well,
+   * it is sorted anyway, so the Sort operator is kept.
+   */
+  const auto sort_node = std::dynamic_pointer_cast<SortNode>(node->left_input());
+  if (sort_node && sort_node->output_count() == 1 &&
+      limit_node->num_rows_expression->type == ExpressionType::Value) {
+    return std::make_shared<TopK>(translate_node(sort_node->left_input()), _translate_sort_definitions(sort_node),
+                                  row_count_expression);
+  }
+
+  const auto input_operator = translate_node(node->left_input());
+  return std::make_shared<Limit>(input_operator, row_count_expression);
 }
 
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_insert_node(
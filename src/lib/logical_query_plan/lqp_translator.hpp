@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "abstract_lqp_node.hpp"
 #include "all_type_variant.hpp"
@@ -12,7 +13,10 @@ namespace opossum {
 class AbstractOperator;
 class TransactionContext;
 class AbstractExpression;
+class JoinNode;
 class PredicateNode;
+class SortNode;
+struct SortColumnDefinition;
 struct OperatorScanPredicate;
 struct OperatorJoinPredicate;
 
@@ -32,6 +36,8 @@ class LQPTranslator {
 
   std::shared_ptr<AbstractOperator> _translate_stored_table_node(const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_predicate_node(const std::shared_ptr<AbstractLQPNode>& node) const;
+  std::shared_ptr<AbstractOperator> _translate_predicate_nodes_to_multi_column_join(
+      const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_predicate_node_to_index_scan(
       const std::shared_ptr<PredicateNode>& node, const std::shared_ptr<AbstractOperator>& input_operator) const;
   std::shared_ptr<AbstractOperator> _translate_predicate_node_to_table_scan(
@@ -40,6 +46,7 @@ class LQPTranslator {
   std::shared_ptr<AbstractOperator> _translate_alias_node(const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_projection_node(const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_sort_node(const std::shared_ptr<AbstractLQPNode>& node) const;
+  std::vector<SortColumnDefinition> _translate_sort_definitions(const std::shared_ptr<SortNode>& sort_node) const;
   std::shared_ptr<AbstractOperator> _translate_join_node(const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_aggregate_node(const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_limit_node(const std::shared_ptr<AbstractLQPNode>& node) const;
@@ -71,6 +78,10 @@ class LQPTranslator {
       const AbstractLQPNode& input_node, const std::shared_ptr<AbstractOperator>& input_operator,
       const AbstractExpression& operand, const PredicateCondition predicate_condition);
 
+  // Cost-based choice of JoinIndex over JoinHash for equi-joins whose right input has an indexed join column
+  static bool _is_join_index_preferable(const JoinNode& join_node,
+                                        const OperatorJoinPredicate& operator_join_predicate);
+
   static AllParameterVariant _translate_to_all_parameter_variant(const AbstractLQPNode& input_node,
                                                                  const AbstractExpression& expression);
 
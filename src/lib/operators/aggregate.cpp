@@ -3,6 +3,7 @@
 #include <boost/container/pmr/monotonic_buffer_resource.hpp>
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <string>
@@ -16,7 +17,10 @@
 #include "scheduler/abstract_task.hpp"
 #include "scheduler/current_scheduler.hpp"
 #include "scheduler/job_task.hpp"
+#include "scheduler/topology.hpp"
 #include "storage/create_iterable_from_segment.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/vector_compression/resolve_compressed_vector_type.hpp"
 #include "type_comparison.hpp"
 #include "utils/aligned_size.hpp"
 #include "utils/assert.hpp"
@@ -77,52 +81,12 @@ void Aggregate::_on_set_parameters(const std::unordered_map<ParameterID, AllType
 
 void Aggregate::_on_cleanup() { _contexts_per_column.clear(); }
 
-/*
-Visitor context for the partitioning/grouping visitor
-*/
-template <typename AggregateKey>
-struct GroupByContext : SegmentVisitorContext {
-  GroupByContext(const std::shared_ptr<const Table>& t, ChunkID chunk, ColumnID column,
-                 const std::shared_ptr<AggregateKeys<AggregateKey>>& keys)
-      : table_in(t), chunk_id(chunk), column_id(column), hash_keys(keys) {}
-
-  GroupByContext(const std::shared_ptr<BaseSegment>&, const std::shared_ptr<const Table>& referenced_table,
-                 const std::shared_ptr<SegmentVisitorContext>& base_context, ChunkID chunk_id,
-                 const std::shared_ptr<std::vector<ChunkOffset>>& chunk_offsets)
-      : table_in(referenced_table),
-        chunk_id(chunk_id),
-        column_id(std::static_pointer_cast<GroupByContext>(base_context)->column_id),
-        hash_keys(std::static_pointer_cast<GroupByContext>(base_context)->hash_keys),
-        chunk_offsets_in(chunk_offsets) {}
-
-  std::shared_ptr<const Table> table_in;
-  ChunkID chunk_id;
-  const ColumnID column_id;
-  std::shared_ptr<AggregateKeys<AggregateKey>> hash_keys;
-  std::shared_ptr<std::vector<ChunkOffset>> chunk_offsets_in;
-};
-
 /*
 Visitor context for the AggregateVisitor.
 */
-template <typename ColumnType, typename AggregateType, typename AggregateKey>
+template <typename ColumnType, typename AggregateType>
 struct AggregateContext : SegmentVisitorContext {
-  AggregateContext() = default;
-  explicit AggregateContext(const std::shared_ptr<GroupByContext<AggregateKey>>& base_context)
-      : groupby_context(base_context) {}
-
-  AggregateContext(const std::shared_ptr<BaseSegment>&, const std::shared_ptr<const Table>&,
-                   const std::shared_ptr<SegmentVisitorContext>& base_context, ChunkID chunk_id,
-                   const std::shared_ptr<std::vector<ChunkOffset>>& chunk_offsets)
-      : groupby_context(std::static_pointer_cast<AggregateContext>(base_context)->groupby_context),
-        results(std::static_pointer_cast<AggregateContext>(base_context)->results) {
-    groupby_context->chunk_id = chunk_id;
-    groupby_context->chunk_offsets_in = chunk_offsets;
-  }
-
-  std::shared_ptr<GroupByContext<AggregateKey>> groupby_context;
-  std::shared_ptr<std::unordered_map<AggregateKey, AggregateResult<AggregateType, ColumnType>, std::hash<AggregateKey>>>
-      results;
+  AggregateResults<AggregateType, ColumnType> results;
 };
 
 /*
@@ -200,46 +164,84 @@ struct AggregateFunctionBuilder<ColumnType, AggregateType, AggregateFunction::Co
   }
 };
 
-template <typename ColumnDataType, AggregateFunction function, typename AggregateKey>
-void Aggregate::_aggregate_segment(ChunkID chunk_id, ColumnID column_index, const BaseSegment& base_segment,
-                                   const KeysPerChunk<AggregateKey>& keys_per_chunk) {
+template <typename ColumnDataType, AggregateFunction function>
+void Aggregate::_aggregate_segment(const std::shared_ptr<SegmentVisitorContext>& context,
+                                   const BaseSegment& base_segment, const std::vector<GroupID>& group_ids) {
   using AggregateType = typename AggregateTraits<ColumnDataType, function>::AggregateType;
 
   auto aggregator = AggregateFunctionBuilder<ColumnDataType, AggregateType, function>().get_aggregate_function();
 
-  auto& context = *std::static_pointer_cast<AggregateContext<ColumnDataType, AggregateType, AggregateKey>>(
-      _contexts_per_column[column_index]);
-
-  auto& results = *context.results;
-  const auto& hash_keys = keys_per_chunk[chunk_id];
+  auto& results = std::static_pointer_cast<AggregateContext<ColumnDataType, AggregateType>>(context)->results;
 
   // clang-format off
   resolve_segment_type<ColumnDataType>(
       // clang-format on
-      base_segment, [&results, &hash_keys, chunk_id, aggregator](const auto& typed_segment) {
+      base_segment, [&results, &group_ids, aggregator](const auto& typed_segment) {
+        using SegmentType = std::decay_t<decltype(typed_segment)>;
+
+        if constexpr ((function == AggregateFunction::Min || function == AggregateFunction::Max) &&
+                      std::is_same_v<SegmentType, DictionarySegment<ColumnDataType>>) {
+          /**
+           * Dictionaries are sorted, so the smallest (largest) ValueID of a group stands for its minimum (maximum).
+           * Thus, only ValueIDs are compared per row and the dictionary is accessed once per group. This needs an
+           * array of ValueIDs for all groups, which is only used if it is not larger than the segment.
+           */
+          const auto group_count = results.current_aggregates.size();
+          if (group_count <= typed_segment.size()) {
+            const auto null_value_id = typed_segment.null_value_id();
+            auto value_ids = std::vector<ValueID>(group_count, INVALID_VALUE_ID);
+
+            resolve_compressed_vector_type(*typed_segment.attribute_vector(), [&](const auto& attribute_vector) {
+              auto group_id_iter = group_ids.cbegin();
+              for (auto iter = attribute_vector.cbegin(); iter != attribute_vector.cend(); ++iter, ++group_id_iter) {
+                const auto value_id = ValueID{static_cast<ValueID::base_type>(*iter)};
+                if (value_id == null_value_id) continue;
+
+                auto& group_value_id = value_ids[*group_id_iter];
+                if constexpr (function == AggregateFunction::Min) {
+                  if (value_id < group_value_id) group_value_id = value_id;
+                } else {
+                  if (group_value_id == INVALID_VALUE_ID || value_id > group_value_id) group_value_id = value_id;
+                }
+
+                ++results.aggregate_counts[*group_id_iter];
+              }
+            });
+
+            const auto& dictionary = *typed_segment.dictionary();
+            for (GroupID group_id{0}; group_id < group_count; ++group_id) {
+              if (value_ids[group_id] == INVALID_VALUE_ID) continue;
+              aggregator(dictionary[value_ids[group_id]], results.current_aggregates[group_id]);
+            }
+
+            return;
+          }
+        }
+
         auto iterable = create_iterable_from_segment<ColumnDataType>(typed_segment);
 
         ChunkOffset chunk_offset{0};
 
         // Now that all relevant types have been resolved, we can iterate over the segment and build the aggregations.
-        iterable.for_each([&, chunk_id, aggregator](const auto& value) {
-          auto& hash_entry = results[hash_keys[chunk_offset]];
-          hash_entry.row_id = RowID(chunk_id, chunk_offset);
-
+        iterable.for_each([&, aggregator](const auto& value) {
           /**
           * If the value is NULL, the current aggregate value does not change.
           */
           if (!value.is_null()) {
-            // If we have a value, use the aggregator lambda to update the current aggregate value for this group
-            aggregator(value.value(), hash_entry.current_aggregate);
-
-            // increase value counter
-            ++hash_entry.aggregate_count;
+            const auto group_id = group_ids[chunk_offset];
 
             if constexpr (function == AggregateFunction::CountDistinct) {  // NOLINT
               // clang-tidy error: https://bugs.llvm.org/show_bug.cgi?id=35824
-              // for the case of CountDistinct, insert this value into the set to keep track of distinct values
-              hash_entry.distinct_values.insert(value.value());
+              // for the case of CountDistinct, only count values that have not been seen in this group before
+              if (results.distinct_values.insert({group_id, value.value()}).second) {
+                ++results.aggregate_counts[group_id];
+              }
+            } else {
+              // If we have a value, use the aggregator lambda to update the current aggregate value for this group
+              aggregator(value.value(), results.current_aggregates[group_id]);
+
+              // increase value counter
+              ++results.aggregate_counts[group_id];
             }
           }
 
@@ -248,6 +250,188 @@ void Aggregate::_aggregate_segment(ChunkID chunk_id, ColumnID column_index, cons
       });
 }
 
+void Aggregate::_aggregate_chunk(const ChunkID chunk_id, const std::vector<GroupID>& group_ids,
+                                 const std::vector<std::shared_ptr<SegmentVisitorContext>>& contexts_per_column) {
+  const auto input_table = input_table_left();
+  const auto chunk_in = input_table->get_chunk(chunk_id);
+
+  for (ColumnID column_index{0}; column_index < _aggregates.size(); ++column_index) {
+    const auto& aggregate = _aggregates[column_index];
+    const auto& context = contexts_per_column[column_index];
+
+    /**
+     * Special COUNT(*) implementation.
+     * Because COUNT(*) does not have a specific target column, we go through the GroupIDs of the chunk and count
+     * the occurrences of each group. The results are saved in the regular aggregate_counts so that we don't need a
+     * specific output logic for COUNT(*).
+     */
+    if (!aggregate.column && aggregate.function == AggregateFunction::Count) {
+      auto& aggregate_counts =
+          std::static_pointer_cast<AggregateContext<CountColumnType, CountAggregateType>>(context)
+              ->results.aggregate_counts;
+
+      // count occurrences for each group
+      for (const auto group_id : group_ids) {
+        ++aggregate_counts[group_id];
+      }
+
+      continue;
+    }
+
+    const auto base_segment = chunk_in->get_segment(*aggregate.column);
+    const auto data_type = input_table->column_data_type(*aggregate.column);
+
+    /*
+    Invoke correct aggregator for each segment
+    */
+
+    resolve_data_type(data_type, [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+
+      switch (aggregate.function) {
+        case AggregateFunction::Min:
+          _aggregate_segment<ColumnDataType, AggregateFunction::Min>(context, *base_segment, group_ids);
+          break;
+        case AggregateFunction::Max:
+          _aggregate_segment<ColumnDataType, AggregateFunction::Max>(context, *base_segment, group_ids);
+          break;
+        case AggregateFunction::Sum:
+          _aggregate_segment<ColumnDataType, AggregateFunction::Sum>(context, *base_segment, group_ids);
+          break;
+        case AggregateFunction::Avg:
+          _aggregate_segment<ColumnDataType, AggregateFunction::Avg>(context, *base_segment, group_ids);
+          break;
+        case AggregateFunction::Count:
+          _aggregate_segment<ColumnDataType, AggregateFunction::Count>(context, *base_segment, group_ids);
+          break;
+        case AggregateFunction::CountDistinct:
+          _aggregate_segment<ColumnDataType, AggregateFunction::CountDistinct>(context, *base_segment, group_ids);
+          break;
+      }
+    });
+  }
+}
+
+namespace {
+
+// Chunks are pre-aggregated in ranges of at least this many rows, so that small inputs are aggregated by a single job
+constexpr auto MIN_ROWS_PER_JOB = size_t{65'536};
+
+// The groups are merged in at most this many partitions per CPU. More partitions than CPUs balance the merge jobs, but
+// every chunk range allocates a list of groups for each partition.
+constexpr auto MAX_PARTITIONS_PER_CPU = size_t{4};
+
+// Keys of a single group-by column are mapped to GroupIDs with a direct-indexed array if there are at most this many
+constexpr auto MAX_DIRECT_INDEXED_KEY_COUNT = size_t{65'536};
+
+constexpr auto INVALID_GROUP_ID = std::numeric_limits<GroupID>::max();
+
+/*
+Groups and aggregates of the chunks [chunk_begin, chunk_end), pre-aggregated by one job independently of the other
+chunk ranges. The groups are partitioned by the hash of their AggregateKey, so that the partitions can be merged
+independently of each other.
+*/
+template <typename AggregateKey>
+struct PartialAggregation {
+  ChunkID chunk_begin{0};
+  ChunkID chunk_end{0};
+
+  // AggregateKey and RowID of the first row of each group
+  std::vector<AggregateKey> group_keys;
+  PosList group_row_ids;
+  std::vector<std::shared_ptr<SegmentVisitorContext>> contexts_per_column;
+
+  std::vector<size_t> group_partitions;
+  std::vector<std::vector<GroupID>> groups_per_partition;
+  // For each COUNT(DISTINCT) column, the ids of the distinct (group, value) pairs in each partition
+  std::vector<std::vector<std::vector<size_t>>> distinct_value_ids_per_column_and_partition;
+  // GroupID of each group in the merged result
+  std::vector<GroupID> merged_group_ids;
+};
+
+/*
+Buckets the distinct (group, value) pairs of a COUNT(DISTINCT) column by the partitions of their groups, so that the
+merge job of a partition only visits its own pairs.
+*/
+template <typename ColumnDataType, typename AggregateKey>
+void partition_distinct_values(PartialAggregation<AggregateKey>& partial_aggregation, const ColumnID column_index,
+                               const size_t partition_count) {
+  using AggregateType = typename AggregateTraits<ColumnDataType, AggregateFunction::CountDistinct>::AggregateType;
+  using Context = AggregateContext<ColumnDataType, AggregateType>;
+
+  const auto& distinct_values =
+      std::static_pointer_cast<Context>(partial_aggregation.contexts_per_column[column_index])->results.distinct_values;
+
+  auto& distinct_value_ids_per_partition =
+      partial_aggregation.distinct_value_ids_per_column_and_partition[column_index];
+  distinct_value_ids_per_partition.resize(partition_count);
+
+  const auto& keys = distinct_values.keys();
+  for (auto distinct_value_id = size_t{0}; distinct_value_id < keys.size(); ++distinct_value_id) {
+    const auto partition = partial_aggregation.group_partitions[keys[distinct_value_id].first];
+    distinct_value_ids_per_partition[partition].emplace_back(distinct_value_id);
+  }
+}
+
+/*
+Merges the partial aggregates of one aggregate column for the groups of one partition into context. The merged
+GroupIDs of these groups need to be set already.
+*/
+template <typename ColumnDataType, AggregateFunction function, typename AggregateKey>
+void merge_partial_aggregates(const std::shared_ptr<SegmentVisitorContext>& context,
+                              const std::vector<PartialAggregation<AggregateKey>>& partial_aggregations,
+                              const ColumnID column_index, const size_t partition) {
+  using AggregateType = typename AggregateTraits<ColumnDataType, function>::AggregateType;
+  using Context = AggregateContext<ColumnDataType, AggregateType>;
+
+  auto& results = std::static_pointer_cast<Context>(context)->results;
+
+  // The jobs of the other partitions write to the same results, so COUNT(DISTINCT) deduplicates into its own map. A
+  // value might have been seen for the same group in several chunk ranges.
+  [[maybe_unused]] auto distinct_values = decltype(results.distinct_values){};
+
+  for (const auto& partial_aggregation : partial_aggregations) {
+    const auto& partial_results =
+        std::static_pointer_cast<Context>(partial_aggregation.contexts_per_column[column_index])->results;
+    const auto& merged_group_ids = partial_aggregation.merged_group_ids;
+
+    if constexpr (function == AggregateFunction::CountDistinct) {  // NOLINT
+      const auto& distinct_value_ids =
+          partial_aggregation.distinct_value_ids_per_column_and_partition[column_index][partition];
+      for (const auto distinct_value_id : distinct_value_ids) {
+        const auto& [group_id, value] = partial_results.distinct_values.keys()[distinct_value_id];
+        const auto merged_group_id = merged_group_ids[group_id];
+        if (distinct_values.insert({merged_group_id, value}).second) {
+          ++results.aggregate_counts[merged_group_id];
+        }
+      }
+    } else {
+      for (const auto group_id : partial_aggregation.groups_per_partition[partition]) {
+        const auto merged_group_id = merged_group_ids[group_id];
+        results.aggregate_counts[merged_group_id] += partial_results.aggregate_counts[group_id];
+
+        const auto& partial_aggregate = partial_results.current_aggregates[group_id];
+        if (!partial_aggregate) continue;
+
+        auto& current_aggregate = results.current_aggregates[merged_group_id];
+        if constexpr (function == AggregateFunction::Min) {
+          if (!current_aggregate || value_smaller(*partial_aggregate, *current_aggregate)) {
+            current_aggregate = partial_aggregate;
+          }
+        } else if constexpr (function == AggregateFunction::Max) {
+          if (!current_aggregate || value_greater(*partial_aggregate, *current_aggregate)) {
+            current_aggregate = partial_aggregate;
+          }
+        } else if constexpr (function == AggregateFunction::Sum || function == AggregateFunction::Avg) {
+          current_aggregate = current_aggregate ? *current_aggregate + *partial_aggregate : *partial_aggregate;
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
 template <typename AggregateKey>
 void Aggregate::_aggregate() {
   // We use monotonic_buffer_resource for the vector of vectors that hold the aggregate keys. That is so that we can
@@ -331,13 +515,18 @@ void Aggregate::_aggregate() {
   std::vector<std::shared_ptr<AbstractTask>> jobs;
   jobs.reserve(_groupby_column_ids.size());
 
+  // Number of IDs assigned for each group-by column, including the ID 0 for NULL
+  auto id_counts = std::vector<AggregateKeyEntry>(_groupby_column_ids.size());
+
   for (size_t group_column_index = 0; group_column_index < _groupby_column_ids.size(); ++group_column_index) {
-    jobs.emplace_back(std::make_shared<JobTask>([&input_table, group_column_index, &keys_per_chunk, this]() {
+    jobs.emplace_back(std::make_shared<JobTask>([&input_table, group_column_index, &keys_per_chunk, &id_counts,
+                                                 this]() {
       const auto column_id = _groupby_column_ids.at(group_column_index);
       const auto data_type = input_table->column_data_type(column_id);
 
       resolve_data_type(data_type, [&](auto type) {
         using ColumnDataType = typename decltype(type)::type;
+        using DictionarySegmentType = DictionarySegment<ColumnDataType>;
 
         /*
         Store unique IDs for equal values in the groupby column (similar to dictionary encoding).
@@ -358,34 +547,63 @@ void Aggregate::_aggregate() {
           const auto chunk_in = input_table->get_chunk(chunk_id);
           const auto base_segment = chunk_in->get_segment(column_id);
 
+          auto& keys = keys_per_chunk[chunk_id];
+          const auto set_key = [&](const ChunkOffset chunk_offset, const AggregateKeyEntry key_entry) {
+            if constexpr (std::is_same_v<AggregateKey, AggregateKeyEntry>) {
+              keys[chunk_offset] = key_entry;
+            } else {
+              keys[chunk_offset][group_column_index] = key_entry;
+            }
+          };
+
           resolve_segment_type<ColumnDataType>(*base_segment, [&](auto& typed_segment) {
-            auto iterable = create_iterable_from_segment<ColumnDataType>(typed_segment);
+            using SegmentType = std::decay_t<decltype(typed_segment)>;
+
+            if constexpr (std::is_same_v<SegmentType, DictionarySegmentType>) {
+              /*
+              The ValueIDs of a DictionarySegment already identify the values of the chunk. Thus, only the dictionary
+              is looked up in the id_map and the ValueIDs are mapped to IDs with a direct-indexed array.
+              */
+              const auto& dictionary = *typed_segment.dictionary();
+              DebugAssert(typed_segment.null_value_id() == dictionary.size(), "Unexpected null_value_id");
+
+              auto ids_by_value_id = std::vector<AggregateKeyEntry>(dictionary.size() + 1, 0u);
+              for (ValueID value_id{0}; value_id < dictionary.size(); ++value_id) {
+                auto inserted = id_map.try_emplace(dictionary[value_id], id_counter);
+                ids_by_value_id[value_id] = inserted.first->second;
+                if (inserted.second) ++id_counter;
+              }
 
-            ChunkOffset chunk_offset{0};
-            iterable.for_each([&](const auto& value) {
-              if (value.is_null()) {
-                if constexpr (std::is_same_v<AggregateKey, AggregateKeyEntry>) {
-                  keys_per_chunk[chunk_id][chunk_offset] = 0u;
-                } else {
-                  keys_per_chunk[chunk_id][chunk_offset][group_column_index] = 0u;
+              resolve_compressed_vector_type(*typed_segment.attribute_vector(), [&](const auto& attribute_vector) {
+                ChunkOffset chunk_offset{0};
+                for (auto iter = attribute_vector.cbegin(); iter != attribute_vector.cend(); ++iter) {
+                  set_key(chunk_offset, ids_by_value_id[*iter]);
+                  ++chunk_offset;
                 }
-              } else {
-                auto inserted = id_map.try_emplace(value.value(), id_counter);
-                // store either the current id_counter or the existing ID of the value
-                if constexpr (std::is_same_v<AggregateKey, AggregateKeyEntry>) {
-                  keys_per_chunk[chunk_id][chunk_offset] = inserted.first->second;
+              });
+            } else {
+              auto iterable = create_iterable_from_segment<ColumnDataType>(typed_segment);
+
+              ChunkOffset chunk_offset{0};
+              iterable.for_each([&](const auto& value) {
+                if (value.is_null()) {
+                  set_key(chunk_offset, 0u);
                 } else {
-                  keys_per_chunk[chunk_id][chunk_offset][group_column_index] = inserted.first->second;
-                }
+                  auto inserted = id_map.try_emplace(value.value(), id_counter);
+                  // store either the current id_counter or the existing ID of the value
+                  set_key(chunk_offset, inserted.first->second);
 
-                // if the id_map didn't have the value as a key and a new element was inserted
-                if (inserted.second) ++id_counter;
-              }
+                  // if the id_map didn't have the value as a key and a new element was inserted
+                  if (inserted.second) ++id_counter;
+                }
 
-              ++chunk_offset;
-            });
+                ++chunk_offset;
+              });
+            }
           });
         }
+
+        id_counts[group_column_index] = id_counter;
       });
     }));
     jobs.back()->schedule();
@@ -394,150 +612,232 @@ void Aggregate::_aggregate() {
   CurrentScheduler::wait_for_tasks(jobs);
 
   /*
-  AGGREGATION PHASE
+  PRE-AGGREGATION PHASE
+  The chunks are split into ranges and each range is aggregated by its own job. The job maps each distinct AggregateKey
+  of its range to a dense GroupID, so that the aggregates can be stored in arrays indexed by the GroupID, and aggregates
+  its chunks into its own contexts. Thus, the jobs do not need to synchronize. Finally, each job partitions its groups
+  by the hash of their AggregateKey. There is one partition per chunk range, but at most MAX_PARTITIONS_PER_CPU per
+  CPU, so that the number of partition lists does not grow quadratically with the input size.
   */
-  _contexts_per_column = std::vector<std::shared_ptr<SegmentVisitorContext>>(_aggregates.size());
+  auto partial_aggregations = std::vector<PartialAggregation<AggregateKey>>{};
+
+  for (ChunkID chunk_begin{0}; chunk_begin < input_table->chunk_count();) {
+    auto chunk_end = chunk_begin;
+    auto row_count = size_t{0};
+    while (chunk_end < input_table->chunk_count() && row_count < MIN_ROWS_PER_JOB) {
+      row_count += input_table->get_chunk(chunk_end)->size();
+      ++chunk_end;
+    }
 
-  if (_aggregates.empty()) {
-    /*
-    Insert a dummy context for the DISTINCT implementation.
-    That way, _contexts_per_column will always have at least one context with results.
-    This is important later on when we write the group keys into the table.
+    auto& partial_aggregation = partial_aggregations.emplace_back();
+    partial_aggregation.chunk_begin = chunk_begin;
+    partial_aggregation.chunk_end = chunk_end;
+    chunk_begin = chunk_end;
+  }
 
-    We choose int8_t for column type and aggregate type because it's small.
-    */
-    auto context = std::make_shared<AggregateContext<DistinctColumnType, DistinctAggregateType, AggregateKey>>();
-    context->results =
-        std::make_shared<std::unordered_map<AggregateKey, AggregateResult<DistinctAggregateType, DistinctColumnType>,
-                                            std::hash<AggregateKey>>>();
+  const auto partition_count =
+      std::min(partial_aggregations.size(), std::max(Topology::get().num_cpus(), size_t{1}) * MAX_PARTITIONS_PER_CPU);
 
-    _contexts_per_column.push_back(context);
-  }
+  jobs.clear();
+  jobs.reserve(partial_aggregations.size());
 
-  /**
-   * Create an AggregateContext for each column in the input table that a normal (i.e. non-DISTINCT) aggregate is
-   * created on. We do this here, and not in the per-chunk-loop below, because there might be no Chunks in the input
-   * and _write_aggregate_output() needs these contexts anyway.
-   */
-  for (ColumnID column_id{0}; column_id < _aggregates.size(); ++column_id) {
-    const auto& aggregate = _aggregates[column_id];
-    if (!aggregate.column && aggregate.function == AggregateFunction::Count) {
-      // SELECT COUNT(*) - we know the template arguments, so we don't need a visitor
-      auto context = std::make_shared<AggregateContext<CountColumnType, CountAggregateType, AggregateKey>>();
-      context->results =
-          std::make_shared<std::unordered_map<AggregateKey, AggregateResult<CountAggregateType, CountColumnType>,
-                                              std::hash<AggregateKey>>>();
-      _contexts_per_column[column_id] = context;
-      continue;
-    }
-    auto data_type = input_table->column_data_type(*aggregate.column);
-    _contexts_per_column[column_id] = _create_aggregate_context<AggregateKey>(data_type, aggregate.function);
-  }
-
-  // Process Chunks and perform aggregations
-  for (ChunkID chunk_id{0}; chunk_id < input_table->chunk_count(); ++chunk_id) {
-    auto chunk_in = input_table->get_chunk(chunk_id);
-
-    const auto& hash_keys = keys_per_chunk[chunk_id];
-
-    if (_aggregates.empty()) {
-      /**
-       * DISTINCT implementation
-       *
-       * In Opossum we handle the SQL keyword DISTINCT by grouping without aggregation.
-       *
-       * For a query like "SELECT DISTINCT * FROM A;"
-       * we would assume that all columns from A are part of 'groupby_columns',
-       * respectively any columns that were specified in the projection.
-       * The optimizer is responsible to take care of passing in the correct columns.
-       *
-       * How does this operation work?
-       * Distinct rows are retrieved by grouping by vectors of values. Similar as for the usual aggregation
-       * these vectors are used as keys in the 'column_results' map.
-       *
-       * At this point we've got all the different keys from the chunks and accumulate them in 'column_results'.
-       * In order to reuse the aggregation implementation, we add a dummy AggregateResult.
-       * One could optimize here in the future.
-       *
-       * Obviously this implementation is also used for plain GroupBy's.
-       */
-
-      auto context =
-          std::static_pointer_cast<AggregateContext<DistinctColumnType, DistinctAggregateType, AggregateKey>>(
-              _contexts_per_column[0]);
-      auto& results = *context->results;
-
-      for (ChunkOffset chunk_offset{0}; chunk_offset < chunk_in->size(); chunk_offset++) {
-        results[hash_keys[chunk_offset]].row_id = RowID(chunk_id, chunk_offset);
-      }
-    } else {
-      ColumnID column_index{0};
-      for (const auto& aggregate : _aggregates) {
-        /**
-         * Special COUNT(*) implementation.
-         * Because COUNT(*) does not have a specific target column, we use the maximum ColumnID.
-         * We then go through the keys_per_chunk map and count the occurrences of each group key.
-         * The results are saved in the regular aggregate_count variable so that we don't need a
-         * specific output logic for COUNT(*).
-         */
-        if (!aggregate.column && aggregate.function == AggregateFunction::Count) {
-          auto context = std::static_pointer_cast<AggregateContext<CountColumnType, CountAggregateType, AggregateKey>>(
-              _contexts_per_column[column_index]);
-
-          auto& results = *context->results;
-
-          // count occurrences for each group key
-          for (ChunkOffset chunk_offset{0}; chunk_offset < chunk_in->size(); chunk_offset++) {
-            auto& hash_entry = results[hash_keys[chunk_offset]];
-            hash_entry.row_id = RowID(chunk_id, chunk_offset);
-            ++hash_entry.aggregate_count;
-          }
+  for (auto& partial_aggregation : partial_aggregations) {
+    jobs.emplace_back(std::make_shared<JobTask>([&partial_aggregation, &keys_per_chunk, &id_counts, partition_count,
+                                                 this]() {
+      auto& group_keys = partial_aggregation.group_keys;
 
-          ++column_index;
-          continue;
+      auto group_ids_per_chunk = std::vector<std::vector<GroupID>>{};
+      group_ids_per_chunk.reserve(partial_aggregation.chunk_end - partial_aggregation.chunk_begin);
+
+      // insert_key(key) returns the GroupID of key and whether key was seen for the first time
+      const auto assign_group_ids = [&](const auto& insert_key) {
+        for (auto chunk_id = partial_aggregation.chunk_begin; chunk_id < partial_aggregation.chunk_end; ++chunk_id) {
+          const auto& hash_keys = keys_per_chunk[chunk_id];
+          auto& group_ids = group_ids_per_chunk.emplace_back(hash_keys.size());
+
+          for (ChunkOffset chunk_offset{0}; chunk_offset < hash_keys.size(); ++chunk_offset) {
+            const auto [group_id, inserted] = insert_key(hash_keys[chunk_offset]);
+            group_ids[chunk_offset] = group_id;
+            if (inserted) partial_aggregation.group_row_ids.emplace_back(chunk_id, chunk_offset);
+          }
+        }
+      };
+
+      const auto assign_hashed_group_ids = [&]() {
+        auto group_id_map = GroupIdMap<AggregateKey>{};
+        assign_group_ids([&](const AggregateKey& key) { return group_id_map.insert(key); });
+        group_keys = group_id_map.release_keys();
+      };
+
+      if constexpr (std::is_same_v<AggregateKey, AggregateKeyEntry>) {
+        // Without group-by columns, all keys are 0
+        const auto key_count = _groupby_column_ids.empty() ? size_t{1} : size_t{id_counts.front()};
+
+        if (key_count <= MAX_DIRECT_INDEXED_KEY_COUNT) {
+          // There are few distinct values in the single group-by column (e.g., a small dictionary), so their IDs index
+          // an array of GroupIDs and no hashing is needed
+          auto group_ids_by_key = std::vector<GroupID>(key_count, INVALID_GROUP_ID);
+          assign_group_ids([&](const AggregateKeyEntry key) {
+            auto& group_id = group_ids_by_key[key];
+            if (group_id != INVALID_GROUP_ID) return std::make_pair(group_id, false);
+
+            group_id = group_keys.size();
+            group_keys.emplace_back(key);
+            return std::make_pair(group_id, true);
+          });
+        } else {
+          assign_hashed_group_ids();
         }
+      } else {
+        assign_hashed_group_ids();
+      }
 
-        auto base_segment = chunk_in->get_segment(*aggregate.column);
-        auto data_type = input_table->column_data_type(*aggregate.column);
+      const auto group_count = group_keys.size();
+      partial_aggregation.contexts_per_column = _create_aggregate_contexts(group_count);
 
-        /*
-        Invoke correct aggregator for each segment
-        */
+      for (auto chunk_id = partial_aggregation.chunk_begin; chunk_id < partial_aggregation.chunk_end; ++chunk_id) {
+        _aggregate_chunk(chunk_id, group_ids_per_chunk[chunk_id - partial_aggregation.chunk_begin],
+                         partial_aggregation.contexts_per_column);
+      }
+
+      partial_aggregation.group_partitions.resize(group_count);
+      partial_aggregation.groups_per_partition.resize(partition_count);
+      partial_aggregation.merged_group_ids.resize(group_count);
 
-        resolve_data_type(data_type, [&, aggregate](auto type) {
+      for (GroupID group_id{0}; group_id < group_count; ++group_id) {
+        const auto partition = std::hash<AggregateKey>{}(group_keys[group_id]) % partition_count;
+        partial_aggregation.group_partitions[group_id] = partition;
+        partial_aggregation.groups_per_partition[partition].emplace_back(group_id);
+      }
+
+      partial_aggregation.distinct_value_ids_per_column_and_partition.resize(_aggregates.size());
+      for (ColumnID column_index{0}; column_index < _aggregates.size(); ++column_index) {
+        const auto& aggregate = _aggregates[column_index];
+        if (aggregate.function != AggregateFunction::CountDistinct || !aggregate.column) continue;
+
+        resolve_data_type(input_table_left()->column_data_type(*aggregate.column), [&](auto type) {
           using ColumnDataType = typename decltype(type)::type;
+          partition_distinct_values<ColumnDataType>(partial_aggregation, column_index, partition_count);
+        });
+      }
+    }));
+    jobs.back()->schedule();
+  }
+
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  /*
+  MERGE PHASE
+  The partitions are merged in parallel. First, the AggregateKeys of each partition are mapped to GroupIDs local to
+  the partition. The partitions are then concatenated, i.e., the GroupIDs of a partition are offset by the number of
+  groups in the preceding partitions. Finally, the partial aggregates are merged into the final contexts. Because each
+  group belongs to exactly one partition, the jobs write to disjoint groups of these contexts.
+  A single chunk range does not need to be merged.
+  */
+  auto group_row_ids = PosList{};
+
+  if (partial_aggregations.size() == 1) {
+    group_row_ids = std::move(partial_aggregations.front().group_row_ids);
+    _contexts_per_column = std::move(partial_aggregations.front().contexts_per_column);
+  } else {
+    auto group_row_ids_per_partition = std::vector<PosList>(partition_count);
+
+    jobs.clear();
+    jobs.reserve(partition_count);
+
+    for (auto partition = size_t{0}; partition < partition_count; ++partition) {
+      jobs.emplace_back(
+          std::make_shared<JobTask>([&partial_aggregations, &group_row_ids_per_partition, partition]() {
+            auto group_id_map = GroupIdMap<AggregateKey>{};
+            auto& partition_group_row_ids = group_row_ids_per_partition[partition];
+
+            // The chunk ranges are visited in order, so that the first row of each group is the first row overall
+            for (auto& partial_aggregation : partial_aggregations) {
+              const auto& group_keys = partial_aggregation.group_keys;
+              for (const auto group_id : partial_aggregation.groups_per_partition[partition]) {
+                const auto [merged_group_id, inserted] = group_id_map.insert(group_keys[group_id]);
+                partial_aggregation.merged_group_ids[group_id] = merged_group_id;
+                if (inserted) partition_group_row_ids.emplace_back(partial_aggregation.group_row_ids[group_id]);
+              }
+            }
+          }));
+      jobs.back()->schedule();
+    }
+
+    CurrentScheduler::wait_for_tasks(jobs);
+
+    auto partition_offsets = std::vector<GroupID>(partition_count);
+    for (auto partition = size_t{0}; partition < partition_count; ++partition) {
+      partition_offsets[partition] = group_row_ids.size();
+      const auto& partition_group_row_ids = group_row_ids_per_partition[partition];
+      group_row_ids.insert(group_row_ids.end(), partition_group_row_ids.begin(), partition_group_row_ids.end());
+    }
 
-          switch (aggregate.function) {
-            case AggregateFunction::Min:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Min, AggregateKey>(chunk_id, column_index,
-                                                                                       *base_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Max:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Max, AggregateKey>(chunk_id, column_index,
-                                                                                       *base_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Sum:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Sum, AggregateKey>(chunk_id, column_index,
-                                                                                       *base_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Avg:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Avg, AggregateKey>(chunk_id, column_index,
-                                                                                       *base_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Count:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Count, AggregateKey>(chunk_id, column_index,
-                                                                                         *base_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::CountDistinct:
-              _aggregate_segment<ColumnDataType, AggregateFunction::CountDistinct, AggregateKey>(
-                  chunk_id, column_index, *base_segment, keys_per_chunk);
-              break;
+    _contexts_per_column = _create_aggregate_contexts(group_row_ids.size());
+
+    jobs.clear();
+    jobs.reserve(partition_count);
+
+    for (auto partition = size_t{0}; partition < partition_count; ++partition) {
+      jobs.emplace_back(std::make_shared<JobTask>([&, partition]() {
+        for (auto& partial_aggregation : partial_aggregations) {
+          for (const auto group_id : partial_aggregation.groups_per_partition[partition]) {
+            partial_aggregation.merged_group_ids[group_id] += partition_offsets[partition];
           }
-        });
+        }
 
-        ++column_index;
-      }
+        for (ColumnID column_index{0}; column_index < _aggregates.size(); ++column_index) {
+          const auto& aggregate = _aggregates[column_index];
+          const auto& context = _contexts_per_column[column_index];
+
+          if (!aggregate.column) {
+            // COUNT(*)
+            merge_partial_aggregates<CountColumnType, AggregateFunction::Count>(context, partial_aggregations,
+                                                                                column_index, partition);
+            continue;
+          }
+
+          resolve_data_type(input_table->column_data_type(*aggregate.column), [&](auto type) {
+            using ColumnDataType = typename decltype(type)::type;
+
+            switch (aggregate.function) {
+              case AggregateFunction::Min:
+                merge_partial_aggregates<ColumnDataType, AggregateFunction::Min>(context, partial_aggregations,
+                                                                                 column_index, partition);
+                break;
+              case AggregateFunction::Max:
+                merge_partial_aggregates<ColumnDataType, AggregateFunction::Max>(context, partial_aggregations,
+                                                                                 column_index, partition);
+                break;
+              case AggregateFunction::Sum:
+                merge_partial_aggregates<ColumnDataType, AggregateFunction::Sum>(context, partial_aggregations,
+                                                                                 column_index, partition);
+                break;
+              case AggregateFunction::Avg:
+                merge_partial_aggregates<ColumnDataType, AggregateFunction::Avg>(context, partial_aggregations,
+                                                                                 column_index, partition);
+                break;
+              case AggregateFunction::Count:
+                merge_partial_aggregates<ColumnDataType, AggregateFunction::Count>(context, partial_aggregations,
+                                                                                   column_index, partition);
+                break;
+              case AggregateFunction::CountDistinct:
+                merge_partial_aggregates<ColumnDataType, AggregateFunction::CountDistinct>(
+                    context, partial_aggregations, column_index, partition);
+                break;
+            }
+          });
+        }
+      }));
+      jobs.back()->schedule();
     }
+
+    CurrentScheduler::wait_for_tasks(jobs);
+  }
+
+  // An empty input has no chunk ranges, but _write_aggregate_output() needs the contexts anyway
+  if (partial_aggregations.empty()) {
+    _contexts_per_column = _create_aggregate_contexts(0);
   }
 
   // add group by columns
@@ -550,24 +850,11 @@ void Aggregate::_aggregate() {
     _groupby_segments.push_back(groupby_segment);
     _output_segments.push_back(groupby_segment);
   }
+
   /**
-   * Write group-by columns.
-   *
-   * 'results_per_column' always contains at least one element, since there are either GroupBy or Aggregate columns.
-   * However, we need to look only at the first element, because the keys for all columns are the same.
-   *
-   * The following loop is used for both, actual GroupBy columns and DISTINCT columns.
+   * Write group-by columns. The following is used for both, actual GroupBy columns and DISTINCT columns.
    **/
-  if (_aggregates.empty()) {
-    auto context = std::static_pointer_cast<AggregateContext<DistinctColumnType, DistinctAggregateType, AggregateKey>>(
-        _contexts_per_column[0]);
-    auto pos_list = PosList();
-    pos_list.reserve(context->results->size());
-    for (auto& map : *context->results) {
-      pos_list.push_back(map.second.row_id);
-    }
-    _write_groupby_output(pos_list);
-  }
+  _write_groupby_output(group_row_ids);
 
   /*
   Write the aggregated columns to the output
@@ -580,7 +867,7 @@ void Aggregate::_aggregate() {
     const auto data_type = !column ? DataType::Int : input_table->column_data_type(*column);
 
     resolve_data_type(data_type, [&, column_index](auto type) {
-      _write_aggregate_output<AggregateKey>(type, column_index, aggregate.function);
+      _write_aggregate_output(type, column_index, aggregate.function);
     });
 
     ++column_index;
@@ -619,102 +906,76 @@ The following template functions write the aggregated values for the different a
 They are separate and templated to avoid compiler errors for invalid type/function combinations.
 */
 // MIN, MAX, SUM write the current aggregated value
-template <typename ColumnType, typename AggregateType, AggregateFunction func, typename AggregateKey>
+template <typename ColumnType, typename AggregateType, AggregateFunction func>
 typename std::enable_if<
     func == AggregateFunction::Min || func == AggregateFunction::Max || func == AggregateFunction::Sum, void>::type
 write_aggregate_values(std::shared_ptr<ValueSegment<AggregateType>> segment,
-                       std::shared_ptr<std::unordered_map<AggregateKey, AggregateResult<AggregateType, ColumnType>,
-                                                          std::hash<AggregateKey>>>
-                           results) {
+                       const AggregateResults<AggregateType, ColumnType>& results) {
   DebugAssert(segment->is_nullable(), "Aggregate: Output segment needs to be nullable");
 
   auto& values = segment->values();
   auto& null_values = segment->null_values();
 
-  values.resize(results->size());
-  null_values.resize(results->size());
+  const auto group_count = results.current_aggregates.size();
+  values.resize(group_count);
+  null_values.resize(group_count);
 
-  size_t i = 0;
-  for (auto& kv : *results) {
-    null_values[i] = !kv.second.current_aggregate;
+  for (GroupID group_id{0}; group_id < group_count; ++group_id) {
+    const auto& current_aggregate = results.current_aggregates[group_id];
+    null_values[group_id] = !current_aggregate;
 
-    if (kv.second.current_aggregate) {
-      values[i] = *kv.second.current_aggregate;
+    if (current_aggregate) {
+      values[group_id] = *current_aggregate;
     }
-    ++i;
   }
 }
 
-// COUNT writes the aggregate counter
-template <typename ColumnType, typename AggregateType, AggregateFunction func, typename AggregateKey>
-typename std::enable_if<func == AggregateFunction::Count, void>::type write_aggregate_values(
-    std::shared_ptr<ValueSegment<AggregateType>> segment,
-    std::shared_ptr<
-        std::unordered_map<AggregateKey, AggregateResult<AggregateType, ColumnType>, std::hash<AggregateKey>>>
-        results) {
+// COUNT and COUNT(DISTINCT) write the aggregate counter
+template <typename ColumnType, typename AggregateType, AggregateFunction func>
+typename std::enable_if<func == AggregateFunction::Count || func == AggregateFunction::CountDistinct, void>::type
+write_aggregate_values(std::shared_ptr<ValueSegment<AggregateType>> segment,
+                       const AggregateResults<AggregateType, ColumnType>& results) {
   DebugAssert(!segment->is_nullable(), "Aggregate: Output segment for COUNT shouldn't be nullable");
 
   auto& values = segment->values();
-  values.resize(results->size());
 
-  size_t i = 0;
-  for (auto& kv : *results) {
-    values[i] = kv.second.aggregate_count;
-    ++i;
-  }
-}
+  const auto group_count = results.aggregate_counts.size();
+  values.resize(group_count);
 
-// COUNT(DISTINCT) writes the number of distinct values
-template <typename ColumnType, typename AggregateType, AggregateFunction func, typename AggregateKey>
-typename std::enable_if<func == AggregateFunction::CountDistinct, void>::type write_aggregate_values(
-    std::shared_ptr<ValueSegment<AggregateType>> segment,
-    std::shared_ptr<
-        std::unordered_map<AggregateKey, AggregateResult<AggregateType, ColumnType>, std::hash<AggregateKey>>>
-        results) {
-  DebugAssert(!segment->is_nullable(), "Aggregate: Output segment for COUNT shouldn't be nullable");
-
-  auto& values = segment->values();
-  values.resize(results->size());
-
-  size_t i = 0;
-  for (auto& kv : *results) {
-    values[i] = kv.second.distinct_values.size();
-    ++i;
+  for (GroupID group_id{0}; group_id < group_count; ++group_id) {
+    values[group_id] = results.aggregate_counts[group_id];
   }
 }
 
 // AVG writes the calculated average from current aggregate and the aggregate counter
-template <typename ColumnType, typename AggregateType, AggregateFunction func, typename AggregateKey>
+template <typename ColumnType, typename AggregateType, AggregateFunction func>
 typename std::enable_if<func == AggregateFunction::Avg && std::is_arithmetic<AggregateType>::value, void>::type
 write_aggregate_values(std::shared_ptr<ValueSegment<AggregateType>> segment,
-                       std::shared_ptr<std::unordered_map<AggregateKey, AggregateResult<AggregateType, ColumnType>,
-                                                          std::hash<AggregateKey>>>
-                           results) {
+                       const AggregateResults<AggregateType, ColumnType>& results) {
   DebugAssert(segment->is_nullable(), "Aggregate: Output segment needs to be nullable");
 
   auto& values = segment->values();
   auto& null_values = segment->null_values();
 
-  values.resize(results->size());
-  null_values.resize(results->size());
+  const auto group_count = results.current_aggregates.size();
+  values.resize(group_count);
+  null_values.resize(group_count);
 
-  size_t i = 0;
-  for (auto& kv : *results) {
-    null_values[i] = !kv.second.current_aggregate;
+  for (GroupID group_id{0}; group_id < group_count; ++group_id) {
+    const auto& current_aggregate = results.current_aggregates[group_id];
+    null_values[group_id] = !current_aggregate;
 
-    if (kv.second.current_aggregate) {
-      values[i] = *kv.second.current_aggregate / static_cast<AggregateType>(kv.second.aggregate_count);
+    if (current_aggregate) {
+      values[group_id] = *current_aggregate / static_cast<AggregateType>(results.aggregate_counts[group_id]);
     }
-    ++i;
   }
 }
 
 // AVG is not defined for non-arithmetic types. Avoiding compiler errors.
-template <typename ColumnType, typename AggregateType, AggregateFunction func, typename AggregateKey>
+template <typename ColumnType, typename AggregateType, AggregateFunction func>
 typename std::enable_if<func == AggregateFunction::Avg && !std::is_arithmetic<AggregateType>::value, void>::type
 write_aggregate_values(std::shared_ptr<ValueSegment<AggregateType>>,
-                       std::shared_ptr<std::unordered_map<AggregateKey, AggregateResult<AggregateType, ColumnType>,
-                                                          std::hash<AggregateKey>>>) {
+                       const AggregateResults<AggregateType, ColumnType>&) {
   Fail("Invalid aggregate");
 }
 
@@ -732,32 +993,32 @@ void Aggregate::_write_groupby_output(PosList& pos_list) {
   }
 }
 
-template <typename AggregateKey, typename ColumnType>
+template <typename ColumnType>
 void Aggregate::_write_aggregate_output(boost::hana::basic_type<ColumnType> type, ColumnID column_index,
                                         AggregateFunction function) {
   switch (function) {
     case AggregateFunction::Min:
-      write_aggregate_output<ColumnType, AggregateFunction::Min, AggregateKey>(column_index);
+      write_aggregate_output<ColumnType, AggregateFunction::Min>(column_index);
       break;
     case AggregateFunction::Max:
-      write_aggregate_output<ColumnType, AggregateFunction::Max, AggregateKey>(column_index);
+      write_aggregate_output<ColumnType, AggregateFunction::Max>(column_index);
       break;
     case AggregateFunction::Sum:
-      write_aggregate_output<ColumnType, AggregateFunction::Sum, AggregateKey>(column_index);
+      write_aggregate_output<ColumnType, AggregateFunction::Sum>(column_index);
       break;
     case AggregateFunction::Avg:
-      write_aggregate_output<ColumnType, AggregateFunction::Avg, AggregateKey>(column_index);
+      write_aggregate_output<ColumnType, AggregateFunction::Avg>(column_index);
       break;
     case AggregateFunction::Count:
-      write_aggregate_output<ColumnType, AggregateFunction::Count, AggregateKey>(column_index);
+      write_aggregate_output<ColumnType, AggregateFunction::Count>(column_index);
       break;
     case AggregateFunction::CountDistinct:
-      write_aggregate_output<ColumnType, AggregateFunction::CountDistinct, AggregateKey>(column_index);
+      write_aggregate_output<ColumnType, AggregateFunction::CountDistinct>(column_index);
       break;
   }
 }
 
-template <typename ColumnType, AggregateFunction function, typename AggregateKey>
+template <typename ColumnType, AggregateFunction function>
 void Aggregate::write_aggregate_output(ColumnID column_index) {
   // retrieve type information from the aggregation traits
   typename AggregateTraits<ColumnType, function>::AggregateType aggregate_type;
@@ -791,23 +1052,12 @@ void Aggregate::write_aggregate_output(ColumnID column_index) {
 
   auto output_segment = std::make_shared<ValueSegment<decltype(aggregate_type)>>(NEEDS_NULL);
 
-  auto context = std::static_pointer_cast<AggregateContext<ColumnType, decltype(aggregate_type), AggregateKey>>(
+  auto context = std::static_pointer_cast<AggregateContext<ColumnType, decltype(aggregate_type)>>(
       _contexts_per_column[column_index]);
 
-  // write all group keys into the respective columns
-  if (column_index == 0) {
-    auto pos_list = PosList();
-    pos_list.reserve(context->results->size());
-    for (auto& map : *context->results) {
-      pos_list.push_back(map.second.row_id);
-    }
-    _write_groupby_output(pos_list);
-  }
-
   // write aggregated values into the segment
-  if (!context->results->empty()) {
-    write_aggregate_values<ColumnType, decltype(aggregate_type), function, AggregateKey>(output_segment,
-                                                                                         context->results);
+  if (!context->results.aggregate_counts.empty()) {
+    write_aggregate_values<ColumnType, decltype(aggregate_type), function>(output_segment, context->results);
   } else if (_groupby_segments.empty()) {
     // If we did not GROUP BY anything and we have no results, we need to add NULL for most aggregates and 0 for count
     output_segment->values().push_back(decltype(aggregate_type){});
@@ -819,41 +1069,68 @@ void Aggregate::write_aggregate_output(ColumnID column_index) {
   _output_segments.push_back(output_segment);
 }
 
-template <typename AggregateKey>
+/**
+ * Create an AggregateContext for each aggregate column with room for group_count groups.
+ *
+ * In Opossum we handle the SQL keyword DISTINCT by grouping without aggregation, i.e., there are no contexts then.
+ * The optimizer is responsible to pass in the correct group-by columns, e.g., all columns of A for
+ * "SELECT DISTINCT * FROM A;". Obviously this is also used for plain GroupBy's.
+ */
+std::vector<std::shared_ptr<SegmentVisitorContext>> Aggregate::_create_aggregate_contexts(
+    const size_t group_count) const {
+  auto contexts_per_column = std::vector<std::shared_ptr<SegmentVisitorContext>>(_aggregates.size());
+
+  for (ColumnID column_index{0}; column_index < _aggregates.size(); ++column_index) {
+    const auto& aggregate = _aggregates[column_index];
+    if (!aggregate.column && aggregate.function == AggregateFunction::Count) {
+      // SELECT COUNT(*) - we know the template arguments, so we don't need a visitor
+      auto context = std::make_shared<AggregateContext<CountColumnType, CountAggregateType>>();
+      context->results.resize(group_count);
+      contexts_per_column[column_index] = context;
+      continue;
+    }
+    const auto data_type = input_table_left()->column_data_type(*aggregate.column);
+    contexts_per_column[column_index] = _create_aggregate_context(data_type, aggregate.function, group_count);
+  }
+
+  return contexts_per_column;
+}
+
 std::shared_ptr<SegmentVisitorContext> Aggregate::_create_aggregate_context(const DataType data_type,
-                                                                            const AggregateFunction function) const {
+                                                                            const AggregateFunction function,
+                                                                            const size_t group_count) const {
   std::shared_ptr<SegmentVisitorContext> context;
   resolve_data_type(data_type, [&](auto type) {
     using ColumnDataType = typename decltype(type)::type;
     switch (function) {
       case AggregateFunction::Min:
-        context = _create_aggregate_context_impl<ColumnDataType, AggregateFunction::Min, AggregateKey>();
+        context = _create_aggregate_context_impl<ColumnDataType, AggregateFunction::Min>(group_count);
         break;
       case AggregateFunction::Max:
-        context = _create_aggregate_context_impl<ColumnDataType, AggregateFunction::Max, AggregateKey>();
+        context = _create_aggregate_context_impl<ColumnDataType, AggregateFunction::Max>(group_count);
         break;
       case AggregateFunction::Sum:
-        context = _create_aggregate_context_impl<ColumnDataType, AggregateFunction::Sum, AggregateKey>();
+        context = _create_aggregate_context_impl<ColumnDataType, AggregateFunction::Sum>(group_count);
         break;
       case AggregateFunction::Avg:
-        context = _create_aggregate_context_impl<ColumnDataType, AggregateFunction::Avg, AggregateKey>();
+        context = _create_aggregate_context_impl<ColumnDataType, AggregateFunction::Avg>(group_count);
         break;
       case AggregateFunction::Count:
-        context = _create_aggregate_context_impl<ColumnDataType, AggregateFunction::Count, AggregateKey>();
+        context = _create_aggregate_context_impl<ColumnDataType, AggregateFunction::Count>(group_count);
         break;
       case AggregateFunction::CountDistinct:
-        context = _create_aggregate_context_impl<ColumnDataType, AggregateFunction::CountDistinct, AggregateKey>();
+        context = _create_aggregate_context_impl<ColumnDataType, AggregateFunction::CountDistinct>(group_count);
         break;
     }
   });
   return context;
 }
 
-template <typename ColumnDataType, AggregateFunction aggregate_function, typename AggregateKey>
-std::shared_ptr<SegmentVisitorContext> Aggregate::_create_aggregate_context_impl() const {
-  const auto context = std::make_shared<AggregateContext<
-      ColumnDataType, typename AggregateTraits<ColumnDataType, aggregate_function>::AggregateType, AggregateKey>>();
-  context->results = std::make_shared<typename decltype(context->results)::element_type>();
+template <typename ColumnDataType, AggregateFunction aggregate_function>
+std::shared_ptr<SegmentVisitorContext> Aggregate::_create_aggregate_context_impl(const size_t group_count) const {
+  const auto context = std::make_shared<
+      AggregateContext<ColumnDataType, typename AggregateTraits<ColumnDataType, aggregate_function>::AggregateType>>();
+  context->results.resize(group_count);
   return context;
 }
 
@@ -7,13 +7,13 @@
 #include <limits>
 #include <memory>
 #include <optional>
-#include <set>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "abstract_read_only_operator.hpp"
+#include "aggregate/group_id_map.hpp"
 #include "expression/aggregate_expression.hpp"
 #include "resolve_type.hpp"
 #include "storage/abstract_segment_visitor.hpp"
@@ -24,9 +24,6 @@
 
 namespace opossum {
 
-template <typename AggregateKey>
-struct GroupByContext;
-
 /**
  * Aggregates are defined by the column (ColumnID for Operators, LQPColumnReference in LQP) they operate on and the aggregate
  * function they use. COUNT() is the exception that doesn't use a column, which is why column is optional
@@ -49,21 +46,32 @@ For implementation details, please check the wiki: https://github.com/hyrise/hyr
 */
 
 /*
-Current aggregated value and the number of rows that were used.
-The latter is used for AVG and COUNT.
+The key type that is used for the aggregation map.
 */
-template <typename AggregateType, typename ColumnDataType>
-struct AggregateResult {
-  std::optional<AggregateType> current_aggregate;
-  size_t aggregate_count = 0;
-  std::set<ColumnDataType> distinct_values;
-  RowID row_id;
-};
+using AggregateKeyEntry = uint64_t;
 
 /*
-The key type that is used for the aggregation map.
+Dense index of a group, assigned by a GroupIdMap over the AggregateKeys
 */
-using AggregateKeyEntry = uint64_t;
+using GroupID = size_t;
+
+/*
+The aggregates of all groups for one aggregate column, stored column-wise and indexed by GroupID.
+current_aggregates holds the aggregated value (MIN, MAX, SUM, AVG), which is not set if all values were NULL.
+aggregate_counts holds the number of non-NULL values (AVG, COUNT) or the number of distinct values (COUNT(DISTINCT)).
+For COUNT(DISTINCT), the (group, value) pairs are tracked in a single map for all groups.
+*/
+template <typename AggregateType, typename ColumnDataType>
+struct AggregateResults {
+  void resize(const size_t group_count) {
+    current_aggregates.resize(group_count);
+    aggregate_counts.resize(group_count);
+  }
+
+  std::vector<std::optional<AggregateType>> current_aggregates;
+  std::vector<size_t> aggregate_counts;
+  GroupIdMap<std::pair<GroupID, ColumnDataType>, boost::hash<std::pair<GroupID, ColumnDataType>>> distinct_values;
+};
 
 template <typename AggregateKey>
 using AggregateKeys = pmr_vector<AggregateKey>;
@@ -72,12 +80,10 @@ template <typename AggregateKey>
 using KeysPerChunk = pmr_vector<AggregateKeys<AggregateKey>>;
 
 /**
- * Types that are used for the special COUNT(*) and DISTINCT implementations
+ * Types that are used for the special COUNT(*) implementation
  */
 using CountColumnType = int32_t;
 using CountAggregateType = int64_t;
-using DistinctColumnType = int8_t;
-using DistinctAggregateType = int8_t;
 
 /**
  * Note: Aggregate does not support null values at the moment
@@ -94,7 +100,7 @@ class Aggregate : public AbstractReadOnlyOperator {
   const std::string description(DescriptionMode description_mode) const override;
 
   // write the aggregated output for a given aggregate column
-  template <typename ColumnType, AggregateFunction function, typename AggregateKey>
+  template <typename ColumnType, AggregateFunction function>
   void write_aggregate_output(ColumnID column_index);
 
  protected:
@@ -111,22 +117,27 @@ class Aggregate : public AbstractReadOnlyOperator {
 
   void _on_cleanup() override;
 
-  template <typename AggregateKey, typename ColumnType>
+  template <typename ColumnType>
   void _write_aggregate_output(boost::hana::basic_type<ColumnType> type, ColumnID column_index,
                                AggregateFunction function);
 
   void _write_groupby_output(PosList& pos_list);
 
-  template <typename ColumnDataType, AggregateFunction function, typename AggregateKey>
-  void _aggregate_segment(ChunkID chunk_id, ColumnID column_index, const BaseSegment& base_segment,
-                          const KeysPerChunk<AggregateKey>& keys_per_chunk);
+  void _aggregate_chunk(ChunkID chunk_id, const std::vector<GroupID>& group_ids,
+                        const std::vector<std::shared_ptr<SegmentVisitorContext>>& contexts_per_column);
+
+  template <typename ColumnDataType, AggregateFunction function>
+  void _aggregate_segment(const std::shared_ptr<SegmentVisitorContext>& context, const BaseSegment& base_segment,
+                          const std::vector<GroupID>& group_ids);
+
+  std::vector<std::shared_ptr<SegmentVisitorContext>> _create_aggregate_contexts(const size_t group_count) const;
 
-  template <typename AggregateKey>
   std::shared_ptr<SegmentVisitorContext> _create_aggregate_context(const DataType data_type,
-                                                                   const AggregateFunction function) const;
+                                                                   const AggregateFunction function,
+                                                                   const size_t group_count) const;
 
-  template <typename ColumnDataType, AggregateFunction aggregate_function, typename AggregateKey>
-  std::shared_ptr<SegmentVisitorContext> _create_aggregate_context_impl() const;
+  template <typename ColumnDataType, AggregateFunction aggregate_function>
+  std::shared_ptr<SegmentVisitorContext> _create_aggregate_context_impl(const size_t group_count) const;
 
   const std::vector<AggregateColumnDefinition> _aggregates;
   const std::vector<ColumnID> _groupby_column_ids;
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace opossum {
+
+/**
+ * Flat hash map that assigns each distinct key a dense id. Ids start at 0 and are handed out in the order in which
+ * the keys are inserted first. The keys are stored in a vector indexed by their id. The hash table itself only
+ * consists of slots holding the hash and the id of a key, which are probed linearly.
+ *
+ * Compared to a node-based std::unordered_map, inserting a key does not allocate a node and a lookup usually touches
+ * a single cache line of slots.
+ */
+template <typename Key, typename Hash = std::hash<Key>>
+class GroupIdMap {
+ public:
+  /**
+   * @return the id of key and whether key was inserted, i.e., was not contained in the map before
+   */
+  std::pair<size_t, bool> insert(const Key& key) {
+    if ((_keys.size() + 1) * 2 > _slots.size()) {
+      _grow();
+    }
+
+    const auto hash = _mix(Hash{}(key));
+    for (auto slot_idx = hash >> _shift;; slot_idx = (slot_idx + 1) & (_slots.size() - 1)) {
+      auto& slot = _slots[slot_idx];
+
+      if (slot.id == EMPTY_SLOT) {
+        slot = Slot{hash, _keys.size()};
+        _keys.emplace_back(key);
+        return {slot.id, true};
+      }
+
+      if (slot.hash == hash && _keys[slot.id] == key) {
+        return {slot.id, false};
+      }
+    }
+  }
+
+  size_t size() const { return _keys.size(); }
+
+  /**
+   * @return the keys, indexed by their id
+   */
+  const std::vector<Key>& keys() const { return _keys; }
+
+  /**
+   * Moves the keys, indexed by their id, out of the map and leaves the map empty
+   */
+  std::vector<Key> release_keys() {
+    auto keys = std::move(_keys);
+    _keys.clear();
+    _slots.clear();
+    return keys;
+  }
+
+ private:
+  struct Slot {
+    size_t hash;
+    size_t id;
+  };
+
+  static constexpr auto EMPTY_SLOT = std::numeric_limits<size_t>::max();
+
+  // std::hash is the identity for integers. Fibonacci hashing spreads such hashes over the upper bits, which select
+  // the slot.
+  static size_t _mix(const size_t hash) { return hash * size_t{0x9E3779B97F4A7C15}; }
+
+  void _grow() {
+    const auto slot_count = std::max(size_t{16}, _slots.size() * 2);
+    auto slots = std::vector<Slot>(slot_count, Slot{0, EMPTY_SLOT});
+
+    _shift = std::numeric_limits<size_t>::digits;
+    for (auto remaining_slot_count = slot_count; remaining_slot_count > 1; remaining_slot_count >>= 1) {
+      --_shift;
+    }
+
+    for (const auto& slot : _slots) {
+      if (slot.id == EMPTY_SLOT) continue;
+
+      auto slot_idx = slot.hash >> _shift;
+      while (slots[slot_idx].id != EMPTY_SLOT) {
+        slot_idx = (slot_idx + 1) & (slot_count - 1);
+      }
+      slots[slot_idx] = slot;
+    }
+
+    _slots = std::move(slots);
+  }
+
+  std::vector<Slot> _slots;
+  size_t _shift{0};
+  std::vector<Key> _keys;
+};
+
+}  // namespace opossum
@@ -5,6 +5,7 @@
 
 #include "concurrency/transaction_context.hpp"
 #include "concurrency/transaction_manager.hpp"
+#include "logging/logger.hpp"
 #include "statistics/table_statistics.hpp"
 #include "storage/reference_segment.hpp"
 #include "storage/storage_manager.hpp"
@@ -42,6 +43,11 @@ std::shared_ptr<const Table> Delete::_on_execute(std::shared_ptr<TransactionCont
     for (const auto& row_id : *pos_list) {
       auto referenced_chunk = _table->get_chunk(row_id.chunk_id);
 
+      // Readers must not skip the visibility checks of the chunk anymore (see MvccData::all_rows_visible())
+      if (auto mvcc_data = referenced_chunk->get_scoped_mvcc_data_lock(); !mvcc_data->has_invalidated_rows()) {
+        mvcc_data->register_invalidation();
+      }
+
       auto expected = 0u;
       // Actual row lock for delete happens here
       const auto success =
@@ -79,6 +85,8 @@ void Delete::_on_commit_records(const CommitID cid) {
       chunk->get_scoped_mvcc_data_lock()->end_cids[row_id.chunk_offset] = cid;
       // We do not unlock the rows so subsequent transactions properly fail when attempting to update these rows.
     }
+
+    if (Logger::get().is_enabled()) Logger::get().log_invalidation(_transaction_id, _table_name, *pos_list);
   }
 }
 
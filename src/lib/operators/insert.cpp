@@ -6,8 +6,13 @@
 #include <vector>
 
 #include "concurrency/transaction_context.hpp"
+#include "logging/logger.hpp"
 #include "resolve_type.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
 #include "storage/base_encoded_segment.hpp"
+#include "storage/create_iterable_from_segment.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/value_segment.hpp"
 #include "type_cast.hpp"
@@ -80,11 +85,27 @@ class TypedSegmentProcessor : public AbstractTypedSegmentProcessor {
 
       // Ignore source value and only set null to true
       casted_target->null_values()[target_start_index] = true;
+    } else if (source->data_type() == data_type_from_type<T>()) {
+      // Encoded and reference segments are copied through their typed iterables, which avoids the conversion of every
+      // value into an AllTypeVariant. Segment iterators only support forward traversal.
+      resolve_segment_type<T>(*source, [&](const auto& typed_source) {
+        create_iterable_from_segment<T>(typed_source).with_iterators([&](auto it, auto /* end */) {
+          std::advance(it, source_start_index);
+          for (auto target_index = target_start_index; target_index < target_start_index + length;
+               ++target_index, ++it) {
+            const auto& value = *it;
+            if (value.is_null()) {
+              Assert(target_is_nullable, "Cannot insert NULL into NOT NULL target");
+              values[target_index] = T{};
+              casted_target->null_values()[target_index] = true;
+            } else {
+              values[target_index] = value.value();
+            }
+          }
+        });
+      });
     } else {
-      // } else if(auto casted_source = std::dynamic_pointer_cast<ReferenceSegment>(source)){
-      // since we have no guarantee that a ReferenceSegment references only a single other segment,
-      // this would require us to find out the referenced segment's type for each single row.
-      // instead, we just use the slow path below.
+      // Slow path for sources of a different data type
       for (auto i = 0u; i < length; i++) {
         auto ref_value = (*source)[source_start_index + i];
         if (variant_is_null(ref_value)) {
@@ -162,7 +183,20 @@ std::shared_ptr<const Table> Insert::_on_execute(std::shared_ptr<TransactionCont
   }
   // TODO(all): make compress chunk thread-safe; if it gets called here by another thread, things will likely break.
 
-  // Then, actually insert the data.
+  /**
+   * Then, actually insert the data. First, plan which source rows go to which target chunk. The copies into the
+   * (already resized) target segments are independent of each other, so each target chunk and column gets its own job.
+   */
+  struct CopyOperation {
+    ChunkID source_chunk_id;
+    ChunkOffset source_start_index;
+    ChunkOffset target_start_index;
+    ChunkOffset length;
+  };
+
+  auto copy_operations_by_target_chunk = std::vector<std::vector<CopyOperation>>(total_chunks_inserted + 1);
+  _inserted_rows.reserve(total_rows_to_insert);
+
   auto input_offset = 0u;
   auto source_chunk_id = ChunkID{0};
   auto source_chunk_start_index = 0u;
@@ -170,6 +204,7 @@ std::shared_ptr<const Table> Insert::_on_execute(std::shared_ptr<TransactionCont
   for (auto target_chunk_id = start_chunk_id; target_chunk_id <= start_chunk_id + total_chunks_inserted;
        target_chunk_id++) {
     auto target_chunk = _target_table->get_chunk(target_chunk_id);
+    auto& copy_operations = copy_operations_by_target_chunk[target_chunk_id - start_chunk_id];
 
     const auto current_num_rows_to_insert =
         std::min(target_chunk->size() - start_index, total_rows_to_insert - input_offset);
@@ -178,15 +213,13 @@ std::shared_ptr<const Table> Insert::_on_execute(std::shared_ptr<TransactionCont
     auto still_to_insert = current_num_rows_to_insert;
 
     // while target chunk is not full
-    while (target_start_index != target_chunk->size()) {
+    while (still_to_insert > 0) {
       const auto source_chunk = input_table_left()->get_chunk(source_chunk_id);
       auto num_to_insert = std::min(source_chunk->size() - source_chunk_start_index, still_to_insert);
-      for (ColumnID column_id{0}; column_id < target_chunk->column_count(); ++column_id) {
-        const auto& source_segment = source_chunk->get_segment(column_id);
-        typed_segment_processors[column_id]->copy_data(source_segment, source_chunk_start_index,
-                                                       target_chunk->get_segment(column_id), target_start_index,
-                                                       num_to_insert);
+      if (num_to_insert > 0) {
+        copy_operations.push_back({source_chunk_id, source_chunk_start_index, target_start_index, num_to_insert});
       }
+
       still_to_insert -= num_to_insert;
       target_start_index += num_to_insert;
       source_chunk_start_index += num_to_insert;
@@ -198,13 +231,19 @@ std::shared_ptr<const Table> Insert::_on_execute(std::shared_ptr<TransactionCont
       }
     }
 
+    // we do not need to check whether other operators have locked the rows, we have just created them
+    // and they are not visible for other operators.
+    // the transaction IDs are set here and not during the resize, because
+    // tbb::concurrent_vector::grow_to_at_least(n, t)" does not work with atomics, since their copy constructor is
+    // deleted.
+    {
+      auto mvcc_data = target_chunk->get_scoped_mvcc_data_lock();
+      for (auto i = start_index; i < start_index + current_num_rows_to_insert; i++) {
+        mvcc_data->tids[i] = context->transaction_id();
+      }
+    }
+
     for (auto i = start_index; i < start_index + current_num_rows_to_insert; i++) {
-      // we do not need to check whether other operators have locked the rows, we have just created them
-      // and they are not visible for other operators.
-      // the transaction IDs are set here and not during the resize, because
-      // tbb::concurrent_vector::grow_to_at_least(n, t)" does not work with atomics, since their copy constructor is
-      // deleted.
-      target_chunk->get_scoped_mvcc_data_lock()->tids[i] = context->transaction_id();
       _inserted_rows.emplace_back(RowID{target_chunk_id, i});
     }
 
@@ -212,6 +251,45 @@ std::shared_ptr<const Table> Insert::_on_execute(std::shared_ptr<TransactionCont
     start_index = 0u;
   }
 
+  const auto copy_segment = [&](const ChunkID target_chunk_id, const ColumnID column_id) {
+    const auto target_segment = _target_table->get_chunk(target_chunk_id)->get_segment(column_id);
+    for (const auto& copy_operation : copy_operations_by_target_chunk[target_chunk_id - start_chunk_id]) {
+      const auto source_segment = input_table_left()->get_chunk(copy_operation.source_chunk_id)->get_segment(column_id);
+      typed_segment_processors[column_id]->copy_data(source_segment, copy_operation.source_start_index, target_segment,
+                                                     copy_operation.target_start_index, copy_operation.length);
+    }
+  };
+
+  const auto column_count = _target_table->column_count();
+
+  // Scheduling jobs does not pay off for small inserts, e.g., INSERT INTO ... VALUES
+  if (total_rows_to_insert < MIN_ROWS_FOR_PARALLEL_COPY) {
+    for (auto target_chunk_id = start_chunk_id; target_chunk_id <= start_chunk_id + total_chunks_inserted;
+         ++target_chunk_id) {
+      for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+        copy_segment(target_chunk_id, column_id);
+      }
+    }
+    return nullptr;
+  }
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve((total_chunks_inserted + 1) * column_count);
+
+  for (auto target_chunk_id = start_chunk_id; target_chunk_id <= start_chunk_id + total_chunks_inserted;
+       ++target_chunk_id) {
+    if (copy_operations_by_target_chunk[target_chunk_id - start_chunk_id].empty()) continue;
+
+    for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+      jobs.emplace_back(std::make_shared<JobTask>([&, target_chunk_id, column_id]() {
+        copy_segment(target_chunk_id, column_id);
+      }));
+      jobs.back()->schedule();
+    }
+  }
+
+  CurrentScheduler::wait_for_tasks(jobs);
+
   return nullptr;
 }
 
@@ -223,6 +301,11 @@ void Insert::_on_commit_records(const CommitID cid) {
     mvcc_data->begin_cids[row_id.chunk_offset] = cid;
     mvcc_data->tids[row_id.chunk_offset] = 0u;
   }
+
+  if (Logger::get().is_enabled()) {
+    Logger::get().log_insert(transaction_context()->transaction_id(), _target_table_name, *_target_table,
+                             _inserted_rows);
+  }
 }
 
 void Insert::_on_rollback_records() {
@@ -230,6 +313,7 @@ void Insert::_on_rollback_records() {
     auto chunk = _target_table->get_chunk(row_id.chunk_id);
     // We set the begin and end cids to 0 (effectively making it invisible for everyone) so that the ChunkCompression
     // does not think that this row is still incomplete. We need to make sure that the end is written before the begin.
+    chunk->get_scoped_mvcc_data_lock()->register_invalidation();
     chunk->get_scoped_mvcc_data_lock()->end_cids[row_id.chunk_offset] = 0u;
     std::atomic_thread_fence(std::memory_order_release);
     chunk->get_scoped_mvcc_data_lock()->begin_cids[row_id.chunk_offset] = 0u;
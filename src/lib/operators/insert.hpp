@@ -16,6 +16,9 @@ class TransactionContext;
  * Expects the table name of the table to insert into as a string and
  * the values to insert in a separate table using the same column layout.
  *
+ * The input rows are copied segment-wise. For large inputs, every target chunk and column is filled by its own job
+ * once the space for all rows has been reserved.
+ *
  * Assumption: The input has been validated before.
  * Note: Insert does not support null values at the moment
  */
@@ -35,6 +38,9 @@ class Insert : public AbstractReadWriteOperator {
   void _on_rollback_records() override;
 
  private:
+  // Inserts with fewer rows copy their values without scheduling jobs
+  static constexpr auto MIN_ROWS_FOR_PARALLEL_COPY = 10'000u;
+
   const std::string _target_table_name;
   std::shared_ptr<Table> _target_table;
 
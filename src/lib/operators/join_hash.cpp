@@ -1,8 +1,11 @@
 #include "join_hash.hpp"
 
 #include <boost/lexical_cast.hpp>
-#include <boost/variant.hpp>
 
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <memory>
 #include <numeric>
@@ -12,7 +15,9 @@
 #include <utility>
 #include <vector>
 
+#include "join_hash/blocked_bloom_filter.hpp"
 #include "join_hash/hash_traits.hpp"
+#include "join_hash/join_hash_table.hpp"
 #include "resolve_type.hpp"
 #include "scheduler/abstract_task.hpp"
 #include "scheduler/current_scheduler.hpp"
@@ -30,18 +35,48 @@ namespace opossum {
 JoinHash::JoinHash(const std::shared_ptr<const AbstractOperator>& left,
                    const std::shared_ptr<const AbstractOperator>& right, const JoinMode mode,
                    const ColumnIDPair& column_ids, const PredicateCondition predicate_condition,
-                   const size_t radix_bits)
-    : AbstractJoinOperator(OperatorType::JoinHash, left, right, mode, column_ids, predicate_condition),
+                   const std::vector<OperatorJoinPredicate>& secondary_predicates,
+                   const std::optional<size_t>& radix_bits)
+    : AbstractJoinOperator(OperatorType::JoinHash, left, right, mode, column_ids, predicate_condition,
+                           std::make_unique<JoinHash::PerformanceData>()),
+      _secondary_predicates(secondary_predicates),
       _radix_bits(radix_bits) {
   DebugAssert(predicate_condition == PredicateCondition::Equals, "Operator not supported by Hash Join.");
+  for (const auto& secondary_predicate : _secondary_predicates) {
+    Assert(secondary_predicate.predicate_condition == PredicateCondition::Equals,
+           "Hash Join only supports secondary equi-predicates.");
+  }
 }
 
 const std::string JoinHash::name() const { return "JoinHash"; }
 
+const std::string JoinHash::description(DescriptionMode description_mode) const {
+  auto description = AbstractJoinOperator::description(description_mode);
+  if (_secondary_predicates.empty()) return description;
+
+  // Insert the secondary predicates before the closing parenthesis of the primary predicate
+  description.pop_back();
+  for (const auto& secondary_predicate : _secondary_predicates) {
+    auto column_name_left = std::string("Column #") + std::to_string(secondary_predicate.column_ids.first);
+    auto column_name_right = std::string("Column #") + std::to_string(secondary_predicate.column_ids.second);
+
+    if (input_table_left()) column_name_left = input_table_left()->column_name(secondary_predicate.column_ids.first);
+    if (input_table_right()) {
+      column_name_right = input_table_right()->column_name(secondary_predicate.column_ids.second);
+    }
+
+    description += " AND " + column_name_left + " = " + column_name_right;
+  }
+  return description + ")";
+}
+
+const std::vector<OperatorJoinPredicate>& JoinHash::secondary_predicates() const { return _secondary_predicates; }
+
 std::shared_ptr<AbstractOperator> JoinHash::_on_deep_copy(
     const std::shared_ptr<AbstractOperator>& copied_input_left,
     const std::shared_ptr<AbstractOperator>& copied_input_right) const {
-  return std::make_shared<JoinHash>(copied_input_left, copied_input_right, _mode, _column_ids, _predicate_condition);
+  return std::make_shared<JoinHash>(copied_input_left, copied_input_right, _mode, _column_ids, _predicate_condition,
+                                    _secondary_predicates, _radix_bits);
 }
 
 void JoinHash::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {}
@@ -77,20 +112,100 @@ std::shared_ptr<const Table> JoinHash::_on_execute() {
 
   auto adjusted_column_ids = std::make_pair(build_column_id, probe_column_id);
 
+  auto adjusted_secondary_column_ids = std::vector<ColumnIDPair>{};
+  adjusted_secondary_column_ids.reserve(_secondary_predicates.size());
+  for (const auto& secondary_predicate : _secondary_predicates) {
+    const auto& column_ids = secondary_predicate.column_ids;
+    adjusted_secondary_column_ids.emplace_back(inputs_swapped ? std::make_pair(column_ids.second, column_ids.first)
+                                                              : column_ids);
+  }
+
   auto build_input = build_operator->get_output();
   auto probe_input = probe_operator->get_output();
 
   _impl = make_unique_by_data_types<AbstractReadOnlyOperatorImpl, JoinHashImpl>(
       build_input->column_data_type(build_column_id), probe_input->column_data_type(probe_column_id), build_operator,
-      probe_operator, _mode, adjusted_column_ids, _predicate_condition, inputs_swapped, _radix_bits);
+      probe_operator, _mode, adjusted_column_ids, _predicate_condition, adjusted_secondary_column_ids, inputs_swapped,
+      _radix_bits, static_cast<PerformanceData&>(*_performance_data));
   return _impl->_on_execute();
 }
 
 void JoinHash::_on_cleanup() { _impl.reset(); }
 
+std::string JoinHash::PerformanceData::to_string(DescriptionMode description_mode) const {
+  std::string string = OperatorPerformanceData::to_string(description_mode);
+  string += (description_mode == DescriptionMode::SingleLine ? " / " : "\\n");
+  string += std::to_string(probe_rows_filtered) + " of " + std::to_string(probe_row_count) +
+            " probe rows dropped by Bloom filter";
+  return string;
+}
+
 // currently using 32bit Murmur
 using Hash = uint32_t;
 
+/*
+The fan-out of a single radix partitioning pass is limited: Each partition that is written to concurrently needs its
+own TLB entry and a cache line to write to. With more partitions than TLB entries, partitioning thrashes the TLB.
+If more radix bits are requested, the inputs are partitioned in multiple passes.
+*/
+constexpr size_t MAX_RADIX_BITS_PER_PASS = 8;
+
+/*
+Returns the size of the L2 cache in bytes. Falls back to 256 KB if the operating system does not report it.
+*/
+size_t l2_cache_size() {
+  constexpr auto default_l2_cache_size = size_t{256'000};
+
+#ifdef _SC_LEVEL2_CACHE_SIZE
+  const auto reported_l2_cache_size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+  if (reported_l2_cache_size > 0) {
+    return static_cast<size_t>(reported_l2_cache_size);
+  }
+#endif
+
+  return default_l2_cache_size;
+}
+
+/*
+Returns the size of the last level cache in bytes. Falls back to the size of the L2 cache if the operating system
+does not report an L3 cache.
+*/
+size_t last_level_cache_size() {
+#ifdef _SC_LEVEL3_CACHE_SIZE
+  const auto reported_l3_cache_size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+  if (reported_l3_cache_size > 0) {
+    return static_cast<size_t>(reported_l3_cache_size);
+  }
+#endif
+
+  return l2_cache_size();
+}
+
+/*
+The Bloom filter uses BlockedBloomFilter::BITS_PER_ELEMENT bits per build row. For larger build relations, the filter
+would not fit into the last level cache, so that probing it would miss the cache as often as probing the hash table
+and cost more than it saves.
+*/
+size_t max_bloom_filter_element_count() {
+  static const auto max_element_count = last_level_cache_size() * 8 / BlockedBloomFilter::BITS_PER_ELEMENT;
+  return max_element_count;
+}
+
+/*
+Distributes radix_bits over as few passes as possible, so that no pass uses more than MAX_RADIX_BITS_PER_PASS bits.
+The bits are spread evenly, e.g., 10 bits are partitioned in two passes with 5 bits each.
+*/
+std::vector<size_t> radix_bits_per_pass(const size_t radix_bits) {
+  const auto pass_count = std::max(size_t{1}, (radix_bits + MAX_RADIX_BITS_PER_PASS - 1) / MAX_RADIX_BITS_PER_PASS);
+
+  auto bits_per_pass = std::vector<size_t>(pass_count, radix_bits / pass_count);
+  for (auto pass = size_t{0}; pass < radix_bits % pass_count; ++pass) {
+    ++bits_per_pass[pass];
+  }
+
+  return bits_per_pass;
+}
+
 /*
 This is how elements of the input relations are saved after materialization.
 The original value is used to detect hash collisions.
@@ -109,7 +224,7 @@ template <typename T>
 using Partition = std::vector<PartitionedElement<T>>;
 
 template <typename T>
-using HashTable = std::unordered_map<T, boost::variant<RowID, PosList>>;
+using HashTable = JoinHashTable<T>;
 
 /*
 This struct contains radix-partitioned data in a contiguous buffer,
@@ -121,6 +236,22 @@ struct RadixContainer {
   std::vector<size_t> partition_offsets;
 };
 
+/*
+Casts the given value into the HashedType that is defined by the current Hash Traits.
+Only performs a (potentially lexical) cast if the types differ.
+*/
+template <typename OriginalType, typename HashedType>
+HashedType to_hashed_type(const OriginalType& value) {
+  // clang-format off
+  // doesn't deal with constexpr nicely
+  if constexpr(!std::is_same_v<OriginalType, HashedType>) {
+    return type_cast<HashedType>(value);
+  } else {
+    return value;
+  }
+  // clang-format on
+}
+
 /*
 Build all the hash tables for the partitions of Left. We parallelize this process for all partitions of Left
 */
@@ -151,29 +282,21 @@ std::vector<std::optional<HashTable<HashedType>>> build(const RadixContainer<Lef
                                                  partition_size]() {
       auto& partition_left = static_cast<Partition<LeftType>&>(*radix_container.elements);
 
-      // Potentially oversizing the hash table when values are often repeated.
-      // But rather have slightly too large hash tables than paying for complete rehashing/resizing.
       auto hashtable = HashTable<HashedType>(partition_size);
 
       for (size_t partition_offset = partition_left_begin; partition_offset < partition_left_end; ++partition_offset) {
         const auto& element = partition_left[partition_offset];
 
-        const auto hash_key = type_cast<HashedType>(element.value);
-        const auto it = hashtable.find(hash_key);
-        if (it == hashtable.end()) {
-          // key is not present: add value and row ID
-          hashtable[hash_key] = element.row_id;
-        } else {
-          auto& map_entry = it->second;
-          if (map_entry.type() == typeid(RowID)) {
-            // Previously, there was only one row id stored for this value. Convert the entry to a multi-row-id one.
-            hashtable[hash_key] = PosList{boost::get<RowID>(map_entry), element.row_id};
-          } else {
-            boost::get<PosList>(map_entry).push_back(element.row_id);
-          }
+        if (element.row_id.chunk_offset == INVALID_CHUNK_OFFSET) {
+          continue;
         }
+
+        // The partition hash was computed on the HashedType, so it can be reused for the hash table
+        hashtable.insert(to_hashed_type<LeftType, HashedType>(element.value), element.partition_hash,
+                         element.row_id);
       }
 
+      hashtable.finalize();
       hashtables[current_partition_id] = std::move(hashtable);
     }));
     jobs.back()->schedule();
@@ -200,21 +323,162 @@ constexpr Hash hash_value(const OriginalType& value, const unsigned int seed) {
   // clang-format on
 }
 
+/*
+Combines the hash of a further key column into the hash of a multi-column key (same scheme as boost::hash_combine).
+*/
+Hash combine_hashes(const Hash hash, const Hash value_hash) {
+  return hash ^ (value_hash + 0x9e3779b9u + (hash << 6) + (hash >> 2));
+}
+
+/*
+For joins with secondary predicates, this holds, for every row of one input relation, the combined hash of all
+secondary key columns and whether any of them is NULL. Both are indexed by the RowIDs that are stored in the
+PartitionedElements, i.e., by the chunk id and the offset within the chunk of the input relation.
+*/
+struct SecondaryKeyHashes {
+  explicit SecondaryKeyHashes(const Table& table) : hashes(table.chunk_count()), nulls(table.chunk_count()) {
+    for (ChunkID chunk_id{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      hashes[chunk_id].resize(table.get_chunk(chunk_id)->size());
+      nulls[chunk_id].resize(table.get_chunk(chunk_id)->size());
+    }
+  }
+
+  std::vector<std::vector<Hash>> hashes;
+  std::vector<std::vector<bool>> nulls;
+};
+
+/*
+One secondary key column pair of a multi-column join. The values of both columns are materialized chunk by chunk as
+the HashedType of the pair, so that candidate matches can be compared without any casts during the probe phase.
+*/
+class BaseSecondaryColumnPair {
+ public:
+  virtual ~BaseSecondaryColumnPair() = default;
+
+  // Materializes both columns and combines the hashes of their values into the key hashes of the respective rows
+  virtual void materialize(SecondaryKeyHashes& build_key_hashes, SecondaryKeyHashes& probe_key_hashes,
+                           const unsigned int seed) = 0;
+
+  // NULL values are never equal to any other value
+  virtual bool equals(const RowID& build_row_id, const RowID& probe_row_id) const = 0;
+};
+
+template <typename BuildType, typename ProbeType>
+class SecondaryColumnPair : public BaseSecondaryColumnPair {
+ public:
+  using HashedType = typename JoinHashTraits<BuildType, ProbeType>::HashType;
+
+  SecondaryColumnPair(const std::shared_ptr<const Table>& build_table, const ColumnID build_column_id,
+                      const std::shared_ptr<const Table>& probe_table, const ColumnID probe_column_id)
+      : _build_table(build_table),
+        _probe_table(probe_table),
+        _build_column_id(build_column_id),
+        _probe_column_id(probe_column_id) {}
+
+  void materialize(SecondaryKeyHashes& build_key_hashes, SecondaryKeyHashes& probe_key_hashes,
+                   const unsigned int seed) override {
+    _build_values.resize(_build_table->chunk_count());
+    _probe_values.resize(_probe_table->chunk_count());
+
+    std::vector<std::shared_ptr<AbstractTask>> jobs;
+    jobs.reserve(_build_table->chunk_count() + _probe_table->chunk_count());
+
+    for (ChunkID chunk_id{0}; chunk_id < _build_table->chunk_count(); ++chunk_id) {
+      jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+        _materialize_chunk<BuildType>(*_build_table, _build_column_id, chunk_id, _build_values[chunk_id],
+                                      build_key_hashes, seed);
+      }));
+      jobs.back()->schedule();
+    }
+
+    for (ChunkID chunk_id{0}; chunk_id < _probe_table->chunk_count(); ++chunk_id) {
+      jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+        _materialize_chunk<ProbeType>(*_probe_table, _probe_column_id, chunk_id, _probe_values[chunk_id],
+                                      probe_key_hashes, seed);
+      }));
+      jobs.back()->schedule();
+    }
+
+    CurrentScheduler::wait_for_tasks(jobs);
+  }
+
+  bool equals(const RowID& build_row_id, const RowID& probe_row_id) const override {
+    const auto& build_value = _build_values[build_row_id.chunk_id][build_row_id.chunk_offset];
+    const auto& probe_value = _probe_values[probe_row_id.chunk_id][probe_row_id.chunk_offset];
+    return build_value && probe_value && *build_value == *probe_value;
+  }
+
+ protected:
+  template <typename T>
+  static void _materialize_chunk(const Table& table, const ColumnID column_id, const ChunkID chunk_id,
+                                 std::vector<std::optional<HashedType>>& values, SecondaryKeyHashes& key_hashes,
+                                 const unsigned int seed) {
+    const auto segment = table.get_chunk(chunk_id)->get_segment(column_id);
+    auto& hashes = key_hashes.hashes[chunk_id];
+    auto& nulls = key_hashes.nulls[chunk_id];
+
+    values.resize(segment->size());
+
+    resolve_segment_type<T>(*segment, [&](auto& typed_segment) {
+      create_iterable_from_segment<T>(typed_segment).for_each([&](const auto& value) {
+        // For ReferenceSegments, this is the offset within the ReferenceSegment, just as in materialize_input
+        const auto chunk_offset = value.chunk_offset();
+
+        if (value.is_null()) {
+          nulls[chunk_offset] = true;
+        } else {
+          const auto hashed_value = to_hashed_type<T, HashedType>(value.value());
+          hashes[chunk_offset] = combine_hashes(hashes[chunk_offset], murmur2<HashedType>(hashed_value, seed));
+          values[chunk_offset] = hashed_value;
+        }
+      });
+    });
+  }
+
+  const std::shared_ptr<const Table> _build_table, _probe_table;
+  const ColumnID _build_column_id, _probe_column_id;
+
+  std::vector<std::vector<std::optional<HashedType>>> _build_values;
+  std::vector<std::vector<std::optional<HashedType>>> _probe_values;
+};
+
+using SecondaryColumnPairs = std::vector<std::unique_ptr<BaseSecondaryColumnPair>>;
+
+// Returns true if all secondary key columns of the two rows are equal
+bool secondary_keys_equal(const SecondaryColumnPairs& secondary_column_pairs, const RowID& build_row_id,
+                          const RowID& probe_row_id) {
+  for (const auto& secondary_column_pair : secondary_column_pairs) {
+    if (!secondary_column_pair->equals(build_row_id, probe_row_id)) return false;
+  }
+  return true;
+}
+
+/*
+Materializes the join column of in_table and computes the histograms for the first radix partitioning pass.
+If bloom_filter_to_fill is given, the hashes of all materialized values are added to it (build side). If
+bloom_filter_to_check is given, values whose hash is not contained in it are dropped (probe side) and counted in
+filtered_row_count. Filtering must not be used when keep_nulls is set, because outer joins need all probe rows.
+For multi-column joins, secondary_key_hashes holds the hashes of the secondary key columns, which are combined with
+the hash of the join column. Rows with a NULL value in any key column are treated like rows with a NULL join value.
+*/
 template <typename T, typename HashedType>
 std::shared_ptr<Partition<T>> materialize_input(const std::shared_ptr<const Table>& in_table, ColumnID column_id,
                                                 std::vector<std::shared_ptr<std::vector<size_t>>>& histograms,
                                                 const size_t radix_bits, const unsigned int partitioning_seed,
-                                                bool keep_nulls = false) {
+                                                bool keep_nulls = false,
+                                                const SecondaryKeyHashes* secondary_key_hashes = nullptr,
+                                                BlockedBloomFilter* bloom_filter_to_fill = nullptr,
+                                                const BlockedBloomFilter* bloom_filter_to_check = nullptr,
+                                                std::atomic<size_t>* filtered_row_count = nullptr) {
+  DebugAssert(!keep_nulls || !bloom_filter_to_check, "Cannot drop rows that have to be kept");
+
   // list of all elements that will be partitioned
   auto elements = std::make_shared<Partition<T>>();
   elements->resize(in_table->row_count());
 
-  // fan-out
+  // fan-out of the first partitioning pass
   const size_t num_partitions = 1ull << radix_bits;
-
-  // currently, we just do one pass
-  size_t pass = 0;
-  size_t mask = static_cast<uint32_t>(pow(2, radix_bits * (pass + 1)) - 1);
+  const Hash mask = static_cast<Hash>(num_partitions - 1);
 
   auto chunk_offsets = std::vector<size_t>(in_table->chunk_count());
 
@@ -245,29 +509,45 @@ std::shared_ptr<Partition<T>> materialize_input(const std::shared_ptr<const Tabl
       histograms[chunk_id] = std::make_shared<std::vector<size_t>>(num_partitions);
       auto& histogram = static_cast<std::vector<size_t>&>(*histograms[chunk_id]);
 
+      auto chunk_filtered_row_count = size_t{0};
+
       resolve_segment_type<T>(*segment, [&, chunk_id, keep_nulls](auto& typed_segment) {
         auto reference_chunk_offset = ChunkOffset{0};
         auto iterable = create_iterable_from_segment<T>(typed_segment);
 
         iterable.for_each([&, chunk_id, keep_nulls](const auto& value) {
-          if (!value.is_null() || keep_nulls) {
-            const Hash hashed_value = hash_value<T, HashedType>(value.value(), partitioning_seed);
-
-            /*
-            For ReferenceSegments we do not use the RowIDs from the referenced tables.
-            Instead, we use the index in the ReferenceSegment itself. This way we can later correctly dereference
-            values from different inputs (important for Multi Joins).
-            */
-            if constexpr (std::is_same<std::decay<decltype(typed_segment)>, ReferenceSegment>::value) {
-              *(output_iterator++) =
-                  PartitionedElement<T>{RowID{chunk_id, reference_chunk_offset}, hashed_value, value.value()};
-            } else {
-              *(output_iterator++) =
-                  PartitionedElement<T>{RowID{chunk_id, value.chunk_offset()}, hashed_value, value.value()};
+          const auto has_null_secondary_key =
+              secondary_key_hashes && secondary_key_hashes->nulls[chunk_id][value.chunk_offset()];
+
+          if ((!value.is_null() && !has_null_secondary_key) || keep_nulls) {
+            Hash hashed_value = hash_value<T, HashedType>(value.value(), partitioning_seed);
+            if (secondary_key_hashes) {
+              const auto& secondary_hashes = secondary_key_hashes->hashes[chunk_id];
+              hashed_value = combine_hashes(hashed_value, secondary_hashes[value.chunk_offset()]);
             }
 
-            const Hash radix = hashed_value & mask;
-            histogram[radix]++;
+            if (bloom_filter_to_check && !bloom_filter_to_check->may_contain(hashed_value)) {
+              // There is no join partner for this value, so it is neither materialized nor partitioned
+              ++chunk_filtered_row_count;
+            } else {
+              if (bloom_filter_to_fill) bloom_filter_to_fill->insert(hashed_value);
+
+              /*
+              For ReferenceSegments we do not use the RowIDs from the referenced tables.
+              Instead, we use the index in the ReferenceSegment itself. This way we can later correctly dereference
+              values from different inputs (important for Multi Joins).
+              */
+              if constexpr (std::is_same<std::decay<decltype(typed_segment)>, ReferenceSegment>::value) {
+                *(output_iterator++) =
+                    PartitionedElement<T>{RowID{chunk_id, reference_chunk_offset}, hashed_value, value.value()};
+              } else {
+                *(output_iterator++) =
+                    PartitionedElement<T>{RowID{chunk_id, value.chunk_offset()}, hashed_value, value.value()};
+              }
+
+              const Hash radix = hashed_value & mask;
+              histogram[radix]++;
+            }
           }
           // reference_chunk_offset is only used for ReferenceSegments
           if constexpr (std::is_same<std::decay<decltype(typed_segment)>, ReferenceSegment>::value) {
@@ -275,6 +555,8 @@ std::shared_ptr<Partition<T>> materialize_input(const std::shared_ptr<const Tabl
           }
         });
       });
+
+      if (filtered_row_count) *filtered_row_count += chunk_filtered_row_count;
     }));
     jobs.back()->schedule();
   }
@@ -289,12 +571,9 @@ RadixContainer<T> partition_radix_parallel(const std::shared_ptr<Partition<T>>&
                                            const std::shared_ptr<std::vector<size_t>>& chunk_offsets,
                                            std::vector<std::shared_ptr<std::vector<size_t>>>& histograms,
                                            const size_t radix_bits, bool keep_nulls = false) {
-  // fan-out
+  // fan-out of the first partitioning pass, which uses the histograms created during materialization
   const size_t num_partitions = 1ull << radix_bits;
-
-  // currently, we just do one pass
-  size_t pass = 0;
-  size_t mask = static_cast<uint32_t>(pow(2, radix_bits * (pass + 1)) - 1);
+  const Hash mask = static_cast<Hash>(num_partitions - 1);
 
   // allocate new (shared) output
   auto output = std::make_shared<Partition<T>>();
@@ -354,6 +633,62 @@ RadixContainer<T> partition_radix_parallel(const std::shared_ptr<Partition<T>>&
   return radix_output;
 }
 
+/*
+Subsequent partitioning pass: Every partition of the previous passes is split into 2^pass_radix_bits partitions,
+using the next pass_radix_bits bits of the partition hash that was stored during materialization. As each input
+partition is processed independently, the passes after the first one are parallelized over partitions.
+Partition p of the previous passes becomes the partitions (p << pass_radix_bits) to ((p + 1) << pass_radix_bits) - 1.
+*/
+template <typename T>
+RadixContainer<T> partition_radix_pass(const RadixContainer<T>& input, const size_t previous_radix_bits,
+                                       const size_t pass_radix_bits) {
+  const auto input_partition_count = input.partition_offsets.size() - 1;
+  const size_t fan_out = 1ull << pass_radix_bits;
+  const Hash mask = static_cast<Hash>(fan_out - 1);
+
+  RadixContainer<T> radix_output;
+  radix_output.elements = std::make_shared<Partition<T>>(input.elements->size());
+  radix_output.partition_offsets.resize(input_partition_count * fan_out + 1);
+  radix_output.partition_offsets.back() = input.partition_offsets.back();
+
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(input_partition_count);
+
+  for (size_t input_partition_id = 0; input_partition_id < input_partition_count; ++input_partition_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, input_partition_id]() {
+      const auto partition_begin = input.partition_offsets[input_partition_id];
+      const auto partition_end = input.partition_offsets[input_partition_id + 1];
+
+      const auto& in = static_cast<const Partition<T>&>(*input.elements);
+      auto& out = static_cast<Partition<T>&>(*radix_output.elements);
+
+      // Each input partition is written to the same range in the output, so the histogram is local to this job
+      auto histogram = std::vector<size_t>(fan_out);
+      for (auto element_id = partition_begin; element_id < partition_end; ++element_id) {
+        ++histogram[(in[element_id].partition_hash >> previous_radix_bits) & mask];
+      }
+
+      auto output_offsets = std::vector<size_t>(fan_out);
+      auto offset = partition_begin;
+      for (size_t sub_partition_id = 0; sub_partition_id < fan_out; ++sub_partition_id) {
+        radix_output.partition_offsets[input_partition_id * fan_out + sub_partition_id] = offset;
+        output_offsets[sub_partition_id] = offset;
+        offset += histogram[sub_partition_id];
+      }
+
+      for (auto element_id = partition_begin; element_id < partition_end; ++element_id) {
+        const auto& element = in[element_id];
+        out[output_offsets[(element.partition_hash >> previous_radix_bits) & mask]++] = element;
+      }
+    }));
+    jobs.back()->schedule();
+  }
+
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  return radix_output;
+}
+
 /*
   In the probe phase we take all partitions from the right partition, iterate over them and compare each join candidate
   with the values in the hash table. Since Left and Right are hashed using the same hash function, we can reduce the
@@ -362,7 +697,8 @@ RadixContainer<T> partition_radix_parallel(const std::shared_ptr<Partition<T>>&
 template <typename RightType, typename HashedType>
 void probe(const RadixContainer<RightType>& radix_container,
            const std::vector<std::optional<HashTable<HashedType>>>& hashtables, std::vector<PosList>& pos_lists_left,
-           std::vector<PosList>& pos_lists_right, const JoinMode mode) {
+           std::vector<PosList>& pos_lists_right, const JoinMode mode,
+           const SecondaryColumnPairs& secondary_column_pairs) {
   std::vector<std::shared_ptr<AbstractTask>> jobs;
   jobs.reserve(radix_container.partition_offsets.size() - 1);
 
@@ -406,30 +742,25 @@ void probe(const RadixContainer<RightType>& radix_container,
             continue;
           }
 
-          const auto& rows_iter = hashtable.find(type_cast<HashedType>(row.value));
-
-          if (rows_iter != hashtable.end()) {
-            // Key exists, thus we have at least one hit
-            const auto& matching_rows_variant = rows_iter->second;
-            if (matching_rows_variant.type() == typeid(PosList)) {
-              // Multiple matches, stored in one PosList
-              for (const auto row_id : boost::get<PosList>(matching_rows_variant)) {
-                if (row_id.chunk_offset != INVALID_CHUNK_OFFSET) {
-                  pos_list_left_local.emplace_back(row_id);
-                  pos_list_right_local.emplace_back(row.row_id);
-                }
-              }
-            } else {
-              // A single RowID
-              const auto row_id = boost::get<RowID>(matching_rows_variant);
-              if (row_id.chunk_offset != INVALID_CHUNK_OFFSET) {
-                pos_list_left_local.emplace_back(row_id);
-                pos_list_right_local.emplace_back(row.row_id);
-              }
+          const auto [matching_rows_begin, matching_rows_end] =
+              hashtable.find(to_hashed_type<RightType, HashedType>(row.value), row.partition_hash);
+
+          auto has_match = false;
+          for (auto matching_row = matching_rows_begin; matching_row != matching_rows_end; ++matching_row) {
+            // The hash table only compares the join column, the secondary key columns are compared here
+            if (!secondary_column_pairs.empty() &&
+                !secondary_keys_equal(secondary_column_pairs, *matching_row, row.row_id)) {
+              continue;
             }
-            // We assume that the relations have been swapped previously,
-            // so that the outer relation is the probing relation.
-          } else if (mode == JoinMode::Left || mode == JoinMode::Right) {
+
+            pos_list_left_local.emplace_back(*matching_row);
+            pos_list_right_local.emplace_back(row.row_id);
+            has_match = true;
+          }
+
+          // We assume that the relations have been swapped previously,
+          // so that the outer relation is the probing relation.
+          if (!has_match && (mode == JoinMode::Left || mode == JoinMode::Right)) {
             pos_list_left_local.emplace_back(NULL_ROW_ID);
             pos_list_right_local.emplace_back(row.row_id);
           }
@@ -468,7 +799,8 @@ void probe(const RadixContainer<RightType>& radix_container,
 template <typename RightType, typename HashedType>
 void probe_semi_anti(const RadixContainer<RightType>& radix_container,
                      const std::vector<std::optional<HashTable<HashedType>>>& hashtables,
-                     std::vector<PosList>& pos_lists, const JoinMode mode) {
+                     std::vector<PosList>& pos_lists, const JoinMode mode,
+                     const SecondaryColumnPairs& secondary_column_pairs) {
   std::vector<std::shared_ptr<AbstractTask>> jobs;
   jobs.reserve(radix_container.partition_offsets.size() - 1);
 
@@ -499,9 +831,18 @@ void probe_semi_anti(const RadixContainer<RightType>& radix_container,
           }
 
           const auto& hashtable = hashtables[current_partition_id].value();
-          const auto it = hashtable.find(type_cast<HashedType>(row.value));
+          auto has_match = false;
+          if (secondary_column_pairs.empty()) {
+            has_match = hashtable.contains(to_hashed_type<RightType, HashedType>(row.value), row.partition_hash);
+          } else {
+            const auto [matching_rows_begin, matching_rows_end] =
+                hashtable.find(to_hashed_type<RightType, HashedType>(row.value), row.partition_hash);
+            has_match = std::any_of(matching_rows_begin, matching_rows_end, [&](const auto& matching_row) {
+              return secondary_keys_equal(secondary_column_pairs, matching_row, row.row_id);
+            });
+          }
 
-          if ((mode == JoinMode::Semi && it != hashtable.end()) || (mode == JoinMode::Anti && it == hashtable.end())) {
+          if ((mode == JoinMode::Semi && has_match) || (mode == JoinMode::Anti && !has_match)) {
             // Semi: found at least one match for this row -> match
             // Anti: no matching rows found -> match
             pos_list_local.emplace_back(row.row_id);
@@ -616,20 +957,21 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
  public:
   JoinHashImpl(const std::shared_ptr<const AbstractOperator>& left,
                const std::shared_ptr<const AbstractOperator>& right, const JoinMode mode,
-               const ColumnIDPair& column_ids, const PredicateCondition predicate_condition, const bool inputs_swapped,
-               const size_t radix_bits)
+               const ColumnIDPair& column_ids, const PredicateCondition predicate_condition,
+               const std::vector<ColumnIDPair>& secondary_column_ids, const bool inputs_swapped,
+               const std::optional<size_t>& radix_bits, PerformanceData& performance_data)
       : _left(left),
         _right(right),
         _mode(mode),
         _column_ids(column_ids),
         _predicate_condition(predicate_condition),
-        _inputs_swapped(inputs_swapped) {
+        _secondary_column_ids(secondary_column_ids),
+        _inputs_swapped(inputs_swapped),
+        _performance_data(performance_data) {
     /*
       Setting number of bits for radix clustering:
       The number of bits is used to create probe partitions with a size that can
-      be expected to fit into the L2 cache.
-      This should incorporate hardware knowledge, once available in Hyrise.
-      As of now, we assume a L2 cache size of 256 KB.
+      be expected to fit into the L2 cache. The L2 cache size is queried from the operating system.
       We estimate the size the following way:
         - we assume each key appears once (that is an overestimation space-wise, but we
         aim rather for a hash map that is slightly smaller than L2 than slightly larger)
@@ -650,21 +992,16 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
       PerformanceWarning(warning);
     }
 
-    const auto l2_cache_size = 256'000;  // bytes
-
-    // We assume an std::unordered_map with a linked list within the buckets.
-    // To get a pessimistic estimation (ensure that the hash table fits within the cache), we assume
-    // that each value maps to two RowIDs (thus, no single value optimizatio via boost::variant).
+    // We assume a JoinHashTable in which every value is distinct. This is pessimistic, as duplicates only add a RowID.
+    // Per row, it stores two slots (the load factor is kept at or below 0.5), the key, an offset, and the RowID.
     const auto complete_hash_map_size =
-        // hash map
-        build_relation_size * (sizeof(LeftType) + sizeof(void*)) +
-        // PosLists
-        (build_relation_size / 2) * (sizeof(PosList) + 2 * sizeof(RowID));
+        build_relation_size * (2 * 2 * sizeof(uint32_t) + sizeof(LeftType) + sizeof(size_t) + sizeof(RowID));
 
     const auto adaption_factor = 2.0f;  // don't occupy the whole L2 cache
-    const auto cluster_count = std::max(1.0f, (adaption_factor * complete_hash_map_size) / l2_cache_size);
+    const auto cluster_count = std::max(1.0f, (adaption_factor * complete_hash_map_size) / l2_cache_size());
 
-    _radix_bits = std::ceil(std::log2(cluster_count));
+    _radix_bits = radix_bits ? *radix_bits : static_cast<size_t>(std::ceil(std::log2(cluster_count)));
+    _radix_bits_per_pass = radix_bits_per_pass(_radix_bits);
   }
 
  protected:
@@ -672,12 +1009,15 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
   const JoinMode _mode;
   const ColumnIDPair _column_ids;
   const PredicateCondition _predicate_condition;
+  const std::vector<ColumnIDPair> _secondary_column_ids;
   const bool _inputs_swapped;
+  PerformanceData& _performance_data;
 
   std::shared_ptr<Table> _output_table;
 
   const unsigned int _partitioning_seed = 17;
   size_t _radix_bits;
+  std::vector<size_t> _radix_bits_per_pass;
 
   // Determine correct type for hashing
   using HashedType = typename JoinHashTraits<LeftType, RightType>::HashType;
@@ -747,12 +1087,49 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
     However, it would be a good idea to keep each materialized vector on one node if possible.
     This helps choosing a scheduler node for the radix phase (see below).
     */
+    /*
+    Semi-join reduction: For inner and semi joins, probe rows without a join partner do not contribute to the output.
+    A Bloom filter is filled while materializing the build relation and checked while materializing the probe relation,
+    so that most of these rows are dropped before they are partitioned and probed.
+    */
+    const auto use_bloom_filter = (_mode == JoinMode::Inner || _mode == JoinMode::Semi) &&
+                                  left_in_table->row_count() <= max_bloom_filter_element_count();
+    auto bloom_filter = use_bloom_filter ? std::make_unique<BlockedBloomFilter>(left_in_table->row_count()) : nullptr;
+    auto probe_rows_filtered = std::atomic<size_t>{0};
+
+    /*
+    Multi-column joins: The secondary key columns are materialized first, so that their hashes can be combined with the
+    hash of the join column during the materialization of the join column.
+    */
+    auto secondary_column_pairs = SecondaryColumnPairs{};
+    auto secondary_key_hashes_left = std::unique_ptr<SecondaryKeyHashes>{};
+    auto secondary_key_hashes_right = std::unique_ptr<SecondaryKeyHashes>{};
+
+    if (!_secondary_column_ids.empty()) {
+      secondary_key_hashes_left = std::make_unique<SecondaryKeyHashes>(*left_in_table);
+      secondary_key_hashes_right = std::make_unique<SecondaryKeyHashes>(*right_in_table);
+
+      for (const auto& [left_column_id, right_column_id] : _secondary_column_ids) {
+        secondary_column_pairs.emplace_back(
+            make_unique_by_data_types<BaseSecondaryColumnPair, SecondaryColumnPair>(
+                left_in_table->column_data_type(left_column_id), right_in_table->column_data_type(right_column_id),
+                left_in_table, left_column_id, right_in_table, right_column_id));
+        secondary_column_pairs.back()->materialize(*secondary_key_hashes_left, *secondary_key_hashes_right,
+                                                   _partitioning_seed);
+      }
+    }
+
     // Scheduler note: parallelize this at some point. Currently, the amount of jobs would be too high
-    auto materialized_left = materialize_input<LeftType, HashedType>(left_in_table, _column_ids.first, histograms_left,
-                                                                     _radix_bits, _partitioning_seed);
+    auto materialized_left = materialize_input<LeftType, HashedType>(
+        left_in_table, _column_ids.first, histograms_left, _radix_bits_per_pass.front(), _partitioning_seed, false,
+        secondary_key_hashes_left.get(), bloom_filter.get());
     // 'keep_nulls' makes sure that the relation on the right materializes NULL values when executing an OUTER join.
     auto materialized_right = materialize_input<RightType, HashedType>(
-        right_in_table, _column_ids.second, histograms_right, _radix_bits, _partitioning_seed, keep_nulls);
+        right_in_table, _column_ids.second, histograms_right, _radix_bits_per_pass.front(), _partitioning_seed,
+        keep_nulls, secondary_key_hashes_right.get(), nullptr, bloom_filter.get(), &probe_rows_filtered);
+
+    _performance_data.probe_row_count = right_in_table->row_count();
+    _performance_data.probe_rows_filtered = probe_rows_filtered;
 
     // Radix Partitioning phase
     /*
@@ -765,11 +1142,20 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
     partitions leftB and leftB should also be on the same node.
     */
     // Scheduler note: parallelize this at some point. Currently, the amount of jobs would be too high
-    auto radix_left =
-        partition_radix_parallel<LeftType>(materialized_left, left_chunk_offsets, histograms_left, _radix_bits);
+    auto radix_left = partition_radix_parallel<LeftType>(materialized_left, left_chunk_offsets, histograms_left,
+                                                         _radix_bits_per_pass.front());
     // 'keep_nulls' makes sure that the relation on the right keeps NULL values when executing an OUTER join.
     auto radix_right = partition_radix_parallel<RightType>(materialized_right, right_chunk_offsets, histograms_right,
-                                                           _radix_bits, keep_nulls);
+                                                           _radix_bits_per_pass.front(), keep_nulls);
+
+    // Further passes refine the partitions of the previous passes. Both sides use the same bits in the same order, so
+    // partition i of the left side still corresponds to partition i of the right side.
+    auto previous_radix_bits = _radix_bits_per_pass.front();
+    for (auto pass = size_t{1}; pass < _radix_bits_per_pass.size(); ++pass) {
+      radix_left = partition_radix_pass(radix_left, previous_radix_bits, _radix_bits_per_pass[pass]);
+      radix_right = partition_radix_pass(radix_right, previous_radix_bits, _radix_bits_per_pass[pass]);
+      previous_radix_bits += _radix_bits_per_pass[pass];
+    }
 
     // Build phase
     auto hashtables = build<LeftType, HashedType>(radix_left);
@@ -793,9 +1179,10 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
     leftP, rightP and hashtableP.
     */
     if (_mode == JoinMode::Semi || _mode == JoinMode::Anti) {
-      probe_semi_anti<RightType, HashedType>(radix_right, hashtables, right_pos_lists, _mode);
+      probe_semi_anti<RightType, HashedType>(radix_right, hashtables, right_pos_lists, _mode, secondary_column_pairs);
     } else {
-      probe<RightType, HashedType>(radix_right, hashtables, left_pos_lists, right_pos_lists, _mode);
+      probe<RightType, HashedType>(radix_right, hashtables, left_pos_lists, right_pos_lists, _mode,
+                                   secondary_column_pairs);
     }
 
     auto only_output_right_input = _inputs_swapped && (_mode == JoinMode::Semi || _mode == JoinMode::Anti);
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "abstract_join_operator.hpp"
+#include "operator_join_predicate.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
 
@@ -14,20 +16,42 @@ namespace opossum {
 /**
  * This operator joins two tables using one column of each table.
  * The output is a new table with referenced columns for all columns of the two inputs and filtered pos_lists.
- * If you want to filter by multiple criteria, you can chain this operator.
+ *
+ * Additional equi-predicates on further column pairs can be passed as secondary_predicates. The values of all key
+ * columns are hashed into one composite hash that is used for partitioning and for the hash tables, and all key
+ * columns are compared while probing. Thus, multi-column joins are executed in a single pass instead of joining on
+ * the first column and filtering the (potentially much larger) intermediate result afterwards.
  *
  * As with most operators, we do not guarantee a stable operation with regards to positions -
  * i.e., your sorting order might be disturbed.
  *
+ * The number of radix bits used for partitioning both inputs is derived from the size of the build relation and the
+ * size of the L2 cache, unless it is passed explicitly. If more bits are needed than can be partitioned efficiently
+ * in a single pass, the inputs are partitioned in multiple passes.
+ *
+ * For inner and semi joins, a Bloom filter over the build side is used to drop probe rows that have no join partner
+ * before they are partitioned. The number of dropped rows is reported in the PerformanceData.
+ *
  * Find more information in our Wiki: https://github.com/hyrise/hyrise/wiki/Radix-Partitioned-and-Hash-Based-Join
  */
 class JoinHash : public AbstractJoinOperator {
  public:
   JoinHash(const std::shared_ptr<const AbstractOperator>& left, const std::shared_ptr<const AbstractOperator>& right,
            const JoinMode mode, const ColumnIDPair& column_ids, const PredicateCondition predicate_condition,
-           const size_t radix_bits = 9);
+           const std::vector<OperatorJoinPredicate>& secondary_predicates = {},
+           const std::optional<size_t>& radix_bits = std::nullopt);
 
   const std::string name() const override;
+  const std::string description(DescriptionMode description_mode) const override;
+
+  const std::vector<OperatorJoinPredicate>& secondary_predicates() const;
+
+  struct PerformanceData : public OperatorPerformanceData {
+    size_t probe_row_count{0};
+    size_t probe_rows_filtered{0};
+
+    std::string to_string(DescriptionMode description_mode = DescriptionMode::SingleLine) const override;
+  };
 
  protected:
   std::shared_ptr<const Table> _on_execute() override;
@@ -38,7 +62,8 @@ class JoinHash : public AbstractJoinOperator {
   void _on_cleanup() override;
 
   std::unique_ptr<AbstractReadOnlyOperatorImpl> _impl;
-  const size_t _radix_bits;
+  const std::vector<OperatorJoinPredicate> _secondary_predicates;
+  const std::optional<size_t> _radix_bits;
 
   template <typename LeftType, typename RightType>
   class JoinHashImpl;
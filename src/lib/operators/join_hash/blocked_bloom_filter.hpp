@@ -0,0 +1,54 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace opossum {
+
+/**
+ * Register-blocked Bloom filter over 32-bit hash values, used by JoinHash to drop probe rows that cannot have a
+ * join partner before they are partitioned.
+ *
+ * Each hash value is mapped to a single 64-bit block, in which three bits are set. Thus, a lookup costs one memory
+ * access and is answered with a single comparison. Compared to a standard Bloom filter, the false positive rate is
+ * slightly higher for the same size, which we compensate by using BITS_PER_ELEMENT bits per expected element.
+ *
+ * Insertions are thread-safe, so that the filter can be filled by multiple materialization jobs at once. Lookups
+ * must not run concurrently with insertions.
+ */
+class BlockedBloomFilter {
+ public:
+  using Hash = uint32_t;
+
+  static constexpr size_t BITS_PER_ELEMENT = 16;
+
+  explicit BlockedBloomFilter(const size_t expected_element_count)
+      : _blocks(std::max(size_t{1}, (expected_element_count * BITS_PER_ELEMENT + 63) / 64)) {}
+
+  void insert(const Hash hash) { _blocks[_block_id(hash)].fetch_or(_bit_pattern(hash), std::memory_order_relaxed); }
+
+  // May return true for hashes that were never inserted, but never returns false for inserted hashes
+  bool may_contain(const Hash hash) const {
+    const auto pattern = _bit_pattern(hash);
+    return (_blocks[_block_id(hash)].load(std::memory_order_relaxed) & pattern) == pattern;
+  }
+
+  size_t size_in_bytes() const { return _blocks.size() * sizeof(uint64_t); }
+
+ protected:
+  // Maps the upper bits of the hash to a block. The lower bits are used for radix partitioning and for the pattern.
+  size_t _block_id(const Hash hash) const { return (uint64_t{hash} * _blocks.size()) >> 32; }
+
+  static uint64_t _bit_pattern(const Hash hash) {
+    const auto mixed_hash = static_cast<Hash>((hash ^ (hash >> 16)) * 0x85ebca6bu);
+    return (uint64_t{1} << (mixed_hash & 63)) | (uint64_t{1} << ((mixed_hash >> 6) & 63)) |
+           (uint64_t{1} << ((mixed_hash >> 12) & 63));
+  }
+
+  // Value-initialization of the vector zeroes the atomics
+  std::vector<std::atomic<uint64_t>> _blocks;
+};
+
+}  // namespace opossum
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "types.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+/**
+ * Hash table used by JoinHash for one radix partition of the build relation.
+ *
+ * Instead of a node-based std::unordered_map that holds either a single RowID or a PosList per key, this table keeps
+ * all of its data in a few contiguous arrays:
+ *   - _slots:   open addressing with linear probing. Each slot stores the full hash (to skip most key comparisons) and
+ *               the index of the distinct key it belongs to.
+ *   - _keys:    one entry per distinct key.
+ *   - _offsets: _offsets[key_index] to _offsets[key_index + 1] is the range of the key's RowIDs in _row_ids.
+ *   - _row_ids: the RowIDs of all inserted rows, grouped by key.
+ *
+ * The table is used in two phases: First, all rows are inserted. Then, finalize() groups the RowIDs by key. Only
+ * afterwards, find() and contains() can be called. The hash values are passed in by the caller, so that the hashes
+ * computed during radix partitioning can be reused.
+ *
+ * A key is only found if both the key and the hash match. For multi-column joins, JoinHash passes the join column as
+ * the key and the combined hash of all key columns as the hash, so that rows that only share the join column value
+ * mostly end up in different groups. The remaining key columns have to be compared by the caller.
+ */
+template <typename T>
+class JoinHashTable {
+ public:
+  using Hash = uint32_t;
+  using RowIDIterator = typename std::vector<RowID>::const_iterator;
+
+  explicit JoinHashTable(const size_t expected_row_count) {
+    // Potentially oversizing the hash table when values are often repeated.
+    // But rather have slightly too large hash tables than paying for complete rehashing/resizing.
+    _resize_slots(std::max(MIN_SLOT_COUNT, _next_power_of_two(expected_row_count * 2)));
+
+    _row_ids.reserve(expected_row_count);
+    _key_indices.reserve(expected_row_count);
+  }
+
+  void insert(const T& key, const Hash hash, const RowID& row_id) {
+    DebugAssert(!_finalized, "Cannot insert into a finalized JoinHashTable");
+
+    // Keep the load factor at or below 0.5 so that probe sequences stay short
+    if (_keys.size() * 2 >= _slots.size()) {
+      _resize_slots(_slots.size() * 2);
+    }
+
+    auto& slot = _slots[_find_slot(key, hash)];
+    if (slot.key_index == EMPTY_SLOT) {
+      DebugAssert(_keys.size() < EMPTY_SLOT, "Too many distinct keys for one JoinHashTable");
+      slot.hash = hash;
+      slot.key_index = static_cast<KeyIndex>(_keys.size());
+      _keys.emplace_back(key);
+      _offsets.emplace_back(0);
+    }
+
+    ++_offsets[slot.key_index];
+    _key_indices.emplace_back(slot.key_index);
+    _row_ids.emplace_back(row_id);
+  }
+
+  // Turns the per-key counts into offsets and groups the RowIDs of each key in a contiguous range of _row_ids
+  void finalize() {
+    DebugAssert(!_finalized, "JoinHashTable was already finalized");
+
+    // Exclusive prefix sum over the counts gathered in insert()
+    auto offset = size_t{0};
+    for (auto& count : _offsets) {
+      const auto key_count = count;
+      count = offset;
+      offset += key_count;
+    }
+    _offsets.emplace_back(offset);
+
+    // If all keys are unique (e.g., primary keys), the RowIDs are already stored in key order
+    if (_keys.size() != _row_ids.size()) {
+      auto write_offsets = std::vector<size_t>(_offsets.begin(), _offsets.end() - 1);
+      auto grouped_row_ids = std::vector<RowID>(_row_ids.size());
+
+      for (auto row_index = size_t{0}; row_index < _row_ids.size(); ++row_index) {
+        grouped_row_ids[write_offsets[_key_indices[row_index]]++] = _row_ids[row_index];
+      }
+
+      _row_ids = std::move(grouped_row_ids);
+    }
+
+    _key_indices = std::vector<KeyIndex>{};
+    _finalized = true;
+  }
+
+  // Returns the range of RowIDs whose key equals `key`. The range is empty if there is no such key.
+  std::pair<RowIDIterator, RowIDIterator> find(const T& key, const Hash hash) const {
+    DebugAssert(_finalized, "JoinHashTable has to be finalized before probing");
+
+    const auto key_index = _slots[_find_slot(key, hash)].key_index;
+    if (key_index == EMPTY_SLOT) {
+      return {_row_ids.cend(), _row_ids.cend()};
+    }
+
+    return {_row_ids.cbegin() + _offsets[key_index], _row_ids.cbegin() + _offsets[key_index + 1]};
+  }
+
+  bool contains(const T& key, const Hash hash) const {
+    return _slots[_find_slot(key, hash)].key_index != EMPTY_SLOT;
+  }
+
+  size_t row_count() const { return _row_ids.size(); }
+
+  size_t distinct_key_count() const { return _keys.size(); }
+
+ protected:
+  using KeyIndex = uint32_t;
+
+  static constexpr KeyIndex EMPTY_SLOT = std::numeric_limits<KeyIndex>::max();
+  static constexpr size_t MIN_SLOT_COUNT = 8;
+
+  struct Slot {
+    Hash hash{0};
+    KeyIndex key_index{EMPTY_SLOT};
+  };
+
+  static size_t _next_power_of_two(const size_t value) {
+    auto power = size_t{1};
+    while (power < value) power <<= 1;
+    return power;
+  }
+
+  /**
+   * Within a radix partition, the lower bits of all hashes are identical. Fibonacci hashing takes the upper bits of
+   * the product, which depend on all bits of the hash, to determine the first slot.
+   */
+  size_t _home_slot(const Hash hash) const { return static_cast<Hash>(hash * 2654435769u) >> _slot_shift; }
+
+  // Returns the slot that either contains `key` or is the empty slot where `key` would be inserted
+  size_t _find_slot(const T& key, const Hash hash) const {
+    auto slot_id = _home_slot(hash);
+    while (true) {
+      const auto& slot = _slots[slot_id];
+      if (slot.key_index == EMPTY_SLOT || (slot.hash == hash && _keys[slot.key_index] == key)) {
+        return slot_id;
+      }
+      slot_id = (slot_id + 1) & _slot_mask;
+    }
+  }
+
+  void _resize_slots(const size_t slot_count) {
+    DebugAssert(slot_count >= MIN_SLOT_COUNT && (slot_count & (slot_count - 1)) == 0,
+                "Slot count has to be a power of two");
+
+    const auto old_slots = std::move(_slots);
+
+    _slots = std::vector<Slot>(slot_count);
+    _slot_mask = slot_count - 1;
+    _slot_shift = 32;
+    for (auto remaining_slots = slot_count; remaining_slots > 1; remaining_slots >>= 1) --_slot_shift;
+
+    // Re-insert all occupied slots. As their keys are distinct, there is no need to compare keys.
+    for (const auto& old_slot : old_slots) {
+      if (old_slot.key_index == EMPTY_SLOT) continue;
+
+      auto slot_id = _home_slot(old_slot.hash);
+      while (_slots[slot_id].key_index != EMPTY_SLOT) slot_id = (slot_id + 1) & _slot_mask;
+      _slots[slot_id] = old_slot;
+    }
+  }
+
+  std::vector<Slot> _slots;
+  size_t _slot_mask{0};
+  size_t _slot_shift{0};
+
+  std::vector<T> _keys;
+  std::vector<size_t> _offsets;
+  std::vector<RowID> _row_ids;
+
+  // Only used while inserting: the key index of every inserted row, in insertion order
+  std::vector<KeyIndex> _key_indices;
+
+  bool _finalized{false};
+};
+
+}  // namespace opossum
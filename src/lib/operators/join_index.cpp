@@ -3,6 +3,7 @@
 #include <map>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <set>
 #include <string>
 #include <utility>
@@ -11,8 +12,12 @@
 #include "all_type_variant.hpp"
 #include "join_nested_loop.hpp"
 #include "resolve_type.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
 #include "storage/create_iterable_from_segment.hpp"
 #include "storage/index/base_index.hpp"
+#include "storage/reference_segment.hpp"
 #include "type_comparison.hpp"
 #include "utils/assert.hpp"
 #include "utils/performance_warning.hpp"
@@ -20,8 +25,8 @@
 namespace opossum {
 
 /*
- * This is an index join implementation. It expects to find an index on the right column.
- * It can be used for all join modes except JoinMode::Cross.
+ * This is an index join implementation. It expects to find an index on the right column, or on the referenced column
+ * if the right input is a reference table. It can be used for all join modes except JoinMode::Cross.
  * For the remaining join types or if no index is found it falls back to a nested loop join.
  */
 
@@ -78,82 +83,120 @@ void JoinIndex::_create_table_structure() {
 }
 
 void JoinIndex::_perform_join() {
-  _right_matches.resize(_right_in_table->chunk_count());
-  _left_matches.resize(_left_in_table->chunk_count());
+  const auto left_chunk_count = _left_in_table->chunk_count();
+  const auto right_chunk_count = _right_in_table->chunk_count();
+
+  _right_matches.resize(right_chunk_count);
+  _left_matches.resize(left_chunk_count);
 
   const auto track_left_matches = (_mode == JoinMode::Left || _mode == JoinMode::Outer);
   if (track_left_matches) {
-    for (ChunkID chunk_id_left = ChunkID{0}; chunk_id_left < _left_in_table->chunk_count(); ++chunk_id_left) {
+    for (ChunkID chunk_id_left = ChunkID{0}; chunk_id_left < left_chunk_count; ++chunk_id_left) {
       // initialize the data structures for left matches
       _left_matches[chunk_id_left].resize(_left_in_table->get_chunk(chunk_id_left)->size());
     }
   }
 
   const auto track_right_matches = (_mode == JoinMode::Right || _mode == JoinMode::Outer);
+  if (track_right_matches) {
+    for (ChunkID chunk_id_right = ChunkID{0}; chunk_id_right < right_chunk_count; ++chunk_id_right) {
+      _right_matches[chunk_id_right].resize(_right_in_table->get_chunk(chunk_id_right)->size());
+    }
+  }
 
-  _pos_list_left = std::make_shared<PosList>();
-  _pos_list_right = std::make_shared<PosList>();
-
-  size_t worst_case = _left_in_table->row_count() * _right_in_table->row_count();
+  auto& performance_data = static_cast<PerformanceData&>(*_performance_data);
 
-  _pos_list_left->reserve(worst_case);
-  _pos_list_right->reserve(worst_case);
+  // Find the indexes for all chunks of the right input once, as they are used by all jobs
+  auto chunk_indices_by_right_chunk = std::vector<std::optional<std::vector<ChunkIndex>>>(right_chunk_count);
+  for (ChunkID chunk_id_right = ChunkID{0}; chunk_id_right < right_chunk_count; ++chunk_id_right) {
+    chunk_indices_by_right_chunk[chunk_id_right] = _find_chunk_indices(chunk_id_right);
+    if (chunk_indices_by_right_chunk[chunk_id_right]) {
+      performance_data.chunks_scanned_with_index++;
+    } else {
+      performance_data.chunks_scanned_without_index++;
+    }
+  }
 
-  auto& performance_data = static_cast<PerformanceData&>(*_performance_data);
+  // Join each chunk of the left input with all chunks of the right input in its own job
+  auto chunk_join_results = std::vector<ChunkJoinResult>(left_chunk_count);
 
-  // Scan all chunks for right input
-  for (ChunkID chunk_id_right = ChunkID{0}; chunk_id_right < _right_in_table->chunk_count(); ++chunk_id_right) {
-    const auto chunk_right = _right_in_table->get_chunk(chunk_id_right);
-    const auto indices = chunk_right->get_indices(std::vector<ColumnID>{_right_column_id});
-    if (track_right_matches) _right_matches[chunk_id_right].resize(chunk_right->size());
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(left_chunk_count);
 
-    std::shared_ptr<BaseIndex> index = nullptr;
+  for (ChunkID chunk_id_left = ChunkID{0}; chunk_id_left < left_chunk_count; ++chunk_id_left) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id_left]() {
+      auto& result = chunk_join_results[chunk_id_left];
+      if (track_right_matches) result.right_matches.resize(right_chunk_count);
 
-    if (!indices.empty()) {
-      // We assume the first index to be efficient for our join
-      // as we do not want to spend time on evaluating the best index inside of this join loop
-      index = indices.front();
-    }
+      const auto segment_left = _left_in_table->get_chunk(chunk_id_left)->get_segment(_left_column_id);
 
-    // Scan all chunks from left input
-    if (index != nullptr) {
-      for (ChunkID chunk_id_left = ChunkID{0}; chunk_id_left < _left_in_table->chunk_count(); ++chunk_id_left) {
-        const auto segment_left = _left_in_table->get_chunk(chunk_id_left)->get_segment(_left_column_id);
+      for (ChunkID chunk_id_right = ChunkID{0}; chunk_id_right < right_chunk_count; ++chunk_id_right) {
+        const auto& chunk_indices = chunk_indices_by_right_chunk[chunk_id_right];
 
-        resolve_data_and_segment_type(*segment_left, [&](auto left_type, auto& typed_left_segment) {
-          using LeftType = typename decltype(left_type)::type;
+        if (chunk_indices) {
+          resolve_data_and_segment_type(*segment_left, [&](auto left_type, auto& typed_left_segment) {
+            using LeftType = typename decltype(left_type)::type;
 
-          auto iterable_left = create_iterable_from_segment<LeftType>(typed_left_segment);
+            auto iterable_left = create_iterable_from_segment<LeftType>(typed_left_segment);
 
-          // utilize index for join
-          iterable_left.with_iterators([&](auto left_it, auto left_end) {
-            _join_two_segments_using_index(left_it, left_end, chunk_id_left, chunk_id_right, index);
+            // utilize index for join
+            for (const auto& chunk_index : *chunk_indices) {
+              iterable_left.with_iterators([&](auto left_it, auto left_end) {
+                _join_two_segments_using_index(left_it, left_end, chunk_id_left, chunk_id_right, chunk_index, result);
+              });
+            }
           });
-        });
+        } else {
+          // Fall back to NestedLoopJoin
+          const auto segment_right = _right_in_table->get_chunk(chunk_id_right)->get_segment(_right_column_id);
+          auto& right_matches = result.right_matches.empty() ? _right_matches[chunk_id_right]
+                                                             : result.right_matches[chunk_id_right];
+          if (track_right_matches) right_matches.resize(segment_right->size());
+
+          JoinNestedLoop::JoinParams params{result.pos_list_left,
+                                            result.pos_list_right,
+                                            _left_matches[chunk_id_left],
+                                            right_matches,
+                                            track_left_matches,
+                                            track_right_matches,
+                                            _mode,
+                                            _predicate_condition};
+          JoinNestedLoop::_join_two_untyped_segments(segment_left, segment_right, chunk_id_left, chunk_id_right,
+                                                     params);
+        }
       }
-      performance_data.chunks_scanned_with_index++;
-    } else {
-      // Fall back to NestedLoopJoin
-      const auto segment_right = _right_in_table->get_chunk(chunk_id_right)->get_segment(_right_column_id);
-      for (ChunkID chunk_id_left = ChunkID{0}; chunk_id_left < _left_in_table->chunk_count(); ++chunk_id_left) {
-        const auto segment_left = _left_in_table->get_chunk(chunk_id_left)->get_segment(_left_column_id);
-        JoinNestedLoop::JoinParams params{*_pos_list_left,
-                                          *_pos_list_right,
-                                          _left_matches[chunk_id_left],
-                                          _right_matches[chunk_id_right],
-                                          track_left_matches,
-                                          track_right_matches,
-                                          _mode,
-                                          _predicate_condition};
-        JoinNestedLoop::_join_two_untyped_segments(segment_left, segment_right, chunk_id_left, chunk_id_right, params);
+    }));
+    jobs.back()->schedule();
+  }
+
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  // Concatenate the matches in the order of the left chunks and merge the right matches of all jobs
+  auto match_count = size_t{0};
+  for (const auto& result : chunk_join_results) match_count += result.pos_list_left.size();
+
+  _pos_list_left = std::make_shared<PosList>();
+  _pos_list_right = std::make_shared<PosList>();
+  _pos_list_left->reserve(match_count);
+  _pos_list_right->reserve(match_count);
+
+  for (auto& result : chunk_join_results) {
+    _pos_list_left->insert(_pos_list_left->end(), result.pos_list_left.begin(), result.pos_list_left.end());
+    _pos_list_right->insert(_pos_list_right->end(), result.pos_list_right.begin(), result.pos_list_right.end());
+
+    for (ChunkID chunk_id_right = ChunkID{0}; chunk_id_right < result.right_matches.size(); ++chunk_id_right) {
+      const auto& right_matches = result.right_matches[chunk_id_right];
+      for (ChunkOffset chunk_offset{0}; chunk_offset < right_matches.size(); ++chunk_offset) {
+        if (right_matches[chunk_offset]) _right_matches[chunk_id_right][chunk_offset] = true;
       }
-      performance_data.chunks_scanned_without_index++;
     }
+
+    result = ChunkJoinResult{};
   }
 
   // For Full Outer and Left Join we need to add all unmatched rows for the left side
   if (_mode == JoinMode::Left || _mode == JoinMode::Outer) {
-    for (ChunkID chunk_id_left = ChunkID{0}; chunk_id_left < _left_in_table->chunk_count(); ++chunk_id_left) {
+    for (ChunkID chunk_id_left = ChunkID{0}; chunk_id_left < left_chunk_count; ++chunk_id_left) {
       for (ChunkOffset chunk_offset{0}; chunk_offset < _left_matches[chunk_id_left].size(); ++chunk_offset) {
         if (!_left_matches[chunk_id_left][chunk_offset]) {
           _pos_list_left->emplace_back(RowID{chunk_id_left, chunk_offset});
@@ -175,9 +218,6 @@ void JoinIndex::_perform_join() {
     }
   }
 
-  _pos_list_left->shrink_to_fit();
-  _pos_list_right->shrink_to_fit();
-
   // write output chunks
   Segments output_segments;
 
@@ -194,10 +234,66 @@ void JoinIndex::_perform_join() {
   }
 }
 
+std::optional<std::vector<JoinIndex::ChunkIndex>> JoinIndex::_find_chunk_indices(const ChunkID chunk_id_right) const {
+  const auto chunk_right = _right_in_table->get_chunk(chunk_id_right);
+
+  if (_right_in_table->type() == TableType::Data) {
+    const auto indices = chunk_right->get_indices(std::vector<ColumnID>{_right_column_id});
+    if (indices.empty()) return std::nullopt;
+
+    // We assume the first index to be efficient for our join
+    // as we do not want to spend time on evaluating the best index inside of this join loop
+    return std::vector<ChunkIndex>{ChunkIndex{indices.front(), {}}};
+  }
+
+  // Group the referenced positions by the referenced chunks and look up the indexes of those
+  const auto reference_segment =
+      std::static_pointer_cast<const ReferenceSegment>(chunk_right->get_segment(_right_column_id));
+  const auto& referenced_table = reference_segment->referenced_table();
+  const auto referenced_column_id = reference_segment->referenced_column_id();
+  const auto& pos_list = *reference_segment->pos_list();
+
+  auto chunk_indices_by_referenced_chunk = std::map<ChunkID, ChunkIndex>{};
+
+  for (ChunkOffset chunk_offset{0}; chunk_offset < pos_list.size(); ++chunk_offset) {
+    const auto& row_id = pos_list[chunk_offset];
+
+    // NULL values never match
+    if (row_id.is_null()) continue;
+
+    auto chunk_index_iter = chunk_indices_by_referenced_chunk.find(row_id.chunk_id);
+    if (chunk_index_iter == chunk_indices_by_referenced_chunk.end()) {
+      const auto referenced_chunk = referenced_table->get_chunk(row_id.chunk_id);
+      const auto indices = referenced_chunk->get_indices(std::vector<ColumnID>{referenced_column_id});
+      if (indices.empty()) return std::nullopt;
+
+      auto chunk_index = ChunkIndex{indices.front(), std::vector<ChunkOffset>(referenced_chunk->size(),
+                                                                              INVALID_CHUNK_OFFSET)};
+      chunk_index_iter = chunk_indices_by_referenced_chunk.emplace(row_id.chunk_id, std::move(chunk_index)).first;
+    }
+
+    // A row that is referenced more than once cannot be mapped back to a single offset
+    auto& mapped_chunk_offset = chunk_index_iter->second.chunk_offsets[row_id.chunk_offset];
+    if (mapped_chunk_offset != INVALID_CHUNK_OFFSET) return std::nullopt;
+    mapped_chunk_offset = chunk_offset;
+  }
+
+  auto chunk_indices = std::vector<ChunkIndex>{};
+  chunk_indices.reserve(chunk_indices_by_referenced_chunk.size());
+  for (auto& [referenced_chunk_id, chunk_index] : chunk_indices_by_referenced_chunk) {
+    chunk_indices.emplace_back(std::move(chunk_index));
+  }
+
+  return chunk_indices;
+}
+
 // join loop that joins two segments of two columns using an iterator for the left, and an index for the right
 template <typename LeftIterator>
 void JoinIndex::_join_two_segments_using_index(LeftIterator left_it, LeftIterator left_end, const ChunkID chunk_id_left,
-                                               const ChunkID chunk_id_right, const std::shared_ptr<BaseIndex>& index) {
+                                               const ChunkID chunk_id_right, const ChunkIndex& chunk_index,
+                                               ChunkJoinResult& result) {
+  const auto& index = chunk_index.index;
+
   for (; left_it != left_end; ++left_it) {
     const auto left_value = *left_it;
     if (left_value.is_null()) continue;
@@ -216,7 +312,8 @@ void JoinIndex::_join_two_segments_using_index(LeftIterator left_it, LeftIterato
         range_begin = index->cbegin();
         range_end = index->lower_bound({left_value.value()});
 
-        _append_matches(range_begin, range_end, left_value.chunk_offset(), chunk_id_left, chunk_id_right);
+        _append_matches(range_begin, range_end, chunk_index.chunk_offsets, left_value.chunk_offset(), chunk_id_left,
+                        chunk_id_right, result);
 
         // set range for second half to all values greater than the search value
         range_begin = index->upper_bound({left_value.value()});
@@ -247,47 +344,31 @@ void JoinIndex::_join_two_segments_using_index(LeftIterator left_it, LeftIterato
         Fail("Unsupported comparison type encountered");
     }
 
-    _append_matches(range_begin, range_end, left_value.chunk_offset(), chunk_id_left, chunk_id_right);
+    _append_matches(range_begin, range_end, chunk_index.chunk_offsets, left_value.chunk_offset(), chunk_id_left,
+                    chunk_id_right, result);
   }
 }
 
-// join loop that joins two segments of two columns via their iterators
-template <typename BinaryFunctor, typename LeftIterator, typename RightIterator>
-void JoinIndex::_join_two_segments_nested_loop(const BinaryFunctor& func, LeftIterator left_it, LeftIterator left_end,
-                                               RightIterator right_begin, RightIterator right_end,
-                                               const ChunkID chunk_id_left, const ChunkID chunk_id_right) {
-  // No index so we fall back on a nested loop join
-  for (; left_it != left_end; ++left_it) {
-    const auto left_value = *left_it;
-    if (left_value.is_null()) continue;
-
-    for (auto right_it = right_begin; right_it != right_end; ++right_it) {
-      const auto right_value = *right_it;
-      if (right_value.is_null()) continue;
-
-      if (func(left_value.value(), right_value.value())) {
-        _pos_list_left->emplace_back(RowID{chunk_id_left, left_value.chunk_offset()});
-        _pos_list_right->emplace_back(RowID{chunk_id_right, right_value.chunk_offset()});
-
-        if (_mode == JoinMode::Left || _mode == JoinMode::Outer) {
-          _left_matches[chunk_id_left][left_value.chunk_offset()] = true;
-        }
-
-        if (_mode == JoinMode::Outer || _mode == JoinMode::Right) {
-          DebugAssert(chunk_id_right < _right_in_table->chunk_count(), "invalid chunk_id in join_index");
-          DebugAssert(right_value.chunk_offset() < _right_in_table->get_chunk(chunk_id_right)->size(),
-                      "invalid chunk_offset in join_index");
-          _right_matches[chunk_id_right][right_value.chunk_offset()] = true;
-        }
-      }
+void JoinIndex::_append_matches(const BaseIndex::Iterator& range_begin, const BaseIndex::Iterator& range_end,
+                                const std::vector<ChunkOffset>& chunk_offsets, const ChunkOffset chunk_offset_left,
+                                const ChunkID chunk_id_left, const ChunkID chunk_id_right, ChunkJoinResult& result) {
+  const auto pos_list_size_before = result.pos_list_right.size();
+
+  if (chunk_offsets.empty()) {
+    std::transform(range_begin, range_end, std::back_inserter(result.pos_list_right),
+                   [chunk_id_right](ChunkOffset chunk_offset_right) {
+                     return RowID{chunk_id_right, chunk_offset_right};
+                   });
+  } else {
+    // The index belongs to a referenced chunk, so only the referenced rows match
+    for (auto range_iter = range_begin; range_iter != range_end; ++range_iter) {
+      const auto chunk_offset_right = chunk_offsets[*range_iter];
+      if (chunk_offset_right == INVALID_CHUNK_OFFSET) continue;
+      result.pos_list_right.emplace_back(RowID{chunk_id_right, chunk_offset_right});
     }
   }
-}
 
-void JoinIndex::_append_matches(const BaseIndex::Iterator& range_begin, const BaseIndex::Iterator& range_end,
-                                const ChunkOffset chunk_offset_left, const ChunkID chunk_id_left,
-                                const ChunkID chunk_id_right) {
-  const auto num_right_matches = std::distance(range_begin, range_end);
+  const auto num_right_matches = result.pos_list_right.size() - pos_list_size_before;
 
   if (num_right_matches == 0) {
     return;
@@ -299,17 +380,14 @@ void JoinIndex::_append_matches(const BaseIndex::Iterator& range_begin, const Ba
   }
 
   // we replicate the left value for each right value
-  std::fill_n(std::back_inserter(*_pos_list_left), num_right_matches, RowID{chunk_id_left, chunk_offset_left});
-
-  std::transform(range_begin, range_end, std::back_inserter(*_pos_list_right),
-                 [chunk_id_right](ChunkOffset chunk_offset_right) {
-                   return RowID{chunk_id_right, chunk_offset_right};
-                 });
+  std::fill_n(std::back_inserter(result.pos_list_left), num_right_matches, RowID{chunk_id_left, chunk_offset_left});
 
   if (_mode == JoinMode::Outer || _mode == JoinMode::Right) {
-    std::for_each(range_begin, range_end, [this, chunk_id_right](ChunkOffset chunk_offset_right) {
-      _right_matches[chunk_id_right][chunk_offset_right] = true;
-    });
+    auto& right_matches = result.right_matches[chunk_id_right];
+    if (right_matches.empty()) right_matches.resize(_right_matches[chunk_id_right].size());
+
+    std::for_each(result.pos_list_right.begin() + pos_list_size_before, result.pos_list_right.end(),
+                  [&right_matches](const RowID& row_id_right) { right_matches[row_id_right.chunk_offset] = true; });
   }
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <utility>
@@ -16,8 +17,11 @@ namespace opossum {
    * A speedup compared to the Nested Loop Join is achieved by avoiding the inner loop, and instead
    * finding the right values utilizing the index.
    *
-   * Note: An index needs to be present on the right table in order to execute an index join.
+   * Note: An index needs to be present on the right table in order to execute an index join. If the right input
+   *       consists of ReferenceSegments, the indexes of the referenced chunks are used.
    * Note: Cross joins are not supported. Use the product operator instead.
+   *
+   * Each chunk of the left input is joined with all chunks of the right input in its own job.
    */
 class JoinIndex : public AbstractJoinOperator {
  public:
@@ -42,19 +46,39 @@ class JoinIndex : public AbstractJoinOperator {
       const std::shared_ptr<AbstractOperator>& copied_input_right) const override;
   void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
 
+  /**
+   * An index that can be used to join a chunk of the right input. If that chunk consists of ReferenceSegments, the
+   * index belongs to a referenced chunk and chunk_offsets maps the offsets in the referenced chunk to the offsets in
+   * the ReferenceSegment (INVALID_CHUNK_OFFSET for rows that are not referenced). For data chunks, chunk_offsets is
+   * empty.
+   */
+  struct ChunkIndex {
+    std::shared_ptr<BaseIndex> index;
+    std::vector<ChunkOffset> chunk_offsets;
+  };
+
+  // Matches of one chunk of the left input with all chunks of the right input
+  struct ChunkJoinResult {
+    PosList pos_list_left;
+    PosList pos_list_right;
+
+    // Only filled for right/outer joins, the inner vectors are resized when the first match is found
+    std::vector<std::vector<bool>> right_matches;
+  };
+
   void _perform_join();
 
+  // Returns std::nullopt if (some of) the rows of the right chunk cannot be looked up using an index
+  std::optional<std::vector<ChunkIndex>> _find_chunk_indices(const ChunkID chunk_id_right) const;
+
   template <typename LeftIterator>
   void _join_two_segments_using_index(LeftIterator left_it, LeftIterator left_end, const ChunkID chunk_id_left,
-                                      const ChunkID chunk_id_right, const std::shared_ptr<BaseIndex>& index);
-
-  template <typename BinaryFunctor, typename LeftIterator, typename RightIterator>
-  void _join_two_segments_nested_loop(const BinaryFunctor& func, LeftIterator left_it, LeftIterator left_end,
-                                      RightIterator right_begin, RightIterator right_end, const ChunkID chunk_id_left,
-                                      const ChunkID chunk_id_right);
+                                      const ChunkID chunk_id_right, const ChunkIndex& chunk_index,
+                                      ChunkJoinResult& result);
 
   void _append_matches(const BaseIndex::Iterator& range_begin, const BaseIndex::Iterator& range_end,
-                       const ChunkOffset chunk_offset_left, const ChunkID chunk_id_left, const ChunkID chunk_id_right);
+                       const std::vector<ChunkOffset>& chunk_offsets, const ChunkOffset chunk_offset_left,
+                       const ChunkID chunk_id_left, const ChunkID chunk_id_right, ChunkJoinResult& result);
 
   void _create_table_structure();
 
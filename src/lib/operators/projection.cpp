@@ -12,6 +12,9 @@
 #include "expression/expression_utils.hpp"
 #include "expression/pqp_column_expression.hpp"
 #include "expression/value_expression.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
 #include "utils/assert.hpp"
 
 namespace opossum {
@@ -82,27 +85,43 @@ std::shared_ptr<const Table> Projection::_on_execute() {
   }
 
   /**
-   * Perform the projection
+   * Perform the projection, one job per chunk. The jobs write to their own slot of output_segments_by_chunk, so that
+   * the output chunks can be appended in the order of the input chunks afterwards.
    */
-  for (auto chunk_id = ChunkID{0}; chunk_id < input_table_left()->chunk_count(); ++chunk_id) {
-    Segments output_segments;
-    output_segments.reserve(expressions.size());
+  const auto chunk_count = input_table_left()->chunk_count();
+  auto output_segments_by_chunk = std::vector<Segments>(chunk_count);
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(chunk_count);
+
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    auto job_task = std::make_shared<JobTask>([&, chunk_id]() {
+      auto& output_segments = output_segments_by_chunk[chunk_id];
+      output_segments.reserve(expressions.size());
+
+      const auto input_chunk = input_table_left()->get_chunk(chunk_id);
+
+      ExpressionEvaluator evaluator(input_table_left(), chunk_id, uncorrelated_select_results);
+      for (const auto& expression : expressions) {
+        // Forward input column if possible
+        if (expression->type == ExpressionType::PQPColumn && forward_columns) {
+          const auto pqp_column_expression = std::dynamic_pointer_cast<PQPColumnExpression>(expression);
+          output_segments.emplace_back(input_chunk->get_segment(pqp_column_expression->column_id));
+        } else {
+          output_segments.emplace_back(evaluator.evaluate_expression_to_segment(*expression));
+        }
+      }
+    });
 
-    const auto input_chunk = input_table_left()->get_chunk(chunk_id);
+    jobs.push_back(job_task);
+    job_task->schedule();
+  }
 
-    ExpressionEvaluator evaluator(input_table_left(), chunk_id, uncorrelated_select_results);
-    for (const auto& expression : expressions) {
-      // Forward input column if possible
-      if (expression->type == ExpressionType::PQPColumn && forward_columns) {
-        const auto pqp_column_expression = std::dynamic_pointer_cast<PQPColumnExpression>(expression);
-        output_segments.emplace_back(input_chunk->get_segment(pqp_column_expression->column_id));
-      } else {
-        output_segments.emplace_back(evaluator.evaluate_expression_to_segment(*expression));
-      }
-    }
+  CurrentScheduler::wait_for_tasks(jobs);
 
-    output_table->append_chunk(output_segments);
-    output_table->get_chunk(chunk_id)->set_mvcc_data(input_chunk->mvcc_data());
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    output_table->append_chunk(output_segments_by_chunk[chunk_id]);
+    output_table->get_chunk(chunk_id)->set_mvcc_data(input_table_left()->get_chunk(chunk_id)->mvcc_data());
   }
 
   return output_table;
@@ -1,249 +1,422 @@
 #include "sort.hpp"
 
+#include <algorithm>
 #include <functional>
+#include <map>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "sort/normalized_sort_keys.hpp"
 #include "storage/reference_segment.hpp"
 #include "storage/segment_accessor.hpp"
-#include "storage/segment_iterables/chunk_offset_mapping.hpp"
 #include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
 
 namespace opossum {
 
+namespace {
+
+// Positions of the input rows, indexed by the row's position in the input table (counted over all chunks)
+using RowIndex = size_t;
+
+}  // namespace
+
 Sort::Sort(const std::shared_ptr<const AbstractOperator>& in, const ColumnID column_id, const OrderByMode order_by_mode,
            const size_t output_chunk_size)
+    : Sort(in, {SortColumnDefinition{column_id, order_by_mode}}, output_chunk_size) {}
+
+Sort::Sort(const std::shared_ptr<const AbstractOperator>& in, const std::vector<SortColumnDefinition>& sort_definitions,
+           const size_t output_chunk_size, const OutputMode output_mode)
     : AbstractReadOnlyOperator(OperatorType::Sort, in),
-      _column_id(column_id),
-      _order_by_mode(order_by_mode),
-      _output_chunk_size(output_chunk_size) {}
+      _sort_definitions(sort_definitions),
+      _output_chunk_size(output_chunk_size),
+      _output_mode(output_mode) {
+  Assert(!_sort_definitions.empty(), "Expected at least one sort definition");
+}
 
-ColumnID Sort::column_id() const { return _column_id; }
+const std::vector<SortColumnDefinition>& Sort::sort_definitions() const { return _sort_definitions; }
 
-OrderByMode Sort::order_by_mode() const { return _order_by_mode; }
+Sort::OutputMode Sort::output_mode() const { return _output_mode; }
 
 const std::string Sort::name() const { return "Sort"; }
 
 std::shared_ptr<AbstractOperator> Sort::_on_deep_copy(
     const std::shared_ptr<AbstractOperator>& copied_input_left,
     const std::shared_ptr<AbstractOperator>& copied_input_right) const {
-  return std::make_shared<Sort>(copied_input_left, _column_id, _order_by_mode, _output_chunk_size);
+  return std::make_shared<Sort>(copied_input_left, _sort_definitions, _output_chunk_size, _output_mode);
 }
 
 void Sort::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {}
 
-std::shared_ptr<const Table> Sort::_on_execute() {
-  _impl = make_unique_by_data_type<AbstractReadOnlyOperatorImpl, SortImpl>(
-      input_table_left()->column_data_type(_column_id), input_table_left(), _column_id, _order_by_mode,
-      _output_chunk_size);
-  return _impl->_on_execute();
-}
-
 void Sort::_on_cleanup() { _impl.reset(); }
 
-// This class fulfills only the materialization task for a sorted row_id_value_vector.
-template <typename SortColumnType>
-class Sort::SortImplMaterializeOutput {
+// Computes the sorted order of the input rows and hands it to one of the output classes
+class Sort::SortImpl : public AbstractReadOnlyOperatorImpl {
  public:
-  // creates a new table with reference segments
-  SortImplMaterializeOutput(const std::shared_ptr<const Table>& in,
-                            const std::shared_ptr<std::vector<std::pair<RowID, SortColumnType>>>& id_value_map,
-                            const size_t output_chunk_size)
-      : _table_in(in), _output_chunk_size(output_chunk_size), _row_id_value_vector(id_value_map) {}
+  SortImpl(const std::shared_ptr<const Table>& table_in, const std::vector<SortColumnDefinition>& sort_definitions,
+           const size_t output_chunk_size, const OutputMode output_mode)
+      : _table_in(table_in),
+        _sort_definitions(sort_definitions),
+        _output_chunk_size(output_chunk_size),
+        _output_mode(output_mode),
+        _normalized_keys(*table_in, sort_definitions),
+        _key_width(_normalized_keys.key_width()) {}
 
-  std::shared_ptr<const Table> execute() {
-    // First we create a new table as the output
-    auto output = std::make_shared<Table>(_table_in->column_definitions(), TableType::Data, _output_chunk_size);
+  std::shared_ptr<const Table> _on_execute() override;
 
-    // We have decided against duplicating MVCC data in https://github.com/hyrise/hyrise/issues/408
+ protected:
+  void _materialize_keys();
+  void _sort_runs();
+  void _merge_runs();
+
+  bool _less(const RowIndex left, const RowIndex right) const {
+    const auto string_count = _normalized_keys.string_count();
+    return _normalized_keys.less(&_keys[left * _key_width], _strings.data() + left * string_count,
+                                 &_keys[right * _key_width], _strings.data() + right * string_count);
+  }
 
-    // After we created the output table and initialized the column structure, we can start adding values. Because the
-    // values are not ordered by input chunks anymore, we can't process them chunk by chunk. Instead the values are
-    // copied column by column for each output row. For each column in a row we visit the input segment with a reference
-    // to the output segment. This enables for the SortImplMaterializeOutput class to ignore the column types during the
-    // copying of the values.
-    const auto row_count_out = _row_id_value_vector->size();
+  const std::shared_ptr<const Table> _table_in;
+  const std::vector<SortColumnDefinition> _sort_definitions;
+  const size_t _output_chunk_size;
+  const OutputMode _output_mode;
 
-    // Ceiling of integer division
-    const auto div_ceil = [](auto x, auto y) { return (x + y - 1u) / y; };
+  // The RowIndex of the first row of each input chunk
+  std::vector<RowIndex> _chunk_offsets;
+  size_t _row_count{0};
 
-    const auto chunk_count_out = div_ceil(row_count_out, _output_chunk_size);
+  const NormalizedSortKeys _normalized_keys;
+  const size_t _key_width;
 
-    // Vector of segments for each chunk
-    std::vector<Segments> output_segments_by_chunk(chunk_count_out);
+  std::vector<uint8_t> _keys;
+  std::vector<std::string> _strings;
+  std::vector<RowID> _input_row_ids;
+
+  // Sorted runs, one per input chunk until they are merged. _run_offsets has one more entry than there are runs.
+  std::vector<RowIndex> _sorted_rows;
+  std::vector<size_t> _run_offsets;
+};
+
+// Creates a materialized output table from the sorted RowIDs
+class Sort::SortImplMaterializeOutput {
+ public:
+  SortImplMaterializeOutput(const std::shared_ptr<const Table>& table_in,
+                            const std::shared_ptr<const PosList>& sorted_row_ids, const size_t output_chunk_size)
+      : _table_in(table_in), _sorted_row_ids(sorted_row_ids), _output_chunk_size(output_chunk_size) {}
 
-    // Materialize segment-wise
-    for (ColumnID column_id{0u}; column_id < output->column_count(); ++column_id) {
-      const auto column_data_type = output->column_data_type(column_id);
+  std::shared_ptr<const Table> execute();
 
-      resolve_data_type(column_data_type, [&](auto type) {
-        using ColumnDataType = typename decltype(type)::type;
+ protected:
+  const std::shared_ptr<const Table> _table_in;
+  const std::shared_ptr<const PosList> _sorted_row_ids;
+  const size_t _output_chunk_size;
+};
+
+// Creates an output table of ReferenceSegments from the sorted RowIDs
+class Sort::SortImplReferenceOutput {
+ public:
+  SortImplReferenceOutput(const std::shared_ptr<const Table>& table_in,
+                          const std::shared_ptr<const PosList>& sorted_row_ids, const size_t output_chunk_size)
+      : _table_in(table_in), _sorted_row_ids(sorted_row_ids), _output_chunk_size(output_chunk_size) {}
 
-        auto chunk_it = output_segments_by_chunk.begin();
-        auto chunk_offset_out = 0u;
+  std::shared_ptr<const Table> execute();
 
-        auto value_segment_value_vector = pmr_concurrent_vector<ColumnDataType>();
-        auto value_segment_null_vector = pmr_concurrent_vector<bool>();
+ protected:
+  const std::shared_ptr<const Table> _table_in;
+  const std::shared_ptr<const PosList> _sorted_row_ids;
+  const size_t _output_chunk_size;
+};
 
-        auto segment_ptr_and_accessor_by_chunk_id =
-            std::unordered_map<ChunkID, std::pair<std::shared_ptr<const BaseSegment>,
-                                                  std::shared_ptr<BaseSegmentAccessor<ColumnDataType>>>>();
-        segment_ptr_and_accessor_by_chunk_id.reserve(row_count_out);
+namespace {
 
-        for (auto row_index = 0u; row_index < row_count_out; ++row_index) {
-          const auto [chunk_id, chunk_offset] = _row_id_value_vector->at(row_index).first;  // NOLINT
+// The table that stores the values of an output column, the column's ID in that table, and the sorted RowIDs into it
+struct ResolvedColumn {
+  std::shared_ptr<const Table> table;
+  ColumnID column_id;
+  std::shared_ptr<const PosList> row_ids;
+};
 
-          auto& segment_ptr_and_typed_ptr_pair = segment_ptr_and_accessor_by_chunk_id[chunk_id];
-          auto& base_segment = segment_ptr_and_typed_ptr_pair.first;
-          auto& accessor = segment_ptr_and_typed_ptr_pair.second;
+using ResolvedRowIDsCache = std::map<std::vector<std::shared_ptr<const PosList>>, std::shared_ptr<const PosList>>;
+
+/**
+ * For data tables, the values of a column are stored in the input table itself. For reference tables, the
+ * sorted_row_ids are resolved using the PosLists of the input. resolved_row_ids_cache avoids resolving the same
+ * PosLists multiple times, as most columns of a reference table usually share them.
+ */
+ResolvedColumn resolve_column(const std::shared_ptr<const Table>& table_in, const ColumnID column_id,
+                              const std::shared_ptr<const PosList>& sorted_row_ids,
+                              ResolvedRowIDsCache& resolved_row_ids_cache) {
+  if (table_in->type() == TableType::Data) {
+    return {table_in, column_id, sorted_row_ids};
+  }
 
-          if (!base_segment) {
-            base_segment = _table_in->get_chunk(chunk_id)->get_segment(column_id);
-            accessor = create_segment_accessor<ColumnDataType>(base_segment);
-          }
+  auto input_pos_lists = std::vector<std::shared_ptr<const PosList>>(table_in->chunk_count());
+  auto referenced_table = std::shared_ptr<const Table>{};
+  auto referenced_column_id = ColumnID{0};
 
-          // If the input segment is not a ReferenceSegment, we can take a fast(er) path
-          if (accessor) {
-            const auto typed_value = accessor->access(chunk_offset);
-            const auto is_null = !typed_value.has_value();
-            value_segment_value_vector.push_back(is_null ? ColumnDataType{} : typed_value.value());
-            value_segment_null_vector.push_back(is_null);
-          } else {
-            const auto value = (*base_segment)[chunk_offset];
-            const auto is_null = variant_is_null(value);
-            value_segment_value_vector.push_back(is_null ? ColumnDataType{} : type_cast<ColumnDataType>(value));
-            value_segment_null_vector.push_back(is_null);
-          }
+  for (ChunkID chunk_id{0}; chunk_id < table_in->chunk_count(); ++chunk_id) {
+    const auto reference_segment =
+        std::static_pointer_cast<const ReferenceSegment>(table_in->get_chunk(chunk_id)->get_segment(column_id));
+    input_pos_lists[chunk_id] = reference_segment->pos_list();
+    referenced_table = reference_segment->referenced_table();
+    referenced_column_id = reference_segment->referenced_column_id();
+  }
 
-          ++chunk_offset_out;
-
-          // Check if value segment is full
-          if (chunk_offset_out >= _output_chunk_size) {
-            chunk_offset_out = 0u;
-            auto value_segment = std::make_shared<ValueSegment<ColumnDataType>>(std::move(value_segment_value_vector),
-                                                                                std::move(value_segment_null_vector));
-            chunk_it->push_back(value_segment);
-            value_segment_value_vector = pmr_concurrent_vector<ColumnDataType>();
-            value_segment_null_vector = pmr_concurrent_vector<bool>();
-            ++chunk_it;
-          }
-        }
-
-        // Last segment has not been added
-        if (chunk_offset_out > 0u) {
-          auto value_segment = std::make_shared<ValueSegment<ColumnDataType>>(std::move(value_segment_value_vector),
-                                                                              std::move(value_segment_null_vector));
-          chunk_it->push_back(value_segment);
-        }
-      });
+  auto cache_iter = resolved_row_ids_cache.find(input_pos_lists);
+  if (cache_iter == resolved_row_ids_cache.end()) {
+    auto resolved_row_ids = std::make_shared<PosList>(sorted_row_ids->size());
+    for (auto row_index = size_t{0}; row_index < sorted_row_ids->size(); ++row_index) {
+      const auto& row_id = (*sorted_row_ids)[row_index];
+      (*resolved_row_ids)[row_index] = (*input_pos_lists[row_id.chunk_id])[row_id.chunk_offset];
     }
+    cache_iter = resolved_row_ids_cache.emplace(input_pos_lists, resolved_row_ids).first;
+  }
 
-    for (auto& segments : output_segments_by_chunk) {
-      output->append_chunk(segments);
-    }
+  return {referenced_table, referenced_column_id, cache_iter->second};
+}
+
+}  // namespace
 
-    return output;
+std::shared_ptr<const Table> Sort::_on_execute() {
+  const auto table_in = input_table_left();
+  _impl = std::make_unique<SortImpl>(table_in, _sort_definitions, _output_chunk_size, _output_mode);
+  return _impl->_on_execute();
+}
+
+std::shared_ptr<const Table> Sort::SortImpl::_on_execute() {
+  for (ChunkID chunk_id{0}; chunk_id < _table_in->chunk_count(); ++chunk_id) {
+    _chunk_offsets.emplace_back(_row_count);
+    _row_count += _table_in->get_chunk(chunk_id)->size();
   }
 
- protected:
-  const std::shared_ptr<const Table> _table_in;
-  const size_t _output_chunk_size;
-  const std::shared_ptr<std::vector<std::pair<RowID, SortColumnType>>> _row_id_value_vector;
-};
+  // 1. Encode the sort columns of all rows into normalized keys
+  _materialize_keys();
 
-// we need to use the impl pattern because the scan operator of the sort depends on the type of the column
-template <typename SortColumnType>
-class Sort::SortImpl : public AbstractReadOnlyOperatorImpl {
- public:
-  using RowIDValuePair = std::pair<RowID, SortColumnType>;
+  // 2. Sort the rows of each chunk and merge the sorted runs
+  _sort_runs();
+  _merge_runs();
 
-  SortImpl(const std::shared_ptr<const Table>& table_in, const ColumnID column_id,
-           const OrderByMode order_by_mode = OrderByMode::Ascending, const size_t output_chunk_size = 0)
-      : _table_in(table_in),
-        _column_id(column_id),
-        _order_by_mode(order_by_mode),
-        _output_chunk_size(output_chunk_size) {
-    // initialize a structure which can be sorted by std::sort
-    _row_id_value_vector = std::make_shared<std::vector<RowIDValuePair>>();
-    _null_value_rows = std::make_shared<std::vector<RowIDValuePair>>();
+  auto sorted_row_ids = std::make_shared<PosList>(_row_count);
+  for (auto row_index = size_t{0}; row_index < _row_count; ++row_index) {
+    (*sorted_row_ids)[row_index] = _input_row_ids[_sorted_rows[row_index]];
   }
 
- protected:
-  std::shared_ptr<const Table> _on_execute() override {
-    // 1. Prepare Sort: Creating rowid-value-Structure
-    _materialize_sort_column();
-
-    // 2. After we got our ValueRowID Map we sort the map by the value of the pair
-    if (_order_by_mode == OrderByMode::Ascending || _order_by_mode == OrderByMode::AscendingNullsLast) {
-      _sort_with_operator<std::less<>>();
-    } else {
-      _sort_with_operator<std::greater<>>();
-    }
+  // 3. Create the output table in the requested format
+  if (_output_mode == OutputMode::References) {
+    return SortImplReferenceOutput{_table_in, sorted_row_ids, _output_chunk_size}.execute();
+  }
+  return SortImplMaterializeOutput{_table_in, sorted_row_ids, _output_chunk_size}.execute();
+}
+
+void Sort::SortImpl::_materialize_keys() {
+  _keys.resize(_row_count * _key_width);
+  _strings.resize(_row_count * _normalized_keys.string_count());
+  _input_row_ids.resize(_row_count);
+
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(_table_in->chunk_count());
 
-    // 2b. Insert null rows if necessary
-    if (!_null_value_rows->empty()) {
-      if (_order_by_mode == OrderByMode::AscendingNullsLast || _order_by_mode == OrderByMode::DescendingNullsLast) {
-        // NULLs last
-        _row_id_value_vector->insert(_row_id_value_vector->end(), _null_value_rows->begin(), _null_value_rows->end());
-      } else {
-        // NULLs first (default behavior)
-        _row_id_value_vector->insert(_row_id_value_vector->begin(), _null_value_rows->begin(), _null_value_rows->end());
+  for (ChunkID chunk_id{0}; chunk_id < _table_in->chunk_count(); ++chunk_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+      const auto chunk = _table_in->get_chunk(chunk_id);
+      const auto chunk_offset = _chunk_offsets[chunk_id];
+
+      for (ChunkOffset offset{0}; offset < chunk->size(); ++offset) {
+        _input_row_ids[chunk_offset + offset] = RowID{chunk_id, offset};
       }
+
+      _normalized_keys.encode_chunk(*chunk, _keys.data() + chunk_offset * _key_width,
+                                    _strings.data() + chunk_offset * _normalized_keys.string_count());
+    }));
+    jobs.back()->schedule();
+  }
+
+  CurrentScheduler::wait_for_tasks(jobs);
+}
+
+void Sort::SortImpl::_sort_runs() {
+  _sorted_rows.resize(_row_count);
+  std::iota(_sorted_rows.begin(), _sorted_rows.end(), RowIndex{0});
+
+  _run_offsets = _chunk_offsets;
+  _run_offsets.emplace_back(_row_count);
+
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(_table_in->chunk_count());
+
+  for (auto run_id = size_t{0}; run_id + 1 < _run_offsets.size(); ++run_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, run_id]() {
+      // Stable, so that rows with equal keys keep their order within the chunk
+      std::stable_sort(_sorted_rows.begin() + _run_offsets[run_id], _sorted_rows.begin() + _run_offsets[run_id + 1],
+                       [&](const RowIndex left, const RowIndex right) { return _less(left, right); });
+    }));
+    jobs.back()->schedule();
+  }
+
+  CurrentScheduler::wait_for_tasks(jobs);
+}
+
+void Sort::SortImpl::_merge_runs() {
+  auto merged_rows = std::vector<RowIndex>(_row_count);
+
+  // Merge neighboring runs pairwise until only one run is left. The merges of one round are independent.
+  while (_run_offsets.size() > 2) {
+    const auto run_count = _run_offsets.size() - 1;
+
+    auto merged_run_offsets = std::vector<size_t>{};
+    merged_run_offsets.reserve(run_count / 2 + 2);
+
+    std::vector<std::shared_ptr<AbstractTask>> jobs;
+    jobs.reserve(run_count / 2 + 1);
+
+    for (auto run_id = size_t{0}; run_id < run_count; run_id += 2) {
+      merged_run_offsets.emplace_back(_run_offsets[run_id]);
+
+      const auto begin = _run_offsets[run_id];
+      const auto middle = _run_offsets[std::min(run_id + 1, run_count)];
+      const auto end = _run_offsets[std::min(run_id + 2, run_count)];
+
+      jobs.emplace_back(std::make_shared<JobTask>([&, begin, middle, end]() {
+        // std::merge prefers the first range for equal elements, which keeps the sort stable
+        std::merge(_sorted_rows.begin() + begin, _sorted_rows.begin() + middle, _sorted_rows.begin() + middle,
+                   _sorted_rows.begin() + end, merged_rows.begin() + begin,
+                   [&](const RowIndex left, const RowIndex right) { return _less(left, right); });
+      }));
+      jobs.back()->schedule();
     }
+    merged_run_offsets.emplace_back(_row_count);
+
+    CurrentScheduler::wait_for_tasks(jobs);
 
-    // 3. Materialization of the result: We take the sorted ValueRowID Vector, create chunks fill them until they are
-    // full and create the next one. Each chunk is filled row by row.
-    auto materialization = std::make_shared<SortImplMaterializeOutput<SortColumnType>>(_table_in, _row_id_value_vector,
-                                                                                       _output_chunk_size);
-    return materialization->execute();
+    std::swap(_sorted_rows, merged_rows);
+    _run_offsets = std::move(merged_run_offsets);
   }
+}
+
+std::shared_ptr<const Table> Sort::SortImplMaterializeOutput::execute() {
+  auto output = std::make_shared<Table>(_table_in->column_definitions(), TableType::Data, _output_chunk_size);
+
+  // We have decided against duplicating MVCC data in https://github.com/hyrise/hyrise/issues/408
 
-  // completely materializes the sort column to create a vector of RowID-Value pairs
-  void _materialize_sort_column() {
-    auto& row_id_value_vector = *_row_id_value_vector;
-    row_id_value_vector.reserve(_table_in->row_count());
+  const auto row_count_out = _sorted_row_ids->size();
+  const auto chunk_count_out = (row_count_out + _output_chunk_size - 1) / _output_chunk_size;
 
-    auto& null_value_rows = *_null_value_rows;
+  // Vector of segments for each chunk
+  std::vector<Segments> output_segments_by_chunk(chunk_count_out, Segments(output->column_count()));
 
-    for (ChunkID chunk_id{0}; chunk_id < _table_in->chunk_count(); ++chunk_id) {
-      auto chunk = _table_in->get_chunk(chunk_id);
+  auto resolved_row_ids_cache = ResolvedRowIDsCache{};
 
-      auto base_segment = chunk->get_segment(_column_id);
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(output->column_count() * chunk_count_out);
 
-      resolve_segment_type<SortColumnType>(*base_segment, [&](auto& typed_segment) {
-        auto iterable = create_iterable_from_segment<SortColumnType>(typed_segment);
+  // Materialize segment-wise, with one job per output segment. The values are gathered from the tables that actually
+  // store them, so that ReferenceSegments do not have to be accessed row by row.
+  for (ColumnID column_id{0u}; column_id < output->column_count(); ++column_id) {
+    const auto resolved_column = resolve_column(_table_in, column_id, _sorted_row_ids, resolved_row_ids_cache);
+    const auto& resolved_row_ids = resolved_column.row_ids;
 
-        iterable.for_each([&](const auto& value) {
-          if (value.is_null()) {
-            null_value_rows.emplace_back(RowID{chunk_id, value.chunk_offset()}, SortColumnType{});
-          } else {
-            row_id_value_vector.emplace_back(RowID{chunk_id, value.chunk_offset()}, value.value());
+    resolve_data_type(output->column_data_type(column_id), [&, column_id](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+      using Accessors = std::vector<std::unique_ptr<BaseSegmentAccessor<ColumnDataType>>>;
+
+      // The accessors are shared by the jobs of this column
+      const auto referenced_chunk_count = resolved_column.table ? resolved_column.table->chunk_count() : ChunkID{0};
+      auto accessors = std::make_shared<Accessors>(referenced_chunk_count);
+      for (ChunkID chunk_id{0}; chunk_id < referenced_chunk_count; ++chunk_id) {
+        (*accessors)[chunk_id] = create_segment_accessor<ColumnDataType>(
+            resolved_column.table->get_chunk(chunk_id)->get_segment(resolved_column.column_id));
+      }
+
+      for (auto chunk_id_out = size_t{0}; chunk_id_out < chunk_count_out; ++chunk_id_out) {
+        jobs.emplace_back(std::make_shared<JobTask>([&, column_id, chunk_id_out, accessors, resolved_row_ids]() {
+          const auto begin = chunk_id_out * _output_chunk_size;
+          const auto end = std::min(begin + _output_chunk_size, row_count_out);
+
+          auto value_segment_value_vector = pmr_concurrent_vector<ColumnDataType>(end - begin);
+          auto value_segment_null_vector = pmr_concurrent_vector<bool>(end - begin);
+
+          for (auto row_index = begin; row_index < end; ++row_index) {
+            const auto& row_id = (*resolved_row_ids)[row_index];
+
+            // NULL_ROW_IDs are produced, e.g., by outer joins
+            if (row_id.chunk_offset == INVALID_CHUNK_OFFSET) {
+              value_segment_null_vector[row_index - begin] = true;
+              continue;
+            }
+
+            const auto typed_value = (*accessors)[row_id.chunk_id]->access(row_id.chunk_offset);
+            if (typed_value) {
+              value_segment_value_vector[row_index - begin] = *typed_value;
+            } else {
+              value_segment_null_vector[row_index - begin] = true;
+            }
           }
-        });
-      });
-    }
+
+          output_segments_by_chunk[chunk_id_out][column_id] = std::make_shared<ValueSegment<ColumnDataType>>(
+              std::move(value_segment_value_vector), std::move(value_segment_null_vector));
+        }));
+        jobs.back()->schedule();
+      }
+    });
   }
 
-  template <typename Comparator>
-  void _sort_with_operator() {
-    Comparator comparator;
-    std::stable_sort(_row_id_value_vector->begin(), _row_id_value_vector->end(),
-                     [comparator](RowIDValuePair a, RowIDValuePair b) { return comparator(a.second, b.second); });
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  for (auto& segments : output_segments_by_chunk) {
+    output->append_chunk(segments);
   }
 
-  const std::shared_ptr<const Table> _table_in;
+  return output;
+}
 
-  // column to sort by
-  const ColumnID _column_id;
-  const OrderByMode _order_by_mode;
-  // chunk size of the materialized output
-  const size_t _output_chunk_size;
+std::shared_ptr<const Table> Sort::SortImplReferenceOutput::execute() {
+  auto output = std::make_shared<Table>(_table_in->column_definitions(), TableType::References);
 
-  std::shared_ptr<std::vector<RowIDValuePair>> _row_id_value_vector;
-  std::shared_ptr<std::vector<RowIDValuePair>> _null_value_rows;
-};
+  const auto row_count_out = _sorted_row_ids->size();
+  const auto chunk_count_out = (row_count_out + _output_chunk_size - 1) / _output_chunk_size;
+
+  std::vector<Segments> output_segments_by_chunk(chunk_count_out);
+
+  auto resolved_row_ids_cache = ResolvedRowIDsCache{};
+
+  // Columns that reference the same table with the same RowIDs share the PosLists of their output segments
+  auto output_pos_lists_by_resolved_row_ids =
+      std::map<std::shared_ptr<const PosList>, std::vector<std::shared_ptr<const PosList>>>{};
+
+  for (ColumnID column_id{0u}; column_id < output->column_count(); ++column_id) {
+    const auto resolved_column = resolve_column(_table_in, column_id, _sorted_row_ids, resolved_row_ids_cache);
+    const auto& resolved_row_ids = resolved_column.row_ids;
+
+    // If the input has no chunks, there are no rows to reference either
+    const auto referenced_table = resolved_column.table ? resolved_column.table
+                                                        : Table::create_dummy_table(_table_in->column_definitions());
+
+    auto& output_pos_lists = output_pos_lists_by_resolved_row_ids[resolved_row_ids];
+    if (output_pos_lists.empty()) {
+      for (auto chunk_id_out = size_t{0}; chunk_id_out < chunk_count_out; ++chunk_id_out) {
+        const auto begin = resolved_row_ids->begin() + chunk_id_out * _output_chunk_size;
+        const auto end = resolved_row_ids->begin() + std::min((chunk_id_out + 1) * _output_chunk_size, row_count_out);
+        output_pos_lists.emplace_back(std::make_shared<PosList>(begin, end));
+      }
+    }
+
+    for (auto chunk_id_out = size_t{0}; chunk_id_out < chunk_count_out; ++chunk_id_out) {
+      output_segments_by_chunk[chunk_id_out].emplace_back(std::make_shared<ReferenceSegment>(
+          referenced_table, resolved_column.column_id, output_pos_lists[chunk_id_out]));
+    }
+  }
+
+  for (auto& segments : output_segments_by_chunk) {
+    output->append_chunk(segments);
+  }
+
+  return output;
+}
 
 }  // namespace opossum
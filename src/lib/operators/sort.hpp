@@ -4,6 +4,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -14,19 +15,40 @@
 
 namespace opossum {
 
+// Defines one sort key of the Sort operator: the column to sort by and its order
+struct SortColumnDefinition final {
+  explicit SortColumnDefinition(const ColumnID column, const OrderByMode order_by_mode = OrderByMode::Ascending)
+      : column(column), order_by_mode(order_by_mode) {}
+
+  ColumnID column;
+  OrderByMode order_by_mode;
+};
+
 /**
- * Operator to sort a table by a single column. This implements a stable sort, i.e., rows that share the same value will
- * maintain their relative order.
- * Multi-column sort is not supported yet. For now, you will have to sort by the secondary criterion, then by the first
+ * Operator to sort a table by one or more columns. This implements a stable sort, i.e., rows that share the same
+ * values in all sort columns will maintain their relative order.
+ *
+ * The values of all sort columns are encoded into a normalized key per row, which can be compared using memcmp (see
+ * sort/normalized_sort_keys.hpp). The rows of each input chunk are sorted in parallel, and the sorted runs are merged
+ * pairwise, again in parallel.
+ *
+ * By default, the output table is materialized. With OutputMode::References, the output consists of ReferenceSegments
+ * that point to the (data) tables referenced by the input, so that no column values are copied.
  */
 class Sort : public AbstractReadOnlyOperator {
  public:
-  // The parameter chunk_size sets the chunk size of the output table, which will always be materialized
+  enum class OutputMode { Materialized, References };
+
+  // The parameter chunk_size sets the chunk size of the output table
   Sort(const std::shared_ptr<const AbstractOperator>& in, const ColumnID column_id,
        const OrderByMode order_by_mode = OrderByMode::Ascending, const size_t output_chunk_size = Chunk::MAX_SIZE);
 
-  ColumnID column_id() const;
-  OrderByMode order_by_mode() const;
+  // Sorts by the first sort definition, then by the second one, and so on
+  Sort(const std::shared_ptr<const AbstractOperator>& in, const std::vector<SortColumnDefinition>& sort_definitions,
+       const size_t output_chunk_size = Chunk::MAX_SIZE, const OutputMode output_mode = OutputMode::Materialized);
+
+  const std::vector<SortColumnDefinition>& sort_definitions() const;
+  OutputMode output_mode() const;
 
   const std::string name() const override;
 
@@ -38,18 +60,16 @@ class Sort : public AbstractReadOnlyOperator {
       const std::shared_ptr<AbstractOperator>& copied_input_right) const override;
   void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
 
-  // The operator is separated in three different classes. SortImpl is the common templated implementation of the
-  // operator. SortImpl* und SortImplMaterializeOutput are extra classes for the visitor pattern. They fulfill a certain
-  // task during the Sort process, as described later on.
-  template <typename SortColumnType>
+  // SortImpl computes the sorted order of the input rows, SortImplMaterializeOutput and SortImplReferenceOutput
+  // create the output table from it.
   class SortImpl;
-  template <typename SortColumnType>
   class SortImplMaterializeOutput;
+  class SortImplReferenceOutput;
 
   std::unique_ptr<AbstractReadOnlyOperatorImpl> _impl;
-  const ColumnID _column_id;
-  const OrderByMode _order_by_mode;
+  const std::vector<SortColumnDefinition> _sort_definitions;
   const size_t _output_chunk_size;
+  const OutputMode _output_mode;
 };
 
 }  // namespace opossum
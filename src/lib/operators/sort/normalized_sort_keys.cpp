@@ -0,0 +1,145 @@
+#include "normalized_sort_keys.hpp"
+
+#include <algorithm>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/create_iterable_from_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+template <typename T>
+constexpr size_t normalized_value_width() {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return NormalizedSortKeys::STRING_PREFIX_LENGTH;
+  } else {
+    return sizeof(T);
+  }
+}
+
+// Writes `value` to `key` so that memcmp orders the encoded values just like operator< orders the values
+template <typename T>
+void encode_normalized_value(const T& value, uint8_t* key) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    // std::string compares characters as unsigned chars, just like memcmp. Shorter strings are padded with zeros.
+    const auto prefix_length = std::min(value.size(), NormalizedSortKeys::STRING_PREFIX_LENGTH);
+    std::memcpy(key, value.data(), prefix_length);
+    std::memset(key + prefix_length, 0, NormalizedSortKeys::STRING_PREFIX_LENGTH - prefix_length);
+  } else {
+    static_assert(sizeof(T) == 4 || sizeof(T) == 8, "Unexpected size of sort column type");
+    using UnsignedType = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    constexpr auto sign_bit = UnsignedType{1} << (sizeof(T) * 8 - 1);
+
+    auto bits = UnsignedType{};
+    std::memcpy(&bits, &value, sizeof(T));
+
+    if constexpr (std::is_floating_point_v<T>) {
+      // IEEE 754: Negative values are stored as sign and magnitude, so their order has to be reversed
+      bits = (bits & sign_bit) ? ~bits : bits | sign_bit;
+    } else {
+      // Two's complement: Flipping the sign bit moves negative values before positive ones
+      bits ^= sign_bit;
+    }
+
+    for (auto byte_id = size_t{0}; byte_id < sizeof(T); ++byte_id) {
+      key[byte_id] = static_cast<uint8_t>(bits >> ((sizeof(T) - 1 - byte_id) * 8));
+    }
+  }
+}
+
+bool nulls_last(const OrderByMode order_by_mode) {
+  return order_by_mode == OrderByMode::AscendingNullsLast || order_by_mode == OrderByMode::DescendingNullsLast;
+}
+
+bool descending(const OrderByMode order_by_mode) {
+  return order_by_mode == OrderByMode::Descending || order_by_mode == OrderByMode::DescendingNullsLast;
+}
+
+}  // namespace
+
+NormalizedSortKeys::NormalizedSortKeys(const Table& table, const std::vector<SortColumnDefinition>& sort_definitions)
+    : _sort_definitions(sort_definitions) {
+  auto segment_offset = size_t{0};
+
+  for (const auto& sort_definition : _sort_definitions) {
+    Assert(sort_definition.column < table.column_count(), "Sort column out of range");
+
+    _column_key_offsets.emplace_back(_key_width);
+    _data_types.emplace_back(table.column_data_type(sort_definition.column));
+
+    resolve_data_type(_data_types.back(), [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+
+      // One byte for NULL values, followed by the normalized value
+      _key_width += 1 + normalized_value_width<ColumnDataType>();
+
+      if constexpr (std::is_same_v<ColumnDataType, std::string>) {
+        _key_segments.emplace_back(KeySegment{segment_offset, _key_width - segment_offset, _string_count,
+                                              descending(sort_definition.order_by_mode)});
+        ++_string_count;
+        segment_offset = _key_width;
+      }
+    });
+  }
+
+  if (segment_offset < _key_width) {
+    _key_segments.emplace_back(KeySegment{segment_offset, _key_width - segment_offset, std::nullopt, false});
+  }
+}
+
+size_t NormalizedSortKeys::key_width() const { return _key_width; }
+
+size_t NormalizedSortKeys::string_count() const { return _string_count; }
+
+void NormalizedSortKeys::encode_chunk(const Chunk& chunk, uint8_t* keys, std::string* strings) const {
+  auto string_index = size_t{0};
+
+  for (auto sort_column_index = size_t{0}; sort_column_index < _sort_definitions.size(); ++sort_column_index) {
+    const auto& sort_definition = _sort_definitions[sort_column_index];
+    const auto column_key_offset = _column_key_offsets[sort_column_index];
+    const auto null_byte = nulls_last(sort_definition.order_by_mode) ? uint8_t{1} : uint8_t{0};
+    const auto flip_value = descending(sort_definition.order_by_mode);
+
+    resolve_data_type(_data_types[sort_column_index], [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+      constexpr auto value_width = normalized_value_width<ColumnDataType>();
+
+      const auto segment = chunk.get_segment(sort_definition.column);
+      resolve_segment_type<ColumnDataType>(*segment, [&](const auto& typed_segment) {
+        create_iterable_from_segment<ColumnDataType>(typed_segment).for_each([&](const auto& value) {
+          const auto chunk_offset = value.chunk_offset();
+          auto* key = keys + chunk_offset * _key_width + column_key_offset;
+
+          if (value.is_null()) {
+            // All NULL values are equal
+            key[0] = null_byte;
+            std::memset(key + 1, 0, value_width);
+            if constexpr (std::is_same_v<ColumnDataType, std::string>) {
+              strings[chunk_offset * _string_count + string_index].clear();
+            }
+            return;
+          }
+
+          key[0] = null_byte ^ uint8_t{1};
+          encode_normalized_value(value.value(), key + 1);
+          if (flip_value) {
+            for (auto byte_id = size_t{1}; byte_id <= value_width; ++byte_id) key[byte_id] = ~key[byte_id];
+          }
+
+          if constexpr (std::is_same_v<ColumnDataType, std::string>) {
+            strings[chunk_offset * _string_count + string_index] = value.value();
+          }
+        });
+      });
+
+      if constexpr (std::is_same_v<ColumnDataType, std::string>) ++string_index;
+    });
+  }
+}
+
+}  // namespace opossum
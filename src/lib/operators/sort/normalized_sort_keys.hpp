@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "operators/sort.hpp"
+#include "storage/chunk.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Normalized keys, as used by Sort and TopK
+ *
+ * For every row, the values of all sort columns are encoded into a fixed-width byte string, the normalized key, so
+ * that comparing two keys with memcmp yields the order of the rows. Per sort column, the key contains
+ *   - one byte that orders NULL values before (or, for the *NullsLast modes, after) all other values
+ *   - the value itself, encoded as an unsigned big-endian number. For descending sort columns, all bits of the value
+ *     are flipped.
+ * Strings are only represented by their first STRING_PREFIX_LENGTH bytes. If the prefixes of two strings are equal,
+ * the full strings are compared before looking at the next sort column. Thus, the full strings of all string sort
+ * columns are stored next to the keys, string_count() per row.
+ */
+class NormalizedSortKeys {
+ public:
+  static constexpr auto STRING_PREFIX_LENGTH = size_t{12};
+
+  NormalizedSortKeys(const Table& table, const std::vector<SortColumnDefinition>& sort_definitions);
+
+  // The number of bytes per row
+  size_t key_width() const;
+
+  // The number of full strings per row
+  size_t string_count() const;
+
+  /**
+   * Writes the keys of all rows of `chunk` to `keys` (key_width() bytes per row) and their strings to `strings`
+   * (string_count() per row). Both are written densely, in the order of the rows in the chunk.
+   */
+  void encode_chunk(const Chunk& chunk, uint8_t* keys, std::string* strings) const;
+
+  bool less(const uint8_t* left_key, const std::string* left_strings, const uint8_t* right_key,
+            const std::string* right_strings) const {
+    for (const auto& key_segment : _key_segments) {
+      const auto result =
+          std::memcmp(left_key + key_segment.offset, right_key + key_segment.offset, key_segment.length);
+      if (result != 0) return result < 0;
+
+      if (key_segment.string_index) {
+        // The prefixes (and NULL bytes) are equal, so the full strings decide. NULL values are stored as empty strings.
+        const auto string_index = *key_segment.string_index;
+        const auto string_result = left_strings[string_index].compare(right_strings[string_index]);
+        if (string_result != 0) return key_segment.descending ? string_result > 0 : string_result < 0;
+      }
+    }
+
+    return false;
+  }
+
+ protected:
+  // A range of the keys that is compared with memcmp. If the range ends with a string column, the full strings of
+  // that column have to be compared if the range is equal.
+  struct KeySegment {
+    size_t offset;
+    size_t length;
+    std::optional<size_t> string_index;
+    bool descending;
+  };
+
+  const std::vector<SortColumnDefinition> _sort_definitions;
+  std::vector<DataType> _data_types;
+
+  // The offset of each sort column's NULL byte within a key
+  std::vector<size_t> _column_key_offsets;
+  std::vector<KeySegment> _key_segments;
+  size_t _key_width{0};
+  size_t _string_count{0};
+};
+
+}  // namespace opossum
@@ -0,0 +1,207 @@
+#pragma once
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "types.hpp"
+
+/**
+ * SIMD kernels for scanning contiguous values against a constant value.
+ *
+ * A scan processes blocks of SIMD_SCAN_BLOCK_SIZE values. Each block is compared using GCC vector extensions, which the
+ * compiler lowers to AVX2 or SSE instructions (depending on -march; 64-bit integer comparisons need SSE4.2) or to
+ * scalar code. The comparison results are turned into a 64-bit mask with movemask instructions, and the positions of
+ * the set bits are appended to the PosList in one go per block.
+ */
+namespace opossum {
+
+constexpr auto SIMD_SCAN_BLOCK_SIZE = size_t{64};
+
+#if defined(__AVX2__)
+constexpr auto SIMD_REGISTER_SIZE = size_t{32};
+#else
+constexpr auto SIMD_REGISTER_SIZE = size_t{16};
+#endif
+
+/**
+ * Vector types of SIMD_REGISTER_SIZE bytes for the types supported by the kernels. Attributes on dependent types are
+ * not reliably supported, so every type is listed explicitly.
+ */
+template <typename T>
+struct SimdVector {};
+
+template <>
+struct SimdVector<uint8_t> {
+  using type = uint8_t __attribute__((vector_size(SIMD_REGISTER_SIZE)));
+};
+
+template <>
+struct SimdVector<uint16_t> {
+  using type = uint16_t __attribute__((vector_size(SIMD_REGISTER_SIZE)));
+};
+
+template <>
+struct SimdVector<uint32_t> {
+  using type = uint32_t __attribute__((vector_size(SIMD_REGISTER_SIZE)));
+};
+
+template <>
+struct SimdVector<int32_t> {
+  using type = int32_t __attribute__((vector_size(SIMD_REGISTER_SIZE)));
+};
+
+template <>
+struct SimdVector<int64_t> {
+  using type = int64_t __attribute__((vector_size(SIMD_REGISTER_SIZE)));
+};
+
+template <>
+struct SimdVector<float> {
+  using type = float __attribute__((vector_size(SIMD_REGISTER_SIZE)));
+};
+
+template <>
+struct SimdVector<double> {
+  using type = double __attribute__((vector_size(SIMD_REGISTER_SIZE)));
+};
+
+template <typename T, typename = void>
+struct has_simd_vector : std::false_type {};
+
+template <typename T>
+struct has_simd_vector<T, std::void_t<typename SimdVector<T>::type>> : std::true_type {};
+
+/**
+ * @return true if values of type T can be scanned with the SIMD kernels
+ */
+template <typename T>
+constexpr bool has_simd_vector_v = has_simd_vector<T>::value;
+
+/**
+ * Turns the result of a vector comparison (all bits of a lane set if it matched) of values of type T into a bitmask
+ * with one bit per lane
+ */
+template <typename T, typename LaneMask>
+uint32_t simd_movemask(const LaneMask& lane_mask) {
+  static_assert(sizeof(LaneMask) == SIMD_REGISTER_SIZE, "Unexpected size of the comparison result");
+
+#if defined(__AVX2__)
+  const auto reg = reinterpret_cast<__m256i>(lane_mask);
+  if constexpr (sizeof(T) == 1) {
+    return static_cast<uint32_t>(_mm256_movemask_epi8(reg));
+  } else if constexpr (sizeof(T) == 2) {
+    // Packing works within the two 128-bit lanes, so the bits of the upper lane end up in bits 16 to 23
+    const auto byte_mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_packs_epi16(reg, _mm256_setzero_si256())));
+    return (byte_mask & 0xFFu) | ((byte_mask >> 8u) & 0xFF00u);
+  } else if constexpr (sizeof(T) == 4) {
+    return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(reg)));
+  } else {
+    return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(reg)));
+  }
+#elif defined(__SSE2__)
+  const auto reg = reinterpret_cast<__m128i>(lane_mask);
+  if constexpr (sizeof(T) == 1) {
+    return static_cast<uint32_t>(_mm_movemask_epi8(reg));
+  } else if constexpr (sizeof(T) == 2) {
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(reg, _mm_setzero_si128())));
+  } else if constexpr (sizeof(T) == 4) {
+    return static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(reg)));
+  } else {
+    return static_cast<uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(reg)));
+  }
+#else
+  auto mask = uint32_t{0};
+  for (auto lane = size_t{0}; lane < SIMD_REGISTER_SIZE / sizeof(T); ++lane) {
+    if (lane_mask[lane]) mask |= uint32_t{1} << lane;
+  }
+  return mask;
+#endif
+}
+
+/**
+ * @return a bitmask in which bit i is set iff comparator(block[i], search_value) holds. block needs to contain
+ *         SIMD_SCAN_BLOCK_SIZE values.
+ */
+template <typename T, typename Comparator>
+uint64_t simd_compare_block(const T* block, const T search_value, const Comparator& comparator) {
+  using Vector = typename SimdVector<T>::type;
+  constexpr auto LANE_COUNT = SIMD_REGISTER_SIZE / sizeof(T);
+
+  Vector search_vector;
+  for (auto lane = size_t{0}; lane < LANE_COUNT; ++lane) {
+    search_vector[lane] = search_value;
+  }
+
+  auto mask = uint64_t{0};
+  for (auto vector_idx = size_t{0}; vector_idx < SIMD_SCAN_BLOCK_SIZE / LANE_COUNT; ++vector_idx) {
+    Vector values;
+    std::memcpy(&values, block + vector_idx * LANE_COUNT, sizeof(Vector));
+    mask |= uint64_t{simd_movemask<T>(comparator(values, search_vector))} << (vector_idx * LANE_COUNT);
+  }
+  return mask;
+}
+
+/**
+ * @return a pointer to SIMD_SCAN_BLOCK_SIZE values starting at block_begin in values. If these are not stored
+ *         contiguously (as it can happen at the segment boundaries of a tbb::concurrent_vector) or if there are less
+ *         than SIMD_SCAN_BLOCK_SIZE values left, they are copied to buffer first. The values in buffer beyond the end
+ *         of values are undefined and need to be masked out by the caller.
+ */
+template <typename Values, typename T>
+const T* simd_scan_block(const Values& values, const size_t block_begin,
+                         std::array<T, SIMD_SCAN_BLOCK_SIZE>& buffer) {
+  const auto block_size = std::min(SIMD_SCAN_BLOCK_SIZE, values.size() - block_begin);
+  const auto* first = &values[block_begin];
+  if (block_size == SIMD_SCAN_BLOCK_SIZE && &values[block_begin + block_size - 1] == first + block_size - 1) {
+    return first;
+  }
+
+  std::copy(values.begin() + block_begin, values.begin() + block_begin + block_size, buffer.begin());
+  return buffer.data();
+}
+
+/**
+ * Appends the RowIDs of the rows whose bits are set in mask to matches_out, where bit i stands for the row
+ * block_begin + i. Bits of rows at or beyond row_count are ignored.
+ */
+inline void simd_append_matches(uint64_t mask, const size_t block_begin, const size_t row_count, const ChunkID chunk_id,
+                                PosList& matches_out) {
+  const auto block_size = row_count - block_begin;
+  if (block_size < SIMD_SCAN_BLOCK_SIZE) {
+    mask &= (uint64_t{1} << block_size) - 1;
+  }
+
+  if (mask == 0) return;
+
+  const auto match_offset = matches_out.size();
+  matches_out.resize(match_offset + __builtin_popcountll(mask));
+
+  auto* match = matches_out.data() + match_offset;
+  for (; mask != 0; mask &= mask - 1) {
+    *match++ = RowID{chunk_id, static_cast<ChunkOffset>(block_begin + __builtin_ctzll(mask))};
+  }
+}
+
+/**
+ * Scans row_count rows in blocks of SIMD_SCAN_BLOCK_SIZE rows. For each block, block_mask(block_begin) returns a
+ * bitmask of the matching rows of the block, where bit i stands for the row block_begin + i. The RowIDs of these rows
+ * are appended to matches_out.
+ */
+template <typename BlockMaskFunctor>
+void simd_scan_blocks(const size_t row_count, const BlockMaskFunctor& block_mask, const ChunkID chunk_id,
+                      PosList& matches_out) {
+  for (auto block_begin = size_t{0}; block_begin < row_count; block_begin += SIMD_SCAN_BLOCK_SIZE) {
+    simd_append_matches(block_mask(block_begin), block_begin, row_count, chunk_id, matches_out);
+  }
+}
+
+}  // namespace opossum
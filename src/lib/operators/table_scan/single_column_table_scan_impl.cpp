@@ -1,17 +1,35 @@
 #include "single_column_table_scan_impl.hpp"
 
+#include <array>
+#include <functional>
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "simd_scan_kernels.hpp"
 #include "storage/base_dictionary_segment.hpp"
 #include "storage/create_iterable_from_segment.hpp"
 #include "storage/resolve_encoded_segment_type.hpp"
 #include "storage/segment_iterables/create_iterable_from_attribute_vector.hpp"
+#include "storage/vector_compression/resolve_compressed_vector_type.hpp"
 
 #include "resolve_type.hpp"
 #include "type_comparison.hpp"
 
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// The SIMD kernels can run directly on attribute vectors that store each ValueID in a full uint8/16/32
+template <typename T>
+struct is_fixed_size_byte_aligned_vector : std::false_type {};
+
+template <typename UnsignedIntType>
+struct is_fixed_size_byte_aligned_vector<FixedSizeByteAlignedVector<UnsignedIntType>> : std::true_type {};
+
+}  // namespace
+
 namespace opossum {
 
 SingleColumnTableScanImpl::SingleColumnTableScanImpl(const std::shared_ptr<const Table>& in_table,
@@ -49,6 +67,38 @@ void SingleColumnTableScanImpl::handle_segment(const BaseValueSegment& base_segm
 
     auto& left_segment = static_cast<const ValueSegment<ColumnDataType>&>(base_segment);
 
+    /**
+     * If the whole segment is scanned, the contiguous values are compared by the SIMD kernels. A NULL value compares
+     * like any other value and is masked out afterwards.
+     */
+    if constexpr (has_simd_vector_v<ColumnDataType>) {
+      if (!mapped_chunk_offsets) {
+        const auto& values = left_segment.values();
+        const auto search_value = type_cast<ColumnDataType>(_right_value);
+
+        with_comparator(_predicate_condition, [&](auto comparator) {
+          auto value_buffer = std::array<ColumnDataType, SIMD_SCAN_BLOCK_SIZE>{};
+          auto null_buffer = std::array<bool, SIMD_SCAN_BLOCK_SIZE>{};
+
+          const auto block_mask = [&](const size_t block_begin) {
+            const auto* block = simd_scan_block(values, block_begin, value_buffer);
+            auto mask = simd_compare_block(block, search_value, comparator);
+
+            if (left_segment.is_nullable()) {
+              const auto* null_block = simd_scan_block(left_segment.null_values(), block_begin, null_buffer);
+              mask &= simd_compare_block(reinterpret_cast<const uint8_t*>(null_block), uint8_t{0},
+                                         std::equal_to<void>{});
+            }
+
+            return mask;
+          };
+
+          simd_scan_blocks(values.size(), block_mask, chunk_id, matches_out);
+        });
+        return;
+      }
+    }
+
     auto left_segment_iterable = create_iterable_from_segment(left_segment);
 
     left_segment_iterable.with_iterators(mapped_chunk_offsets.get(), [&](auto left_it, auto left_end) {
@@ -120,9 +170,81 @@ void SingleColumnTableScanImpl::handle_segment(const BaseDictionarySegment& base
    * value_id >= value | search_vid == 0                       | search_vid == INVALID_VALUE_ID
    */
 
+  /**
+   * If the whole segment is scanned, the ValueIDs are compared by the SIMD kernels. NULLs are stored as null_value_id
+   * and masked out. Returns false if the kernels cannot be used for the attribute vector.
+   */
+  const auto simd_scan = [&](const auto& comparator, const ValueID value_id) {
+    if (mapped_chunk_offsets) return false;
+
+    auto scanned = false;
+    resolve_compressed_vector_type(*base_segment.attribute_vector(), [&](const auto& attribute_vector) {
+      using AttributeVectorType = std::decay_t<decltype(attribute_vector)>;
+
+      if constexpr (is_fixed_size_byte_aligned_vector<AttributeVectorType>::value) {
+        const auto& value_ids = attribute_vector.data();
+        using ValueIDType = typename std::decay_t<decltype(value_ids)>::value_type;
+
+        // Both fit into ValueIDType, since the attribute vector is wide enough to store the null_value_id
+        const auto search_value = static_cast<ValueIDType>(value_id);
+        const auto null_value_id = static_cast<ValueIDType>(base_segment.null_value_id());
+
+        auto buffer = std::array<ValueIDType, SIMD_SCAN_BLOCK_SIZE>{};
+        const auto block_mask = [&](const size_t block_begin) {
+          const auto* block = simd_scan_block(value_ids, block_begin, buffer);
+          return simd_compare_block(block, search_value, comparator) &
+                 simd_compare_block(block, null_value_id, std::not_equal_to<void>{});
+        };
+
+        simd_scan_blocks(value_ids.size(), block_mask, chunk_id, matches_out);
+        scanned = true;
+      } else if constexpr (std::is_same_v<AttributeVectorType, SimdBp128Vector>) {
+        /**
+         * Instead of decompressing a whole meta block, each block of 128 ValueIDs is unpacked right before it is
+         * compared. All ValueIDs of a block are smaller than 2^bit_size. If the search ValueID is larger than that,
+         * the comparison yields the same result for every ValueID of the block (e.g., all are smaller, none is
+         * equal), so the block is either skipped or, if it cannot contain NULLs, taken as a whole without unpacking.
+         */
+        const auto size = attribute_vector.size();
+        const auto search_value = static_cast<uint32_t>(value_id);
+        const auto null_value_id = static_cast<uint32_t>(base_segment.null_value_id());
+
+        auto block = std::array<uint32_t, SimdBp128Packing::block_size>{};
+        attribute_vector.for_each_block([&](const size_t block_begin, const uint8_t bit_size,
+                                            const uint128_t* packed_block) {
+          const auto max_value_id = (uint64_t{1} << bit_size) - 1;
+
+          auto block_matches_all = false;
+          if (search_value > max_value_id) {
+            if (!comparator(uint32_t{0}, search_value)) return;
+            block_matches_all = null_value_id > max_value_id;
+          }
+
+          if (!block_matches_all) SimdBp128Packing::unpack_block(packed_block, block.data(), bit_size);
+
+          for (auto offset = size_t{0}; offset < block.size() && block_begin + offset < size;
+               offset += SIMD_SCAN_BLOCK_SIZE) {
+            auto mask = ~uint64_t{0};
+            if (!block_matches_all) {
+              const auto* values = block.data() + offset;
+              mask = simd_compare_block(values, search_value, comparator) &
+                     simd_compare_block(values, null_value_id, std::not_equal_to<void>{});
+            }
+            simd_append_matches(mask, block_begin + offset, size, chunk_id, matches_out);
+          }
+        });
+        scanned = true;
+      }
+    });
+    return scanned;
+  };
+
   auto left_iterable = create_iterable_from_attribute_vector(base_segment);
 
   if (_right_value_matches_all(base_segment, search_value_id)) {
+    // All rows but the NULLs match
+    if (simd_scan(std::not_equal_to<void>{}, base_segment.null_value_id())) return;
+
     left_iterable.with_iterators(mapped_chunk_offsets.get(), [&](auto left_it, auto left_end) {
       static const auto always_true = [](const auto&) { return true; };
       this->_unary_scan(always_true, left_it, left_end, chunk_id, matches_out);
@@ -135,8 +257,10 @@ void SingleColumnTableScanImpl::handle_segment(const BaseDictionarySegment& base
     return;
   }
 
-  left_iterable.with_iterators(mapped_chunk_offsets.get(), [&](auto left_it, auto left_end) {
-    this->_with_operator_for_dict_segment_scan(_predicate_condition, [&](auto comparator) {
+  this->_with_operator_for_dict_segment_scan(_predicate_condition, [&](auto comparator) {
+    if (simd_scan(comparator, search_value_id)) return;
+
+    left_iterable.with_iterators(mapped_chunk_offsets.get(), [&](auto left_it, auto left_end) {
       this->_unary_scan_with_value(comparator, left_it, left_end, search_value_id, chunk_id, matches_out);
     });
   });
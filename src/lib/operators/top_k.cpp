@@ -0,0 +1,262 @@
+#include "top_k.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "expression/evaluation/expression_evaluator.hpp"
+#include "expression/expression_utils.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "sort/normalized_sort_keys.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// The best rows of one chunk, in sorted order, with the keys and strings that NormalizedSortKeys::less() compares
+struct Candidates {
+  std::vector<uint8_t> keys;
+  std::vector<std::string> strings;
+  std::vector<RowID> row_ids;
+};
+
+Candidates find_chunk_candidates(const NormalizedSortKeys& normalized_keys, const Chunk& chunk, const ChunkID chunk_id,
+                                 const size_t row_count) {
+  const auto key_width = normalized_keys.key_width();
+  const auto string_count = normalized_keys.string_count();
+  const auto chunk_size = chunk.size();
+
+  auto keys = std::vector<uint8_t>(chunk_size * key_width);
+  auto strings = std::vector<std::string>(chunk_size * string_count);
+  normalized_keys.encode_chunk(chunk, keys.data(), strings.data());
+
+  // Rows with equal keys are ordered by their position, so that the result is the same as that of a stable sort
+  const auto less = [&](const ChunkOffset left, const ChunkOffset right) {
+    const auto* left_key = &keys[left * key_width];
+    const auto* left_strings = strings.data() + left * string_count;
+    const auto* right_key = &keys[right * key_width];
+    const auto* right_strings = strings.data() + right * string_count;
+
+    if (normalized_keys.less(left_key, left_strings, right_key, right_strings)) return true;
+    if (normalized_keys.less(right_key, right_strings, left_key, left_strings)) return false;
+    return left < right;
+  };
+
+  // Max-heap of the best rows seen so far, i.e., its front is the worst of them
+  auto heap = std::vector<ChunkOffset>{};
+  heap.reserve(std::min(row_count, static_cast<size_t>(chunk_size)));
+
+  for (ChunkOffset chunk_offset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+    if (heap.size() < row_count) {
+      heap.emplace_back(chunk_offset);
+      std::push_heap(heap.begin(), heap.end(), less);
+    } else if (less(chunk_offset, heap.front())) {
+      std::pop_heap(heap.begin(), heap.end(), less);
+      heap.back() = chunk_offset;
+      std::push_heap(heap.begin(), heap.end(), less);
+    }
+  }
+
+  std::sort_heap(heap.begin(), heap.end(), less);
+
+  // Only keep the keys and strings of the winning rows
+  auto candidates = Candidates{};
+  candidates.keys.reserve(heap.size() * key_width);
+  candidates.strings.reserve(heap.size() * string_count);
+  candidates.row_ids.reserve(heap.size());
+
+  for (const auto chunk_offset : heap) {
+    const auto key_begin = keys.begin() + chunk_offset * key_width;
+    candidates.keys.insert(candidates.keys.end(), key_begin, key_begin + key_width);
+
+    const auto strings_begin = strings.begin() + chunk_offset * string_count;
+    candidates.strings.insert(candidates.strings.end(), std::make_move_iterator(strings_begin),
+                              std::make_move_iterator(strings_begin + string_count));
+
+    candidates.row_ids.emplace_back(RowID{chunk_id, chunk_offset});
+  }
+
+  return candidates;
+}
+
+}  // namespace
+
+TopK::TopK(const std::shared_ptr<const AbstractOperator>& in, const std::vector<SortColumnDefinition>& sort_definitions,
+           const std::shared_ptr<AbstractExpression>& row_count_expression)
+    : AbstractReadOnlyOperator(OperatorType::TopK, in),
+      _sort_definitions(sort_definitions),
+      _row_count_expression(row_count_expression) {
+  Assert(!_sort_definitions.empty(), "Expected at least one sort definition");
+}
+
+const std::string TopK::name() const { return "TopK"; }
+
+const std::string TopK::description(DescriptionMode description_mode) const {
+  return name() + " (" + _row_count_expression->as_column_name() + ")";
+}
+
+const std::vector<SortColumnDefinition>& TopK::sort_definitions() const { return _sort_definitions; }
+
+std::shared_ptr<AbstractExpression> TopK::row_count_expression() const { return _row_count_expression; }
+
+std::shared_ptr<AbstractOperator> TopK::_on_deep_copy(
+    const std::shared_ptr<AbstractOperator>& copied_input_left,
+    const std::shared_ptr<AbstractOperator>& copied_input_right) const {
+  return std::make_shared<TopK>(copied_input_left, _sort_definitions, _row_count_expression->deep_copy());
+}
+
+std::shared_ptr<const Table> TopK::_on_execute() {
+  const auto input_table = input_table_left();
+
+  const auto row_count_expression_result =
+      ExpressionEvaluator{}.evaluate_expression_to_result<int64_t>(*_row_count_expression);
+  Assert(row_count_expression_result->size() == 1, "Expected exactly one row for TopK");
+  Assert(!row_count_expression_result->is_null(0), "Expected non-null for TopK");
+
+  const auto signed_row_count = row_count_expression_result->value(0);
+  Assert(signed_row_count >= 0, "Can't get the top of a negative number of rows");
+
+  const auto row_count = static_cast<size_t>(signed_row_count);
+
+  const auto normalized_keys = NormalizedSortKeys{*input_table, _sort_definitions};
+  const auto key_width = normalized_keys.key_width();
+  const auto string_count = normalized_keys.string_count();
+
+  auto output_table = std::make_shared<Table>(input_table->column_definitions(), TableType::References);
+  if (row_count == 0) return output_table;
+
+  /**
+   * 1. Find the best rows of each chunk
+   */
+  const auto chunk_count = input_table->chunk_count();
+  auto candidates_by_chunk = std::vector<Candidates>(chunk_count);
+
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(chunk_count);
+
+  for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+      candidates_by_chunk[chunk_id] =
+          find_chunk_candidates(normalized_keys, *input_table->get_chunk(chunk_id), chunk_id, row_count);
+    }));
+    jobs.back()->schedule();
+  }
+
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  /**
+   * 2. Merge the sorted candidates of all chunks. The heap holds one cursor per chunk that still has candidates. On
+   *    equal keys, the chunk with the lower ChunkID wins, so that the order of the input is kept.
+   */
+  struct Cursor {
+    ChunkID chunk_id;
+    size_t index;
+  };
+
+  const auto cursor_less = [&](const Cursor& left, const Cursor& right) {
+    const auto& left_candidates = candidates_by_chunk[left.chunk_id];
+    const auto& right_candidates = candidates_by_chunk[right.chunk_id];
+    const auto* left_key = &left_candidates.keys[left.index * key_width];
+    const auto* left_strings = left_candidates.strings.data() + left.index * string_count;
+    const auto* right_key = &right_candidates.keys[right.index * key_width];
+    const auto* right_strings = right_candidates.strings.data() + right.index * string_count;
+
+    if (normalized_keys.less(left_key, left_strings, right_key, right_strings)) return true;
+    if (normalized_keys.less(right_key, right_strings, left_key, left_strings)) return false;
+    return left.chunk_id < right.chunk_id;
+  };
+
+  // std::push_heap and std::pop_heap build a max-heap, so the comparison is inverted to get the smallest row first
+  const auto cursor_greater = [&](const Cursor& left, const Cursor& right) { return cursor_less(right, left); };
+
+  auto cursors = std::vector<Cursor>{};
+  for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+    if (!candidates_by_chunk[chunk_id].row_ids.empty()) cursors.emplace_back(Cursor{chunk_id, 0});
+  }
+  std::make_heap(cursors.begin(), cursors.end(), cursor_greater);
+
+  auto top_row_ids = PosList{};
+  top_row_ids.reserve(std::min(row_count, static_cast<size_t>(input_table->row_count())));
+
+  while (top_row_ids.size() < row_count && !cursors.empty()) {
+    std::pop_heap(cursors.begin(), cursors.end(), cursor_greater);
+    auto& cursor = cursors.back();
+    const auto& candidates = candidates_by_chunk[cursor.chunk_id];
+
+    top_row_ids.emplace_back(candidates.row_ids[cursor.index]);
+
+    ++cursor.index;
+    if (cursor.index < candidates.row_ids.size()) {
+      std::push_heap(cursors.begin(), cursors.end(), cursor_greater);
+    } else {
+      cursors.pop_back();
+    }
+  }
+
+  if (top_row_ids.empty()) return output_table;
+
+  /**
+   * 3. Create the output. For reference tables, the RowIDs are resolved using the PosLists of the input. Columns that
+   *    share the PosLists of the input share the PosList of the output as well.
+   */
+  auto output_segments = Segments{};
+  auto output_pos_lists = std::map<std::vector<std::shared_ptr<const PosList>>, std::shared_ptr<const PosList>>{};
+
+  for (ColumnID column_id{0}; column_id < input_table->column_count(); ++column_id) {
+    if (input_table->type() == TableType::Data) {
+      auto& output_pos_list = output_pos_lists[{}];
+      if (!output_pos_list) output_pos_list = std::make_shared<PosList>(top_row_ids);
+
+      output_segments.emplace_back(std::make_shared<ReferenceSegment>(input_table, column_id, output_pos_list));
+      continue;
+    }
+
+    auto input_pos_lists = std::vector<std::shared_ptr<const PosList>>(chunk_count);
+    auto referenced_table = std::shared_ptr<const Table>{};
+    auto referenced_column_id = ColumnID{0};
+
+    for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto reference_segment =
+          std::static_pointer_cast<const ReferenceSegment>(input_table->get_chunk(chunk_id)->get_segment(column_id));
+      input_pos_lists[chunk_id] = reference_segment->pos_list();
+      referenced_table = reference_segment->referenced_table();
+      referenced_column_id = reference_segment->referenced_column_id();
+    }
+
+    auto& output_pos_list = output_pos_lists[input_pos_lists];
+    if (!output_pos_list) {
+      auto resolved_row_ids = std::make_shared<PosList>(top_row_ids.size());
+      for (auto row_index = size_t{0}; row_index < top_row_ids.size(); ++row_index) {
+        const auto& row_id = top_row_ids[row_index];
+        (*resolved_row_ids)[row_index] = (*input_pos_lists[row_id.chunk_id])[row_id.chunk_offset];
+      }
+      output_pos_list = resolved_row_ids;
+    }
+
+    output_segments.emplace_back(
+        std::make_shared<ReferenceSegment>(referenced_table, referenced_column_id, output_pos_list));
+  }
+
+  output_table->append_chunk(output_segments);
+
+  return output_table;
+}
+
+void TopK::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {
+  expression_set_parameters(_row_count_expression, parameters);
+}
+
+void TopK::_on_set_transaction_context(const std::weak_ptr<TransactionContext>& transaction_context) {
+  expression_set_transaction_context(_row_count_expression, transaction_context);
+}
+
+}  // namespace opossum
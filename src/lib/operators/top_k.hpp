@@ -0,0 +1,49 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "abstract_read_only_operator.hpp"
+#include "expression/abstract_expression.hpp"
+#include "sort.hpp"
+
+namespace opossum {
+
+/**
+ * Returns the first rows of the input as they would be ordered by Sort, i.e., the equivalent of a Limit on top of a
+ * Sort. The number of rows is given by row_count_expression, which is evaluated just like in Limit.
+ *
+ * Instead of sorting the entire input, every chunk keeps the best row_count rows in a bounded heap, in parallel. The
+ * (already sorted) heaps of all chunks are merged at the end. Only the winning rows are kept after a chunk has been
+ * processed, so the memory needed for the result is in O(row_count) per chunk, not in O(input rows). Rows with equal
+ * sort values keep their order from the input, just like in Sort.
+ *
+ * The output consists of a single chunk of ReferenceSegments.
+ */
+class TopK : public AbstractReadOnlyOperator {
+ public:
+  TopK(const std::shared_ptr<const AbstractOperator>& in, const std::vector<SortColumnDefinition>& sort_definitions,
+       const std::shared_ptr<AbstractExpression>& row_count_expression);
+
+  const std::string name() const override;
+  const std::string description(DescriptionMode description_mode) const override;
+
+  const std::vector<SortColumnDefinition>& sort_definitions() const;
+  std::shared_ptr<AbstractExpression> row_count_expression() const;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+  std::shared_ptr<AbstractOperator> _on_deep_copy(
+      const std::shared_ptr<AbstractOperator>& copied_input_left,
+      const std::shared_ptr<AbstractOperator>& copied_input_right) const override;
+  void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
+  void _on_set_transaction_context(const std::weak_ptr<TransactionContext>& transaction_context) override;
+
+ private:
+  const std::vector<SortColumnDefinition> _sort_definitions;
+  std::shared_ptr<AbstractExpression> _row_count_expression;
+};
+
+}  // namespace opossum
@@ -1,13 +1,18 @@
 #include "union_positions.hpp"
 
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
 #include "storage/chunk.hpp"
 #include "storage/reference_segment.hpp"
 #include "storage/table.hpp"
@@ -23,7 +28,11 @@
  * Each element of this VirtualPosList references a row in a ReferenceMatrix by index. This way, if two values need to
  * be swapped while sorting, only two indices need to swapped instead of a RowID for each column in the
  * ReferenceMatrices.
+ * The VirtualPosLists are sorted with a parallel radix sort. First, the rows are partitioned by the ChunkID in the
+ * first column of the ReferenceMatrix. Then, each partition is sorted by the ChunkOffset in that column. Only rows
+ * that are equal in the first column are compared by their remaining columns.
  * Using a implementation derived from std::set_union, the two virtual pos lists are merged into the result table.
+ * Since both inputs are partitioned the same way, the partitions are merged in parallel.
  *
  *
  * ### About ReferenceMatrices
@@ -50,9 +59,77 @@
  * ### TODO(anybody) for potential performance improvements
  * Instead of using a ReferenceMatrix, consider using a linked list of RowIDs for each row. Since most of the sorting
  *      will depend on the leftmost column, this way most of the time no remote memory would need to be accessed
- *
- * The sorting, which is the most expensive part of this operator, could probably be parallelized.
  */
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Number of rows that one job partitions, sorts or merges. Small partitions are grouped into the same job.
+constexpr auto ROWS_PER_JOB = size_t{1} << 16;
+
+// Partitions with fewer rows are sorted with std::sort instead of the radix sort
+constexpr auto MIN_RADIX_SORT_ROW_COUNT = size_t{256};
+
+/**
+ * The sort keys consist of the ChunkOffset in the upper and the row index in the ReferenceMatrix in the lower 32 bits.
+ * This sorts the keys of one partition by their ChunkOffset with an LSD radix sort of 8 bits per pass. Passes for
+ * digits that are zero for all keys are skipped. The sort is stable.
+ */
+void radix_sort_by_chunk_offset(uint64_t* keys, const size_t key_count, uint64_t* buffer) {
+  if (key_count < MIN_RADIX_SORT_ROW_COUNT) {
+    std::sort(keys, keys + key_count,
+              [](const uint64_t left, const uint64_t right) { return left >> 32 < right >> 32; });
+    return;
+  }
+
+  auto max_chunk_offset = uint64_t{0};
+  for (auto key_idx = size_t{0}; key_idx < key_count; ++key_idx) {
+    max_chunk_offset = std::max(max_chunk_offset, keys[key_idx] >> 32);
+  }
+
+  for (auto shift = 32u; shift < 64u && (max_chunk_offset >> (shift - 32u)) > 0; shift += 8u) {
+    auto digit_offsets = std::array<size_t, 257>{};
+    for (auto key_idx = size_t{0}; key_idx < key_count; ++key_idx) {
+      ++digit_offsets[((keys[key_idx] >> shift) & 0xFFu) + 1];
+    }
+    std::partial_sum(digit_offsets.begin(), digit_offsets.end(), digit_offsets.begin());
+
+    for (auto key_idx = size_t{0}; key_idx < key_count; ++key_idx) {
+      buffer[digit_offsets[(keys[key_idx] >> shift) & 0xFFu]++] = keys[key_idx];
+    }
+    std::copy(buffer, buffer + key_count, keys);
+  }
+}
+
+/**
+ * Splits the partitions into ranges [begin, end) of about ROWS_PER_JOB rows and runs @param functor for each of them
+ * in its own job
+ */
+template <typename RowCountFunctor, typename Functor>
+void for_each_partition_range_in_parallel(const size_t partition_count, const RowCountFunctor& row_count,
+                                          const Functor& functor) {
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+
+  auto range_begin = size_t{0};
+  auto range_row_count = size_t{0};
+  for (auto partition_idx = size_t{0}; partition_idx < partition_count; ++partition_idx) {
+    range_row_count += row_count(partition_idx);
+
+    if (range_row_count >= ROWS_PER_JOB || partition_idx + 1 == partition_count) {
+      const auto range_end = partition_idx + 1;
+      jobs.emplace_back(std::make_shared<JobTask>([&, range_begin, range_end]() { functor(range_begin, range_end); }));
+      jobs.back()->schedule();
+
+      range_begin = range_end;
+      range_row_count = 0;
+    }
+  }
+
+  CurrentScheduler::wait_for_tasks(jobs);
+}
+
+}  // namespace
+
 namespace opossum {
 
 UnionPositions::UnionPositions(const std::shared_ptr<const AbstractOperator>& left,
@@ -82,30 +159,103 @@ std::shared_ptr<const Table> UnionPositions::_on_execute() {
   auto reference_matrix_right = _build_reference_matrix(input_table_right());
 
   /**
-   * Init the virtual pos lists
+   * Sort the virtual pos lists so that they bring the rows in their respective ReferenceMatrix into order.
+   * This is necessary for merging them.
+   * Both are partitioned by the ChunkIDs in their first column, with an additional partition for NULLs.
    */
-  VirtualPosList virtual_pos_list_left(input_table_left()->row_count(), 0u);
-  std::iota(virtual_pos_list_left.begin(), virtual_pos_list_left.end(), 0u);
-  VirtualPosList virtual_pos_list_right(input_table_right()->row_count(), 0u);
-  std::iota(virtual_pos_list_right.begin(), virtual_pos_list_right.end(), 0u);
+  auto max_chunk_id = size_t{0};
+  for (const auto* reference_matrix : {&reference_matrix_left, &reference_matrix_right}) {
+    for (const auto& row_id : reference_matrix->front()) {
+      if (row_id.chunk_id == INVALID_CHUNK_ID) continue;
+      max_chunk_id = std::max(max_chunk_id, static_cast<size_t>(row_id.chunk_id));
+    }
+  }
+  const auto partition_count = max_chunk_id + 2;
+  const auto sorted_left = _sort_reference_matrix(reference_matrix_left, partition_count);
+  const auto sorted_right = _sort_reference_matrix(reference_matrix_right, partition_count);
 
   /**
-   * Sort the virtual pos lists so that they bring the rows in their respective ReferenceMatrix into order.
-   * This is necessary for merging them.
-   * PERFORMANCE NOTE: These sorts take the vast majority of time spend in this Operator
+   * Merge the partitions of reference_matrix_left and reference_matrix_right. The implementation is derived from
+   * std::set_union(). Each job writes the merged rows of its partitions to its own ReferenceMatrix.
    */
-  std::sort(virtual_pos_list_left.begin(), virtual_pos_list_left.end(),
-            VirtualPosListCmpContext{reference_matrix_left});
-  std::sort(virtual_pos_list_right.begin(), virtual_pos_list_right.end(),
-            VirtualPosListCmpContext{reference_matrix_right});
+  auto merged_matrices = std::vector<ReferenceMatrix>{};
+  auto merged_matrix_by_partition = std::vector<size_t>(partition_count);
+  {
+    // Assign the jobs their ReferenceMatrices before scheduling them, so that they do not reallocate the vector
+    auto job_count = size_t{0};
+    auto range_row_count = size_t{0};
+    for (auto partition_idx = size_t{0}; partition_idx < partition_count; ++partition_idx) {
+      merged_matrix_by_partition[partition_idx] = job_count;
+      range_row_count +=
+          sorted_left.partition_offsets[partition_idx + 1] - sorted_left.partition_offsets[partition_idx];
+      range_row_count +=
+          sorted_right.partition_offsets[partition_idx + 1] - sorted_right.partition_offsets[partition_idx];
+      if (range_row_count >= ROWS_PER_JOB || partition_idx + 1 == partition_count) {
+        ++job_count;
+        range_row_count = 0;
+      }
+    }
+    merged_matrices.resize(job_count, ReferenceMatrix(reference_matrix_left.size()));
+  }
+
+  const auto partition_row_count = [&](const size_t partition_idx) {
+    return sorted_left.partition_offsets[partition_idx + 1] - sorted_left.partition_offsets[partition_idx] +
+           sorted_right.partition_offsets[partition_idx + 1] - sorted_right.partition_offsets[partition_idx];
+  };
+
+  for_each_partition_range_in_parallel(partition_count, partition_row_count, [&](const size_t partition_begin,
+                                                                                 const size_t partition_end) {
+    auto& merged_matrix = merged_matrices[merged_matrix_by_partition[partition_begin]];
+
+    // Adds the row `row_idx` from `reference_matrix` to the merged rows
+    const auto emit_row = [&](const ReferenceMatrix& reference_matrix, size_t row_idx) {
+      for (size_t pos_list_idx = 0; pos_list_idx < merged_matrix.size(); ++pos_list_idx) {
+        merged_matrix[pos_list_idx].emplace_back(reference_matrix[pos_list_idx][row_idx]);
+      }
+    };
+
+    auto left_idx = sorted_left.partition_offsets[partition_begin];
+    auto right_idx = sorted_right.partition_offsets[partition_begin];
+    const auto left_end = sorted_left.partition_offsets[partition_end];
+    const auto right_end = sorted_right.partition_offsets[partition_end];
+    const auto& virtual_pos_list_left = sorted_left.virtual_pos_list;
+    const auto& virtual_pos_list_right = sorted_right.virtual_pos_list;
+
+    for (auto& pos_list : merged_matrix) pos_list.reserve(left_end - left_idx + right_end - right_idx);
+
+    // The partitions are ordered by their ChunkIDs, so the range of partitions can be merged in one go
+    for (; left_idx < left_end || right_idx < right_end;) {
+      /**
+       * Begin derived from std::union()
+       */
+      if (left_idx == left_end) {
+        emit_row(reference_matrix_right, virtual_pos_list_right[right_idx]);
+        ++right_idx;
+      } else if (right_idx == right_end) {
+        emit_row(reference_matrix_left, virtual_pos_list_left[left_idx]);
+        ++left_idx;
+      } else if (_compare_reference_matrix_rows(reference_matrix_right, virtual_pos_list_right[right_idx],
+                                                reference_matrix_left, virtual_pos_list_left[left_idx])) {
+        emit_row(reference_matrix_right, virtual_pos_list_right[right_idx]);
+        ++right_idx;
+      } else {
+        emit_row(reference_matrix_left, virtual_pos_list_left[left_idx]);
+
+        if (!_compare_reference_matrix_rows(reference_matrix_left, virtual_pos_list_left[left_idx],
+                                            reference_matrix_right, virtual_pos_list_right[right_idx])) {
+          ++right_idx;
+        }
+        ++left_idx;
+      }
+      /**
+       * End derived from std::union()
+       */
+    }
+  });
 
   /**
    * Build result table
    */
-  auto left_idx = size_t{0};
-  auto right_idx = size_t{0};
-  const auto num_rows_left = virtual_pos_list_left.size();
-  const auto num_rows_right = virtual_pos_list_right.size();
 
   // Somewhat random way to decide on a chunk size.
   const auto out_chunk_size = std::max(input_table_left()->max_chunk_size(), input_table_right()->max_chunk_size());
@@ -116,13 +266,6 @@ std::shared_ptr<const Table> UnionPositions::_on_execute() {
   std::vector<std::shared_ptr<PosList>> pos_lists(reference_matrix_left.size());
   std::generate(pos_lists.begin(), pos_lists.end(), [&] { return std::make_shared<PosList>(); });
 
-  // Adds the row `row_idx` from `reference_matrix` to the pos_lists we're currently building
-  const auto emit_row = [&](const ReferenceMatrix& reference_matrix, size_t row_idx) {
-    for (size_t pos_list_idx = 0; pos_list_idx < pos_lists.size(); ++pos_list_idx) {
-      pos_lists[pos_list_idx]->emplace_back(reference_matrix[pos_list_idx][row_idx]);
-    }
-  };
-
   // Turn 'pos_lists' into a new chunk and append it to the table
   const auto emit_chunk = [&]() {
     Segments output_segments;
@@ -143,51 +286,33 @@ std::shared_ptr<const Table> UnionPositions::_on_execute() {
   };
 
   /**
-   * This loop merges reference_matrix_left and reference_matrix_right into the result table. The implementation is
-   * derived from std::set_union() and only differs from it insofar as that it builds the output table at the same
-   * time as merging the two ReferenceMatrices
+   * Split the merged rows of all jobs into chunks
    */
-  size_t chunk_row_idx = 0;
-  for (; left_idx < num_rows_left || right_idx < num_rows_right;) {
-    /**
-     * Begin derived from std::union()
-     */
-    if (left_idx == num_rows_left) {
-      emit_row(reference_matrix_right, virtual_pos_list_right[right_idx]);
-      ++right_idx;
-    } else if (right_idx == num_rows_right) {
-      emit_row(reference_matrix_left, virtual_pos_list_left[left_idx]);
-      ++left_idx;
-    } else if (_compare_reference_matrix_rows(reference_matrix_right, virtual_pos_list_right[right_idx],
-                                              reference_matrix_left, virtual_pos_list_left[left_idx])) {
-      emit_row(reference_matrix_right, virtual_pos_list_right[right_idx]);
-      ++right_idx;
-    } else {
-      emit_row(reference_matrix_left, virtual_pos_list_left[left_idx]);
-
-      if (!_compare_reference_matrix_rows(reference_matrix_left, virtual_pos_list_left[left_idx],
-                                          reference_matrix_right, virtual_pos_list_right[right_idx])) {
-        ++right_idx;
+  for (const auto& merged_matrix : merged_matrices) {
+    const auto merged_row_count = merged_matrix.front().size();
+
+    for (auto row_idx = size_t{0}; row_idx < merged_row_count;) {
+      const auto chunk_row_count = pos_lists.front()->size();
+      const auto row_count = std::min(out_chunk_size - chunk_row_count, merged_row_count - row_idx);
+
+      for (size_t pos_list_idx = 0; pos_list_idx < pos_lists.size(); ++pos_list_idx) {
+        const auto& merged_pos_list = merged_matrix[pos_list_idx];
+        pos_lists[pos_list_idx]->insert(pos_lists[pos_list_idx]->end(), merged_pos_list.begin() + row_idx,
+                                        merged_pos_list.begin() + row_idx + row_count);
+      }
+      row_idx += row_count;
+
+      /**
+       * Emit a completed chunk
+       */
+      if (pos_lists.front()->size() == out_chunk_size) {
+        emit_chunk();
+        std::generate(pos_lists.begin(), pos_lists.end(), [&] { return std::make_shared<PosList>(); });
       }
-      ++left_idx;
-    }
-    ++chunk_row_idx;
-    /**
-     * End derived from std::union()
-     */
-
-    /**
-     * Emit a completed chunk
-     */
-    if (chunk_row_idx == out_chunk_size && out_chunk_size != 0) {
-      emit_chunk();
-
-      chunk_row_idx = 0;
-      std::generate(pos_lists.begin(), pos_lists.end(), [&] { return std::make_shared<PosList>(); });
     }
   }
 
-  if (chunk_row_idx != 0) {
+  if (!pos_lists.front()->empty()) {
     emit_chunk();
   }
 
@@ -332,6 +457,114 @@ UnionPositions::ReferenceMatrix UnionPositions::_build_reference_matrix(
   return reference_matrix;
 }
 
+UnionPositions::PartitionedVirtualPosList UnionPositions::_sort_reference_matrix(
+    const ReferenceMatrix& reference_matrix, const size_t partition_count) const {
+  const auto& first_pos_list = reference_matrix.front();
+  const auto row_count = first_pos_list.size();
+  Assert(row_count <= std::numeric_limits<uint32_t>::max(), "Row indices of the ReferenceMatrix exceed 32 bits");
+
+  const auto partition_of = [&](const RowID& row_id) {
+    // NULL_ROW_ID sorts last, since its ChunkID is the largest one
+    if (row_id.chunk_id == INVALID_CHUNK_ID) return partition_count - 1;
+    return static_cast<size_t>(row_id.chunk_id);
+  };
+
+  /**
+   * 1. Count the rows per partition, in blocks of ROWS_PER_JOB rows
+   */
+  const auto block_count = std::max(size_t{1}, (row_count + ROWS_PER_JOB - 1) / ROWS_PER_JOB);
+  auto histograms = std::vector<std::vector<size_t>>(block_count, std::vector<size_t>(partition_count));
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(block_count);
+  for (auto block_idx = size_t{0}; block_idx < block_count; ++block_idx) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, block_idx]() {
+      auto& histogram = histograms[block_idx];
+      const auto block_end = std::min((block_idx + 1) * ROWS_PER_JOB, row_count);
+      for (auto row_idx = block_idx * ROWS_PER_JOB; row_idx < block_end; ++row_idx) {
+        ++histogram[partition_of(first_pos_list[row_idx])];
+      }
+    }));
+    jobs.back()->schedule();
+  }
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  /**
+   * 2. Compute the offsets of the partitions and, within them, of the blocks
+   */
+  auto result = PartitionedVirtualPosList{};
+  result.partition_offsets.resize(partition_count + 1);
+
+  auto offset = size_t{0};
+  for (auto partition_idx = size_t{0}; partition_idx < partition_count; ++partition_idx) {
+    result.partition_offsets[partition_idx] = offset;
+    for (auto& histogram : histograms) {
+      const auto block_row_count = histogram[partition_idx];
+      histogram[partition_idx] = offset;
+      offset += block_row_count;
+    }
+  }
+  result.partition_offsets[partition_count] = offset;
+
+  /**
+   * 3. Scatter the sort keys of the rows to their partitions
+   */
+  auto keys = std::vector<uint64_t>(row_count);
+
+  jobs.clear();
+  for (auto block_idx = size_t{0}; block_idx < block_count; ++block_idx) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, block_idx]() {
+      auto& write_offsets = histograms[block_idx];
+      const auto block_end = std::min((block_idx + 1) * ROWS_PER_JOB, row_count);
+      for (auto row_idx = block_idx * ROWS_PER_JOB; row_idx < block_end; ++row_idx) {
+        const auto& row_id = first_pos_list[row_idx];
+        keys[write_offsets[partition_of(row_id)]++] = static_cast<uint64_t>(row_id.chunk_offset) << 32 | row_idx;
+      }
+    }));
+    jobs.back()->schedule();
+  }
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  /**
+   * 4. Sort each partition by the ChunkOffsets. Rows with the same RowID in the first column are then sorted by the
+   * remaining columns.
+   */
+  result.virtual_pos_list.resize(row_count);
+  auto buffer = std::vector<uint64_t>(row_count);
+
+  const auto partition_row_count = [&](const size_t partition_idx) {
+    return result.partition_offsets[partition_idx + 1] - result.partition_offsets[partition_idx];
+  };
+
+  for_each_partition_range_in_parallel(partition_count, partition_row_count, [&](const size_t partition_begin,
+                                                                                 const size_t partition_end) {
+    for (auto partition_idx = partition_begin; partition_idx < partition_end; ++partition_idx) {
+      const auto begin = result.partition_offsets[partition_idx];
+      const auto end = result.partition_offsets[partition_idx + 1];
+      radix_sort_by_chunk_offset(keys.data() + begin, end - begin, buffer.data() + begin);
+
+      for (auto row_idx = begin; row_idx < end; ++row_idx) {
+        result.virtual_pos_list[row_idx] = keys[row_idx] & std::numeric_limits<uint32_t>::max();
+      }
+
+      if (reference_matrix.size() == 1) continue;
+
+      for (auto run_begin = begin; run_begin < end;) {
+        auto run_end = run_begin + 1;
+        while (run_end < end && keys[run_end] >> 32 == keys[run_begin] >> 32) ++run_end;
+
+        if (run_end - run_begin > 1) {
+          std::sort(result.virtual_pos_list.begin() + run_begin, result.virtual_pos_list.begin() + run_end,
+                    VirtualPosListCmpContext{reference_matrix});
+        }
+        run_begin = run_end;
+      }
+    }
+  });
+
+  return result;
+}
+
 bool UnionPositions::_compare_reference_matrix_rows(const ReferenceMatrix& left_matrix, size_t left_row_idx,
                                                     const ReferenceMatrix& right_matrix, size_t right_row_idx) const {
   for (size_t column_idx = 0; column_idx < left_matrix.size(); ++column_idx) {
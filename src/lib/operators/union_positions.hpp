@@ -83,10 +83,20 @@ class UnionPositions : public AbstractReadOnlyOperator {
    * Needs to know about the ReferenceMatrix that the VirtualPosList references and is thus dubbed a "Context".
    */
   struct VirtualPosListCmpContext {
-    ReferenceMatrix& reference_matrix;
+    const ReferenceMatrix& reference_matrix;
     bool operator()(size_t left, size_t right) const;
   };
 
+  /**
+   * The rows of a ReferenceMatrix, sorted and partitioned by the ChunkID in their first column. The rows of partition
+   * p are virtual_pos_list[partition_offsets[p]] to virtual_pos_list[partition_offsets[p + 1] - 1]. Rows with
+   * INVALID_CHUNK_ID in their first column are in the last partition.
+   */
+  struct PartitionedVirtualPosList {
+    VirtualPosList virtual_pos_list;
+    std::vector<size_t> partition_offsets;
+  };
+
   std::shared_ptr<const Table> _on_execute() override;
 
   std::shared_ptr<AbstractOperator> _on_deep_copy(
@@ -107,6 +117,8 @@ class UnionPositions : public AbstractReadOnlyOperator {
   std::shared_ptr<const Table> _prepare_operator();
 
   UnionPositions::ReferenceMatrix _build_reference_matrix(const std::shared_ptr<const Table>& input_table) const;
+  UnionPositions::PartitionedVirtualPosList _sort_reference_matrix(const ReferenceMatrix& reference_matrix,
+                                                                   const size_t partition_count) const;
   bool _compare_reference_matrix_rows(const ReferenceMatrix& left_matrix, size_t left_row_idx,
                                       const ReferenceMatrix& right_matrix, size_t right_row_idx) const;
 
@@ -1,11 +1,15 @@
 #include "validate.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "concurrency/transaction_context.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
 #include "storage/reference_segment.hpp"
 #include "utils/assert.hpp"
 
@@ -28,6 +32,120 @@ bool is_row_visible(CommitID our_tid, CommitID snapshot_commit_id, ChunkOffset c
   return snapshot_commit_id < end_cid && ((snapshot_commit_id >= begin_cid) != (row_tid == our_tid));
 }
 
+/**
+ * Checks whether all rows of a chunk were committed before the snapshot, are not deleted, and are not locked by our
+ * own transaction, i.e., whether they are visible without deciding it row by row. This is the common case for chunks
+ * that are not modified anymore. The loop only has a single, well-predictable exit condition.
+ */
+bool all_rows_visible(TransactionID our_tid, CommitID snapshot_commit_id, ChunkOffset chunk_size,
+                      const MvccData& mvcc_data) {
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+    const auto row_visible = (mvcc_data.begin_cids[chunk_offset] <= snapshot_commit_id) &
+                             (mvcc_data.end_cids[chunk_offset] > snapshot_commit_id) &
+                             (mvcc_data.tids[chunk_offset].load() != our_tid);
+    if (!row_visible) return false;
+  }
+  return true;
+}
+
+// Returns the segments of the output chunk for the given input chunk, or no segments if no row is visible
+Segments validate_chunk(const std::shared_ptr<const Table>& in_table, const ChunkID chunk_id,
+                        const TransactionID our_tid, const CommitID snapshot_commit_id) {
+  const auto chunk_in = in_table->get_chunk(chunk_id);
+
+  Segments output_segments;
+  auto pos_list_out = std::make_shared<PosList>();
+  auto referenced_table = std::shared_ptr<const Table>();
+  const auto ref_segment_in = std::dynamic_pointer_cast<const ReferenceSegment>(chunk_in->get_segment(ColumnID{0}));
+
+  // If the segments in this chunk reference a segment, build a poslist for a reference segment.
+  if (ref_segment_in) {
+    DebugAssert(chunk_in->references_exactly_one_table(),
+                "Input to Validate contains a Chunk referencing more than one table.");
+
+    // Check all rows in the old poslist and put them in pos_list_out if they are visible.
+    referenced_table = ref_segment_in->referenced_table();
+    DebugAssert(referenced_table->has_mvcc(), "Trying to use Validate on a table that has no MVCC data");
+
+    const auto& pos_list_in = *ref_segment_in->pos_list();
+    pos_list_out->resize(pos_list_in.size());
+    auto pos_list_out_size = size_t{0};
+
+    // Consecutive RowIDs that reference the same chunk are validated as a group that takes the MVCC lock only once
+    auto group_begin = size_t{0};
+    while (group_begin < pos_list_in.size()) {
+      const auto referenced_chunk_id = pos_list_in[group_begin].chunk_id;
+      auto group_end = group_begin + 1;
+      while (group_end < pos_list_in.size() && pos_list_in[group_end].chunk_id == referenced_chunk_id) ++group_end;
+
+      // NULL_ROW_IDs (e.g., from outer joins) do not reference any chunk and are never visible
+      if (referenced_chunk_id != INVALID_CHUNK_ID) {
+        const auto mvcc_data = referenced_table->get_chunk(referenced_chunk_id)->get_scoped_mvcc_data_lock();
+
+        if (mvcc_data->all_rows_visible(snapshot_commit_id)) {
+          // The summary of the MVCC data shows that the whole group is visible, so the rows are not checked
+          std::copy(pos_list_in.begin() + group_begin, pos_list_in.begin() + group_end,
+                    pos_list_out->begin() + pos_list_out_size);
+          pos_list_out_size += group_end - group_begin;
+        } else {
+          for (auto row_index = group_begin; row_index < group_end; ++row_index) {
+            const auto& row_id = pos_list_in[row_index];
+            (*pos_list_out)[pos_list_out_size] = row_id;
+            pos_list_out_size += is_row_visible(our_tid, snapshot_commit_id, row_id.chunk_offset, *mvcc_data);
+          }
+        }
+      }
+
+      group_begin = group_end;
+    }
+
+    pos_list_out->resize(pos_list_out_size);
+
+    // Construct the actual ReferenceSegment objects and add them to the chunk.
+    for (ColumnID column_id{0}; column_id < chunk_in->column_count(); ++column_id) {
+      const auto reference_segment = std::static_pointer_cast<const ReferenceSegment>(chunk_in->get_segment(column_id));
+      const auto referenced_column_id = reference_segment->referenced_column_id();
+      auto ref_segment_out = std::make_shared<ReferenceSegment>(referenced_table, referenced_column_id, pos_list_out);
+      output_segments.push_back(ref_segment_out);
+    }
+
+    // Otherwise we have a Value- or DictionarySegment and simply iterate over all rows to build a poslist.
+  } else {
+    referenced_table = in_table;
+    DebugAssert(chunk_in->has_mvcc_data(), "Trying to use Validate on a table that has no MVCC data");
+    const auto mvcc_data = chunk_in->get_scoped_mvcc_data_lock();
+
+    const auto chunk_size = chunk_in->size();  // The compiler fails to optimize this in the for clause :(
+    pos_list_out->resize(chunk_size);
+
+    // For immutable chunks, the summary of the MVCC data usually shows that all rows are visible without checking them
+    if (mvcc_data->all_rows_visible(snapshot_commit_id) ||
+        all_rows_visible(our_tid, snapshot_commit_id, chunk_size, *mvcc_data)) {
+      // Fast path: All rows of the chunk are visible, so the per-row check (and its branches) can be skipped
+      for (auto i = 0u; i < chunk_size; i++) {
+        (*pos_list_out)[i] = RowID{chunk_id, i};
+      }
+    } else {
+      auto pos_list_out_size = size_t{0};
+      for (auto i = 0u; i < chunk_size; i++) {
+        (*pos_list_out)[pos_list_out_size] = RowID{chunk_id, i};
+        pos_list_out_size += is_row_visible(our_tid, snapshot_commit_id, i, *mvcc_data);
+      }
+      pos_list_out->resize(pos_list_out_size);
+    }
+
+    // Create actual ReferenceSegment objects.
+    for (ColumnID column_id{0}; column_id < chunk_in->column_count(); ++column_id) {
+      auto ref_segment_out = std::make_shared<ReferenceSegment>(referenced_table, column_id, pos_list_out);
+      output_segments.push_back(ref_segment_out);
+    }
+  }
+
+  if (pos_list_out->empty()) return {};
+
+  return output_segments;
+}
+
 }  // namespace
 
 Validate::Validate(const std::shared_ptr<AbstractOperator>& in)
@@ -56,67 +174,25 @@ std::shared_ptr<const Table> Validate::_on_execute(std::shared_ptr<TransactionCo
   const auto our_tid = transaction_context->transaction_id();
   const auto snapshot_commit_id = transaction_context->snapshot_commit_id();
 
-  for (ChunkID chunk_id{0}; chunk_id < in_table->chunk_count(); ++chunk_id) {
-    const auto chunk_in = in_table->get_chunk(chunk_id);
-
-    Segments output_segments;
-    auto pos_list_out = std::make_shared<PosList>();
-    auto referenced_table = std::shared_ptr<const Table>();
-    const auto ref_segment_in = std::dynamic_pointer_cast<const ReferenceSegment>(chunk_in->get_segment(ColumnID{0}));
-
-    // If the segments in this chunk reference a segment, build a poslist for a reference segment.
-    if (ref_segment_in) {
-      DebugAssert(chunk_in->references_exactly_one_table(),
-                  "Input to Validate contains a Chunk referencing more than one table.");
-
-      // Check all rows in the old poslist and put them in pos_list_out if they are visible.
-      referenced_table = ref_segment_in->referenced_table();
-      DebugAssert(referenced_table->has_mvcc(), "Trying to use Validate on a table that has no MVCC data");
+  // The chunks are validated in parallel. Their output segments are collected so that the order of the chunks is kept.
+  auto output_segments_by_chunk = std::vector<Segments>(in_table->chunk_count());
 
-      for (auto row_id : *ref_segment_in->pos_list()) {
-        const auto referenced_chunk = referenced_table->get_chunk(row_id.chunk_id);
-
-        auto mvcc_data = referenced_chunk->get_scoped_mvcc_data_lock();
-
-        if (is_row_visible(our_tid, snapshot_commit_id, row_id.chunk_offset, *mvcc_data)) {
-          pos_list_out->emplace_back(row_id);
-        }
-      }
-
-      // Construct the actual ReferenceSegment objects and add them to the chunk.
-      for (ColumnID column_id{0}; column_id < chunk_in->column_count(); ++column_id) {
-        const auto reference_segment =
-            std::static_pointer_cast<const ReferenceSegment>(chunk_in->get_segment(column_id));
-        const auto referenced_column_id = reference_segment->referenced_column_id();
-        auto ref_segment_out = std::make_shared<ReferenceSegment>(referenced_table, referenced_column_id, pos_list_out);
-        output_segments.push_back(ref_segment_out);
-      }
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(in_table->chunk_count());
 
-      // Otherwise we have a Value- or DictionarySegment and simply iterate over all rows to build a poslist.
-    } else {
-      referenced_table = in_table;
-      DebugAssert(chunk_in->has_mvcc_data(), "Trying to use Validate on a table that has no MVCC data");
-      const auto mvcc_data = chunk_in->get_scoped_mvcc_data_lock();
-
-      // Generate pos_list_out.
-      auto chunk_size = chunk_in->size();  // The compiler fails to optimize this in the for clause :(
-      for (auto i = 0u; i < chunk_size; i++) {
-        if (is_row_visible(our_tid, snapshot_commit_id, i, *mvcc_data)) {
-          pos_list_out->emplace_back(RowID{chunk_id, i});
-        }
-      }
+  for (ChunkID chunk_id{0}; chunk_id < in_table->chunk_count(); ++chunk_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+      output_segments_by_chunk[chunk_id] = validate_chunk(in_table, chunk_id, our_tid, snapshot_commit_id);
+    }));
+    jobs.back()->schedule();
+  }
 
-      // Create actual ReferenceSegment objects.
-      for (ColumnID column_id{0}; column_id < chunk_in->column_count(); ++column_id) {
-        auto ref_segment_out = std::make_shared<ReferenceSegment>(referenced_table, column_id, pos_list_out);
-        output_segments.push_back(ref_segment_out);
-      }
-    }
+  CurrentScheduler::wait_for_tasks(jobs);
 
-    if (!pos_list_out->empty() > 0) {
-      output->append_chunk(output_segments);
-    }
+  for (const auto& output_segments : output_segments_by_chunk) {
+    if (!output_segments.empty()) output->append_chunk(output_segments);
   }
+
   return output;
 }
 
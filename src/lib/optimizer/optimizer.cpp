@@ -16,6 +16,7 @@
 #include "strategy/join_ordering_rule.hpp"
 #include "strategy/predicate_pushdown_rule.hpp"
 #include "strategy/predicate_reordering_rule.hpp"
+#include "strategy/subselect_to_join_rule.hpp"
 #include "utils/performance_warning.hpp"
 
 /**
@@ -83,6 +84,13 @@ namespace opossum {
 std::shared_ptr<Optimizer> Optimizer::create_default_optimizer() {
   auto optimizer = std::make_shared<Optimizer>(100);
 
+  // Rewrite subselects into joins first, so that the following rules optimize the resulting joins as part of the LQP.
+  // Pruning needs to come afterwards, as the rewrite makes the columns of the subselects' correlated predicates
+  // available above them.
+  RuleBatch subselect_batch(RuleBatchExecutionPolicy::Once);
+  subselect_batch.add_rule(std::make_shared<SubselectToJoinRule>());
+  optimizer->add_rule_batch(subselect_batch);
+
   // Run pruning just once since the rule would otherwise insert the pruning ProjectionNodes multiple times.
   RuleBatch pruning_batch(RuleBatchExecutionPolicy::Once);
   pruning_batch.add_rule(std::make_shared<ColumnPruningRule>());
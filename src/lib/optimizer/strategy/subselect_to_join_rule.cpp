@@ -0,0 +1,457 @@
+#include "subselect_to_join_rule.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "expression/aggregate_expression.hpp"
+#include "expression/binary_predicate_expression.hpp"
+#include "expression/exists_expression.hpp"
+#include "expression/expression_functional.hpp"
+#include "expression/expression_utils.hpp"
+#include "expression/in_expression.hpp"
+#include "expression/lqp_select_expression.hpp"
+#include "expression/parameter_expression.hpp"
+#include "logical_query_plan/abstract_lqp_node.hpp"
+#include "logical_query_plan/aggregate_node.hpp"
+#include "logical_query_plan/join_node.hpp"
+#include "logical_query_plan/logical_plan_root_node.hpp"
+#include "logical_query_plan/lqp_utils.hpp"
+#include "logical_query_plan/predicate_node.hpp"
+#include "logical_query_plan/projection_node.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// An equality predicate `<inner column> = <parameter>` in a sub-LQP. outer_expression is the expression of the outer
+// LQP that the parameter stands for.
+struct CorrelatedPredicate {
+  std::shared_ptr<PredicateNode> predicate_node;
+  std::shared_ptr<AbstractExpression> inner_expression;
+  std::shared_ptr<AbstractExpression> outer_expression;
+};
+
+/**
+ * @return whether a JoinHash on lhs and rhs compares their values the same way the ExpressionEvaluator does. JoinHash
+ *         compares strings and numbers via a lexical cast.
+ */
+bool is_joinable(const AbstractExpression& lhs, const AbstractExpression& rhs) {
+  if (lhs.data_type() == DataType::Null || rhs.data_type() == DataType::Null) return false;
+  return (lhs.data_type() == DataType::String) == (rhs.data_type() == DataType::String);
+}
+
+/**
+ * @return the correlated equality predicates in lqp, which is (a copy of) the LQP of select_expression, or std::nullopt
+ *         if the parameters of select_expression are used anywhere else, as such a correlation cannot be removed.
+ */
+std::optional<std::vector<CorrelatedPredicate>> find_correlated_predicates(
+    const LQPSelectExpression& select_expression, const std::shared_ptr<AbstractLQPNode>& lqp) {
+  const auto find_parameter_idx = [&](const std::shared_ptr<AbstractExpression>& expression) -> std::optional<size_t> {
+    if (expression->type != ExpressionType::Parameter) return std::nullopt;
+
+    const auto& parameter_expression = static_cast<const ParameterExpression&>(*expression);
+    if (parameter_expression.parameter_expression_type != ParameterExpressionType::External) return std::nullopt;
+
+    const auto& parameter_ids = select_expression.parameter_ids;
+    const auto parameter_id_iter =
+        std::find(parameter_ids.begin(), parameter_ids.end(), parameter_expression.parameter_id);
+    if (parameter_id_iter == parameter_ids.end()) return std::nullopt;
+
+    return static_cast<size_t>(std::distance(parameter_ids.begin(), parameter_id_iter));
+  };
+
+  auto correlated_predicates = std::vector<CorrelatedPredicate>{};
+  auto parameter_usage_count = size_t{0};
+
+  visit_lqp(lqp, [&](const auto& node) {
+    for (const auto& expression : node->node_expressions()) {
+      visit_expression(expression, [&](const auto& sub_expression) {
+        if (find_parameter_idx(sub_expression)) ++parameter_usage_count;
+        return ExpressionVisitation::VisitArguments;
+      });
+    }
+
+    if (node->type != LQPNodeType::Predicate) return LQPVisitation::VisitInputs;
+
+    const auto predicate_node = std::static_pointer_cast<PredicateNode>(node);
+    const auto binary_predicate = std::dynamic_pointer_cast<BinaryPredicateExpression>(predicate_node->predicate);
+    if (!binary_predicate || binary_predicate->predicate_condition != PredicateCondition::Equals) {
+      return LQPVisitation::VisitInputs;
+    }
+
+    auto inner_expression = binary_predicate->left_operand();
+    auto parameter_idx = find_parameter_idx(binary_predicate->right_operand());
+    if (!parameter_idx) {
+      inner_expression = binary_predicate->right_operand();
+      parameter_idx = find_parameter_idx(binary_predicate->left_operand());
+    }
+
+    if (parameter_idx && inner_expression->type == ExpressionType::LQPColumn &&
+        is_joinable(*inner_expression, *select_expression.parameter_expression(*parameter_idx))) {
+      correlated_predicates.emplace_back(CorrelatedPredicate{
+          predicate_node, inner_expression, select_expression.parameter_expression(*parameter_idx)});
+    }
+
+    return LQPVisitation::VisitInputs;
+  });
+
+  if (parameter_usage_count != correlated_predicates.size()) return std::nullopt;
+
+  return correlated_predicates;
+}
+
+/**
+ * @return the nodes on the path from node (exclusive) up to the LogicalPlanRootNode (exclusive), bottom-up, or
+ *         std::nullopt if a node on that path has multiple outputs
+ */
+std::optional<std::vector<std::shared_ptr<AbstractLQPNode>>> collect_nodes_above(
+    const std::shared_ptr<AbstractLQPNode>& node) {
+  auto nodes_above = std::vector<std::shared_ptr<AbstractLQPNode>>{};
+
+  auto current_node = node;
+  while (true) {
+    const auto outputs = current_node->outputs();
+    if (outputs.size() != 1) return std::nullopt;
+
+    current_node = outputs.front();
+    if (current_node->type == LQPNodeType::Root) return nodes_above;
+
+    nodes_above.emplace_back(current_node);
+  }
+}
+
+/**
+ * @return whether node produces the same rows (plus the inner column) if a correlated predicate below it is removed
+ *         and applied as a join predicate above it instead
+ */
+bool is_independent_of_removed_predicate(const std::shared_ptr<AbstractLQPNode>& node) {
+  switch (node->type) {
+    case LQPNodeType::Predicate:
+    case LQPNodeType::Projection:
+    case LQPNodeType::Sort:
+    case LQPNodeType::Validate:
+      return true;
+
+    case LQPNodeType::Join: {
+      const auto join_mode = std::static_pointer_cast<JoinNode>(node)->join_mode;
+      return join_mode == JoinMode::Inner || join_mode == JoinMode::Cross;
+    }
+
+    default:
+      return false;
+  }
+}
+
+// Adds expression to the ProjectionNodes in nodes (ordered bottom-up) that do not forward it yet
+void forward_expression(const std::vector<std::shared_ptr<AbstractLQPNode>>& nodes,
+                        const std::shared_ptr<AbstractExpression>& expression) {
+  for (const auto& node : nodes) {
+    if (node->type != LQPNodeType::Projection || node->find_column_id(*expression)) continue;
+    std::static_pointer_cast<ProjectionNode>(node)->expressions.emplace_back(expression);
+  }
+}
+
+// @return whether expression is used by any of the nodes above node
+bool is_used_above(const std::shared_ptr<AbstractLQPNode>& node, const AbstractExpression& expression) {
+  for (const auto& output : node->outputs()) {
+    for (const auto& node_expression : output->node_expressions()) {
+      auto used = false;
+      visit_expression(node_expression, [&](const auto& sub_expression) {
+        if (*sub_expression != expression) return ExpressionVisitation::VisitArguments;
+        used = true;
+        return ExpressionVisitation::DoNotVisitArguments;
+      });
+      if (used) return true;
+    }
+
+    if (is_used_above(output, expression)) return true;
+  }
+
+  return false;
+}
+
+/**
+ * The SQLTranslator computes the subselect in a ProjectionNode below the PredicateNode that filters on it. Once the
+ * predicate is rewritten, the subselect must not be computed anymore, so remove it from there, and the ProjectionNode
+ * as well if it only forwards its input afterwards.
+ */
+void remove_from_input_projection(const std::shared_ptr<PredicateNode>& predicate_node,
+                                  const AbstractExpression& expression) {
+  const auto input_node = predicate_node->left_input();
+  if (input_node->type != LQPNodeType::Projection || input_node->output_count() != 1) return;
+
+  auto& expressions = std::static_pointer_cast<ProjectionNode>(input_node)->expressions;
+  const auto is_expression = [&](const auto& projected_expression) { return *projected_expression == expression; };
+  expressions.erase(std::remove_if(expressions.begin(), expressions.end(), is_expression), expressions.end());
+
+  if (expressions_equal(expressions, input_node->left_input()->column_expressions())) {
+    lqp_remove_node(input_node);
+  }
+}
+
+// Puts replacement_node, whose inputs are already set, in the place of node
+void replace_with_subplan(const std::shared_ptr<AbstractLQPNode>& node,
+                          const std::shared_ptr<AbstractLQPNode>& replacement_node) {
+  const auto outputs = node->outputs();
+  const auto input_sides = node->get_input_sides();
+
+  for (auto output_idx = size_t{0}; output_idx < outputs.size(); ++output_idx) {
+    outputs[output_idx]->set_input(input_sides[output_idx], replacement_node);
+  }
+
+  node->set_left_input(nullptr);
+}
+
+}  // namespace
+
+namespace opossum {
+
+std::string SubselectToJoinRule::name() const { return "Subselect to Join Rule"; }
+
+bool SubselectToJoinRule::apply_to(const std::shared_ptr<AbstractLQPNode>& node) const {
+  if (node->type == LQPNodeType::Predicate) {
+    const auto predicate_node = std::static_pointer_cast<PredicateNode>(node);
+
+    auto replacement_node = _rewrite_exists(predicate_node);
+    if (!replacement_node) replacement_node = _rewrite_in(predicate_node);
+    if (!replacement_node) replacement_node = _rewrite_scalar_comparison(predicate_node);
+
+    if (replacement_node) {
+      // Continue below the replacement, so that subselects in the now inlined sub-LQP are rewritten as well
+      _apply_to_inputs(replacement_node);
+      return true;
+    }
+  }
+
+  return _apply_to_inputs(node);
+}
+
+std::shared_ptr<AbstractLQPNode> SubselectToJoinRule::_rewrite_exists(
+    const std::shared_ptr<PredicateNode>& predicate_node) {
+  // The SQLTranslator turns `EXISTS (...)` into `EXISTS (...) != 0` and `NOT EXISTS (...)` into `EXISTS (...) = 0`
+  const auto binary_predicate = std::dynamic_pointer_cast<BinaryPredicateExpression>(predicate_node->predicate);
+  if (!binary_predicate || binary_predicate->left_operand()->type != ExpressionType::Exists ||
+      *binary_predicate->right_operand() != *value_(0)) {
+    return nullptr;
+  }
+
+  const auto predicate_condition = binary_predicate->predicate_condition;
+  if (predicate_condition != PredicateCondition::Equals && predicate_condition != PredicateCondition::NotEquals) {
+    return nullptr;
+  }
+  const auto join_mode = predicate_condition == PredicateCondition::NotEquals ? JoinMode::Semi : JoinMode::Anti;
+
+  const auto exists_expression = std::static_pointer_cast<ExistsExpression>(binary_predicate->left_operand());
+  const auto select_expression = std::dynamic_pointer_cast<LQPSelectExpression>(exists_expression->select());
+  if (!select_expression || is_used_above(predicate_node, *exists_expression)) return nullptr;
+
+  // Work on a copy of the sub-LQP, as it might be referenced by other expressions as well
+  const auto root_node = LogicalPlanRootNode::make(select_expression->lqp->deep_copy());
+
+  // A JoinNode has a single predicate, so only a single correlated predicate is supported
+  const auto correlated_predicates = find_correlated_predicates(*select_expression, root_node);
+  if (!correlated_predicates || correlated_predicates->size() != 1) return nullptr;
+  const auto& correlated_predicate = correlated_predicates->front();
+
+  if (!predicate_node->left_input()->find_column_id(*correlated_predicate.outer_expression)) return nullptr;
+  if (join_mode == JoinMode::Anti && correlated_predicate.outer_expression->is_nullable()) return nullptr;
+
+  const auto nodes_above = collect_nodes_above(correlated_predicate.predicate_node);
+  if (!nodes_above ||
+      !std::all_of(nodes_above->begin(), nodes_above->end(), is_independent_of_removed_predicate)) {
+    return nullptr;
+  }
+
+  forward_expression(*nodes_above, correlated_predicate.inner_expression);
+  lqp_remove_node(correlated_predicate.predicate_node);
+
+  const auto sub_lqp = root_node->left_input();
+  root_node->set_left_input(nullptr);
+
+  remove_from_input_projection(predicate_node, *exists_expression);
+
+  const auto join_node =
+      JoinNode::make(join_mode, equals_(correlated_predicate.outer_expression, correlated_predicate.inner_expression),
+                     predicate_node->left_input(), sub_lqp);
+  replace_with_subplan(predicate_node, join_node);
+
+  return join_node;
+}
+
+std::shared_ptr<AbstractLQPNode> SubselectToJoinRule::_rewrite_in(
+    const std::shared_ptr<PredicateNode>& predicate_node) {
+  // The SQLTranslator turns `a IN (...)` into `a IN (...) != 0` and `a NOT IN (...)` into `a IN (...) = 0`
+  const auto binary_predicate = std::dynamic_pointer_cast<BinaryPredicateExpression>(predicate_node->predicate);
+  if (!binary_predicate || *binary_predicate->right_operand() != *value_(0)) return nullptr;
+
+  const auto in_expression = std::dynamic_pointer_cast<InExpression>(binary_predicate->left_operand());
+  if (!in_expression) return nullptr;
+
+  const auto predicate_condition = binary_predicate->predicate_condition;
+  if (predicate_condition != PredicateCondition::Equals && predicate_condition != PredicateCondition::NotEquals) {
+    return nullptr;
+  }
+  const auto join_mode = predicate_condition == PredicateCondition::NotEquals ? JoinMode::Semi : JoinMode::Anti;
+
+  // Correlated IN subselects would need the correlated predicates as additional join predicates
+  const auto select_expression = std::dynamic_pointer_cast<LQPSelectExpression>(in_expression->set());
+  if (!select_expression || select_expression->is_correlated() || is_used_above(predicate_node, *in_expression)) {
+    return nullptr;
+  }
+
+  const auto& value_expression = in_expression->value();
+  if (!predicate_node->left_input()->find_column_id(*value_expression)) return nullptr;
+
+  const auto sub_lqp = select_expression->lqp->deep_copy();
+  if (sub_lqp->column_expressions().size() != 1) return nullptr;
+  const auto set_expression = sub_lqp->column_expressions().front();
+
+  if (!is_joinable(*value_expression, *set_expression)) return nullptr;
+
+  // `a NOT IN (...)` is NULL, not true, if a is NULL or if the subselect returns a NULL
+  if (join_mode == JoinMode::Anti && (value_expression->is_nullable() || set_expression->is_nullable())) {
+    return nullptr;
+  }
+
+  remove_from_input_projection(predicate_node, *in_expression);
+
+  const auto join_node =
+      JoinNode::make(join_mode, equals_(value_expression, set_expression), predicate_node->left_input(), sub_lqp);
+  replace_with_subplan(predicate_node, join_node);
+
+  return join_node;
+}
+
+std::shared_ptr<AbstractLQPNode> SubselectToJoinRule::_rewrite_scalar_comparison(
+    const std::shared_ptr<PredicateNode>& predicate_node) {
+  const auto binary_predicate = std::dynamic_pointer_cast<BinaryPredicateExpression>(predicate_node->predicate);
+  if (!binary_predicate) return nullptr;
+
+  auto select_is_left_operand = false;
+  auto select_expression = std::dynamic_pointer_cast<LQPSelectExpression>(binary_predicate->right_operand());
+  auto operand = binary_predicate->left_operand();
+  if (!select_expression) {
+    select_is_left_operand = true;
+    select_expression = std::dynamic_pointer_cast<LQPSelectExpression>(binary_predicate->left_operand());
+    operand = binary_predicate->right_operand();
+  }
+
+  // Uncorrelated subselects are only executed once anyway
+  if (!select_expression || !select_expression->is_correlated() || is_used_above(predicate_node, *select_expression)) {
+    return nullptr;
+  }
+
+  const auto outer_input_node = predicate_node->left_input();
+  if (!outer_input_node->find_column_id(*operand)) return nullptr;
+
+  // Work on a copy of the sub-LQP, as it might be referenced by other expressions as well
+  const auto root_node = LogicalPlanRootNode::make(select_expression->lqp->deep_copy());
+  if (root_node->left_input()->column_expressions().size() != 1) return nullptr;
+  const auto scalar_expression = root_node->left_input()->column_expressions().front();
+
+  const auto correlated_predicates = find_correlated_predicates(*select_expression, root_node);
+  if (!correlated_predicates || correlated_predicates->empty()) return nullptr;
+
+  /**
+   * All correlated predicates need to be below the same AggregateNode, which may only be followed by ProjectionNodes.
+   * Remember the nodes between each predicate and the AggregateNode and the nodes above the AggregateNode, so that the
+   * inner columns can be forwarded through them.
+   */
+  auto aggregate_node = std::shared_ptr<AggregateNode>{};
+  auto nodes_below_aggregate = std::vector<std::vector<std::shared_ptr<AbstractLQPNode>>>{};
+  auto nodes_above_aggregate = std::vector<std::shared_ptr<AbstractLQPNode>>{};
+
+  for (const auto& correlated_predicate : *correlated_predicates) {
+    if (!outer_input_node->find_column_id(*correlated_predicate.outer_expression)) return nullptr;
+
+    const auto nodes_above = collect_nodes_above(correlated_predicate.predicate_node);
+    if (!nodes_above) return nullptr;
+
+    const auto aggregate_iter = std::find_if(nodes_above->begin(), nodes_above->end(),
+                                             [](const auto& node) { return node->type == LQPNodeType::Aggregate; });
+    if (aggregate_iter == nodes_above->end()) return nullptr;
+
+    if (!std::all_of(nodes_above->begin(), aggregate_iter, is_independent_of_removed_predicate) ||
+        !std::all_of(std::next(aggregate_iter), nodes_above->end(),
+                     [](const auto& node) { return node->type == LQPNodeType::Projection; })) {
+      return nullptr;
+    }
+
+    const auto current_aggregate_node = std::static_pointer_cast<AggregateNode>(*aggregate_iter);
+    if (aggregate_node && aggregate_node != current_aggregate_node) return nullptr;
+    aggregate_node = current_aggregate_node;
+
+    nodes_below_aggregate.emplace_back(nodes_above->begin(), aggregate_iter);
+    nodes_above_aggregate.assign(std::next(aggregate_iter), nodes_above->end());
+  }
+
+  // Without GROUP BY, the subselect returns a single row. Grouping it by the inner columns is only equivalent if an
+  // empty group would have produced NULL, which is not the case for COUNT.
+  if (!aggregate_node->group_by_expressions.empty()) return nullptr;
+  for (const auto& aggregate_expression : aggregate_node->aggregate_expressions) {
+    if (aggregate_expression->type != ExpressionType::Aggregate) return nullptr;
+
+    const auto aggregate_function =
+        std::static_pointer_cast<AggregateExpression>(aggregate_expression)->aggregate_function;
+    if (aggregate_function == AggregateFunction::Count || aggregate_function == AggregateFunction::CountDistinct) {
+      return nullptr;
+    }
+  }
+
+  // Group the sub-LQP by the inner columns instead of filtering it by the correlated predicates
+  auto group_by_expressions = std::vector<std::shared_ptr<AbstractExpression>>{};
+  for (auto predicate_idx = size_t{0}; predicate_idx < correlated_predicates->size(); ++predicate_idx) {
+    const auto& correlated_predicate = (*correlated_predicates)[predicate_idx];
+
+    forward_expression(nodes_below_aggregate[predicate_idx], correlated_predicate.inner_expression);
+    lqp_remove_node(correlated_predicate.predicate_node);
+
+    if (std::none_of(group_by_expressions.begin(), group_by_expressions.end(), [&](const auto& expression) {
+          return *expression == *correlated_predicate.inner_expression;
+        })) {
+      group_by_expressions.emplace_back(correlated_predicate.inner_expression);
+    }
+  }
+
+  lqp_replace_node(aggregate_node, AggregateNode::make(group_by_expressions, aggregate_node->aggregate_expressions));
+  for (const auto& group_by_expression : group_by_expressions) {
+    forward_expression(nodes_above_aggregate, group_by_expression);
+  }
+
+  const auto sub_lqp = root_node->left_input();
+  root_node->set_left_input(nullptr);
+
+  remove_from_input_projection(predicate_node, *select_expression);
+
+  // Join on the first correlated predicate, the others are fused into the same join by the LQPTranslator
+  const auto& first_correlated_predicate = correlated_predicates->front();
+  const auto output_expressions = predicate_node->left_input()->column_expressions();
+
+  const auto join_predicate =
+      equals_(first_correlated_predicate.outer_expression, first_correlated_predicate.inner_expression);
+  auto lqp = std::shared_ptr<AbstractLQPNode>{
+      JoinNode::make(JoinMode::Inner, join_predicate, predicate_node->left_input(), sub_lqp)};
+  for (auto predicate_idx = size_t{1}; predicate_idx < correlated_predicates->size(); ++predicate_idx) {
+    const auto& correlated_predicate = (*correlated_predicates)[predicate_idx];
+    lqp = PredicateNode::make(equals_(correlated_predicate.outer_expression, correlated_predicate.inner_expression),
+                              lqp);
+  }
+
+  const auto scalar_predicate = std::make_shared<BinaryPredicateExpression>(
+      binary_predicate->predicate_condition, select_is_left_operand ? scalar_expression : operand,
+      select_is_left_operand ? operand : scalar_expression);
+  lqp = PredicateNode::make(scalar_predicate, lqp);
+
+  // Remove the columns of the sub-LQP again
+  const auto projection_node = ProjectionNode::make(output_expressions, lqp);
+  replace_with_subplan(predicate_node, projection_node);
+
+  return projection_node;
+}
+
+}  // namespace opossum
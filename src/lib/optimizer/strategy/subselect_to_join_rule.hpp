@@ -0,0 +1,70 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "abstract_rule.hpp"
+
+namespace opossum {
+
+class AbstractLQPNode;
+class PredicateNode;
+
+/**
+ * This optimizer rule rewrites PredicateNodes filtering on subselects into joins, so that the subselect is executed
+ * once for all rows instead of once for each row (correlated subselects) or for each evaluation of the IN list.
+ *
+ * The following patterns, as produced by the SQLTranslator, are rewritten:
+ *
+ * SELECT * FROM a WHERE EXISTS (SELECT * FROM b WHERE b.x = a.x AND b.y > 5)
+ * =>
+ * SELECT * FROM a SEMI JOIN (SELECT * FROM b WHERE b.y > 5) ON a.x = b.x
+ *
+ * SELECT * FROM a WHERE a.x IN (SELECT b.x FROM b WHERE b.y > 5)
+ * =>
+ * SELECT * FROM a SEMI JOIN (SELECT b.x FROM b WHERE b.y > 5) ON a.x = b.x
+ *
+ * SELECT * FROM a WHERE a.y < (SELECT 0.5 * SUM(b.y) FROM b WHERE b.x = a.x)
+ * =>
+ * SELECT a.* FROM a INNER JOIN (SELECT 0.5 * SUM(b.y) AS s, b.x FROM b GROUP BY b.x) AS b ON a.x = b.x WHERE a.y < b.s
+ *
+ * NOT EXISTS and NOT IN become anti joins. As NULLs are not matched by the anti join, this is only done if the
+ * compared columns are not nullable.
+ *
+ *
+ * HOW THIS WORKS
+ *
+ * A subselect is correlated via ParameterExpressions that stand for columns of the outer query. The rule only handles
+ * correlation through equality predicates `<inner column> = <parameter>` that are the only usages of the parameters.
+ * These predicates are removed from the sub-LQP and become the join predicates, with the inner columns being forwarded
+ * by the ProjectionNodes on the way to the root of the sub-LQP.
+ *
+ * For EXISTS, only PredicateNodes, ProjectionNodes, ValidateNodes, SortNodes and inner/cross joins may be located
+ * above the correlated predicate, since other nodes (e.g., Aggregates or Limits) would produce different results once
+ * the correlated predicate is removed.
+ *
+ * For scalar subselects, the sub-LQP needs to be an aggregate without GROUP BY (optionally followed by projections)
+ * that is correlated below the AggregateNode. The AggregateNode is grouped by the inner columns instead, so the
+ * subselect produces one row per value of the outer columns. Outer rows without a matching group are dropped by the
+ * inner join, which is what the comparison with the NULL result of the subselect would have done as well. COUNT
+ * returns 0 instead of NULL for empty groups, so subselects with COUNT are not rewritten.
+ *
+ * Correlated IN subselects and correlation through other predicates than equality (e.g., the `<>` in TPC-H Q21) are
+ * left as they are.
+ */
+class SubselectToJoinRule : public AbstractRule {
+ public:
+  std::string name() const override;
+  bool apply_to(const std::shared_ptr<AbstractLQPNode>& node) const override;
+
+ private:
+  /**
+   * @return the node that replaced predicate_node, or nullptr if the predicate could not be rewritten
+   */
+  static std::shared_ptr<AbstractLQPNode> _rewrite_exists(const std::shared_ptr<PredicateNode>& predicate_node);
+  static std::shared_ptr<AbstractLQPNode> _rewrite_in(const std::shared_ptr<PredicateNode>& predicate_node);
+  static std::shared_ptr<AbstractLQPNode> _rewrite_scalar_comparison(
+      const std::shared_ptr<PredicateNode>& predicate_node);
+};
+
+}  // namespace opossum
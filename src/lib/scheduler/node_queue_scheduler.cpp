@@ -1,8 +1,11 @@
 #include "node_queue_scheduler.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <memory>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -11,6 +14,7 @@
 #include "processing_unit.hpp"
 #include "task_queue.hpp"
 #include "topology.hpp"
+#include "worker.hpp"
 
 #include "uid_allocator.hpp"
 #include "utils/assert.hpp"
@@ -52,8 +56,10 @@ void NodeQueueScheduler::begin() {
 void NodeQueueScheduler::finish() {
   /**
    * Periodically count all finished tasks and when this number matches the number of scheduled tasks, it is safe to
-   * shut down
+   * shut down. The polling interval starts small and grows exponentially, so that finishing an idle scheduler does not
+   * take longer than necessary.
    */
+  auto polling_interval = std::chrono::microseconds{10};
   while (true) {
     uint64_t num_finished_tasks = 0;
     for (auto& processing_unit : _processing_units) {
@@ -62,7 +68,8 @@ void NodeQueueScheduler::finish() {
 
     if (num_finished_tasks == _task_counter) break;
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    std::this_thread::sleep_for(polling_interval);
+    polling_interval = std::min(polling_interval * 2, std::chrono::microseconds{Worker::WORK_STEALING_INTERVAL});
   }
 
   // All queues SHOULD be empty by now
@@ -76,6 +83,11 @@ void NodeQueueScheduler::finish() {
     processing_unit->shutdown();
   }
 
+  // Wake up the workers that are waiting for new tasks
+  for (auto& queue : _queues) {
+    queue->shut_down();
+  }
+
   for (auto& processing_unit : _processing_units) {
     processing_unit->join();
   }
@@ -69,6 +69,10 @@ namespace opossum {
  * worker of the remote node pulled the task, the current worker is pulling the task and therefore steals it.
  * Afterwards, the current worker is checking its local queue gain.
  *
+ * If neither the local queue nor any remote queue has a task, the worker spins on its local queue for a short time
+ * and then blocks until a task is pushed to that queue. Thus, idle workers do not use the CPU, but still pick up new
+ * tasks within microseconds. If there are remote queues, the worker wakes up periodically to check them again.
+ *
  * [1] http://frankdenneman.nl/2016/07/13/numa-deep-dive-4-local-memory-optimization/
  */
 
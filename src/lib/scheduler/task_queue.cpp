@@ -1,6 +1,9 @@
 #include "task_queue.hpp"
 
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <utility>
 
 #include "abstract_task.hpp"
@@ -24,6 +27,16 @@ void TaskQueue::push(const std::shared_ptr<AbstractTask>& task, uint32_t priorit
   _queues[priority].push(task);
 
   _num_tasks++;
+
+  /**
+   * A waiting worker increments _num_waiting_workers before it checks whether the queue is empty, and we increment
+   * _num_tasks before we check for waiting workers. As both are sequentially consistent, either the worker sees the
+   * new task or we see the worker. Taking the mutex makes sure that the worker is not between its check and the wait.
+   */
+  if (_num_waiting_workers > 0) {
+    { std::lock_guard<std::mutex> lock(_wait_mutex); }
+    _wait_condition_variable.notify_one();
+  }
 }
 
 std::shared_ptr<AbstractTask> TaskQueue::pull(SchedulePriority min_priority) {
@@ -61,4 +74,31 @@ std::shared_ptr<AbstractTask> TaskQueue::steal() {
   return nullptr;
 }
 
+void TaskQueue::wait_for_tasks(const std::optional<std::chrono::milliseconds>& timeout) {
+  for (auto spin_iteration = size_t{0}; spin_iteration < WAIT_SPIN_ITERATIONS; ++spin_iteration) {
+    if (!empty()) return;
+  }
+
+  std::unique_lock<std::mutex> lock(_wait_mutex);
+  _num_waiting_workers++;
+
+  const auto wake_up = [&]() { return !empty() || _shut_down; };
+
+  if (timeout) {
+    _wait_condition_variable.wait_for(lock, *timeout, wake_up);
+  } else {
+    _wait_condition_variable.wait(lock, wake_up);
+  }
+
+  _num_waiting_workers--;
+}
+
+void TaskQueue::shut_down() {
+  {
+    std::lock_guard<std::mutex> lock(_wait_mutex);
+    _shut_down = true;
+  }
+  _wait_condition_variable.notify_all();
+}
+
 }  // namespace opossum
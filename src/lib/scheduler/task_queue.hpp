@@ -4,7 +4,11 @@
 #include <tbb/concurrent_queue.h>
 #include <array>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <optional>
 
 #include "types.hpp"
 
@@ -14,11 +18,18 @@ class AbstractTask;
 
 /**
  * Holds a queue of AbstractTasks, usually one of these exists per node
+ *
+ * Workers that find the queue empty park in wait_for_tasks() and are woken up by push(). Before blocking, they spin
+ * for a short time, so that a task that is pushed shortly after the queue ran empty is picked up without the latency
+ * of a context switch.
  */
 class TaskQueue {
  public:
   static constexpr uint32_t NUM_PRIORITY_LEVELS = 4;
 
+  // Number of times a worker checks the queue before it blocks. This corresponds to a few microseconds.
+  static constexpr size_t WAIT_SPIN_ITERATIONS = 10'000;
+
   explicit TaskQueue(NodeID node_id);
 
   bool empty() const;
@@ -39,10 +50,29 @@ class TaskQueue {
    */
   std::shared_ptr<AbstractTask> steal();
 
+  /**
+   * Blocks the calling worker until a task is pushed to the queue, shut_down() is called, or the timeout (if any) has
+   * passed. Returns immediately if the queue is not empty. Spurious returns are possible, so the caller has to check
+   * the queue again.
+   */
+  void wait_for_tasks(const std::optional<std::chrono::milliseconds>& timeout = std::nullopt);
+
+  /**
+   * Wakes up all workers that are blocked in wait_for_tasks(). Afterwards, wait_for_tasks() does not block anymore.
+   * Called by the scheduler when it shuts down.
+   */
+  void shut_down();
+
  private:
   NodeID _node_id;
   std::array<tbb::concurrent_queue<std::shared_ptr<AbstractTask>>, NUM_PRIORITY_LEVELS> _queues;
   std::atomic_uint _num_tasks{0};
+
+  // push() only takes the mutex if a worker is (about to be) blocked, i.e., if _num_waiting_workers is not zero
+  std::mutex _wait_mutex;
+  std::condition_variable _wait_condition_variable;
+  std::atomic_uint _num_waiting_workers{0};
+  bool _shut_down{false};  // Guarded by _wait_mutex
 };
 
 }  // namespace opossum
@@ -7,6 +7,7 @@
 #include <chrono>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <thread>
 #include <vector>
 
@@ -93,9 +94,12 @@ void Worker::operator()() {
         }
       }
 
-      // Sleep iff there is no ready task in our queue and work stealing was not successful.
+      // Wait iff there is no ready task in our queue and work stealing was not successful. push() wakes us up when a
+      // task is added to our queue. With multiple queues, we stop waiting after WORK_STEALING_INTERVAL to check the
+      // other queues again.
       if (!work_stealing_successful) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        const auto has_remote_queues = scheduler->queues().size() > 1;
+        _queue->wait_for_tasks(has_remote_queues ? std::optional{WORK_STEALING_INTERVAL} : std::nullopt);
         continue;
       }
     }
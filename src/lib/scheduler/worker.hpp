@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <vector>
 
@@ -21,6 +22,9 @@ class Worker : public std::enable_shared_from_this<Worker>, private Noncopyable
   friend class NodeQueueScheduler;
 
  public:
+  // If there are multiple queues, an idle worker checks the other queues for stealable tasks in this interval
+  static constexpr auto WORK_STEALING_INTERVAL = std::chrono::milliseconds{10};
+
   static std::shared_ptr<Worker> get_this_thread_worker();
 
   Worker(const std::weak_ptr<ProcessingUnit>& processing_unit, const std::shared_ptr<TaskQueue>& queue, WorkerID id,
@@ -2,6 +2,8 @@
 
 #include <boost/asio.hpp>
 
+#include <array>
+
 #include "postgres_wire_handler.hpp"
 #include "then_operator.hpp"
 #include "use_boost_future.hpp"
@@ -166,48 +168,25 @@ boost::future<void> ClientConnection::send_row_description(const std::vector<Col
     PostgresWireHandler::write_value(*output_packet, htonl(column_description.object_id));   // object id of type
     PostgresWireHandler::write_value(*output_packet, htons(column_description.type_width));  // regular int
     PostgresWireHandler::write_value(*output_packet, htonl(-1));                             // no modifier
-    PostgresWireHandler::write_value(*output_packet, htons(0u));                             // text format
+    PostgresWireHandler::write_value(*output_packet, htons(static_cast<uint16_t>(column_description.format_code)));
   }
 
   return _send_bytes_async(output_packet) >> then >> ignore_sent_bytes;
 }
 
-boost::future<void> ClientConnection::send_data_row(const std::vector<std::string>& row_strings) {
-  auto output_packet = PostgresWireHandler::new_output_packet(NetworkMessageType::DataRow);
-
-  /*
-  DataRow (B)
-  Byte1('D')
-  Identifies the message as a data row.
-
-  Int32
-  Length of message contents in bytes, including self.
-
-  Int16
-  The number of column values that follow (possibly zero).
-
-  Next, the following pair of fields appear for each column:
-
-  Int32
-  The length of the column value, in bytes (this count does not include itself). Can be zero. As a special case,
-  -1 indicates a NULL column value. No value bytes follow in the NULL case.
-
-  Byte n
-  The value of the column, in the format indicated by the associated format code. n is the above length.
-  */
-
-  // Number of columns in row
-  PostgresWireHandler::write_value(*output_packet, htons(row_strings.size()));
+boost::future<void> ClientConnection::send_data_rows(const ByteBuffer& data_rows) {
+  // The DataRow messages are already serialized by the QueryResponseBuilder (see there for the format). Together with
+  // the messages that are still buffered (e.g., the RowDescription), they are sent with a single write.
+  const auto buffers =
+      std::array<boost::asio::const_buffer, 2>{boost::asio::buffer(_response_buffer), boost::asio::buffer(data_rows)};
+  const auto total_size = _response_buffer.size() + data_rows.size();
 
-  for (const auto& value_string : row_strings) {
-    // Size of string representation of value, NOT of value type's size
-    PostgresWireHandler::write_value(*output_packet, htonl(value_string.length()));
-
-    // Text mode means that all values are sent as non-terminated strings
-    PostgresWireHandler::write_string(*output_packet, value_string, false);
-  }
-
-  return _send_bytes_async(output_packet) >> then >> ignore_sent_bytes;
+  return boost::asio::async_write(_socket, buffers, boost::asio::use_boost_future) >> then >>
+         [=](uint64_t sent_bytes) {
+           // If this fails, the connection may be closed but the server will keep running.
+           Assert(sent_bytes == total_size, "Could not send all data");
+           _response_buffer.clear();
+         };
 }
 
 boost::future<void> ClientConnection::send_command_complete(const std::string& message) {
@@ -5,6 +5,8 @@
 
 #include <memory>
 
+#include "types.hpp"
+
 namespace opossum {
 
 using ByteBuffer = std::vector<char>;
@@ -13,12 +15,12 @@ struct OutputPacket;
 struct RequestHeader;
 struct ParsePacket;
 struct BindPacket;
-enum class NetworkMessageType : unsigned char;
 
 struct ColumnDescription {
   std::string column_name;
   uint64_t object_id;
   int64_t type_width;
+  FormatCode format_code;
 };
 
 // This class provides a wrapper over the TCP socket and (de)serializes
@@ -48,7 +50,8 @@ class ClientConnection : public std::enable_shared_from_this<ClientConnection> {
   boost::future<void> send_notice(const std::string& notice);
   boost::future<void> send_status_message(const NetworkMessageType& type);
   boost::future<void> send_row_description(const std::vector<ColumnDescription>& row_description);
-  boost::future<void> send_data_row(const std::vector<std::string>& row_strings);
+  // Sends serialized DataRow messages. data_rows has to stay valid until the returned future is resolved.
+  boost::future<void> send_data_rows(const ByteBuffer& data_rows);
   boost::future<void> send_command_complete(const std::string& message);
 
  protected:
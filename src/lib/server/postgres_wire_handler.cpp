@@ -83,9 +83,17 @@ BindPacket PostgresWireHandler::handle_bind_packet(const InputPacket& packet) {
   }
 
   auto num_result_column_format_codes = ntohs(read_value<int16_t>(packet));
-  auto result_column_format_codes = read_values<int16_t>(packet, num_result_column_format_codes);
+  auto network_result_column_format_codes = read_values<int16_t>(packet, num_result_column_format_codes);
+
+  std::vector<FormatCode> result_column_format_codes;
+  for (const auto network_format_code : network_result_column_format_codes) {
+    const auto format_code = static_cast<int16_t>(ntohs(network_format_code));
+    // 0 is the text format, 1 is the binary format
+    Assert(format_code == 0 || format_code == 1, "Unknown result format code");
+    result_column_format_codes.emplace_back(static_cast<FormatCode>(format_code));
+  }
 
-  return BindPacket{statement_name, portal, std::move(parameter_values)};
+  return BindPacket{statement_name, portal, std::move(parameter_values), std::move(result_column_format_codes)};
 }
 
 std::string PostgresWireHandler::handle_execute_packet(const InputPacket& packet) {
@@ -43,6 +43,9 @@ struct BindPacket {
   std::string statement_name;
   std::string destination_portal;
   std::vector<AllTypeVariant> params;
+
+  // Either empty (all columns use the text format), one code for all columns, or one code per column
+  std::vector<FormatCode> result_column_format_codes;
 };
 
 class PostgresWireHandler {
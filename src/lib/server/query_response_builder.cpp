@@ -1,7 +1,18 @@
 #include "query_response_builder.hpp"
 
+#include <boost/lexical_cast.hpp>
+
+#include <charconv>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "resolve_type.hpp"
 #include "server/postgres_wire_handler.hpp"
 #include "sql/sql_pipeline.hpp"
+#include "storage/create_iterable_from_segment.hpp"
 
 #include "SQLParserResult.h"
 
@@ -11,11 +22,174 @@ namespace opossum {
 
 using opossum::then_operator::then;
 
-std::vector<ColumnDescription> QueryResponseBuilder::build_row_description(const std::shared_ptr<const Table>& table) {
+/**
+ * The buffers used to serialize the rows of a chunk. They are kept for all chunks of a result, so that they only
+ * have to grow once.
+ *
+ * For every column, column_fields holds the fields of all rows of the chunk, and column_field_offsets the offset of
+ * each row's field (plus the end of the last field). A field is the length of a value followed by the value itself,
+ * just like in the DataRow message. The fields of all columns are then combined into DataRow messages in data_rows.
+ */
+struct DataRowBuffers {
+  std::vector<ByteBuffer> column_fields;
+  std::vector<std::vector<size_t>> column_field_offsets;
+  ByteBuffer data_rows;
+};
+
+namespace {
+
+// Writes `value` in network byte order
+template <typename T>
+void write_network_value(const T value, char* destination) {
+  static_assert(std::is_arithmetic_v<T>, "Expected an arithmetic type");
+  using UnsignedType =
+      std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>;
+  static_assert(sizeof(T) == sizeof(UnsignedType), "Unexpected size of type");
+
+  auto bits = UnsignedType{};
+  std::memcpy(&bits, &value, sizeof(T));
+
+  for (auto byte_id = size_t{0}; byte_id < sizeof(T); ++byte_id) {
+    destination[byte_id] = static_cast<char>(bits >> ((sizeof(T) - 1 - byte_id) * 8));
+  }
+}
+
+template <typename T>
+void append_network_value(ByteBuffer& buffer, const T value) {
+  const auto offset = buffer.size();
+  buffer.resize(offset + sizeof(T));
+  write_network_value(value, buffer.data() + offset);
+}
+
+template <typename ColumnDataType>
+void append_field(ByteBuffer& buffer, const ColumnDataType& value, const FormatCode format_code) {
+  if constexpr (std::is_same_v<ColumnDataType, std::string>) {
+    // For strings, the text format and the binary format are the same
+    append_network_value(buffer, static_cast<int32_t>(value.size()));
+    buffer.insert(buffer.end(), value.begin(), value.end());
+  } else {
+    if (format_code == FormatCode::Binary) {
+      append_network_value(buffer, static_cast<int32_t>(sizeof(ColumnDataType)));
+      append_network_value(buffer, value);
+      return;
+    }
+
+    // Text format. The length is written once the size of the text is known.
+    const auto length_offset = buffer.size();
+    buffer.resize(length_offset + sizeof(int32_t));
+
+    if constexpr (std::is_integral_v<ColumnDataType>) {
+      char text[24];
+      const auto text_end = std::to_chars(text, text + sizeof(text), value).ptr;
+      buffer.insert(buffer.end(), text, text_end);
+    } else {
+      // boost::lexical_cast prints floating-point values with enough digits to restore them exactly
+      const auto text = boost::lexical_cast<std::string>(value);
+      buffer.insert(buffer.end(), text.begin(), text.end());
+    }
+
+    const auto length = static_cast<int32_t>(buffer.size() - length_offset - sizeof(int32_t));
+    write_network_value(length, buffer.data() + length_offset);
+  }
+}
+
+// Expands the format codes of a Bind message to one format code per column
+std::vector<FormatCode> resolve_format_codes(const std::vector<FormatCode>& format_codes, const size_t column_count) {
+  if (format_codes.empty()) return std::vector<FormatCode>(column_count, FormatCode::Text);
+  if (format_codes.size() == 1) return std::vector<FormatCode>(column_count, format_codes.front());
+
+  Assert(format_codes.size() == column_count, "Expected either one result format code or one per column");
+  return format_codes;
+}
+
+// Serializes all rows of a chunk into buffers.data_rows
+void build_data_rows(const Table& table, const ChunkID chunk_id, const std::vector<FormatCode>& format_codes,
+                     DataRowBuffers& buffers) {
+  const auto& chunk = *table.get_chunk(chunk_id);
+  const auto column_count = table.column_count();
+  const auto row_count = chunk.size();
+
+  buffers.column_fields.resize(column_count);
+  buffers.column_field_offsets.resize(column_count);
+
+  // 1. Serialize the values of each column
+  for (ColumnID column_id{0}; column_id < column_count; ++column_id) {
+    auto& fields = buffers.column_fields[column_id];
+    auto& field_offsets = buffers.column_field_offsets[column_id];
+    fields.clear();
+    field_offsets.resize(row_count + 1);
+
+    const auto format_code = format_codes[column_id];
+
+    resolve_data_type(table.column_data_type(column_id), [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+
+      resolve_segment_type<ColumnDataType>(*chunk.get_segment(column_id), [&](const auto& typed_segment) {
+        auto chunk_offset = ChunkOffset{0};
+
+        create_iterable_from_segment<ColumnDataType>(typed_segment).for_each([&](const auto& value) {
+          field_offsets[chunk_offset] = fields.size();
+          ++chunk_offset;
+
+          if (value.is_null()) {
+            // A length of -1 denotes a NULL value, no value bytes follow
+            append_network_value(fields, int32_t{-1});
+          } else {
+            append_field(fields, value.value(), format_code);
+          }
+        });
+
+        DebugAssert(chunk_offset == row_count, "Expected the iterable to visit every row exactly once");
+      });
+    });
+
+    field_offsets[row_count] = fields.size();
+  }
+
+  /**
+   * 2. Combine the fields into one DataRow message per row:
+   *    Byte1('D'), Int32 length of the message (including itself), Int16 number of fields, the fields
+   */
+  constexpr auto DATA_ROW_HEADER_SIZE = sizeof(NetworkMessageType) + sizeof(int32_t) + sizeof(int16_t);
+
+  auto total_size = row_count * DATA_ROW_HEADER_SIZE;
+  for (const auto& fields : buffers.column_fields) total_size += fields.size();
+
+  auto& data_rows = buffers.data_rows;
+  data_rows.resize(total_size);
+
+  auto* destination = data_rows.data();
+  for (ChunkOffset chunk_offset{0}; chunk_offset < row_count; ++chunk_offset) {
+    auto* message_begin = destination;
+    destination += DATA_ROW_HEADER_SIZE;
+
+    for (ColumnID column_id{0}; column_id < column_count; ++column_id) {
+      const auto& field_offsets = buffers.column_field_offsets[column_id];
+      const auto field_begin = field_offsets[chunk_offset];
+      const auto field_size = field_offsets[chunk_offset + 1] - field_begin;
+
+      std::memcpy(destination, buffers.column_fields[column_id].data() + field_begin, field_size);
+      destination += field_size;
+    }
+
+    // The message type byte does not contribute to the message length
+    message_begin[0] = static_cast<char>(NetworkMessageType::DataRow);
+    write_network_value(static_cast<int32_t>(destination - message_begin - 1), message_begin + 1);
+    write_network_value(static_cast<int16_t>(column_count), message_begin + 1 + sizeof(int32_t));
+  }
+
+  DebugAssert(destination == data_rows.data() + data_rows.size(), "Miscalculated the size of the DataRow messages");
+}
+
+}  // namespace
+
+std::vector<ColumnDescription> QueryResponseBuilder::build_row_description(
+    const std::shared_ptr<const Table>& table, const std::vector<FormatCode>& format_codes) {
   std::vector<ColumnDescription> result;
 
   const auto& column_names = table->column_names();
   const auto& column_types = table->column_data_types();
+  const auto column_format_codes = resolve_format_codes(format_codes, table->column_count());
 
   for (auto column_id = 0u; column_id < table->column_count(); ++column_id) {
     uint32_t object_id;
@@ -46,7 +220,7 @@ std::vector<ColumnDescription> QueryResponseBuilder::build_row_description(const
         Fail("Bad DataType");
     }
 
-    result.emplace_back(ColumnDescription{column_names[column_id], object_id, type_id});
+    result.emplace_back(ColumnDescription{column_names[column_id], object_id, type_id, column_format_codes[column_id]});
   }
 
   return result;
@@ -82,38 +256,35 @@ std::string QueryResponseBuilder::build_execution_info_message(const std::shared
   return sql_pipeline->metrics().to_string();
 }
 
-boost::future<uint64_t> QueryResponseBuilder::send_query_response(const send_row_t& send_row, const Table& table) {
-  // Essentially we're iterating over every row in every chunk in the table, generating and sending
-  // its string representation. However, because of the asynchronous send_row call, we have to
-  // use this two-level recursion instead of two nested for-loops
+boost::future<uint64_t> QueryResponseBuilder::send_query_response(const send_data_rows_t& send_data_rows,
+                                                                  const Table& table,
+                                                                  const std::vector<FormatCode>& format_codes) {
+  // Because of the asynchronous send_data_rows call, we have to use recursion instead of a for-loop over the chunks
 
-  return _send_query_response_chunks(send_row, table, ChunkID{0}) >> then >> [&]() { return table.row_count(); };
-}
+  auto buffers = std::make_shared<DataRowBuffers>();
+  const auto column_format_codes = resolve_format_codes(format_codes, table.column_count());
 
-boost::future<void> QueryResponseBuilder::_send_query_response_chunks(const send_row_t& send_row, const Table& table,
-                                                                      ChunkID current_chunk_id) {
-  if (current_chunk_id == table.chunk_count()) return boost::make_ready_future();
-
-  const auto& chunk = table.get_chunk(current_chunk_id);
-
-  return _send_query_response_rows(send_row, *chunk, ChunkOffset{0}) >> then >>
-         std::bind(QueryResponseBuilder::_send_query_response_chunks, send_row, std::ref(table),
-                   ChunkID{current_chunk_id + 1});
+  return _send_query_response_chunks(send_data_rows, table, column_format_codes, buffers, ChunkID{0}) >> then >>
+         [&]() { return table.row_count(); };
 }
 
-boost::future<void> QueryResponseBuilder::_send_query_response_rows(const send_row_t& send_row, const Chunk& chunk,
-                                                                    ChunkOffset current_chunk_offset) {
-  if (current_chunk_offset == chunk.size()) return boost::make_ready_future();
+boost::future<void> QueryResponseBuilder::_send_query_response_chunks(const send_data_rows_t& send_data_rows,
+                                                                      const Table& table,
+                                                                      const std::vector<FormatCode>& format_codes,
+                                                                      const std::shared_ptr<DataRowBuffers>& buffers,
+                                                                      ChunkID current_chunk_id) {
+  // Skip empty chunks, there is nothing to send for them
+  while (current_chunk_id < table.chunk_count() && table.get_chunk(current_chunk_id)->size() == 0) {
+    ++current_chunk_id;
+  }
 
-  std::vector<std::string> row_strings(chunk.column_count());
+  if (current_chunk_id == table.chunk_count()) return boost::make_ready_future();
 
-  for (ColumnID column_id{0}; column_id < ColumnID{chunk.column_count()}; ++column_id) {
-    const auto& segment = chunk.get_segment(column_id);
-    row_strings[column_id] = type_cast<std::string>((*segment)[current_chunk_offset]);
-  }
+  build_data_rows(table, current_chunk_id, format_codes, *buffers);
 
-  return send_row(row_strings) >> then >> std::bind(QueryResponseBuilder::_send_query_response_rows, send_row,
-                                                    std::ref(chunk), ChunkOffset{current_chunk_offset + 1});
+  return send_data_rows(buffers->data_rows) >> then >>
+         std::bind(QueryResponseBuilder::_send_query_response_chunks, send_data_rows, std::ref(table), format_codes,
+                   buffers, ChunkID{current_chunk_id + 1});
 }
 
 }  // namespace opossum
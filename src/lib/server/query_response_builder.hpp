@@ -1,5 +1,9 @@
 #pragma once
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "sql/SQLStatement.h"
 
 #include "server/client_connection.hpp"
@@ -8,22 +12,35 @@
 namespace opossum {
 
 class SQLPipeline;
+struct DataRowBuffers;
 
 class QueryResponseBuilder {
  public:
-  static std::vector<ColumnDescription> build_row_description(const std::shared_ptr<const Table>& table);
+  /**
+   * @param format_codes The result format codes requested by the client in the Bind message (see BindPacket). Empty
+   *                     for simple queries, which always use the text format.
+   */
+  static std::vector<ColumnDescription> build_row_description(const std::shared_ptr<const Table>& table,
+                                                              const std::vector<FormatCode>& format_codes);
   static std::string build_command_complete_message(hsql::StatementType statement_type, uint64_t row_count);
   static std::string build_execution_info_message(const std::shared_ptr<SQLPipeline>& sql_pipeline);
 
-  using send_row_t = std::function<boost::future<void>(const std::vector<std::string>&)>;
+  // Receives the serialized DataRow messages of one chunk. The buffer is reused for the next chunk once the returned
+  // future is resolved.
+  using send_data_rows_t = std::function<boost::future<void>(const ByteBuffer&)>;
 
-  static boost::future<uint64_t> send_query_response(const send_row_t& send_row, const Table& table);
+  /**
+   * Sends the rows of `table` chunk by chunk. The values of each column are serialized using typed segment iteration,
+   * all rows of a chunk are then sent with a single call to send_data_rows.
+   */
+  static boost::future<uint64_t> send_query_response(const send_data_rows_t& send_data_rows, const Table& table,
+                                                     const std::vector<FormatCode>& format_codes);
 
  protected:
-  static boost::future<void> _send_query_response_chunks(const send_row_t& send_row, const Table& table,
+  static boost::future<void> _send_query_response_chunks(const send_data_rows_t& send_data_rows, const Table& table,
+                                                         const std::vector<FormatCode>& format_codes,
+                                                         const std::shared_ptr<DataRowBuffers>& buffers,
                                                          ChunkID current_chunk_id);
-  static boost::future<void> _send_query_response_rows(const send_row_t& send_row, const Chunk& chunk,
-                                                       ChunkOffset current_chunk_offset);
 };
 
 }  // namespace opossum
@@ -150,11 +150,12 @@ boost::future<void> ServerSessionImpl<TConnection, TTaskRunner>::_send_simple_qu
     // If there is no result table, e.g. after an INSERT command, we cannot send row data
     if (!result_table) return boost::make_ready_future<uint64_t>(0);
 
-    auto row_description = QueryResponseBuilder::build_row_description(sql_pipeline->get_result_table());
+    // Simple queries always use the text format
+    auto row_description = QueryResponseBuilder::build_row_description(sql_pipeline->get_result_table(), {});
 
     return _connection->send_row_description(row_description) >> then >> [=]() {
       return QueryResponseBuilder::send_query_response(
-          [=](const std::vector<std::string>& row) { return _connection->send_data_row(row); }, *result_table);
+          [=](const ByteBuffer& data_rows) { return _connection->send_data_rows(data_rows); }, *result_table, {});
     };
   };
 
@@ -243,12 +244,13 @@ boost::future<void> ServerSessionImpl<TConnection, TTaskRunner>::_handle_bind_co
   }
 
   auto statement_type = sql_pipeline->get_parsed_sql_statements().front()->getStatements().front()->type();
+  auto result_column_format_codes = packet.result_column_format_codes;
 
   auto task = std::make_shared<BindServerPreparedStatementTask>(sql_pipeline, packet.params);
   return _task_runner->dispatch_server_task(task) >> then >>
          [=](std::unique_ptr<SQLQueryPlan> query_plan) {
            std::shared_ptr<SQLQueryPlan> shared_query_plan = std::move(query_plan);
-           auto portal = std::make_pair(statement_type, shared_query_plan);
+           auto portal = Portal{statement_type, shared_query_plan, result_column_format_codes};
            _portals.insert(std::make_pair(portal_name, portal));
          } >>
          then >> [=]() { return _connection->send_status_message(NetworkMessageType::BindComplete); };
@@ -283,8 +285,9 @@ boost::future<void> ServerSessionImpl<TConnection, TTaskRunner>::_handle_execute
   auto portal_it = _portals.find(portal_name);
   if (portal_it == _portals.end()) throw std::logic_error("The specified portal does not exist.");
 
-  auto statement_type = portal_it->second.first;
-  auto query_plan = portal_it->second.second;
+  auto statement_type = portal_it->second.statement_type;
+  auto query_plan = portal_it->second.query_plan;
+  auto result_column_format_codes = portal_it->second.result_column_format_codes;
 
   if (portal_name.empty()) _portals.erase(portal_it);
 
@@ -299,10 +302,12 @@ boost::future<void> ServerSessionImpl<TConnection, TTaskRunner>::_handle_execute
              return _connection->send_status_message(NetworkMessageType::NoDataResponse) >> then >>
                     []() { return uint64_t(0); };
 
-           const auto row_description = QueryResponseBuilder::build_row_description(result_table);
+           const auto row_description =
+               QueryResponseBuilder::build_row_description(result_table, result_column_format_codes);
            return _connection->send_row_description(row_description) >> then >> [=]() {
              return QueryResponseBuilder::send_query_response(
-                 [=](const std::vector<std::string>& row) { return _connection->send_data_row(row); }, *result_table);
+                 [=](const ByteBuffer& data_rows) { return _connection->send_data_rows(data_rows); }, *result_table,
+                 result_column_format_codes);
            };
          } >>
          then >> [=](uint64_t row_count) {
@@ -42,7 +42,12 @@ class ServerSessionImpl : public std::enable_shared_from_this<ServerSessionImpl<
   std::shared_ptr<TransactionContext> _transaction;
   std::unordered_map<std::string, std::shared_ptr<SQLPipeline>> _prepared_statements;
   // TODO(lawben): The type of _portals will change when prepared statements are supported in the SQLPipeline
-  std::unordered_map<std::string, std::pair<hsql::StatementType, std::shared_ptr<SQLQueryPlan>>> _portals;
+  struct Portal {
+    hsql::StatementType statement_type;
+    std::shared_ptr<SQLQueryPlan> query_plan;
+    std::vector<FormatCode> result_column_format_codes;
+  };
+  std::unordered_map<std::string, Portal> _portals;
 };
 
 // The corresponding template instantiation takes place in the .cpp
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 namespace opossum {
 
 enum class NetworkMessageType : unsigned char {
@@ -42,6 +44,9 @@ enum class NetworkMessageType : unsigned char {
   Notice = 'N',
 };
 
+// Format of the values in DataRow messages. The client chooses the format per result column in the Bind message.
+enum class FormatCode : int16_t { Text = 0, Binary = 1 };
+
 enum class TransactionStatusIndicator : unsigned char {
   Idle = 'I',
   InTransactionBlock = 'T',
@@ -19,10 +19,12 @@ ColumnStatistics<ColumnDataType> ColumnStatistics<ColumnDataType>::dummy() {
 
 template <typename ColumnDataType>
 ColumnStatistics<ColumnDataType>::ColumnStatistics(const float null_value_ratio, const float distinct_count,
-                                                   const ColumnDataType min, const ColumnDataType max)
+                                                   const ColumnDataType min, const ColumnDataType max,
+                                                   const std::shared_ptr<const Histogram<ColumnDataType>>& histogram)
     : BaseColumnStatistics(data_type_from_type<ColumnDataType>(), null_value_ratio, distinct_count),
       _min(min),
-      _max(max) {
+      _max(max),
+      _histogram(histogram) {
   Assert(null_value_ratio >= 0.0f && null_value_ratio <= 1.0f, "NullValueRatio out of range");
 }
 
@@ -36,9 +38,15 @@ ColumnDataType ColumnStatistics<ColumnDataType>::max() const {
   return _max;
 }
 
+template <typename ColumnDataType>
+const std::shared_ptr<const Histogram<ColumnDataType>>& ColumnStatistics<ColumnDataType>::histogram() const {
+  return _histogram;
+}
+
 template <typename ColumnDataType>
 std::shared_ptr<BaseColumnStatistics> ColumnStatistics<ColumnDataType>::clone() const {
-  return std::make_shared<ColumnStatistics<ColumnDataType>>(null_value_ratio(), distinct_count(), _min, _max);
+  return std::make_shared<ColumnStatistics<ColumnDataType>>(null_value_ratio(), distinct_count(), _min, _max,
+                                                            _histogram);
 }
 
 template <typename ColumnDataType>
@@ -60,6 +68,9 @@ FilterByValueEstimate ColumnStatistics<ColumnDataType>::estimate_predicate_with_
       if (std::is_integral_v<ColumnDataType>) {
         return estimate_range(_min, value - 1);
       }
+      if (_histogram) {
+        return _estimate_range_without_value(_min, value, value);
+      }
       // intentionally no break
       // if ColumnDataType is a floating point number, OpLessThanEquals behaviour is expected instead of OpLessThan
       [[fallthrough]];
@@ -74,6 +85,9 @@ FilterByValueEstimate ColumnStatistics<ColumnDataType>::estimate_predicate_with_
       if (std::is_integral_v<ColumnDataType>) {
         return estimate_range(value + 1, _max);
       }
+      if (_histogram) {
+        return _estimate_range_without_value(value, _max, value);
+      }
       // intentionally no break
       // if ColumnDataType is a floating point number,
       // OpGreaterThanEquals behaviour is expected instead of OpGreaterThan
@@ -113,6 +127,28 @@ FilterByValueEstimate ColumnStatistics<std::string>::estimate_predicate_with_val
     case PredicateCondition::NotEquals: {
       return estimate_not_equals_with_value(casted_value);
     }
+    case PredicateCondition::LessThan:
+    case PredicateCondition::LessThanEquals:
+    case PredicateCondition::GreaterThan:
+    case PredicateCondition::GreaterThanEquals:
+    case PredicateCondition::Between: {
+      // Without a histogram, there is no way to tell which ratio of the strings is in a range
+      if (!_histogram) return {non_null_value_ratio(), without_null_values()};
+
+      switch (predicate_condition) {
+        case PredicateCondition::LessThan:
+          return _estimate_range_without_value(_min, casted_value, casted_value);
+        case PredicateCondition::LessThanEquals:
+          return estimate_range(_min, casted_value);
+        case PredicateCondition::GreaterThan:
+          return _estimate_range_without_value(casted_value, _max, casted_value);
+        case PredicateCondition::GreaterThanEquals:
+          return estimate_range(casted_value, _max);
+        default:
+          DebugAssert(static_cast<bool>(value2), "Operator BETWEEN should get two parameters, second is missing!");
+          return estimate_range(casted_value, type_cast<std::string>(*value2));
+      }
+    }
     // TODO(anybody) implement other table-scan operators for string.
     default: { return {non_null_value_ratio(), without_null_values()}; }
   }
@@ -276,7 +312,10 @@ FilterByColumnComparisonEstimate ColumnStatistics<ColumnDataType>::estimate_pred
 
   auto equal_values_ratio = 0.0f;
   // calculate ratio of rows with equal values
-  if (left_overlapping_distinct_count < right_overlapping_distinct_count) {
+  if (_histogram && right_column_statistics._histogram) {
+    // The histograms know about skew, e.g., of foreign keys that mostly reference a few primary keys
+    equal_values_ratio = _histogram->estimate_equi_join(*right_column_statistics._histogram);
+  } else if (left_overlapping_distinct_count < right_overlapping_distinct_count) {
     equal_values_ratio = left_overlapping_ratio / right_column_statistics.distinct_count();
   } else {
     equal_values_ratio = right_overlapping_ratio / distinct_count();
@@ -373,8 +412,15 @@ FilterByColumnComparisonEstimate ColumnStatistics<std::string>::estimate_predica
     return {0.f, without_null_values(), right_column_statistics.without_null_values()};
   }
 
-  return {non_null_value_ratio() * right_column_statistics.non_null_value_ratio(), without_null_values(),
-          right_column_statistics.without_null_values()};
+  const auto combined_non_null_ratio = non_null_value_ratio() * right_column_statistics.non_null_value_ratio();
+
+  if (predicate_condition == PredicateCondition::Equals && _histogram && right_column_statistics._histogram) {
+    const auto equal_values_ratio = _histogram->estimate_equi_join(*right_column_statistics._histogram);
+    return {combined_non_null_ratio * equal_values_ratio, without_null_values(),
+            right_column_statistics.without_null_values()};
+  }
+
+  return {combined_non_null_ratio, without_null_values(), right_column_statistics.without_null_values()};
 }
 
 template <typename ColumnDataType>
@@ -385,6 +431,7 @@ std::string ColumnStatistics<ColumnDataType>::description() const {
   stream << "     min      " << _min << std::endl;
   stream << "     max      " << _max << std::endl;
   stream << "     non-null " << non_null_value_ratio() << std::endl;
+  if (_histogram) stream << "     hist.    " << _histogram->description() << std::endl;
   return stream.str();
 }
 
@@ -392,6 +439,8 @@ template <typename ColumnDataType>
 float ColumnStatistics<ColumnDataType>::estimate_range_selectivity(const ColumnDataType minimum,
                                                                    const ColumnDataType maximum) const {
   DebugAssert(minimum <= maximum, "Minimum parameter is larger than maximum parameter.");
+  if (_histogram) return _histogram->estimate_range(minimum, maximum);
+
   // minimum must be smaller or equal than maximum
   // distinction between integers and decimals
   // for integers the number of possible integers is used within the inclusive ranges
@@ -413,6 +462,8 @@ float ColumnStatistics<ColumnDataType>::estimate_range_selectivity(const ColumnD
 template <>
 float ColumnStatistics<std::string>::estimate_range_selectivity(const std::string minimum,          // NOLINT
                                                                 const std::string maximum) const {  // NOLINT
+  if (_histogram) return _histogram->estimate_range(minimum, maximum);
+
   // TODO(anyone) implement selectivity for range approximation for column type string.
   return (maximum < minimum) ? 0.f : 1.f;
 }
@@ -428,18 +479,44 @@ FilterByValueEstimate ColumnStatistics<ColumnDataType>::estimate_range(const Col
     return {non_null_value_ratio(), without_null_values()};
   }
   auto selectivity = 0.f;
+  auto new_distinct_count = 0.f;
+  auto new_histogram = std::shared_ptr<const Histogram<ColumnDataType>>{};
   // estimate_selectivity_for_range function expects that the minimum must not be greater than the maximum
   if (common_min <= common_max) {
     selectivity = estimate_range_selectivity(common_min, common_max);
+
+    if (_histogram) {
+      new_distinct_count = _histogram->estimate_distinct_count(common_min, common_max);
+      new_histogram = _histogram->sliced(common_min, common_max);
+    } else {
+      new_distinct_count = selectivity * distinct_count();
+    }
   }
-  auto column_statistics =
-      std::make_shared<ColumnStatistics<ColumnDataType>>(0.0f, selectivity * distinct_count(), common_min, common_max);
+  auto column_statistics = std::make_shared<ColumnStatistics<ColumnDataType>>(0.0f, new_distinct_count, common_min,
+                                                                              common_max, new_histogram);
   return {non_null_value_ratio() * selectivity, column_statistics};
 }
 
+template <typename ColumnDataType>
+FilterByValueEstimate ColumnStatistics<ColumnDataType>::_estimate_range_without_value(
+    const ColumnDataType minimum, const ColumnDataType maximum, const ColumnDataType value) const {
+  DebugAssert(_histogram, "Only the histogram knows the ratio of rows equal to a value");
+  auto estimate = estimate_range(minimum, maximum);
+  const auto equals_selectivity = non_null_value_ratio() * _histogram->estimate_equals(value);
+  estimate.selectivity = std::max(estimate.selectivity - equals_selectivity, 0.0f);
+  return estimate;
+}
+
 template <typename ColumnDataType>
 FilterByValueEstimate ColumnStatistics<ColumnDataType>::estimate_equals_with_value(const ColumnDataType value) const {
   DebugAssert(distinct_count() > 0, "Distinct count has to be greater zero");
+  if (_histogram) {
+    const auto equals_ratio = _histogram->estimate_equals(value);
+    auto column_statistics =
+        std::make_shared<ColumnStatistics<ColumnDataType>>(0.0f, equals_ratio > 0.0f ? 1.f : 0.f, value, value);
+    return {non_null_value_ratio() * equals_ratio, column_statistics};
+  }
+
   float new_distinct_count = 1.f;
   if (value < _min || value > _max) {
     new_distinct_count = 0.f;
@@ -460,6 +537,9 @@ FilterByValueEstimate ColumnStatistics<ColumnDataType>::estimate_not_equals_with
     return {non_null_value_ratio(), without_null_values()};
   }
   auto column_statistics = std::make_shared<ColumnStatistics<ColumnDataType>>(0.0f, distinct_count() - 1, _min, _max);
+  if (_histogram) {
+    return {non_null_value_ratio() * (1.0f - _histogram->estimate_equals(value)), column_statistics};
+  }
   if (distinct_count() == 0.0f) {
     return {0.0f, column_statistics};
   } else {
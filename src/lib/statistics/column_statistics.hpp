@@ -7,11 +7,15 @@
 
 #include "all_type_variant.hpp"
 #include "base_column_statistics.hpp"
+#include "histogram.hpp"
 
 namespace opossum {
 
 /**
  * @tparam ColumnDataType   the DataType of the values in the Column that these statistics represent
+ *
+ * Without a histogram, values are assumed to be distributed uniformly between min and max. If a histogram is given,
+ * it is used instead for estimating the selectivity of predicates, which is far more accurate for skewed data.
  */
 template <typename ColumnDataType>
 class ColumnStatistics : public BaseColumnStatistics {
@@ -20,7 +24,8 @@ class ColumnStatistics : public BaseColumnStatistics {
   static ColumnStatistics dummy();
 
   ColumnStatistics(const float null_value_ratio, const float distinct_count, const ColumnDataType min,
-                   const ColumnDataType max);
+                   const ColumnDataType max,
+                   const std::shared_ptr<const Histogram<ColumnDataType>>& histogram = nullptr);
 
   /**
    * @defgroup Member access
@@ -28,6 +33,7 @@ class ColumnStatistics : public BaseColumnStatistics {
    */
   ColumnDataType min() const;
   ColumnDataType max() const;
+  const std::shared_ptr<const Histogram<ColumnDataType>>& histogram() const;
   /** @} */
 
   /**
@@ -77,8 +83,16 @@ class ColumnStatistics : public BaseColumnStatistics {
   /** @} */
 
  private:
+  /**
+   * @return estimate_range(), minus the rows equal to `value`, as the histogram knows how many there are. For the
+   *         predicates `column < value` and `column > value` on columns that can't use `value -/+ 1` as a bound.
+   */
+  FilterByValueEstimate _estimate_range_without_value(const ColumnDataType minimum, const ColumnDataType maximum,
+                                                      const ColumnDataType value) const;
+
   ColumnDataType _min;
   ColumnDataType _max;
+  std::shared_ptr<const Histogram<ColumnDataType>> _histogram;
 };
 
 }  // namespace opossum
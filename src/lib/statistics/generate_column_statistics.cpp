@@ -9,7 +9,7 @@ namespace opossum {
 template <>
 std::shared_ptr<BaseColumnStatistics> generate_column_statistics<std::string>(const Table& table,
                                                                               const ColumnID column_id) {
-  std::unordered_set<std::string> distinct_set;
+  std::unordered_map<std::string, size_t> value_counts;
   // It would be nice to use string_view here, but the iterables hold copies of the values, not references themselves.
   // SegmentIteratorValue would have to be changed to `T& _value` and this brings a whole bunch of problems in iterators
   // that create stack copies of the accessed values (e.g., for ReferenceSegments)
@@ -28,14 +28,14 @@ std::shared_ptr<BaseColumnStatistics> generate_column_statistics<std::string>(co
         if (segment_value.is_null()) {
           ++null_value_count;
         } else {
-          if (distinct_set.empty()) {
+          if (value_counts.empty()) {
             min = segment_value.value();
             max = segment_value.value();
           } else {
             min = std::min(min, segment_value.value());
             max = std::max(max, segment_value.value());
           }
-          distinct_set.insert(segment_value.value());
+          ++value_counts[segment_value.value()];
         }
       });
     });
@@ -43,9 +43,12 @@ std::shared_ptr<BaseColumnStatistics> generate_column_statistics<std::string>(co
 
   const auto null_value_ratio =
       table.row_count() > 0 ? static_cast<float>(null_value_count) / static_cast<float>(table.row_count()) : 0.0f;
-  const auto distinct_count = static_cast<float>(distinct_set.size());
+  const auto distinct_count = static_cast<float>(value_counts.size());
 
-  return std::make_shared<ColumnStatistics<std::string>>(null_value_ratio, distinct_count, min, max);
+  const auto histogram = Histogram<std::string>::from_value_counts(
+      std::vector<std::pair<std::string, size_t>>{value_counts.begin(), value_counts.end()});
+
+  return std::make_shared<ColumnStatistics<std::string>>(null_value_ratio, distinct_count, min, max, histogram);
 }
 
 }  // namespace opossum
@@ -1,9 +1,12 @@
 #pragma once
 
-#include <unordered_set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "base_column_statistics.hpp"
 #include "column_statistics.hpp"
+#include "histogram.hpp"
 #include "resolve_type.hpp"
 #include "storage/create_iterable_from_segment.hpp"
 #include "storage/table.hpp"
@@ -15,7 +18,7 @@ namespace opossum {
  */
 template <typename ColumnDataType>
 std::shared_ptr<BaseColumnStatistics> generate_column_statistics(const Table& table, const ColumnID column_id) {
-  std::unordered_set<ColumnDataType> distinct_set;
+  std::unordered_map<ColumnDataType, size_t> value_counts;
 
   auto null_value_count = size_t{0};
 
@@ -31,7 +34,7 @@ std::shared_ptr<BaseColumnStatistics> generate_column_statistics(const Table& ta
         if (segment_value.is_null()) {
           ++null_value_count;
         } else {
-          distinct_set.insert(segment_value.value());
+          ++value_counts[segment_value.value()];
           min = std::min(min, segment_value.value());
           max = std::max(max, segment_value.value());
         }
@@ -41,14 +44,17 @@ std::shared_ptr<BaseColumnStatistics> generate_column_statistics(const Table& ta
 
   const auto null_value_ratio =
       table.row_count() > 0 ? static_cast<float>(null_value_count) / static_cast<float>(table.row_count()) : 0.0f;
-  const auto distinct_count = static_cast<float>(distinct_set.size());
+  const auto distinct_count = static_cast<float>(value_counts.size());
 
   if (distinct_count == 0.0f) {
     min = std::numeric_limits<ColumnDataType>::min();
     max = std::numeric_limits<ColumnDataType>::max();
   }
 
-  return std::make_shared<ColumnStatistics<ColumnDataType>>(null_value_ratio, distinct_count, min, max);
+  const auto histogram = Histogram<ColumnDataType>::from_value_counts(
+      std::vector<std::pair<ColumnDataType, size_t>>{value_counts.begin(), value_counts.end()});
+
+  return std::make_shared<ColumnStatistics<ColumnDataType>>(null_value_ratio, distinct_count, min, max, histogram);
 }
 
 template <>
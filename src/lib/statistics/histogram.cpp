@@ -0,0 +1,289 @@
+#include "histogram.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+template <typename T>
+std::shared_ptr<Histogram<T>> Histogram<T>::from_value_counts(std::vector<std::pair<T, size_t>> value_counts) {
+  if (value_counts.empty()) return nullptr;
+
+  std::sort(value_counts.begin(), value_counts.end(),
+            [](const auto& left, const auto& right) { return left.first < right.first; });
+
+  auto total_count = size_t{0};
+  for (const auto& value_count : value_counts) total_count += value_count.second;
+
+  /**
+   * 1. Pick the most common values. Only values that are considerably more frequent than the average value qualify,
+   *    so that columns without skew do not have any.
+   */
+  const auto average_count = static_cast<float>(total_count) / static_cast<float>(value_counts.size());
+  const auto min_most_common_value_count = MOST_COMMON_VALUE_THRESHOLD * average_count;
+
+  auto candidate_indices = std::vector<size_t>{};
+  for (auto value_index = size_t{0}; value_index < value_counts.size(); ++value_index) {
+    if (static_cast<float>(value_counts[value_index].second) >= min_most_common_value_count) {
+      candidate_indices.emplace_back(value_index);
+    }
+  }
+
+  std::stable_sort(candidate_indices.begin(), candidate_indices.end(), [&](const auto left, const auto right) {
+    return value_counts[left].second > value_counts[right].second;
+  });
+  candidate_indices.resize(std::min(candidate_indices.size(), MAX_MOST_COMMON_VALUE_COUNT));
+  std::sort(candidate_indices.begin(), candidate_indices.end());
+
+  auto is_most_common_value = std::vector<bool>(value_counts.size(), false);
+  auto most_common_values = std::vector<MostCommonValue<T>>{};
+  auto most_common_values_count = size_t{0};
+
+  for (const auto value_index : candidate_indices) {
+    const auto& [value, count] = value_counts[value_index];
+    is_most_common_value[value_index] = true;
+    most_common_values.emplace_back(
+        MostCommonValue<T>{value, static_cast<float>(count) / static_cast<float>(total_count)});
+    most_common_values_count += count;
+  }
+
+  /**
+   * 2. Distribute the remaining values over equal-height buckets. A value is never split between two buckets.
+   */
+  const auto remaining_distinct_count = value_counts.size() - most_common_values.size();
+  const auto remaining_count = total_count - most_common_values_count;
+
+  auto buckets = std::vector<HistogramBucket<T>>{};
+
+  if (remaining_distinct_count > 0) {
+    const auto bucket_count = std::min(MAX_BUCKET_COUNT, remaining_distinct_count);
+    const auto bucket_height = static_cast<double>(remaining_count) / static_cast<double>(bucket_count);
+
+    auto cumulative_count = size_t{0};
+    auto bucket_row_count = size_t{0};
+    auto bucket_distinct_count = size_t{0};
+    auto bucket_min = T{};
+
+    for (auto value_index = size_t{0}; value_index < value_counts.size(); ++value_index) {
+      if (is_most_common_value[value_index]) continue;
+
+      const auto& [value, count] = value_counts[value_index];
+      if (bucket_distinct_count == 0) bucket_min = value;
+
+      cumulative_count += count;
+      bucket_row_count += count;
+      ++bucket_distinct_count;
+
+      const auto bucket_is_full =
+          static_cast<double>(cumulative_count) >= bucket_height * static_cast<double>(buckets.size() + 1);
+      if (bucket_is_full || cumulative_count == remaining_count) {
+        buckets.emplace_back(HistogramBucket<T>{bucket_min, value,
+                                                static_cast<float>(bucket_row_count) / static_cast<float>(total_count),
+                                                static_cast<float>(bucket_distinct_count)});
+        bucket_row_count = 0;
+        bucket_distinct_count = 0;
+      }
+    }
+  }
+
+  return std::make_shared<Histogram<T>>(std::move(most_common_values), std::move(buckets));
+}
+
+template <typename T>
+Histogram<T>::Histogram(std::vector<MostCommonValue<T>> most_common_values, std::vector<HistogramBucket<T>> buckets)
+    : _most_common_values(std::move(most_common_values)), _buckets(std::move(buckets)) {
+  DebugAssert(std::is_sorted(_most_common_values.begin(), _most_common_values.end(),
+                             [](const auto& left, const auto& right) { return left.value < right.value; }),
+              "Most common values have to be sorted");
+  DebugAssert(std::is_sorted(_buckets.begin(), _buckets.end(),
+                             [](const auto& left, const auto& right) { return left.max < right.min; }),
+              "Buckets have to be sorted and must not overlap");
+}
+
+template <typename T>
+const std::vector<MostCommonValue<T>>& Histogram<T>::most_common_values() const {
+  return _most_common_values;
+}
+
+template <typename T>
+const std::vector<HistogramBucket<T>>& Histogram<T>::buckets() const {
+  return _buckets;
+}
+
+template <typename T>
+float Histogram<T>::estimate_equals(const T& value) const {
+  const auto most_common_value_iter = std::lower_bound(
+      _most_common_values.begin(), _most_common_values.end(), value,
+      [](const auto& most_common_value, const T& search_value) { return most_common_value.value < search_value; });
+  if (most_common_value_iter != _most_common_values.end() && most_common_value_iter->value == value) {
+    return most_common_value_iter->ratio;
+  }
+
+  // Find the first bucket that ends at or after value
+  const auto bucket_iter =
+      std::lower_bound(_buckets.begin(), _buckets.end(), value,
+                       [](const auto& bucket, const T& search_value) { return bucket.max < search_value; });
+  if (bucket_iter == _buckets.end() || value < bucket_iter->min) return 0.0f;
+
+  return bucket_iter->ratio / bucket_iter->distinct_count;
+}
+
+template <typename T>
+float Histogram<T>::estimate_range(const T& minimum, const T& maximum) const {
+  if (maximum < minimum) return 0.0f;
+
+  auto ratio = 0.0f;
+
+  for (const auto& most_common_value : _most_common_values) {
+    if (!(most_common_value.value < minimum) && !(maximum < most_common_value.value)) {
+      ratio += most_common_value.ratio;
+    }
+  }
+
+  for (const auto& bucket : _buckets) {
+    ratio += bucket.ratio * _bucket_overlap(bucket, minimum, maximum);
+  }
+
+  return std::min(ratio, 1.0f);
+}
+
+template <typename T>
+float Histogram<T>::estimate_distinct_count(const T& minimum, const T& maximum) const {
+  if (maximum < minimum) return 0.0f;
+
+  auto distinct_count = 0.0f;
+
+  for (const auto& most_common_value : _most_common_values) {
+    if (!(most_common_value.value < minimum) && !(maximum < most_common_value.value)) {
+      distinct_count += 1.0f;
+    }
+  }
+
+  for (const auto& bucket : _buckets) {
+    distinct_count += bucket.distinct_count * _bucket_overlap(bucket, minimum, maximum);
+  }
+
+  return distinct_count;
+}
+
+template <typename T>
+float Histogram<T>::estimate_equi_join(const Histogram<T>& right) const {
+  /**
+   * 1. Pairs in which at least one of the values is a most common value. If it is a most common value of both sides,
+   *    it is only counted once.
+   */
+  auto ratio = 0.0f;
+
+  for (const auto& most_common_value : _most_common_values) {
+    ratio += most_common_value.ratio * right.estimate_equals(most_common_value.value);
+  }
+
+  for (const auto& most_common_value : right._most_common_values) {
+    const auto is_left_most_common_value =
+        std::binary_search(_most_common_values.begin(), _most_common_values.end(), most_common_value,
+                           [](const auto& lhs, const auto& rhs) { return lhs.value < rhs.value; });
+    if (!is_left_most_common_value) ratio += most_common_value.ratio * estimate_equals(most_common_value.value);
+  }
+
+  /**
+   * 2. Pairs of values from the buckets. Within the overlap of two buckets, the values of the side with fewer distinct
+   *    values are assumed to also exist on the other side.
+   */
+  auto left_bucket_iter = _buckets.begin();
+  auto right_bucket_iter = right._buckets.begin();
+
+  while (left_bucket_iter != _buckets.end() && right_bucket_iter != right._buckets.end()) {
+    const auto& left_bucket = *left_bucket_iter;
+    const auto& right_bucket = *right_bucket_iter;
+
+    const auto overlap_min = std::max(left_bucket.min, right_bucket.min);
+    const auto overlap_max = std::min(left_bucket.max, right_bucket.max);
+
+    if (!(overlap_max < overlap_min)) {
+      const auto left_distinct_count =
+          left_bucket.distinct_count * _bucket_overlap(left_bucket, overlap_min, overlap_max);
+      const auto right_distinct_count =
+          right_bucket.distinct_count * _bucket_overlap(right_bucket, overlap_min, overlap_max);
+
+      ratio += std::min(left_distinct_count, right_distinct_count) * (left_bucket.ratio / left_bucket.distinct_count) *
+               (right_bucket.ratio / right_bucket.distinct_count);
+    }
+
+    if (left_bucket.max < right_bucket.max) {
+      ++left_bucket_iter;
+    } else {
+      ++right_bucket_iter;
+    }
+  }
+
+  return std::min(ratio, 1.0f);
+}
+
+template <typename T>
+std::shared_ptr<Histogram<T>> Histogram<T>::sliced(const T& minimum, const T& maximum) const {
+  const auto total_ratio = estimate_range(minimum, maximum);
+  if (total_ratio <= 0.0f) return nullptr;
+
+  auto most_common_values = std::vector<MostCommonValue<T>>{};
+  for (const auto& most_common_value : _most_common_values) {
+    if (!(most_common_value.value < minimum) && !(maximum < most_common_value.value)) {
+      most_common_values.emplace_back(
+          MostCommonValue<T>{most_common_value.value, most_common_value.ratio / total_ratio});
+    }
+  }
+
+  auto buckets = std::vector<HistogramBucket<T>>{};
+  for (const auto& bucket : _buckets) {
+    const auto overlap = _bucket_overlap(bucket, minimum, maximum);
+    if (overlap <= 0.0f) continue;
+
+    buckets.emplace_back(HistogramBucket<T>{std::max(bucket.min, minimum), std::min(bucket.max, maximum),
+                                            bucket.ratio * overlap / total_ratio,
+                                            std::max(bucket.distinct_count * overlap, 1.0f)});
+  }
+
+  return std::make_shared<Histogram<T>>(std::move(most_common_values), std::move(buckets));
+}
+
+template <typename T>
+std::string Histogram<T>::description() const {
+  std::stringstream stream;
+  stream << _most_common_values.size() << " most common values, " << _buckets.size() << " buckets";
+  return stream.str();
+}
+
+template <typename T>
+float Histogram<T>::_bucket_overlap(const HistogramBucket<T>& bucket, const T& minimum, const T& maximum) {
+  const auto overlap_min = std::max(bucket.min, minimum);
+  const auto overlap_max = std::min(bucket.max, maximum);
+
+  if (overlap_max < overlap_min) return 0.0f;
+  if (overlap_min == bucket.min && overlap_max == bucket.max) return 1.0f;
+
+  // A single value of the bucket
+  if (overlap_min == overlap_max) return 1.0f / bucket.distinct_count;
+
+  if constexpr (std::is_integral_v<T>) {
+    // The number of possible integers in the overlap, relative to that in the bucket
+    return static_cast<float>((static_cast<double>(overlap_max) - static_cast<double>(overlap_min) + 1.0) /
+                              (static_cast<double>(bucket.max) - static_cast<double>(bucket.min) + 1.0));
+  } else if constexpr (std::is_floating_point_v<T>) {
+    return static_cast<float>((static_cast<double>(overlap_max) - static_cast<double>(overlap_min)) /
+                              (static_cast<double>(bucket.max) - static_cast<double>(bucket.min)));
+  } else {
+    // Strings cannot be interpolated, so assume that half of the bucket is in the range
+    return 0.5f;
+  }
+}
+
+EXPLICITLY_INSTANTIATE_DATA_TYPES(Histogram);
+
+}  // namespace opossum
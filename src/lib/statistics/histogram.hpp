@@ -0,0 +1,92 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+template <typename T>
+struct HistogramBucket {
+  T min;
+  T max;
+
+  // Ratio of the non-NULL values of the column that are in this bucket
+  float ratio;
+  float distinct_count;
+};
+
+template <typename T>
+struct MostCommonValue {
+  T value;
+
+  // Ratio of the non-NULL values of the column that are equal to value
+  float ratio;
+};
+
+/**
+ * Compressed histogram of the non-NULL values of a column, used by ColumnStatistics for skewed data.
+ *
+ * The most common values (i.e., values that are clearly more frequent than the average value) are stored with their
+ * exact frequency. The remaining values are summarized in equal-height buckets, each of which covers about the same
+ * number of rows. Within a bucket, values are assumed to be distributed uniformly between its min and max, just like
+ * ColumnStatistics does for the entire column. If a column has no more than MAX_BUCKET_COUNT distinct values and no
+ * most common values, every value gets its own bucket, so that the histogram is exact.
+ *
+ * Both most common values and buckets are sorted by value, the buckets do not overlap.
+ */
+template <typename T>
+class Histogram {
+ public:
+  static constexpr size_t MAX_MOST_COMMON_VALUE_COUNT = 16;
+  static constexpr size_t MAX_BUCKET_COUNT = 64;
+
+  // A value is one of the most common values if it is at least this many times as frequent as the average value
+  static constexpr float MOST_COMMON_VALUE_THRESHOLD = 2.0f;
+
+  // value_counts holds the number of occurrences of each distinct value, in any order. Returns nullptr if it is empty.
+  static std::shared_ptr<Histogram<T>> from_value_counts(std::vector<std::pair<T, size_t>> value_counts);
+
+  Histogram(std::vector<MostCommonValue<T>> most_common_values, std::vector<HistogramBucket<T>> buckets);
+
+  const std::vector<MostCommonValue<T>>& most_common_values() const;
+  const std::vector<HistogramBucket<T>>& buckets() const;
+
+  /**
+   * @defgroup Estimations, all relative to the non-NULL values of the column
+   * @{
+   */
+
+  // Ratio of values equal to `value`
+  float estimate_equals(const T& value) const;
+
+  // Ratio of values in [minimum, maximum]
+  float estimate_range(const T& minimum, const T& maximum) const;
+
+  // Number of distinct values in [minimum, maximum]
+  float estimate_distinct_count(const T& minimum, const T& maximum) const;
+
+  // Ratio of pairs of values from this and `right` that are equal, i.e., the selectivity of an equi-join
+  float estimate_equi_join(const Histogram<T>& right) const;
+  /** @} */
+
+  /**
+   * @return the histogram of the values in [minimum, maximum], or nullptr if no values are in that range
+   */
+  std::shared_ptr<Histogram<T>> sliced(const T& minimum, const T& maximum) const;
+
+  std::string description() const;
+
+ private:
+  // Ratio of the values (or of the distinct values) of `bucket` that are in [minimum, maximum]
+  static float _bucket_overlap(const HistogramBucket<T>& bucket, const T& minimum, const T& maximum);
+
+  std::vector<MostCommonValue<T>> _most_common_values;
+  std::vector<HistogramBucket<T>> _buckets;
+};
+
+}  // namespace opossum
@@ -1,9 +1,11 @@
 #include "statistics_import_export.hpp"
 
 #include <fstream>
+#include <vector>
 
 #include "column_statistics.hpp"
 #include "constant_mappings.hpp"
+#include "histogram.hpp"
 #include "resolve_type.hpp"
 #include "utils/assert.hpp"
 
@@ -66,8 +68,29 @@ std::shared_ptr<BaseColumnStatistics> import_column_statistics(const nlohmann::j
     const auto min = json["min"].get<ColumnDataType>();
     const auto max = json["max"].get<ColumnDataType>();
 
+    // Histograms are optional, so that statistics exported before they were introduced can still be imported
+    auto histogram = std::shared_ptr<const Histogram<ColumnDataType>>{};
+    if (json.count("histogram")) {
+      const auto& histogram_json = json["histogram"];
+
+      auto most_common_values = std::vector<MostCommonValue<ColumnDataType>>{};
+      for (const auto& most_common_value_json : histogram_json["most_common_values"]) {
+        most_common_values.emplace_back(MostCommonValue<ColumnDataType>{
+            most_common_value_json["value"].get<ColumnDataType>(), most_common_value_json["ratio"].get<float>()});
+      }
+
+      auto buckets = std::vector<HistogramBucket<ColumnDataType>>{};
+      for (const auto& bucket_json : histogram_json["buckets"]) {
+        buckets.emplace_back(HistogramBucket<ColumnDataType>{
+            bucket_json["min"].get<ColumnDataType>(), bucket_json["max"].get<ColumnDataType>(),
+            bucket_json["ratio"].get<float>(), bucket_json["distinct_count"].get<float>()});
+      }
+
+      histogram = std::make_shared<Histogram<ColumnDataType>>(std::move(most_common_values), std::move(buckets));
+    }
+
     result_column_statistics =
-        std::make_shared<ColumnStatistics<ColumnDataType>>(null_value_ratio, distinct_count, min, max);
+        std::make_shared<ColumnStatistics<ColumnDataType>>(null_value_ratio, distinct_count, min, max, histogram);
   });
 
   Assert(result_column_statistics, "resolve_data_type() apparently failed.");
@@ -98,6 +121,26 @@ nlohmann::json export_column_statistics(const BaseColumnStatistics& base_column_
     const auto& column_statistics = static_cast<const ColumnStatistics<ColumnDataType>&>(base_column_statistics);
     column_statistics_json["min"] = column_statistics.min();
     column_statistics_json["max"] = column_statistics.max();
+
+    const auto& histogram = column_statistics.histogram();
+    if (!histogram) return;
+
+    auto histogram_json = nlohmann::json{};
+    histogram_json["most_common_values"] = nlohmann::json::array();
+    for (const auto& most_common_value : histogram->most_common_values()) {
+      histogram_json["most_common_values"].push_back({{"value", most_common_value.value},
+                                                      {"ratio", most_common_value.ratio}});
+    }
+
+    histogram_json["buckets"] = nlohmann::json::array();
+    for (const auto& bucket : histogram->buckets()) {
+      histogram_json["buckets"].push_back({{"min", bucket.min},
+                                           {"max", bucket.max},
+                                           {"ratio", bucket.ratio},
+                                           {"distinct_count", bucket.distinct_count}});
+    }
+
+    column_statistics_json["histogram"] = histogram_json;
   });
 
   return column_statistics_json;
@@ -34,7 +34,10 @@ Chunk::Chunk(const Segments& segments, const std::shared_ptr<MvccData>& mvcc_dat
 
 bool Chunk::is_mutable() const { return _is_mutable; }
 
-void Chunk::mark_immutable() { _is_mutable = false; }
+void Chunk::mark_immutable() {
+  _is_mutable = false;
+  if (has_mvcc_data()) get_scoped_mvcc_data_lock()->compute_summary();
+}
 
 void Chunk::replace_segment(size_t column_id, const std::shared_ptr<BaseSegment>& segment) {
   std::atomic_store(&_segments.at(column_id), segment);
@@ -50,6 +50,7 @@ class Chunk : private Noncopyable {
   // returns whether new rows can be appended to this Chunk
   bool is_mutable() const;
 
+  // Also computes the summary of the MvccData, see MvccData::compute_summary()
   void mark_immutable();
 
   // Atomically replaces the current segment at column_id with the passed segment
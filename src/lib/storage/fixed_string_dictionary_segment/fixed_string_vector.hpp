@@ -34,6 +34,10 @@ class FixedStringVector {
     }
   }
 
+  // Create a FixedStringVector from the characters of another one, e.g., when restoring it from a Checkpoint
+  FixedStringVector(pmr_vector<char> chars, size_t string_length)
+      : _string_length(string_length), _chars(std::move(chars)) {}
+
   // Add a string to the end of the vector
   void push_back(const std::string& string);
 
@@ -59,6 +63,11 @@ class FixedStringVector {
   // Return a pointer to the underlying memory
   char* data();
 
+  // Return the underlying characters, all strings padded to string_length()
+  const pmr_vector<char>& chars() const;
+
+  size_t string_length() const;
+
   // Return the number of entries in the vector.
   size_t size() const;
 
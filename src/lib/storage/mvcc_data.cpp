@@ -1,5 +1,6 @@
 #include "mvcc_data.hpp"
 
+#include <algorithm>
 #include <shared_mutex>
 
 #include "utils/assert.hpp"
@@ -23,6 +24,42 @@ void MvccData::grow_by(size_t delta, CommitID begin_cid) {
   end_cids.grow_to_at_least(_size, MAX_COMMIT_ID);
 }
 
+CommitID MvccData::max_begin_cid() const { return _max_begin_cid; }
+
+bool MvccData::has_invalidated_rows() const { return _has_invalidated_rows; }
+
+void MvccData::compute_summary() {
+  _is_summarized = true;
+  _update_summary();
+}
+
+void MvccData::register_invalidation() { _has_invalidated_rows = true; }
+
+bool MvccData::all_rows_visible(const CommitID snapshot_commit_id) const {
+  if (_has_invalidated_rows) return false;
+
+  // Rows that were not committed when the chunk became immutable have been committed (or rolled back) by now
+  if (_max_begin_cid == MAX_COMMIT_ID && _is_summarized) _update_summary();
+
+  return !_has_invalidated_rows && _max_begin_cid <= snapshot_commit_id;
+}
+
+void MvccData::_update_summary() const {
+  auto max_begin_cid = CommitID{0};
+  auto has_invalidated_rows = false;
+  for (auto chunk_offset = size_t{0}; chunk_offset < _size; ++chunk_offset) {
+    // No need to look further, max_begin_cid stays MAX_COMMIT_ID until this row is committed
+    if (begin_cids[chunk_offset] == MAX_COMMIT_ID) return;
+
+    max_begin_cid = std::max(max_begin_cid, begin_cids[chunk_offset]);
+    has_invalidated_rows |= end_cids[chunk_offset] != MAX_COMMIT_ID;
+  }
+
+  // A concurrent Delete might have registered an invalidation that is not yet visible in the end_cids
+  if (has_invalidated_rows) _has_invalidated_rows = true;
+  _max_begin_cid = max_begin_cid;
+}
+
 void MvccData::print(std::ostream& stream) const {
   stream << "TIDs: ";
   for (const auto& tid : tids) stream << tid << ", ";
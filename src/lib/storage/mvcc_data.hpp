@@ -42,6 +42,32 @@ struct MvccData {
 
   void print(std::ostream& stream = std::cout) const;
 
+  /**
+   * @defgroup Summary of the MVCC data
+   *
+   * Allows readers to skip the visibility checks of chunks whose rows have all been committed before their snapshot
+   * and none of which has been invalidated, which is the common case for immutable chunks. The summary is computed
+   * when a chunk becomes immutable (see Chunk::mark_immutable()). Until then, max_begin_cid() is MAX_COMMIT_ID. If
+   * some rows are not committed yet at that point, all_rows_visible() completes the summary once they are.
+   * Afterwards, everyone who sets an end_cid or locks a row for doing so has to call register_invalidation() first.
+   * @{
+   */
+
+  // Upper bound for all begin_cids
+  CommitID max_begin_cid() const;
+
+  // True if an end_cid might have been set, or if a row might have been locked by a Delete
+  bool has_invalidated_rows() const;
+
+  void compute_summary();
+  void register_invalidation();
+
+  // True if all rows are visible for every transaction with the given snapshot (apart from rows locked by itself, which
+  // imply has_invalidated_rows())
+  bool all_rows_visible(const CommitID snapshot_commit_id) const;
+
+  /**@}*/
+
  private:
   /**
    * @brief Mutex used to manage access to MVCC data
@@ -53,6 +79,14 @@ struct MvccData {
   std::shared_mutex _mutex;
 
   size_t _size{0};
+
+  // Scans the MVCC data for the summary. Stops at the first uncommitted row, leaving max_begin_cid() unset.
+  void _update_summary() const;
+
+  // The summary is updated lazily by the (const) readers
+  mutable std::atomic<CommitID> _max_begin_cid{MAX_COMMIT_ID};
+  mutable std::atomic<bool> _has_invalidated_rows{false};
+  std::atomic<bool> _is_summarized{false};
 };
 
 }  // namespace opossum
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+
 #include "storage/vector_compression/base_compressed_vector.hpp"
 
 #include "oversized_types.hpp"
@@ -27,6 +29,34 @@ class SimdBp128Vector : public CompressedVector<SimdBp128Vector> {
 
   const pmr_vector<uint128_t>& data() const;
 
+  /**
+   * @brief Calls functor(first_index, bit_size, packed_block) for each block of 128 values
+   *
+   * Allows to process the vector one block at a time without unpacking whole meta blocks. packed_block points to the
+   * bit_size 128-bit words of the block that can be passed to SimdBp128Packing::unpack_block. All values of a block
+   * are smaller than 2^bit_size. The last block may contain fewer than 128 values.
+   */
+  template <typename Functor>
+  void for_each_block(const Functor& functor) const {
+    using Packing = SimdBp128Packing;
+
+    auto data_index = size_t{0u};
+    auto meta_info = std::array<uint8_t, Packing::blocks_in_meta_block>{};
+
+    for (auto meta_block_first_index = size_t{0u}; meta_block_first_index < _size;
+         meta_block_first_index += Packing::meta_block_size) {
+      Packing::read_meta_info(_data.data() + data_index++, meta_info.data());
+
+      for (auto block_index = 0u; block_index < Packing::blocks_in_meta_block; ++block_index) {
+        const auto first_index = meta_block_first_index + block_index * Packing::block_size;
+        if (first_index >= _size) return;
+
+        functor(first_index, meta_info[block_index], _data.data() + data_index);
+        data_index += meta_info[block_index];
+      }
+    }
+  }
+
   size_t on_size() const;
   size_t on_data_size() const;
 
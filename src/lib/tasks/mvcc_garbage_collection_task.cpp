@@ -0,0 +1,224 @@
+#include "mvcc_garbage_collection_task.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "concurrency/transaction_context.hpp"
+#include "concurrency/transaction_manager.hpp"
+#include "operators/delete.hpp"
+#include "operators/insert.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/validate.hpp"
+#include "resolve_type.hpp"
+#include "storage/base_encoded_segment.hpp"
+#include "storage/base_value_segment.hpp"
+#include "storage/chunk.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/run_length_segment.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "storage/vector_compression/compressed_vector_type.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// Rows whose end_cid is not higher than the lowest active snapshot commit id are invisible to all transactions
+size_t dead_row_count(const Chunk& chunk, const CommitID lowest_active_snapshot_commit_id) {
+  const auto mvcc_data = chunk.get_scoped_mvcc_data_lock();
+
+  auto count = size_t{0};
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+    if (mvcc_data->end_cids[chunk_offset] <= lowest_active_snapshot_commit_id) ++count;
+  }
+  return count;
+}
+
+// A chunk is compacted if all of its segments consist of a single run
+bool is_compacted(const Table& table, const Chunk& chunk) {
+  for (auto column_id = ColumnID{0}; column_id < chunk.column_count(); ++column_id) {
+    auto segment_is_compacted = false;
+    resolve_data_type(table.column_data_type(column_id), [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+      const auto run_length_segment =
+          std::dynamic_pointer_cast<const RunLengthSegment<ColumnDataType>>(chunk.get_segment(column_id));
+      segment_is_compacted = run_length_segment && run_length_segment->values()->size() == 1u;
+    });
+
+    if (!segment_is_compacted) return false;
+  }
+  return true;
+}
+
+// Encodes the chunks that are filled up with moved rows like the chunk the rows came from
+ChunkEncodingSpec encoding_spec(const Chunk& chunk) {
+  auto spec = ChunkEncodingSpec{};
+  for (auto column_id = ColumnID{0}; column_id < chunk.column_count(); ++column_id) {
+    const auto encoded_segment = std::dynamic_pointer_cast<const BaseEncodedSegment>(chunk.get_segment(column_id));
+    if (!encoded_segment) {
+      spec.emplace_back(EncodingType::Unencoded);
+      continue;
+    }
+
+    switch (encoded_segment->compressed_vector_type()) {
+      case CompressedVectorType::FixedSize4ByteAligned:
+      case CompressedVectorType::FixedSize2ByteAligned:
+      case CompressedVectorType::FixedSize1ByteAligned:
+        spec.emplace_back(encoded_segment->encoding_type(), VectorCompressionType::FixedSizeByteAligned);
+        break;
+      case CompressedVectorType::SimdBp128:
+        spec.emplace_back(encoded_segment->encoding_type(), VectorCompressionType::SimdBp128);
+        break;
+      case CompressedVectorType::Invalid:
+        spec.emplace_back(encoded_segment->encoding_type());
+        break;
+    }
+  }
+  return spec;
+}
+
+bool is_completed(const Chunk& chunk, const uint32_t max_chunk_size) {
+  if (!chunk.is_mutable() || chunk.size() != max_chunk_size) return false;
+
+  for (auto column_id = ColumnID{0}; column_id < chunk.column_count(); ++column_id) {
+    // Chunks that are already being encoded by someone else
+    if (!std::dynamic_pointer_cast<const BaseValueSegment>(chunk.get_segment(column_id))) return false;
+  }
+
+  const auto mvcc_data = chunk.get_scoped_mvcc_data_lock();
+  for (const auto begin_cid : mvcc_data->begin_cids) {
+    if (begin_cid == MvccData::MAX_COMMIT_ID) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+MvccGarbageCollectionTask::MvccGarbageCollectionTask(const std::string& table_name, const float min_dead_row_ratio)
+    : _table_name{table_name}, _min_dead_row_ratio{min_dead_row_ratio} {}
+
+size_t MvccGarbageCollectionTask::moved_row_count() const { return _moved_row_count; }
+
+size_t MvccGarbageCollectionTask::compacted_chunk_count() const { return _compacted_chunk_count; }
+
+size_t MvccGarbageCollectionTask::reclaimed_bytes() const { return _reclaimed_bytes; }
+
+void MvccGarbageCollectionTask::_on_execute() {
+  const auto table = StorageManager::get().get_table(_table_name);
+  Assert(table != nullptr, "Table does not exist.");
+  Assert(table->has_mvcc() == UseMvcc::Yes, "Table has no MVCC data.");
+
+  if (!table->get_indexes().empty()) return;
+
+  // Step 1: Move the live rows out of chunks that consist mostly of dead rows
+  auto lowest_active_snapshot_commit_id = TransactionManager::get().lowest_active_snapshot_commit_id();
+
+  const auto chunk_count = table->chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    if (chunk->is_mutable() || chunk->size() == 0) continue;
+
+    const auto dead_rows = dead_row_count(*chunk, lowest_active_snapshot_commit_id);
+    if (dead_rows == chunk->size()) continue;
+    if (static_cast<float>(dead_rows) / chunk->size() < _min_dead_row_ratio) continue;
+
+    _moved_row_count += _move_live_rows(table, chunk_id);
+  }
+
+  // Step 2: Compact chunks without any live rows. Rows moved in step 1 are usually still visible to some transaction.
+  lowest_active_snapshot_commit_id = TransactionManager::get().lowest_active_snapshot_commit_id();
+
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    if (chunk->is_mutable() || chunk->size() == 0) continue;
+    if (dead_row_count(*chunk, lowest_active_snapshot_commit_id) != chunk->size()) continue;
+    if (is_compacted(*table, *chunk)) continue;
+
+    _reclaimed_bytes += _compact_chunk(table, chunk);
+    ++_compacted_chunk_count;
+  }
+}
+
+size_t MvccGarbageCollectionTask::_move_live_rows(const std::shared_ptr<Table>& table, const ChunkID chunk_id) {
+  const auto chunk = table->get_chunk(chunk_id);
+
+  // Reference all rows of the chunk, Validate filters the live ones
+  auto pos_list = std::make_shared<PosList>();
+  pos_list->reserve(chunk->size());
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk->size(); ++chunk_offset) {
+    pos_list->emplace_back(chunk_id, chunk_offset);
+  }
+
+  auto segments = Segments{};
+  for (auto column_id = ColumnID{0}; column_id < table->column_count(); ++column_id) {
+    segments.emplace_back(std::make_shared<ReferenceSegment>(table, column_id, pos_list));
+  }
+
+  const auto chunk_table = std::make_shared<Table>(table->column_definitions(), TableType::References);
+  chunk_table->append_chunk(segments);
+
+  const auto transaction_context = TransactionManager::get().new_transaction_context();
+  const auto table_wrapper = std::make_shared<TableWrapper>(chunk_table);
+  const auto validate = std::make_shared<Validate>(table_wrapper);
+  const auto delete_operator = std::make_shared<Delete>(_table_name, validate);
+  const auto insert = std::make_shared<Insert>(_table_name, validate);
+
+  table_wrapper->execute();
+  validate->set_transaction_context(transaction_context);
+  validate->execute();
+
+  delete_operator->set_transaction_context(transaction_context);
+  delete_operator->execute();
+  if (delete_operator->execute_failed()) {
+    // Some rows have been modified concurrently, the next execution tries again
+    transaction_context->rollback();
+    return 0;
+  }
+
+  // The moved rows are appended to the last chunk and the chunks that Insert adds after it
+  const auto first_target_chunk_id = ChunkID{table->chunk_count() - 1};
+
+  insert->set_transaction_context(transaction_context);
+  insert->execute();
+  transaction_context->commit();
+
+  const auto spec = encoding_spec(*chunk);
+  for (auto target_chunk_id = first_target_chunk_id; target_chunk_id < table->chunk_count(); ++target_chunk_id) {
+    const auto target_chunk = table->get_chunk(target_chunk_id);
+    if (!is_completed(*target_chunk, table->max_chunk_size())) continue;
+
+    ChunkEncoder::encode_chunk(target_chunk, table->column_data_types(), spec);
+  }
+
+  return validate->get_output()->row_count();
+}
+
+size_t MvccGarbageCollectionTask::_compact_chunk(const std::shared_ptr<Table>& table,
+                                                 const std::shared_ptr<Chunk>& chunk) {
+  auto reclaimed_bytes = size_t{0};
+
+  for (auto column_id = ColumnID{0}; column_id < table->column_count(); ++column_id) {
+    resolve_data_type(table->column_data_type(column_id), [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+
+      // Running queries might still access the segment, so all offsets have to remain valid
+      const auto compacted_segment = std::make_shared<RunLengthSegment<ColumnDataType>>(
+          std::make_shared<pmr_vector<ColumnDataType>>(1, ColumnDataType{}),
+          std::make_shared<pmr_vector<bool>>(1, false),
+          std::make_shared<pmr_vector<ChunkOffset>>(1, static_cast<ChunkOffset>(chunk->size() - 1)));
+
+      const auto previous_memory_usage = chunk->get_segment(column_id)->estimate_memory_usage();
+      const auto memory_usage = compacted_segment->estimate_memory_usage();
+      if (previous_memory_usage > memory_usage) reclaimed_bytes += previous_memory_usage - memory_usage;
+
+      chunk->replace_segment(column_id, compacted_segment);
+    });
+  }
+
+  return reclaimed_bytes;
+}
+
+}  // namespace opossum
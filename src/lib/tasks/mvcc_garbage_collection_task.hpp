@@ -0,0 +1,63 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "scheduler/abstract_task.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Chunk;
+class Table;
+
+/**
+ * @brief Reclaims the memory of rows that have been invalidated by Delete or Update
+ *
+ * Invalidated rows remain in their chunks, so that RowIDs stay stable while queries are running. A row is dead once no
+ * transaction can see it anymore, i.e., its end_cid is not higher than the lowest active snapshot commit id (see
+ * TransactionManager). The task reclaims dead rows of immutable chunks in two steps:
+ *
+ * 1. If the fraction of dead rows of a chunk reaches min_dead_row_ratio, the remaining rows are moved to the end of the
+ *    table by a transaction that deletes and inserts them again. Thus, moving the rows is logged like any other change,
+ *    and it fails if the rows are concurrently modified (in that case, the next execution tries again). Chunks that
+ *    are filled up with moved rows are encoded like the chunk the rows came from.
+ * 2. Once all rows of a chunk are dead, its segments are replaced by segments that consist of a single run of a
+ *    default value. The MvccData of the chunk remains and keeps all rows invisible. As RowIDs do not change, neither
+ *    running queries that still reference the chunk nor the log are affected.
+ *
+ * Usually, both steps happen in different executions of the task, as the transaction that moves the rows has to be
+ * older than all active snapshots first. The task is meant to be scheduled periodically, similar to the
+ * ChunkCompressionTask. Tables with indexes are skipped, since the indexes reference the segments.
+ */
+class MvccGarbageCollectionTask : public AbstractTask {
+ public:
+  static constexpr auto DEFAULT_MIN_DEAD_ROW_RATIO = 0.5f;
+
+  explicit MvccGarbageCollectionTask(const std::string& table_name,
+                                     const float min_dead_row_ratio = DEFAULT_MIN_DEAD_ROW_RATIO);
+
+  // Statistics, available once the task has been executed
+  size_t moved_row_count() const;
+  size_t compacted_chunk_count() const;
+  size_t reclaimed_bytes() const;
+
+ protected:
+  void _on_execute() override;
+
+ private:
+  // Step 1, returns the number of moved rows
+  size_t _move_live_rows(const std::shared_ptr<Table>& table, const ChunkID chunk_id);
+
+  // Step 2, returns the number of reclaimed bytes
+  size_t _compact_chunk(const std::shared_ptr<Table>& table, const std::shared_ptr<Chunk>& chunk);
+
+  const std::string _table_name;
+  const float _min_dead_row_ratio;
+
+  size_t _moved_row_count{0};
+  size_t _compacted_chunk_count{0};
+  size_t _reclaimed_bytes{0};
+};
+
+}  // namespace opossum
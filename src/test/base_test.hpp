@@ -7,6 +7,7 @@
 
 #include "concurrency/transaction_manager.hpp"
 #include "gtest/gtest.h"
+#include "logging/logger.hpp"
 #include "operators/abstract_operator.hpp"
 #include "scheduler/current_scheduler.hpp"
 #include "storage/dictionary_segment.hpp"
@@ -70,6 +71,7 @@ class BaseTestWithParam : public std::conditional<std::is_same<ParamType, void>:
     NUMAPlacementManager::get().pause();
 #endif
 
+    Logger::reset();
     StorageManager::reset();
     TransactionManager::reset();
   }
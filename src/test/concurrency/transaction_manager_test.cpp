@@ -0,0 +1,78 @@
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "concurrency/transaction_context.hpp"
+#include "concurrency/transaction_manager.hpp"
+
+namespace opossum {
+
+class TransactionManagerTest : public BaseTest {
+ protected:
+  TransactionManager& manager() { return TransactionManager::get(); }
+};
+
+TEST_F(TransactionManagerTest, LowestActiveSnapshotCommitID) {
+  EXPECT_EQ(manager().lowest_active_snapshot_commit_id(), manager().last_commit_id());
+
+  auto first_context = manager().new_transaction_context();
+  manager().new_transaction_context()->commit();
+
+  auto second_context = manager().new_transaction_context();
+  EXPECT_GT(second_context->snapshot_commit_id(), first_context->snapshot_commit_id());
+  EXPECT_EQ(manager().lowest_active_snapshot_commit_id(), first_context->snapshot_commit_id());
+
+  // Committed transactions keep their snapshot until their context is destroyed
+  first_context->commit();
+  EXPECT_EQ(manager().lowest_active_snapshot_commit_id(), first_context->snapshot_commit_id());
+
+  first_context = nullptr;
+  EXPECT_EQ(manager().lowest_active_snapshot_commit_id(), second_context->snapshot_commit_id());
+
+  second_context = nullptr;
+  EXPECT_EQ(manager().lowest_active_snapshot_commit_id(), manager().last_commit_id());
+}
+
+TEST_F(TransactionManagerTest, MoreActiveSnapshotsThanSlots) {
+  auto contexts = std::vector<std::shared_ptr<TransactionContext>>{};
+  for (auto context_idx = 0; context_idx < 1000; ++context_idx) {
+    contexts.emplace_back(manager().new_transaction_context());
+    if (context_idx % 100 == 0) manager().new_transaction_context()->commit();
+  }
+
+  // The first snapshots occupy all slots, the remaining ones are registered in the overflow set
+  const auto first_snapshot_commit_id = contexts.front()->snapshot_commit_id();
+  while (contexts.size() > 1) {
+    contexts.pop_back();
+    EXPECT_EQ(manager().lowest_active_snapshot_commit_id(), first_snapshot_commit_id);
+  }
+
+  contexts.clear();
+  EXPECT_EQ(manager().lowest_active_snapshot_commit_id(), manager().last_commit_id());
+}
+
+TEST_F(TransactionManagerTest, ConcurrentSnapshots) {
+  auto failed = std::atomic_bool{false};
+
+  auto threads = std::vector<std::thread>{};
+  for (auto thread_idx = 0; thread_idx < 8; ++thread_idx) {
+    threads.emplace_back([&]() {
+      for (auto transaction_idx = 0; transaction_idx < 1000; ++transaction_idx) {
+        const auto context = manager().new_transaction_context();
+        if (manager().lowest_active_snapshot_commit_id() > context->snapshot_commit_id()) failed = true;
+        context->commit();
+      }
+    });
+  }
+
+  for (auto& thread : threads) thread.join();
+
+  EXPECT_FALSE(failed);
+  EXPECT_EQ(manager().lowest_active_snapshot_commit_id(), manager().last_commit_id());
+}
+
+}  // namespace opossum
@@ -604,6 +604,30 @@ TEST_F(ExpressionEvaluatorTest, InSelectCorrelated) {
                                        {std::nullopt, std::nullopt, std::nullopt, std::nullopt}));
 }
 
+TEST_F(ExpressionEvaluatorTest, InSelectCorrelatedWithRepeatedParameters) {
+  // PQP that returns the column "a" added to the current value in "c". Rows 1 and 3 share the parameter value NULL
+  // and thus the result of the select.
+  //
+  // row   list returned from select
+  //  0      (34, 35, 36, 37)
+  //  1      (NULL, NULL, NULL, NULL)
+  //  2      (35, 36, 37, 38)
+  //  3      (NULL, NULL, NULL, NULL)
+  const auto table_wrapper = std::make_shared<TableWrapper>(table_a);
+  const auto add_c = add_(parameter_(ParameterID{0}), PQPColumnExpression::from_table(*table_a, "a"));
+  const auto pqp = std::make_shared<Projection>(table_wrapper, expression_vector(add_c));
+  const auto select_c = select_(pqp, DataType::Int, true, std::make_pair(ParameterID{0}, ColumnID{2}));
+
+  EXPECT_TRUE(test_expression<int32_t>(table_a, *in_(35, select_c), {1, std::nullopt, 1, std::nullopt}));
+  EXPECT_TRUE(test_expression<int32_t>(table_a, *in_(38, select_c), {0, std::nullopt, 1, std::nullopt}));
+
+  // Without the cache, only rows evaluated in the same batch share their results
+  ExpressionEvaluator::set_correlated_select_cache_budget(0);
+  EXPECT_TRUE(test_expression<int32_t>(table_a, *in_(35, select_c), {1, std::nullopt, 1, std::nullopt}));
+  EXPECT_TRUE(test_expression<int32_t>(table_a, *in_(38, select_c), {0, std::nullopt, 1, std::nullopt}));
+  ExpressionEvaluator::set_correlated_select_cache_budget(ExpressionEvaluator::DEFAULT_CORRELATED_SELECT_CACHE_BUDGET);
+}
+
 TEST_F(ExpressionEvaluatorTest, Exists) {
   /**
    * Test a co-related EXISTS query
@@ -0,0 +1,55 @@
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "expression/evaluation/expression_result_pool.hpp"
+
+namespace opossum {
+
+class ExpressionResultPoolTest : public ::testing::Test {};
+
+TEST_F(ExpressionResultPoolTest, RecyclesVectors) {
+  auto pool = ExpressionResultPool{};
+
+  EXPECT_EQ(pool.acquire<int32_t>().capacity(), 0u);
+
+  auto values = std::vector<int32_t>(1000, 5);
+  const auto* const data = values.data();
+  pool.release(std::move(values));
+
+  // Vectors are only handed out for their own type
+  EXPECT_EQ(pool.acquire<int64_t>().capacity(), 0u);
+
+  auto recycled_values = pool.acquire<int32_t>();
+  EXPECT_TRUE(recycled_values.empty());
+  EXPECT_GE(recycled_values.capacity(), 1000u);
+  EXPECT_EQ(recycled_values.data(), data);
+
+  EXPECT_EQ(pool.acquire<int32_t>().capacity(), 0u);
+}
+
+TEST_F(ExpressionResultPoolTest, BoundedSize) {
+  auto pool = ExpressionResultPool{};
+
+  for (auto vector_idx = size_t{0}; vector_idx < ExpressionResultPool::MAX_POOLED_VECTOR_COUNT + 2; ++vector_idx) {
+    pool.release(std::vector<bool>(10));
+  }
+
+  for (auto vector_idx = size_t{0}; vector_idx < ExpressionResultPool::MAX_POOLED_VECTOR_COUNT; ++vector_idx) {
+    EXPECT_GT(pool.acquire<bool>().capacity(), 0u);
+  }
+  EXPECT_EQ(pool.acquire<bool>().capacity(), 0u);
+}
+
+TEST_F(ExpressionResultPoolTest, ThreadLocalPool) {
+  const auto pool = ExpressionResultPool::thread_local_pool();
+  EXPECT_EQ(ExpressionResultPool::thread_local_pool(), pool);
+
+  auto other_thread_pool = std::shared_ptr<ExpressionResultPool>{};
+  std::thread([&]() { other_thread_pool = ExpressionResultPool::thread_local_pool(); }).join();
+  EXPECT_NE(other_thread_pool, pool);
+}
+
+}  // namespace opossum
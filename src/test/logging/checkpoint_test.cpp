@@ -0,0 +1,220 @@
+#include <memory>
+#include <string>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "concurrency/transaction_context.hpp"
+#include "concurrency/transaction_manager.hpp"
+#include "logging/checkpoint.hpp"
+#include "logging/logger.hpp"
+#include "operators/delete.hpp"
+#include "operators/get_table.hpp"
+#include "operators/insert.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/validate.hpp"
+#include "storage/base_encoded_segment.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "utils/filesystem.hpp"
+
+namespace opossum {
+
+class CheckpointTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    filesystem::remove(_checkpoint_file_path);
+    filesystem::remove(_log_file_path);
+  }
+
+  void TearDown() override {
+    Logger::reset();
+    filesystem::remove(_checkpoint_file_path);
+    filesystem::remove(_log_file_path);
+  }
+
+  std::shared_ptr<TransactionContext> _insert(const std::string& table_name, const int32_t a, const float b) {
+    auto values =
+        std::make_shared<Table>(StorageManager::get().get_table(table_name)->column_definitions(), TableType::Data);
+    values->append({a, b});
+
+    const auto transaction_context = TransactionManager::get().new_transaction_context();
+    const auto table_wrapper = std::make_shared<TableWrapper>(values);
+    table_wrapper->execute();
+    const auto insert = std::make_shared<Insert>(table_name, table_wrapper);
+    insert->set_transaction_context(transaction_context);
+    insert->execute();
+
+    return transaction_context;
+  }
+
+  void _delete(const std::string& table_name, const int32_t a) {
+    const auto transaction_context = TransactionManager::get().new_transaction_context();
+    const auto get_table = std::make_shared<GetTable>(table_name);
+    const auto validate = std::make_shared<Validate>(get_table);
+    const auto table_scan =
+        std::make_shared<TableScan>(validate, OperatorScanPredicate{ColumnID{0}, PredicateCondition::Equals, a});
+    const auto delete_operator = std::make_shared<Delete>(table_name, table_scan);
+
+    for (const auto& op : {std::static_pointer_cast<AbstractOperator>(get_table),
+                           std::static_pointer_cast<AbstractOperator>(validate),
+                           std::static_pointer_cast<AbstractOperator>(table_scan),
+                           std::static_pointer_cast<AbstractOperator>(delete_operator)}) {
+      op->set_transaction_context(transaction_context);
+      op->execute();
+    }
+
+    transaction_context->commit();
+  }
+
+  std::shared_ptr<const Table> _validated_table(const std::string& table_name) {
+    const auto transaction_context = TransactionManager::get().new_transaction_context();
+    const auto get_table = std::make_shared<GetTable>(table_name);
+    const auto validate = std::make_shared<Validate>(get_table);
+    validate->set_transaction_context(transaction_context);
+    get_table->execute();
+    validate->execute();
+    return validate->get_output();
+  }
+
+  // Loses all tables and transactions, e.g., because of a crash
+  void _crash() {
+    Logger::reset();
+    StorageManager::reset();
+    TransactionManager::reset();
+  }
+
+  const std::string _checkpoint_file_path{test_data_path + "checkpoint_test.checkpoint"};
+  const std::string _log_file_path{test_data_path + "checkpoint_test.log"};
+};
+
+TEST_F(CheckpointTest, RestoresEncodedSegments) {
+  const auto dictionary_table = load_table("src/test/tables/int_float_double_string.tbl", 2);
+  ChunkEncoder::encode_all_chunks(dictionary_table,
+                                  SegmentEncodingSpec{EncodingType::Dictionary, VectorCompressionType::SimdBp128});
+
+  const auto run_length_table = load_table("src/test/tables/int_float_double_string.tbl", 2);
+  ChunkEncoder::encode_all_chunks(run_length_table, SegmentEncodingSpec{EncodingType::RunLength});
+
+  const auto fixed_string_table = load_table("src/test/tables/int_string.tbl", 2);
+  ChunkEncoder::encode_all_chunks(
+      fixed_string_table, ChunkEncodingSpec{{EncodingType::Dictionary, VectorCompressionType::FixedSizeByteAligned},
+                                            {EncodingType::FixedStringDictionary}});
+
+  // The last chunk remains a mutable chunk of ValueSegments
+  const auto frame_of_reference_table = load_table("src/test/tables/int_float_with_null.tbl", 2);
+  ChunkEncoder::encode_chunk(frame_of_reference_table->get_chunk(ChunkID{0}),
+                             frame_of_reference_table->column_data_types(),
+                             ChunkEncodingSpec{{EncodingType::FrameOfReference}, {EncodingType::Dictionary}});
+
+  const auto tables = std::vector<std::pair<std::string, std::shared_ptr<Table>>>{
+      {"dictionary", dictionary_table},
+      {"run_length", run_length_table},
+      {"fixed_string", fixed_string_table},
+      {"frame_of_reference", frame_of_reference_table}};
+  for (const auto& [table_name, table] : tables) {
+    StorageManager::get().add_table(table_name, table);
+  }
+
+  Checkpoint::write(_checkpoint_file_path);
+  _crash();
+  Checkpoint::load(_checkpoint_file_path);
+
+  for (const auto& [table_name, table] : tables) {
+    SCOPED_TRACE(table_name);
+
+    const auto restored_table = StorageManager::get().get_table(table_name);
+    EXPECT_TABLE_EQ_ORDERED(restored_table, table);
+    ASSERT_EQ(restored_table->chunk_count(), table->chunk_count());
+
+    for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+      const auto chunk = table->get_chunk(chunk_id);
+      const auto restored_chunk = restored_table->get_chunk(chunk_id);
+      EXPECT_EQ(restored_chunk->is_mutable(), chunk->is_mutable());
+
+      for (auto column_id = ColumnID{0}; column_id < table->column_count(); ++column_id) {
+        const auto segment = std::dynamic_pointer_cast<const BaseEncodedSegment>(chunk->get_segment(column_id));
+        const auto restored_segment =
+            std::dynamic_pointer_cast<const BaseEncodedSegment>(restored_chunk->get_segment(column_id));
+        ASSERT_EQ(static_cast<bool>(restored_segment), static_cast<bool>(segment));
+        if (!segment) continue;
+
+        EXPECT_EQ(restored_segment->encoding_type(), segment->encoding_type());
+      }
+    }
+  }
+}
+
+TEST_F(CheckpointTest, ContainsCommittedRowsOnly) {
+  const auto table_name = std::string{"checkpoint_test_table"};
+  StorageManager::get().add_table(table_name, load_table("src/test/tables/int_float.tbl", 2));
+
+  _insert(table_name, 1, 1.5f)->commit();
+  _delete(table_name, 123);
+  const auto uncommitted_transaction_context = _insert(table_name, 2, 2.5f);
+
+  const auto expected_table = _validated_table(table_name);
+  const auto row_count = StorageManager::get().get_table(table_name)->row_count();
+
+  Checkpoint::write(_checkpoint_file_path);
+
+  // Not part of the checkpoint
+  uncommitted_transaction_context->commit();
+
+  _crash();
+  Checkpoint::load(_checkpoint_file_path);
+
+  EXPECT_TABLE_EQ_ORDERED(_validated_table(table_name), expected_table);
+
+  // Invisible rows are kept so that all rows keep their RowIDs
+  EXPECT_EQ(StorageManager::get().get_table(table_name)->row_count(), row_count);
+}
+
+TEST_F(CheckpointTest, ReplaysLogOnTopOfCheckpoint) {
+  const auto table_name = std::string{"checkpoint_test_table"};
+  StorageManager::get().add_table(table_name, load_table("src/test/tables/int_float.tbl", 2));
+  Logger::get().enable(_log_file_path);
+
+  _insert(table_name, 1, 1.5f)->commit();
+  _delete(table_name, 123);
+
+  const auto log_size_before_checkpoint = filesystem::file_size(_log_file_path);
+  const auto checkpoint_id = Checkpoint::write(_checkpoint_file_path);
+
+  // The log has been truncated to the checkpoint record
+  EXPECT_LT(filesystem::file_size(_log_file_path), log_size_before_checkpoint);
+
+  _insert(table_name, 2, 2.5f)->commit();
+  _delete(table_name, 1);
+
+  const auto expected_table = _validated_table(table_name);
+
+  _crash();
+
+  // The log only contains the transactions that are not part of the checkpoint
+  StorageManager::get().add_table(table_name, load_table("src/test/tables/int_float.tbl", 2));
+  EXPECT_THROW(Logger::get().enable(_log_file_path), std::logic_error);
+  StorageManager::reset();
+
+  Checkpoint::load(_checkpoint_file_path);
+  Logger::get().enable(_log_file_path, Logger::DEFAULT_FLUSH_INTERVAL, checkpoint_id);
+
+  EXPECT_TABLE_EQ_ORDERED(_validated_table(table_name), expected_table);
+
+  // Checkpoints can be written repeatedly, and a missing checkpoint record is detected
+  _insert(table_name, 3, 3.5f)->commit();
+  const auto second_checkpoint_id = Checkpoint::write(_checkpoint_file_path);
+  const auto expected_table_after_second_checkpoint = _validated_table(table_name);
+
+  _crash();
+  Checkpoint::load(_checkpoint_file_path);
+  EXPECT_THROW(Logger::get().enable(_log_file_path, Logger::DEFAULT_FLUSH_INTERVAL, checkpoint_id),
+               std::logic_error);
+  Logger::get().enable(_log_file_path, Logger::DEFAULT_FLUSH_INTERVAL, second_checkpoint_id);
+
+  EXPECT_TABLE_EQ_ORDERED(_validated_table(table_name), expected_table_after_second_checkpoint);
+}
+
+}  // namespace opossum
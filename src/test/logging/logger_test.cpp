@@ -0,0 +1,215 @@
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "concurrency/transaction_context.hpp"
+#include "concurrency/transaction_manager.hpp"
+#include "logging/logger.hpp"
+#include "operators/delete.hpp"
+#include "operators/get_table.hpp"
+#include "operators/insert.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/validate.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "utils/filesystem.hpp"
+
+namespace opossum {
+
+class LoggerTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    filesystem::remove(_log_file_path);
+    _load_table();
+  }
+
+  void TearDown() override {
+    Logger::reset();
+    filesystem::remove(_log_file_path);
+  }
+
+  void _load_table() { StorageManager::get().add_table(_table_name, load_table("src/test/tables/int_float.tbl", 2)); }
+
+  std::shared_ptr<TransactionContext> _insert(const int32_t a, const float b) {
+    auto values = std::make_shared<Table>(StorageManager::get().get_table(_table_name)->column_definitions(),
+                                          TableType::Data);
+    values->append({a, b});
+
+    const auto transaction_context = TransactionManager::get().new_transaction_context();
+    const auto table_wrapper = std::make_shared<TableWrapper>(values);
+    table_wrapper->execute();
+    const auto insert = std::make_shared<Insert>(_table_name, table_wrapper);
+    insert->set_transaction_context(transaction_context);
+    insert->execute();
+
+    return transaction_context;
+  }
+
+  void _delete(const int32_t a) {
+    const auto transaction_context = TransactionManager::get().new_transaction_context();
+    const auto get_table = std::make_shared<GetTable>(_table_name);
+    const auto validate = std::make_shared<Validate>(get_table);
+    const auto table_scan =
+        std::make_shared<TableScan>(validate, OperatorScanPredicate{ColumnID{0}, PredicateCondition::Equals, a});
+    const auto delete_operator = std::make_shared<Delete>(_table_name, table_scan);
+
+    for (const auto& op : {std::static_pointer_cast<AbstractOperator>(get_table),
+                           std::static_pointer_cast<AbstractOperator>(validate),
+                           std::static_pointer_cast<AbstractOperator>(table_scan),
+                           std::static_pointer_cast<AbstractOperator>(delete_operator)}) {
+      op->set_transaction_context(transaction_context);
+      op->execute();
+    }
+
+    transaction_context->commit();
+  }
+
+  std::shared_ptr<const Table> _validated_table() {
+    const auto transaction_context = TransactionManager::get().new_transaction_context();
+    const auto get_table = std::make_shared<GetTable>(_table_name);
+    const auto validate = std::make_shared<Validate>(get_table);
+    validate->set_transaction_context(transaction_context);
+    get_table->execute();
+    validate->execute();
+    return validate->get_output();
+  }
+
+  // Loses all changes that are not in the log, e.g., because of a crash, and replays the log
+  void _restart() {
+    Logger::reset();
+    StorageManager::reset();
+    TransactionManager::reset();
+
+    _load_table();
+    Logger::get().enable(_log_file_path);
+  }
+
+  const std::string _table_name{"logger_test_table"};
+  const std::string _log_file_path{test_data_path + "logger_test.log"};
+};
+
+TEST_F(LoggerTest, ReplaysCommittedTransactions) {
+  Logger::get().enable(_log_file_path);
+
+  _insert(1, 1.5f)->commit();
+  _insert(2, 2.5f)->commit();
+  _insert(3, 3.5f)->commit();
+  _delete(123);
+  _delete(2);
+
+  const auto expected_table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false},
+                                                                            {"b", DataType::Float, false}},
+                                                     TableType::Data);
+  expected_table->append({12345, 458.7f});
+  expected_table->append({1234, 457.7f});
+  expected_table->append({1, 1.5f});
+  expected_table->append({3, 3.5f});
+
+  const auto table_before_restart = _validated_table();
+  EXPECT_TABLE_EQ_UNORDERED(table_before_restart, expected_table);
+
+  _restart();
+
+  // Rows are restored at their original RowIDs
+  EXPECT_TABLE_EQ_ORDERED(_validated_table(), table_before_restart);
+  EXPECT_EQ(StorageManager::get().get_table(_table_name)->row_count(), 6u);
+
+  // The log can be continued and replayed again
+  _insert(4, 4.5f)->commit();
+  _delete(1);
+  const auto table_before_second_restart = _validated_table();
+
+  _restart();
+
+  EXPECT_TABLE_EQ_ORDERED(_validated_table(), table_before_second_restart);
+}
+
+TEST_F(LoggerTest, DiscardsUncommittedTransactions) {
+  Logger::get().enable(_log_file_path);
+
+  _insert(1, 1.5f)->commit();
+
+  // Simulate a crash after the transaction's records, but before its commit record was written
+  const auto transaction_context = _insert(2, 2.5f);
+  const auto table = StorageManager::get().get_table(_table_name);
+  Logger::get().log_insert(transaction_context->transaction_id(), _table_name, *table,
+                           PosList{RowID{ChunkID{2}, ChunkOffset{0}}});
+  transaction_context->rollback();
+
+  _restart();
+
+  const auto expected_table = load_table("src/test/tables/int_float.tbl", 2);
+  expected_table->append({1, 1.5f});
+  EXPECT_TABLE_EQ_UNORDERED(_validated_table(), expected_table);
+
+  EXPECT_EQ(StorageManager::get().get_table(_table_name)->row_count(), 4u);
+
+  // Transaction ids restart with every run, so the uncommitted transaction's records must not be replayed when a
+  // transaction with the same id commits in a later run
+  for (auto value = 10; value < 13; ++value) {
+    _insert(value, 0.5f)->commit();
+  }
+  _restart();
+
+  expected_table->append({10, 0.5f});
+  expected_table->append({11, 0.5f});
+  expected_table->append({12, 0.5f});
+  EXPECT_TABLE_EQ_UNORDERED(_validated_table(), expected_table);
+}
+
+TEST_F(LoggerTest, CutsOffTornRecords) {
+  Logger::get().enable(_log_file_path);
+  _insert(1, 1.5f)->commit();
+  Logger::get().disable();
+
+  {
+    auto log_file = std::ofstream{_log_file_path, std::ios::binary | std::ios::app};
+    log_file << "torn record";
+  }
+
+  _restart();
+  _insert(2, 2.5f)->commit();
+  _restart();
+
+  const auto expected_table = load_table("src/test/tables/int_float.tbl", 2);
+  expected_table->append({1, 1.5f});
+  expected_table->append({2, 2.5f});
+  EXPECT_TABLE_EQ_UNORDERED(_validated_table(), expected_table);
+}
+
+TEST_F(LoggerTest, GroupCommit) {
+  // Only flush explicitly
+  Logger::get().enable(_log_file_path, std::chrono::hours{1});
+
+  auto committed_transaction_count = std::atomic<size_t>{0};
+  const auto callback = [&](TransactionID) { ++committed_transaction_count; };
+
+  const auto first_transaction_context = _insert(1, 1.5f);
+  const auto second_transaction_context = _insert(2, 2.5f);
+  first_transaction_context->commit_async(callback);
+  second_transaction_context->commit_async(callback);
+
+  // The transactions are visible, but are only reported as committed once they are durable
+  EXPECT_EQ(_validated_table()->row_count(), 5u);
+  EXPECT_EQ(committed_transaction_count, 0u);
+
+  // Read-only transactions do not have to wait for the log
+  TransactionManager::get().new_transaction_context()->commit_async(callback);
+  EXPECT_EQ(committed_transaction_count, 1u);
+
+  const auto flush_count = Logger::get().flush_count();
+  Logger::get().flush();
+
+  EXPECT_EQ(committed_transaction_count, 3u);
+  EXPECT_EQ(Logger::get().flush_count(), flush_count + 1);
+  EXPECT_EQ(Logger::get().flushed_commit_count(), 2u);
+  EXPECT_EQ(second_transaction_context->phase(), TransactionPhase::Committed);
+}
+
+}  // namespace opossum
@@ -12,11 +12,15 @@
 
 #include "operators/abstract_read_only_operator.hpp"
 #include "operators/aggregate.hpp"
+#include "operators/aggregate/group_id_map.hpp"
 #include "operators/join_hash.hpp"
 #include "operators/join_nested_loop.hpp"
 #include "operators/print.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
 #include "storage/chunk_encoder.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
@@ -588,4 +592,65 @@ TEST_F(OperatorsAggregateTest, OuterJoinThenAggregate) {
                     "src/test/tables/aggregateoperator/groupby_int_1gb_1agg/outer_join.tbl", 1, false);
 }
 
+TEST_F(OperatorsAggregateTest, MergesPartialAggregatesOfChunkRanges) {
+  // The input is large enough to be pre-aggregated by several jobs, whose partial aggregates need to be merged. Each
+  // group and each distinct value of c is found in all chunk ranges.
+  const auto column_definitions =
+      TableColumnDefinitions{{"a", DataType::Int}, {"b", DataType::Int}, {"c", DataType::Int}};
+  auto table = std::make_shared<Table>(column_definitions, TableType::Data, 10'000);
+  for (auto row = 0; row < 200'000; ++row) {
+    table->append({row % 1'000, row, row % 7});
+  }
+  const auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto expected_result = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int},
+                                                                        {"MIN(b)", DataType::Int, true},
+                                                                        {"MAX(b)", DataType::Int, true},
+                                                                        {"SUM(b)", DataType::Long, true},
+                                                                        {"COUNT(*)", DataType::Long},
+                                                                        {"COUNT(DISTINCT c)", DataType::Long}},
+                                                 TableType::Data);
+  for (auto a = 0; a < 1'000; ++a) {
+    expected_result->append({a, a, a + 199'000, int64_t{200} * a + 19'900'000, int64_t{200}, int64_t{7}});
+  }
+
+  Topology::use_fake_numa_topology(8, 4);
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  const auto aggregates = std::vector<AggregateColumnDefinition>{{ColumnID{1}, AggregateFunction::Min},
+                                                                 {ColumnID{1}, AggregateFunction::Max},
+                                                                 {ColumnID{1}, AggregateFunction::Sum},
+                                                                 {std::nullopt, AggregateFunction::Count},
+                                                                 {ColumnID{2}, AggregateFunction::CountDistinct}};
+
+  const auto aggregate = std::make_shared<Aggregate>(table_wrapper, aggregates, std::vector<ColumnID>{ColumnID{0}});
+  aggregate->execute();
+  EXPECT_TABLE_EQ_UNORDERED(aggregate->get_output(), expected_result);
+
+  // Group on the ValueIDs of the dictionaries and compute MIN and MAX on ValueIDs
+  ChunkEncoder::encode_all_chunks(table);
+
+  const auto dictionary_aggregate =
+      std::make_shared<Aggregate>(table_wrapper, aggregates, std::vector<ColumnID>{ColumnID{0}});
+  dictionary_aggregate->execute();
+  EXPECT_TABLE_EQ_UNORDERED(dictionary_aggregate->get_output(), expected_result);
+}
+
+TEST_F(OperatorsAggregateTest, GroupIdMapAssignsDenseIds) {
+  auto group_id_map = GroupIdMap<std::pair<int32_t, int32_t>, boost::hash<std::pair<int32_t, int32_t>>>{};
+
+  // Insert enough keys so that the map needs to grow several times
+  for (auto repetition = 0; repetition < 2; ++repetition) {
+    for (auto value = int32_t{0}; value < 1'000; ++value) {
+      const auto [group_id, inserted] = group_id_map.insert({value % 10, value});
+      EXPECT_EQ(group_id, static_cast<size_t>(value));
+      EXPECT_EQ(inserted, repetition == 0);
+    }
+  }
+
+  ASSERT_EQ(group_id_map.size(), 1'000u);
+  EXPECT_EQ(group_id_map.keys()[123], std::make_pair(3, 123));
+}
+
 }  // namespace opossum
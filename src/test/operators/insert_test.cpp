@@ -133,6 +133,68 @@ TEST_F(OperatorsInsertTest, CompressedChunks) {
   EXPECT_EQ(t->row_count(), 13u);
 }
 
+TEST_F(OperatorsInsertTest, InsertFromEncodedAndReferenceSegments) {
+  auto t_name = "test1";
+  auto t_name2 = "test2";
+
+  auto t2 = load_table("src/test/tables/int_float_with_null.tbl", 3u);
+  opossum::ChunkEncoder::encode_all_chunks(t2);
+  StorageManager::get().add_table(t_name2, t2);
+
+  auto t = std::make_shared<Table>(t2->column_definitions(), TableType::Data, 2u, UseMvcc::Yes);
+  t->append_mutable_chunk();
+  StorageManager::get().add_table(t_name, t);
+
+  // Validate outputs ReferenceSegments that point to the DictionarySegments of t2
+  auto gt2 = std::make_shared<GetTable>(t_name2);
+  gt2->execute();
+
+  auto context = TransactionManager::get().new_transaction_context();
+  auto validate = std::make_shared<Validate>(gt2);
+  validate->set_transaction_context(context);
+  validate->execute();
+
+  auto ins = std::make_shared<Insert>(t_name, validate);
+  ins->set_transaction_context(context);
+  ins->execute();
+  context->commit();
+
+  EXPECT_TABLE_EQ_ORDERED(t, t2);
+}
+
+TEST_F(OperatorsInsertTest, InsertManyRowsInParallel) {
+  auto t_name = "test1";
+  auto t_name2 = "test2";
+
+  TableColumnDefinitions column_definitions;
+  column_definitions.emplace_back("a", DataType::Int, true);
+  column_definitions.emplace_back("b", DataType::String);
+
+  auto t = std::make_shared<Table>(column_definitions, TableType::Data, 1'000u, UseMvcc::Yes);
+  t->append_mutable_chunk();
+  StorageManager::get().add_table(t_name, t);
+
+  // More rows than Insert copies without jobs, spread over source chunks that do not align with the target chunks
+  auto t2 = std::make_shared<Table>(column_definitions, TableType::Data, 777u, UseMvcc::Yes);
+  for (auto value = 0; value < 12'345; ++value) {
+    t2->append({value % 5 == 0 ? NULL_VALUE : AllTypeVariant{value}, std::to_string(value)});
+  }
+  opossum::ChunkEncoder::encode_all_chunks(t2);
+  StorageManager::get().add_table(t_name2, t2);
+
+  auto gt2 = std::make_shared<GetTable>(t_name2);
+  gt2->execute();
+
+  auto ins = std::make_shared<Insert>(t_name, gt2);
+  auto context = TransactionManager::get().new_transaction_context();
+  ins->set_transaction_context(context);
+  ins->execute();
+  context->commit();
+
+  EXPECT_EQ(t->chunk_count(), 13u);
+  EXPECT_TABLE_EQ_ORDERED(t, t2);
+}
+
 TEST_F(OperatorsInsertTest, Rollback) {
   auto t_name = "test3";
 
@@ -70,7 +70,8 @@ TYPED_TEST(JoinEquiTest, InnerJoinIntFloatRadixBit) {
     // radix bits = 1
     std::shared_ptr<Table> expected_result = load_table("src/test/tables/joinoperators/float_int_inner.tbl", 1);
     auto join = std::make_shared<JoinHash>(this->_table_wrapper_o, this->_table_wrapper_a, JoinMode::Inner,
-                                           ColumnIDPair(ColumnID{0}, ColumnID{0}), PredicateCondition::Equals, 1);
+                                           ColumnIDPair(ColumnID{0}, ColumnID{0}), PredicateCondition::Equals,
+                                           std::vector<OperatorJoinPredicate>{}, 1);
     join->execute();
 
     EXPECT_TABLE_EQ_UNORDERED(join->get_output(), expected_result);
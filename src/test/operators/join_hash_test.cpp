@@ -1,12 +1,18 @@
+#include <string>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "base_test.hpp"
 #include "gtest/gtest.h"
 
 #include "operators/join_hash.hpp"
+#include "operators/join_hash/blocked_bloom_filter.hpp"
 #include "operators/join_hash/hash_traits.hpp"
+#include "operators/join_hash/join_hash_table.hpp"
 #include "operators/table_wrapper.hpp"
 #include "types.hpp"
+#include "utils/murmur_hash.hpp"
 
 namespace opossum {
 
@@ -19,9 +25,14 @@ class JoinHashTest : public BaseTest {
   void SetUp() override {
     _table_wrapper_small = std::make_shared<TableWrapper>(load_table("src/test/tables/joinoperators/anti_int4.tbl", 2));
     _table_wrapper_small->execute();
+
+    _table_wrapper_a = std::make_shared<TableWrapper>(load_table("src/test/tables/int_float.tbl", 2));
+    _table_wrapper_a->execute();
+    _table_wrapper_b = std::make_shared<TableWrapper>(load_table("src/test/tables/int_float2.tbl", 2));
+    _table_wrapper_b->execute();
   }
 
-  std::shared_ptr<TableWrapper> _table_wrapper_small;
+  std::shared_ptr<TableWrapper> _table_wrapper_small, _table_wrapper_a, _table_wrapper_b;
 };
 
 #define EXPECT_HASH_TYPE(left, right, hash) EXPECT_TRUE((std::is_same_v<hash, JoinHashTraits<left, right>::HashType>))
@@ -124,4 +135,136 @@ TEST_F(JoinHashTest, OperatorName) {
   EXPECT_EQ(join->name(), "JoinHash");
 }
 
+TEST_F(JoinHashTest, MultiPassRadixPartitioning) {
+  // 0 bits do not partition at all, 8 bits need one pass, and 12 bits are partitioned in two passes
+  for (const auto radix_bits : {size_t{0}, size_t{8}, size_t{12}}) {
+    for (const auto mode : {JoinMode::Inner, JoinMode::Left}) {
+      const auto expected_file = mode == JoinMode::Inner ? "src/test/tables/joinoperators/int_inner_join.tbl"
+                                                         : "src/test/tables/joinoperators/int_left_join.tbl";
+
+      auto join = std::make_shared<JoinHash>(_table_wrapper_a, _table_wrapper_b, mode,
+                                             ColumnIDPair(ColumnID{0}, ColumnID{0}), PredicateCondition::Equals,
+                                             std::vector<OperatorJoinPredicate>{}, radix_bits);
+      join->execute();
+
+      EXPECT_TABLE_EQ_UNORDERED(join->get_output(), load_table(expected_file, 1));
+    }
+  }
+}
+
+TEST_F(JoinHashTest, MultiColumnJoin) {
+  // Join on a and b. Rows that only share the value of a must not be joined, NULL values in b never match.
+  auto table_wrapper_left =
+      std::make_shared<TableWrapper>(load_table("src/test/tables/joinoperators/composite_key_left.tbl", 2));
+  table_wrapper_left->execute();
+  auto table_wrapper_right =
+      std::make_shared<TableWrapper>(load_table("src/test/tables/joinoperators/composite_key_right.tbl", 3));
+  table_wrapper_right->execute();
+
+  const auto secondary_predicates =
+      std::vector<OperatorJoinPredicate>{{ColumnIDPair(ColumnID{1}, ColumnID{1}), PredicateCondition::Equals}};
+
+  const auto expected_files = std::vector<std::pair<JoinMode, std::string>>{
+      {JoinMode::Inner, "src/test/tables/joinoperators/composite_key_inner_join.tbl"},
+      {JoinMode::Left, "src/test/tables/joinoperators/composite_key_left_join.tbl"},
+      {JoinMode::Semi, "src/test/tables/joinoperators/composite_key_semi_join.tbl"},
+      {JoinMode::Anti, "src/test/tables/joinoperators/composite_key_anti_join.tbl"}};
+
+  for (const auto& [mode, expected_file] : expected_files) {
+    // Also partition the inputs, so that rows with the same value in a end up in different partitions
+    for (const auto radix_bits : {size_t{0}, size_t{4}}) {
+      auto join = std::make_shared<JoinHash>(table_wrapper_left, table_wrapper_right, mode,
+                                             ColumnIDPair(ColumnID{0}, ColumnID{0}), PredicateCondition::Equals,
+                                             secondary_predicates, radix_bits);
+      join->execute();
+
+      EXPECT_TABLE_EQ_UNORDERED(join->get_output(), load_table(expected_file, 1));
+    }
+  }
+}
+
+TEST_F(JoinHashTest, BloomFilterDropsProbeRowsWithoutPartner) {
+  // The row with the value 12 in _table_wrapper_b has no join partner in _table_wrapper_a
+  auto inner_join = std::make_shared<JoinHash>(_table_wrapper_a, _table_wrapper_b, JoinMode::Inner,
+                                               ColumnIDPair(ColumnID{0}, ColumnID{0}), PredicateCondition::Equals);
+  inner_join->execute();
+
+  EXPECT_TABLE_EQ_UNORDERED(inner_join->get_output(),
+                            load_table("src/test/tables/joinoperators/int_inner_join.tbl", 1));
+  const auto& inner_performance_data = static_cast<const JoinHash::PerformanceData&>(inner_join->performance_data());
+  EXPECT_EQ(inner_performance_data.probe_row_count, 4u);
+  EXPECT_EQ(inner_performance_data.probe_rows_filtered, 1u);
+
+  // Outer joins need all probe rows, so nothing may be filtered
+  auto left_join = std::make_shared<JoinHash>(_table_wrapper_b, _table_wrapper_a, JoinMode::Left,
+                                              ColumnIDPair(ColumnID{0}, ColumnID{0}), PredicateCondition::Equals);
+  left_join->execute();
+
+  const auto& left_performance_data = static_cast<const JoinHash::PerformanceData&>(left_join->performance_data());
+  EXPECT_EQ(left_performance_data.probe_rows_filtered, 0u);
+}
+
+TEST_F(JoinHashTest, BloomFilterHasNoFalseNegatives) {
+  auto bloom_filter = BlockedBloomFilter(1000);
+  for (auto hash = uint32_t{0}; hash < 1000; ++hash) {
+    bloom_filter.insert(murmur2<int32_t>(hash, 17));
+  }
+
+  for (auto hash = uint32_t{0}; hash < 1000; ++hash) {
+    EXPECT_TRUE(bloom_filter.may_contain(murmur2<int32_t>(hash, 17)));
+  }
+
+  auto false_positive_count = size_t{0};
+  for (auto hash = uint32_t{1000}; hash < 11000; ++hash) {
+    if (bloom_filter.may_contain(murmur2<int32_t>(hash, 17))) ++false_positive_count;
+  }
+  EXPECT_LT(false_positive_count, 500u);
+}
+
+TEST_F(JoinHashTest, HashTableGroupsDuplicateKeys) {
+  // Hash values are passed in by the caller. Use colliding hashes for different keys to test the key comparison.
+  auto hash_table = JoinHashTable<int32_t>(2);
+  hash_table.insert(5, 1, RowID{ChunkID{0}, ChunkOffset{0}});
+  hash_table.insert(7, 1, RowID{ChunkID{0}, ChunkOffset{1}});
+  hash_table.insert(5, 1, RowID{ChunkID{1}, ChunkOffset{0}});
+  hash_table.insert(9, 2, RowID{ChunkID{1}, ChunkOffset{1}});
+  hash_table.insert(5, 1, RowID{ChunkID{2}, ChunkOffset{3}});
+  hash_table.finalize();
+
+  EXPECT_EQ(hash_table.row_count(), 5u);
+  EXPECT_EQ(hash_table.distinct_key_count(), 3u);
+
+  const auto [five_begin, five_end] = hash_table.find(5, 1);
+  EXPECT_EQ(std::vector<RowID>(five_begin, five_end),
+            (std::vector<RowID>{RowID{ChunkID{0}, ChunkOffset{0}}, RowID{ChunkID{1}, ChunkOffset{0}},
+                                RowID{ChunkID{2}, ChunkOffset{3}}}));
+
+  const auto [seven_begin, seven_end] = hash_table.find(7, 1);
+  EXPECT_EQ(std::vector<RowID>(seven_begin, seven_end), (std::vector<RowID>{RowID{ChunkID{0}, ChunkOffset{1}}}));
+
+  const auto [missing_begin, missing_end] = hash_table.find(8, 1);
+  EXPECT_EQ(missing_begin, missing_end);
+
+  EXPECT_TRUE(hash_table.contains(9, 2));
+  EXPECT_FALSE(hash_table.contains(9, 1));
+  EXPECT_FALSE(hash_table.contains(6, 3));
+}
+
+TEST_F(JoinHashTest, HashTableGrowsBeyondExpectedSize) {
+  auto hash_table = JoinHashTable<std::string>(1);
+  for (auto index = ChunkOffset{0}; index < 1000; ++index) {
+    hash_table.insert(std::to_string(index % 100), index % 100, RowID{ChunkID{0}, index});
+  }
+  hash_table.finalize();
+
+  EXPECT_EQ(hash_table.row_count(), 1000u);
+  EXPECT_EQ(hash_table.distinct_key_count(), 100u);
+
+  const auto [begin, end] = hash_table.find("42", 42);
+  ASSERT_EQ(std::distance(begin, end), 10);
+  for (auto row_id = begin; row_id != end; ++row_id) {
+    EXPECT_EQ(row_id->chunk_offset % 100, 42u);
+  }
+}
+
 }  // namespace opossum
@@ -98,8 +98,8 @@ class JoinIndexTest : public BaseTest {
 
     EXPECT_TABLE_EQ_UNORDERED(join->get_output(), expected_result);
     const auto& performance_data = static_cast<const JoinIndex::PerformanceData&>(join->performance_data());
-    if (using_index && right->get_output()->type() == TableType::Data) {
-      // We can't execute the index join on referencing tables
+    if (using_index) {
+      // For referencing tables, the indexes of the referenced chunks are used
       EXPECT_EQ(performance_data.chunks_scanned_with_index, static_cast<size_t>(right->get_output()->chunk_count()));
       EXPECT_EQ(performance_data.chunks_scanned_without_index, 0);
     } else {
@@ -143,6 +143,17 @@ TYPED_TEST(JoinIndexTest, RightJoin) {
                          JoinMode::Right, "src/test/tables/joinoperators/int_right_join.tbl", 1);
 }
 
+TYPED_TEST(JoinIndexTest, RightRefJoin) {
+  // scan that returns all rows, its ReferenceSegments are resolved to the indexed chunks of table b
+  auto scan_b = std::make_shared<TableScan>(
+      this->_table_wrapper_b, OperatorScanPredicate{ColumnID{0}, PredicateCondition::GreaterThanEquals, 0});
+  scan_b->execute();
+
+  this->test_join_output(this->_table_wrapper_a, scan_b, std::pair<ColumnID, ColumnID>(ColumnID{0}, ColumnID{0}),
+                         PredicateCondition::Equals, JoinMode::Right,
+                         "src/test/tables/joinoperators/int_right_join.tbl", 1);
+}
+
 TYPED_TEST(JoinIndexTest, RightJoinFallBack) {
   this->test_join_output(this->_table_wrapper_a_no_index, this->_table_wrapper_b_no_index,
                          std::pair<ColumnID, ColumnID>(ColumnID{0}, ColumnID{0}), PredicateCondition::Equals,
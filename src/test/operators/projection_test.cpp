@@ -13,6 +13,9 @@
 #include "operators/projection.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
 #include "storage/chunk_encoder.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
@@ -53,6 +56,40 @@ TEST_F(OperatorsProjectionTest, ExecutedOnAllChunks) {
   EXPECT_TABLE_EQ_UNORDERED(projection->get_output(), load_table("src/test/tables/projection/int_float_add.tbl"));
 }
 
+TEST_F(OperatorsProjectionTest, ParallelExecutionPreservesChunkOrder) {
+  // Chunks are projected by parallel jobs, but the output chunks still have to be in the order of the input chunks
+  auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, true}}, TableType::Data, 3);
+  for (auto value = 0; value < 50; ++value) {
+    table->append({value % 7 == 0 ? AllTypeVariant{NULL_VALUE} : AllTypeVariant{value}});
+  }
+  const auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  const auto a = PQPColumnExpression::from_table(*table, "a");
+
+  Topology::use_fake_numa_topology(8, 4);
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  const auto projection =
+      std::make_shared<opossum::Projection>(table_wrapper, expression_vector(mul_(add_(a, 1), 2), a));
+  projection->execute();
+
+  const auto output_table = projection->get_output();
+  ASSERT_EQ(output_table->chunk_count(), table->chunk_count());
+
+  for (auto value = 0; value < 50; ++value) {
+    const auto chunk = output_table->get_chunk(ChunkID{static_cast<ChunkID::base_type>(value / 3)});
+    const auto chunk_offset = static_cast<ChunkOffset>(value % 3);
+
+    if (value % 7 == 0) {
+      EXPECT_TRUE(variant_is_null((*chunk->get_segment(ColumnID{0}))[chunk_offset]));
+    } else {
+      EXPECT_EQ((*chunk->get_segment(ColumnID{0}))[chunk_offset], AllTypeVariant{(value + 1) * 2});
+      EXPECT_EQ((*chunk->get_segment(ColumnID{1}))[chunk_offset], AllTypeVariant{value});
+    }
+  }
+}
+
 TEST_F(OperatorsProjectionTest, ForwardsIfPossibleDataTable) {
   // The Projection will forward segments from its input if all expressions are segment references.
   // Why would you enforce something like this? E.g., Update relies on it.
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "base_test.hpp"
 #include "gtest/gtest.h"
@@ -11,6 +12,7 @@
 #include "operators/table_wrapper.hpp"
 #include "operators/union_all.hpp"
 #include "storage/chunk_encoder.hpp"
+#include "storage/reference_segment.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
 #include "types.hpp"
@@ -143,6 +145,81 @@ TEST_P(OperatorsSortTest, MultipleColumnSortIsStableMixedOrder) {
   EXPECT_TABLE_EQ_ORDERED(sort_after_a->get_output(), expected_result);
 }
 
+TEST_P(OperatorsSortTest, MultipleColumnSortInOneOperator) {
+  auto table_wrapper = std::make_shared<TableWrapper>(load_table("src/test/tables/int_float4.tbl", 2));
+  table_wrapper->execute();
+
+  auto sort = std::make_shared<Sort>(
+      table_wrapper, std::vector<SortColumnDefinition>{SortColumnDefinition{ColumnID{0}, OrderByMode::Ascending},
+                                                       SortColumnDefinition{ColumnID{1}, OrderByMode::Ascending}},
+      2u);
+  sort->execute();
+  EXPECT_TABLE_EQ_ORDERED(sort->get_output(), load_table("src/test/tables/int_float2_sorted.tbl", 2));
+
+  auto sort_mixed = std::make_shared<Sort>(
+      table_wrapper, std::vector<SortColumnDefinition>{SortColumnDefinition{ColumnID{0}, OrderByMode::Ascending},
+                                                       SortColumnDefinition{ColumnID{1}, OrderByMode::Descending}},
+      2u);
+  sort_mixed->execute();
+  EXPECT_TABLE_EQ_ORDERED(sort_mixed->get_output(), load_table("src/test/tables/int_float2_sorted_mixed.tbl", 2));
+}
+
+TEST_P(OperatorsSortTest, MultipleColumnSortWithLongStrings) {
+  // The strings share a prefix that is longer than the part of the strings that is stored in the normalized keys.
+  // Thus, the full strings have to be compared before the second sort column is considered.
+  const auto column_definitions =
+      TableColumnDefinitions{{"a", DataType::String, false}, {"b", DataType::Int, false}};
+
+  auto table = std::make_shared<Table>(column_definitions, TableType::Data, 2);
+  table->append({"a long common prefix b", 1});
+  table->append({"a long common prefix a", 2});
+  table->append({"short", 0});
+  table->append({"a long common prefix a", 1});
+
+  auto expected_result = std::make_shared<Table>(column_definitions, TableType::Data, 2);
+  expected_result->append({"a long common prefix a", 1});
+  expected_result->append({"a long common prefix a", 2});
+  expected_result->append({"a long common prefix b", 1});
+  expected_result->append({"short", 0});
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto sort = std::make_shared<Sort>(
+      table_wrapper, std::vector<SortColumnDefinition>{SortColumnDefinition{ColumnID{0}, OrderByMode::Ascending},
+                                                       SortColumnDefinition{ColumnID{1}, OrderByMode::Ascending}},
+      2u);
+  sort->execute();
+
+  EXPECT_TABLE_EQ_ORDERED(sort->get_output(), expected_result);
+}
+
+TEST_P(OperatorsSortTest, ReferenceOutput) {
+  std::shared_ptr<Table> expected_result = load_table("src/test/tables/int_float_filtered_sorted.tbl", 2);
+
+  auto input = std::make_shared<TableWrapper>(load_table("src/test/tables/int_float.tbl", 1));
+  input->execute();
+
+  auto scan =
+      std::make_shared<TableScan>(input, OperatorScanPredicate{ColumnID{0}, PredicateCondition::NotEquals, 123});
+  scan->execute();
+
+  auto sort = std::make_shared<Sort>(scan, std::vector<SortColumnDefinition>{SortColumnDefinition{ColumnID{0}}}, 2u,
+                                     Sort::OutputMode::References);
+  sort->execute();
+
+  // The output references the table that is referenced by the input instead of copying the values
+  const auto output = sort->get_output();
+  EXPECT_EQ(output->type(), TableType::References);
+  EXPECT_EQ(output->chunk_count(), 1u);
+  const auto reference_segment =
+      std::dynamic_pointer_cast<const ReferenceSegment>(output->get_chunk(ChunkID{0})->get_segment(ColumnID{0}));
+  ASSERT_TRUE(reference_segment);
+  EXPECT_EQ(reference_segment->referenced_table(), input->get_output());
+
+  EXPECT_TABLE_EQ_ORDERED(output, expected_result);
+}
+
 TEST_P(OperatorsSortTest, AscendingSortOfOneColumnWithNull) {
   std::shared_ptr<Table> expected_result = load_table("src/test/tables/int_float_null_sorted_asc.tbl", 2);
 
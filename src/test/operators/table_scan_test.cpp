@@ -13,10 +13,13 @@
 #include "operators/abstract_read_only_operator.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "storage/base_dictionary_segment.hpp"
 #include "storage/chunk_encoder.hpp"
 #include "storage/encoding_type.hpp"
 #include "storage/reference_segment.hpp"
 #include "storage/table.hpp"
+#include "storage/vector_compression/simd_bp128/simd_bp128_vector.hpp"
+#include "type_comparison.hpp"
 #include "types.hpp"
 
 namespace opossum {
@@ -510,6 +513,88 @@ TEST_P(OperatorsTableScanTest, ScanOnWideDictionarySegment) {
   EXPECT_EQ(scan_2->get_output()->row_count(), static_cast<size_t>(37));
 }
 
+TEST_P(OperatorsTableScanTest, ScanAllPredicatesOnLargeSegmentsWithNullValues) {
+  // Segments are scanned in blocks of 64 values. Compare all predicates against a reference on segments with a
+  // partial last block, NULLs and - for dictionary segments - ValueIDs of 8, 16 and 32 bits. Dictionary segments are
+  // also tested with SIMD-BP128 compressed attribute vectors, where sorted values lead to blocks of different widths.
+  // A block containing a NULL is as wide as the null_value_id, i.e., the dictionary size. Thus, NULLs are either
+  // spread over all blocks or confined to the last rows, so that the blocks of sorted values before them are narrow
+  // enough to be skipped or matched as a whole.
+  const auto row_count = 80'001;
+
+  auto segment_encoding_specs = std::vector<SegmentEncodingSpec>{{_encoding_type}};
+  if (_encoding_type == EncodingType::Dictionary) {
+    segment_encoding_specs.emplace_back(EncodingType::Dictionary, VectorCompressionType::SimdBp128);
+  }
+
+  for (const auto& segment_encoding_spec : segment_encoding_specs) {
+    for (const auto sorted : {false, true}) {
+      for (const auto nulls_in_all_blocks : {true, false}) {
+        for (const auto distinct_value_count : {100, 1'000, 100'000}) {
+          TableColumnDefinitions column_definitions;
+          column_definitions.emplace_back("a", DataType::Int, true);
+          auto table = std::make_shared<Table>(column_definitions, TableType::Data);
+
+          const auto value_of_row = [&](const int row_idx) {
+            if (sorted) return static_cast<int>(int64_t{row_idx} * distinct_value_count / row_count);
+            return (row_idx * 7919) % distinct_value_count;
+          };
+          const auto row_is_null = [&](const int row_idx) {
+            return row_idx % 13 == 0 && (nulls_in_all_blocks || row_idx >= row_count - 1'000);
+          };
+
+          for (auto row_idx = 0; row_idx < row_count; ++row_idx) {
+            if (row_is_null(row_idx)) {
+              table->append({NULL_VALUE});
+            } else {
+              table->append({value_of_row(row_idx)});
+            }
+          }
+          ChunkEncoder::encode_chunks(table, {ChunkID{0}}, {segment_encoding_spec});
+
+          if (segment_encoding_spec.vector_compression_type == VectorCompressionType::SimdBp128 && sorted &&
+              !nulls_in_all_blocks) {
+            // Check that there are blocks whose ValueIDs are all smaller than the search ValueID of the middle value
+            const auto& segment = static_cast<const BaseDictionarySegment&>(
+                *table->get_chunk(ChunkID{0})->get_segment(ColumnID{0}));
+            const auto& attribute_vector = static_cast<const SimdBp128Vector&>(*segment.attribute_vector());
+            const auto search_value_id = uint64_t{segment.lower_bound(distinct_value_count / 2)};
+
+            auto narrow_block_count = size_t{0};
+            attribute_vector.for_each_block([&](const size_t, const uint8_t bit_size, const uint128_t*) {
+              if ((uint64_t{1} << bit_size) - 1 < search_value_id) ++narrow_block_count;
+            });
+            EXPECT_GT(narrow_block_count, 0u);
+          }
+
+          auto table_wrapper = std::make_shared<TableWrapper>(std::move(table));
+          table_wrapper->execute();
+
+          for (const auto search_value : {0, distinct_value_count / 2, distinct_value_count - 1}) {
+            for (const auto predicate_condition :
+                 {PredicateCondition::Equals, PredicateCondition::NotEquals, PredicateCondition::LessThan,
+                  PredicateCondition::LessThanEquals, PredicateCondition::GreaterThan,
+                  PredicateCondition::GreaterThanEquals}) {
+              auto expected_row_count = size_t{0};
+              with_comparator(predicate_condition, [&](auto comparator) {
+                for (auto row_idx = 0; row_idx < row_count; ++row_idx) {
+                  if (!row_is_null(row_idx) && comparator(value_of_row(row_idx), search_value)) ++expected_row_count;
+                }
+              });
+
+              auto scan = std::make_shared<TableScan>(
+                  table_wrapper, OperatorScanPredicate{ColumnID{0}, predicate_condition, search_value});
+              scan->execute();
+
+              EXPECT_EQ(scan->get_output()->row_count(), expected_row_count);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
 TEST_P(OperatorsTableScanTest, OperatorName) {
   auto scan_1 = std::make_shared<TableScan>(
       get_table_op(), OperatorScanPredicate{ColumnID{0}, PredicateCondition::GreaterThanEquals, 1234});
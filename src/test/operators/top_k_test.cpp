@@ -0,0 +1,121 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "expression/expression_functional.hpp"
+#include "operators/limit.hpp"
+#include "operators/sort.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/top_k.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class OperatorsTopKTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // Many duplicates in the sort columns, so that the order of rows with equal sort values matters. Column d is
+    // unique and identifies the rows.
+    const auto column_definitions =
+        TableColumnDefinitions{{"a", DataType::Int, true}, {"b", DataType::String, false},
+                               {"c", DataType::Float, false}, {"d", DataType::Int, false}};
+
+    auto table = std::make_shared<Table>(column_definitions, TableType::Data, 3);
+    for (auto row_id = 0; row_id < 20; ++row_id) {
+      const auto a = row_id % 7 == 3 ? NULL_VALUE : AllTypeVariant{(row_id * 5) % 4};
+      const auto b = std::string{row_id % 3 == 0 ? "a long common prefix x" : "a long common prefix y"};
+      table->append({a, b, static_cast<float>((row_id * 3) % 5) - 2.0f, row_id});
+    }
+
+    _table_wrapper = std::make_shared<TableWrapper>(table);
+    _table_wrapper->execute();
+  }
+
+  // Compares the result of TopK with that of a Sort followed by a Limit
+  void test_top_k(const std::shared_ptr<AbstractOperator>& input,
+                  const std::vector<SortColumnDefinition>& sort_definitions, const int64_t row_count) {
+    auto top_k = std::make_shared<TopK>(input, sort_definitions, to_expression(row_count));
+    top_k->execute();
+
+    auto sort = std::make_shared<Sort>(input, sort_definitions);
+    sort->execute();
+    auto limit = std::make_shared<Limit>(sort, to_expression(row_count));
+    limit->execute();
+
+    EXPECT_EQ(top_k->get_output()->type(), TableType::References);
+    EXPECT_LE(top_k->get_output()->chunk_count(), 1u);
+    EXPECT_TABLE_EQ_ORDERED(top_k->get_output(), limit->get_output());
+  }
+
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsTopKTest, SingleColumn) {
+  for (const auto order_by_mode : {OrderByMode::Ascending, OrderByMode::Descending, OrderByMode::AscendingNullsLast,
+                                   OrderByMode::DescendingNullsLast}) {
+    for (const auto row_count : {int64_t{1}, int64_t{2}, int64_t{5}, int64_t{20}, int64_t{30}}) {
+      test_top_k(_table_wrapper, {SortColumnDefinition{ColumnID{0}, order_by_mode}}, row_count);
+      test_top_k(_table_wrapper, {SortColumnDefinition{ColumnID{2}, order_by_mode}}, row_count);
+    }
+  }
+}
+
+TEST_F(OperatorsTopKTest, MultipleColumns) {
+  for (const auto row_count : {int64_t{1}, int64_t{4}, int64_t{7}, int64_t{20}}) {
+    test_top_k(_table_wrapper,
+               {SortColumnDefinition{ColumnID{1}, OrderByMode::Descending}, SortColumnDefinition{ColumnID{0}}},
+               row_count);
+    test_top_k(_table_wrapper,
+               {SortColumnDefinition{ColumnID{2}}, SortColumnDefinition{ColumnID{1}},
+                SortColumnDefinition{ColumnID{0}, OrderByMode::DescendingNullsLast}},
+               row_count);
+  }
+}
+
+TEST_F(OperatorsTopKTest, ReferenceInput) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper,
+                                          OperatorScanPredicate{ColumnID{3}, PredicateCondition::GreaterThan, 4});
+  scan->execute();
+
+  test_top_k(scan, {SortColumnDefinition{ColumnID{0}, OrderByMode::Descending}}, 3);
+  test_top_k(scan, {SortColumnDefinition{ColumnID{2}}, SortColumnDefinition{ColumnID{0}}}, 6);
+
+  const auto output = [&]() {
+    auto top_k = std::make_shared<TopK>(scan, std::vector<SortColumnDefinition>{SortColumnDefinition{ColumnID{3}}},
+                                        to_expression(int64_t{2}));
+    top_k->execute();
+    return top_k->get_output();
+  }();
+
+  // The output references the data table, not the output of the TableScan
+  const auto reference_segment =
+      std::dynamic_pointer_cast<const ReferenceSegment>(output->get_chunk(ChunkID{0})->get_segment(ColumnID{0}));
+  ASSERT_TRUE(reference_segment);
+  EXPECT_EQ(reference_segment->referenced_table(), _table_wrapper->get_output());
+  EXPECT_EQ(output->get_value<int32_t>(ColumnID{3}, 0), 5);
+  EXPECT_EQ(output->get_value<int32_t>(ColumnID{3}, 1), 6);
+}
+
+TEST_F(OperatorsTopKTest, NoRows) {
+  auto top_k = std::make_shared<TopK>(_table_wrapper,
+                                      std::vector<SortColumnDefinition>{SortColumnDefinition{ColumnID{0}}},
+                                      value_(int64_t{0}));
+  top_k->execute();
+  EXPECT_EQ(top_k->get_output()->row_count(), 0u);
+
+  auto scan = std::make_shared<TableScan>(_table_wrapper,
+                                          OperatorScanPredicate{ColumnID{3}, PredicateCondition::GreaterThan, 100});
+  scan->execute();
+
+  test_top_k(scan, {SortColumnDefinition{ColumnID{0}}}, 5);
+}
+
+}  // namespace opossum
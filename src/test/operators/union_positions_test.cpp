@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "base_test.hpp"
 
@@ -316,4 +318,61 @@ TEST_F(UnionPositionsTest, MultipleShuffledPosList) {
       load_table("src/test/tables/union_positions_multiple_shuffled_pos_list.tbl", Chunk::MAX_SIZE));
 }
 
+TEST_F(UnionPositionsTest, ManyRowsAndChunks) {
+  /**
+   * Union two PosLists that are large enough to be sorted by the radix sort and merged by multiple jobs. They overlap,
+   * contain NULLs and RowIDs from many chunks in descending order.
+   */
+  TableColumnDefinitions column_definitions;
+  column_definitions.emplace_back("a", DataType::Int);
+  const auto referenced_table = std::make_shared<Table>(column_definitions, TableType::Data);
+
+  const auto chunk_count = uint32_t{40};
+  const auto chunk_size = uint32_t{5'000};
+
+  auto pos_list_left = std::make_shared<PosList>();
+  auto pos_list_right = std::make_shared<PosList>();
+  auto expected_row_ids = std::vector<RowID>{};
+
+  for (auto chunk_id = chunk_count; chunk_id > 0; --chunk_id) {
+    for (auto chunk_offset = chunk_size; chunk_offset > 0; --chunk_offset) {
+      const auto row_id = RowID{ChunkID{chunk_id - 1}, ChunkOffset{chunk_offset - 1}};
+      const auto in_left = row_id.chunk_offset % 2 == 0;
+      const auto in_right = row_id.chunk_offset % 3 == 0;
+
+      if (in_left) pos_list_left->emplace_back(row_id);
+      if (in_right) pos_list_right->emplace_back(row_id);
+      if (in_left || in_right) expected_row_ids.emplace_back(row_id);
+    }
+  }
+  pos_list_left->emplace_back(NULL_ROW_ID);
+  pos_list_right->emplace_back(NULL_ROW_ID);
+  expected_row_ids.emplace_back(NULL_ROW_ID);
+
+  const auto table_left = std::make_shared<Table>(column_definitions, TableType::References);
+  table_left->append_chunk(
+      Segments({std::make_shared<ReferenceSegment>(referenced_table, ColumnID{0}, pos_list_left)}));
+  const auto table_right = std::make_shared<Table>(column_definitions, TableType::References);
+  table_right->append_chunk(
+      Segments({std::make_shared<ReferenceSegment>(referenced_table, ColumnID{0}, pos_list_right)}));
+
+  auto table_wrapper_left_op = std::make_shared<TableWrapper>(table_left);
+  auto table_wrapper_right_op = std::make_shared<TableWrapper>(table_right);
+  auto set_union_op = std::make_shared<UnionPositions>(table_wrapper_left_op, table_wrapper_right_op);
+
+  _execute_all({table_wrapper_left_op, table_wrapper_right_op, set_union_op});
+
+  auto row_ids = std::vector<RowID>{};
+  const auto& output = set_union_op->get_output();
+  for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    const auto segment = output->get_chunk(chunk_id)->get_segment(ColumnID{0});
+    const auto& pos_list = *std::dynamic_pointer_cast<const ReferenceSegment>(segment)->pos_list();
+    row_ids.insert(row_ids.end(), pos_list.begin(), pos_list.end());
+  }
+
+  // The output is sorted by RowID, NULLs last
+  std::sort(expected_row_ids.begin(), expected_row_ids.end());
+  EXPECT_EQ(row_ids, expected_row_ids);
+}
+
 }  // namespace opossum
@@ -12,6 +12,8 @@
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
 #include "operators/validate.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/reference_segment.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
 #include "types.hpp"
@@ -81,4 +83,95 @@ TEST_F(OperatorsValidateTest, ScanValidate) {
   EXPECT_TABLE_EQ_UNORDERED(validate->get_output(), expected_result);
 }
 
+TEST_F(OperatorsValidateTest, ValidateReferencesToMultipleChunks) {
+  auto context = std::make_shared<TransactionContext>(1u, 3u);
+
+  // The RowIDs alternate between the referenced chunks, and the row (1, 0) is invisible
+  const auto pos_list = std::make_shared<PosList>(
+      PosList{RowID{ChunkID{1}, 1u}, RowID{ChunkID{0}, 1u}, RowID{ChunkID{1}, 0u}, RowID{ChunkID{1}, 1u},
+              RowID{ChunkID{0}, 0u}, RowID{ChunkID{1}, 0u}});
+
+  const auto data_table = _table_wrapper->get_output();
+  auto segments = Segments{};
+  for (ColumnID column_id{0}; column_id < data_table->column_count(); ++column_id) {
+    segments.emplace_back(std::make_shared<ReferenceSegment>(data_table, column_id, pos_list));
+  }
+
+  auto reference_table = std::make_shared<Table>(data_table->column_definitions(), TableType::References);
+  reference_table->append_chunk(segments);
+
+  auto table_wrapper = std::make_shared<TableWrapper>(reference_table);
+  table_wrapper->execute();
+
+  auto validate = std::make_shared<Validate>(table_wrapper);
+  validate->set_transaction_context(context);
+  validate->execute();
+
+  const auto expected_pos_list =
+      PosList{RowID{ChunkID{1}, 1u}, RowID{ChunkID{0}, 1u}, RowID{ChunkID{1}, 1u}, RowID{ChunkID{0}, 0u}};
+
+  const auto output = validate->get_output();
+  ASSERT_EQ(output->chunk_count(), 1u);
+  const auto output_segment =
+      std::dynamic_pointer_cast<const ReferenceSegment>(output->get_chunk(ChunkID{0})->get_segment(ColumnID{0}));
+  ASSERT_TRUE(output_segment);
+  EXPECT_EQ(*output_segment->pos_list(), expected_pos_list);
+}
+
+TEST_F(OperatorsValidateTest, ValidateKeepsChunkOrder) {
+  auto context = std::make_shared<TransactionContext>(1u, 3u);
+
+  auto validate = std::make_shared<Validate>(_table_wrapper);
+  validate->set_transaction_context(context);
+  validate->execute();
+
+  std::shared_ptr<Table> expected_result = load_table("src/test/tables/validate_output_validated.tbl", 2u);
+  EXPECT_TABLE_EQ_ORDERED(validate->get_output(), expected_result);
+}
+
+TEST_F(OperatorsValidateTest, UsesMvccSummaryOfImmutableChunks) {
+  auto context = std::make_shared<TransactionContext>(1u, 3u);
+
+  std::shared_ptr<Table> test_table = load_table("src/test/tables/validate_input.tbl", 2u);
+  set_all_records_visible(*test_table);
+  ChunkEncoder::encode_all_chunks(test_table);
+
+  for (ChunkID chunk_id{0}; chunk_id < test_table->chunk_count(); ++chunk_id) {
+    const auto mvcc_data = test_table->get_chunk(chunk_id)->get_scoped_mvcc_data_lock();
+    EXPECT_EQ(mvcc_data->max_begin_cid(), 0u);
+    EXPECT_TRUE(mvcc_data->all_rows_visible(context->snapshot_commit_id()));
+  }
+
+  // Invalidating a row disables the summary of its chunk
+  test_table->get_chunk(ChunkID{1})->get_scoped_mvcc_data_lock()->register_invalidation();
+  set_record_invisible_for(*test_table, RowID{ChunkID{1}, 0u}, 2u);
+  EXPECT_FALSE(test_table->get_chunk(ChunkID{1})->get_scoped_mvcc_data_lock()->all_rows_visible(3u));
+
+  auto table_wrapper = std::make_shared<TableWrapper>(test_table);
+  table_wrapper->execute();
+
+  auto validate = std::make_shared<Validate>(table_wrapper);
+  validate->set_transaction_context(context);
+  validate->execute();
+
+  std::shared_ptr<Table> expected_result = load_table("src/test/tables/validate_output_validated.tbl", 2u);
+  EXPECT_TABLE_EQ_ORDERED(validate->get_output(), expected_result);
+}
+
+TEST_F(OperatorsValidateTest, CompletesMvccSummaryAfterPendingInsertsCommitted) {
+  auto mvcc_data = MvccData{3u};
+  mvcc_data.begin_cids[1] = 2u;
+  mvcc_data.begin_cids[2] = MvccData::MAX_COMMIT_ID;
+
+  // The chunk becomes immutable while the insert of the last row is not committed yet
+  mvcc_data.compute_summary();
+  EXPECT_EQ(mvcc_data.max_begin_cid(), MvccData::MAX_COMMIT_ID);
+  EXPECT_FALSE(mvcc_data.all_rows_visible(5u));
+
+  mvcc_data.begin_cids[2] = 4u;
+  EXPECT_TRUE(mvcc_data.all_rows_visible(5u));
+  EXPECT_EQ(mvcc_data.max_begin_cid(), 4u);
+  EXPECT_FALSE(mvcc_data.all_rows_visible(3u));
+}
+
 }  // namespace opossum
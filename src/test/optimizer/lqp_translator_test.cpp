@@ -29,6 +29,7 @@
 #include "operators/get_table.hpp"
 #include "operators/index_scan.hpp"
 #include "operators/join_hash.hpp"
+#include "operators/join_index.hpp"
 #include "operators/join_sort_merge.hpp"
 #include "operators/limit.hpp"
 #include "operators/maintenance/show_columns.hpp"
@@ -37,6 +38,7 @@
 #include "operators/projection.hpp"
 #include "operators/sort.hpp"
 #include "operators/table_scan.hpp"
+#include "operators/top_k.hpp"
 #include "operators/union_positions.hpp"
 #include "storage/chunk_encoder.hpp"
 #include "storage/index/group_key/group_key_index.hpp"
@@ -330,22 +332,19 @@ TEST_F(LQPTranslatorTest, Sort) {
   const auto projection_a = std::dynamic_pointer_cast<const Projection>(pqp);
   ASSERT_TRUE(projection_a);
 
-  const auto sort_a = std::dynamic_pointer_cast<const Sort>(pqp->input_left());
-  ASSERT_TRUE(sort_a);
-  EXPECT_EQ(sort_a->column_id(), ColumnID{1});
-  EXPECT_EQ(sort_a->order_by_mode(), OrderByMode::Ascending);
+  const auto sort = std::dynamic_pointer_cast<const Sort>(pqp->input_left());
+  ASSERT_TRUE(sort);
 
-  const auto sort_a_plus_b = std::dynamic_pointer_cast<const Sort>(sort_a->input_left());
-  ASSERT_TRUE(sort_a_plus_b);
-  EXPECT_EQ(sort_a_plus_b->column_id(), ColumnID{0});
-  EXPECT_EQ(sort_a_plus_b->order_by_mode(), OrderByMode::Descending);
+  const auto& sort_definitions = sort->sort_definitions();
+  ASSERT_EQ(sort_definitions.size(), 3u);
+  EXPECT_EQ(sort_definitions[0].column, ColumnID{1});
+  EXPECT_EQ(sort_definitions[0].order_by_mode, OrderByMode::Ascending);
+  EXPECT_EQ(sort_definitions[1].column, ColumnID{0});
+  EXPECT_EQ(sort_definitions[1].order_by_mode, OrderByMode::Descending);
+  EXPECT_EQ(sort_definitions[2].column, ColumnID{2});
+  EXPECT_EQ(sort_definitions[2].order_by_mode, OrderByMode::AscendingNullsLast);
 
-  const auto sort_b = std::dynamic_pointer_cast<const Sort>(sort_a_plus_b->input_left());
-  ASSERT_TRUE(sort_b);
-  EXPECT_EQ(sort_b->column_id(), ColumnID{2});
-  EXPECT_EQ(sort_b->order_by_mode(), OrderByMode::AscendingNullsLast);
-
-  const auto projection_b = std::dynamic_pointer_cast<const Projection>(sort_b->input_left());
+  const auto projection_b = std::dynamic_pointer_cast<const Projection>(sort->input_left());
   ASSERT_TRUE(projection_b);
 
   const auto get_table = std::dynamic_pointer_cast<const GetTable>(projection_b->input_left());
@@ -408,6 +407,59 @@ TEST_F(LQPTranslatorTest, LimitLiteral) {
   EXPECT_EQ(get_table->table_name(), "table_int_float");
 }
 
+TEST_F(LQPTranslatorTest, LimitOverSortToTopK) {
+  /**
+   * Build LQP and translate to PQP
+   *
+   * LQP resembles:
+   *   SELECT * FROM int_float ORDER BY b DESC, a LIMIT 10
+   */
+  const auto order_by_modes = std::vector<OrderByMode>({OrderByMode::Descending, OrderByMode::Ascending});
+
+  // clang-format off
+  const auto lqp =
+  LimitNode::make(value_(static_cast<int64_t>(10)),
+    SortNode::make(expression_vector(int_float_b, int_float_a), order_by_modes,
+      int_float_node));
+  // clang-format on
+  const auto pqp = LQPTranslator{}.translate_node(lqp);
+
+  /**
+   * Check PQP
+   */
+  const auto top_k = std::dynamic_pointer_cast<TopK>(pqp);
+  ASSERT_TRUE(top_k);
+  EXPECT_EQ(*top_k->row_count_expression(), *value_(static_cast<int64_t>(10)));
+
+  const auto& sort_definitions = top_k->sort_definitions();
+  ASSERT_EQ(sort_definitions.size(), 2u);
+  EXPECT_EQ(sort_definitions[0].column, ColumnID{1});
+  EXPECT_EQ(sort_definitions[0].order_by_mode, OrderByMode::Descending);
+  EXPECT_EQ(sort_definitions[1].column, ColumnID{0});
+  EXPECT_EQ(sort_definitions[1].order_by_mode, OrderByMode::Ascending);
+
+  const auto get_table = std::dynamic_pointer_cast<const GetTable>(top_k->input_left());
+  ASSERT_TRUE(get_table);
+  EXPECT_EQ(get_table->table_name(), "table_int_float");
+}
+
+TEST_F(LQPTranslatorTest, LimitWithParameterOverSort) {
+  /**
+   * The number of rows is only known when the parameter is set, so Sort and Limit are kept
+   */
+  // clang-format off
+  const auto lqp =
+  LimitNode::make(parameter_(ParameterID{0}),
+    SortNode::make(expression_vector(int_float_a), std::vector<OrderByMode>{OrderByMode::Ascending},
+      int_float_node));
+  // clang-format on
+  const auto pqp = LQPTranslator{}.translate_node(lqp);
+
+  const auto limit = std::dynamic_pointer_cast<Limit>(pqp);
+  ASSERT_TRUE(limit);
+  ASSERT_TRUE(std::dynamic_pointer_cast<const Sort>(limit->input_left()));
+}
+
 TEST_F(LQPTranslatorTest, PredicateNodeUnaryScan) {
   /**
    * Build LQP and translate to PQP
@@ -582,6 +634,69 @@ TEST_F(LQPTranslatorTest, JoinNode) {
   EXPECT_EQ(join_op->mode(), JoinMode::Outer);
 }
 
+TEST_F(LQPTranslatorTest, JoinNodeWithIndex) {
+  /**
+   * Build LQP and translate to PQP: A few rows are joined with a large table that has an index on the join column
+   */
+  TableColumnDefinitions column_definitions;
+  column_definitions.emplace_back("a", DataType::Int);
+
+  const auto indexed_table = std::make_shared<Table>(column_definitions, TableType::Data, 1'000u, UseMvcc::Yes);
+  for (auto value = 0; value < 10'000; ++value) indexed_table->append({value});
+  ChunkEncoder::encode_all_chunks(indexed_table);
+  indexed_table->create_index<GroupKeyIndex>({ColumnID{0}});
+  StorageManager::get().add_table("indexed_table", indexed_table);
+
+  const auto indexed_table_node = StoredTableNode::make("indexed_table");
+  const auto indexed_table_a = indexed_table_node->get_column("a");
+
+  auto join_node = JoinNode::make(JoinMode::Inner, equals_(int_float_a, indexed_table_a), int_float_node,
+                                  PredicateNode::make(greater_than_(indexed_table_a, 5), indexed_table_node));
+  const auto op = LQPTranslator{}.translate_node(join_node);
+
+  /**
+   * Check PQP
+   */
+  const auto join_op = std::dynamic_pointer_cast<JoinIndex>(op);
+  ASSERT_TRUE(join_op);
+  EXPECT_EQ(join_op->column_ids(), ColumnIDPair(ColumnID{0}, ColumnID{0}));
+  EXPECT_EQ(join_op->mode(), JoinMode::Inner);
+
+  // The index is only on the left side, so the JoinHash is used
+  auto swapped_join_node =
+      JoinNode::make(JoinMode::Inner, equals_(indexed_table_a, int_float_a), indexed_table_node, int_float_node);
+  EXPECT_TRUE(std::dynamic_pointer_cast<JoinHash>(LQPTranslator{}.translate_node(swapped_join_node)));
+}
+
+TEST_F(LQPTranslatorTest, MultiColumnJoin) {
+  /**
+   * Build LQP and translate to PQP
+   */
+  // clang-format off
+  const auto lqp =
+  PredicateNode::make(greater_than_(int_float_a, 5),
+    PredicateNode::make(equals_(int_float2_b, int_float_b),
+      JoinNode::make(JoinMode::Inner, equals_(int_float_a, int_float2_a),
+        int_float_node,
+        int_float2_node)));
+  // clang-format on
+  const auto op = LQPTranslator{}.translate_node(lqp);
+
+  /**
+   * Check PQP: The equi-predicate becomes a secondary predicate of the JoinHash, the other one stays a TableScan
+   */
+  const auto table_scan_op = std::dynamic_pointer_cast<const TableScan>(op);
+  ASSERT_TRUE(table_scan_op);
+  EXPECT_EQ(table_scan_op->predicate().predicate_condition, PredicateCondition::GreaterThan);
+
+  const auto join_op = std::dynamic_pointer_cast<const JoinHash>(table_scan_op->input_left());
+  ASSERT_TRUE(join_op);
+  EXPECT_EQ(join_op->column_ids(), ColumnIDPair(ColumnID{0}, ColumnID{0}));
+  ASSERT_EQ(join_op->secondary_predicates().size(), 1u);
+  EXPECT_EQ(join_op->secondary_predicates()[0].column_ids, ColumnIDPair(ColumnID{1}, ColumnID{1}));
+  EXPECT_EQ(join_op->secondary_predicates()[0].predicate_condition, PredicateCondition::Equals);
+}
+
 TEST_F(LQPTranslatorTest, ShowTablesNode) {
   /**
    * Build LQP and translate to PQP
@@ -0,0 +1,254 @@
+#include "gtest/gtest.h"
+
+#include "expression/expression_functional.hpp"
+#include "logical_query_plan/aggregate_node.hpp"
+#include "logical_query_plan/join_node.hpp"
+#include "logical_query_plan/mock_node.hpp"
+#include "logical_query_plan/predicate_node.hpp"
+#include "logical_query_plan/projection_node.hpp"
+#include "optimizer/strategy/subselect_to_join_rule.hpp"
+
+#include "strategy_base_test.hpp"
+#include "testing_assert.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class SubselectToJoinRuleTest : public StrategyBaseTest {
+ public:
+  void SetUp() override {
+    node_a = MockNode::make(MockNode::ColumnDefinitions{{DataType::Int, "a"}, {DataType::Int, "b"}}, "a");
+    node_b = MockNode::make(
+        MockNode::ColumnDefinitions{{DataType::Int, "x"}, {DataType::Int, "y"}, {DataType::Int, "z"}}, "b");
+
+    a = node_a->get_column("a");
+    b = node_a->get_column("b");
+    x = node_b->get_column("x");
+    y = node_b->get_column("y");
+    z = node_b->get_column("z");
+
+    parameter_a = parameter_(ParameterID{0}, a);
+    parameter_b = parameter_(ParameterID{1}, b);
+
+    rule = std::make_shared<SubselectToJoinRule>();
+  }
+
+  std::shared_ptr<SubselectToJoinRule> rule;
+  std::shared_ptr<MockNode> node_a, node_b;
+  LQPColumnReference a, b, x, y, z;
+  std::shared_ptr<ParameterExpression> parameter_a, parameter_b;
+};
+
+TEST_F(SubselectToJoinRuleTest, ExistsToSemiJoin) {
+  // clang-format off
+  const auto subselect_lqp =
+  PredicateNode::make(greater_than_(y, 5),
+    PredicateNode::make(equals_(x, parameter_a),
+      node_b));
+  const auto subselect = select_(subselect_lqp, std::make_pair(ParameterID{0}, a));
+
+  const auto input_lqp =
+  ProjectionNode::make(expression_vector(a, b),
+    PredicateNode::make(not_equals_(exists_(subselect), 0),
+      ProjectionNode::make(expression_vector(exists_(subselect), a, b),
+        node_a)));
+
+  const auto expected_lqp =
+  ProjectionNode::make(expression_vector(a, b),
+    JoinNode::make(JoinMode::Semi, equals_(a, x),
+      node_a,
+      PredicateNode::make(greater_than_(y, 5),
+        node_b)));
+  // clang-format on
+
+  const auto actual_lqp = apply_rule(rule, input_lqp);
+
+  EXPECT_LQP_EQ(actual_lqp, expected_lqp);
+}
+
+TEST_F(SubselectToJoinRuleTest, NotExistsToAntiJoin) {
+  // clang-format off
+  const auto subselect_lqp =
+  ProjectionNode::make(expression_vector(z),
+    PredicateNode::make(equals_(parameter_b, y),
+      node_b));
+  const auto subselect = select_(subselect_lqp, std::make_pair(ParameterID{1}, b));
+
+  const auto input_lqp =
+  ProjectionNode::make(expression_vector(a, b),
+    PredicateNode::make(equals_(exists_(subselect), 0),
+      ProjectionNode::make(expression_vector(exists_(subselect), a, b),
+        node_a)));
+
+  const auto expected_lqp =
+  ProjectionNode::make(expression_vector(a, b),
+    JoinNode::make(JoinMode::Anti, equals_(b, y),
+      node_a,
+      ProjectionNode::make(expression_vector(z, y),
+        node_b)));
+  // clang-format on
+
+  const auto actual_lqp = apply_rule(rule, input_lqp);
+
+  EXPECT_LQP_EQ(actual_lqp, expected_lqp);
+}
+
+TEST_F(SubselectToJoinRuleTest, InToSemiJoin) {
+  // clang-format off
+  const auto subselect_lqp =
+  ProjectionNode::make(expression_vector(x),
+    PredicateNode::make(greater_than_(y, 5),
+      node_b));
+  const auto subselect = select_(subselect_lqp);
+
+  const auto input_lqp =
+  ProjectionNode::make(expression_vector(a, b),
+    PredicateNode::make(not_equals_(in_(a, subselect), 0),
+      ProjectionNode::make(expression_vector(in_(a, subselect), a, b),
+        node_a)));
+
+  const auto expected_lqp =
+  ProjectionNode::make(expression_vector(a, b),
+    JoinNode::make(JoinMode::Semi, equals_(a, x),
+      node_a,
+      ProjectionNode::make(expression_vector(x),
+        PredicateNode::make(greater_than_(y, 5),
+          node_b))));
+  // clang-format on
+
+  const auto actual_lqp = apply_rule(rule, input_lqp);
+
+  EXPECT_LQP_EQ(actual_lqp, expected_lqp);
+}
+
+TEST_F(SubselectToJoinRuleTest, NotInToAntiJoin) {
+  // clang-format off
+  const auto subselect_lqp =
+  ProjectionNode::make(expression_vector(x),
+    node_b);
+  const auto subselect = select_(subselect_lqp);
+
+  const auto input_lqp =
+  PredicateNode::make(equals_(in_(b, subselect), 0),
+    ProjectionNode::make(expression_vector(a, b, in_(b, subselect)),
+      node_a));
+
+  const auto expected_lqp =
+  JoinNode::make(JoinMode::Anti, equals_(b, x),
+    node_a,
+    ProjectionNode::make(expression_vector(x),
+      node_b));
+  // clang-format on
+
+  const auto actual_lqp = apply_rule(rule, input_lqp);
+
+  EXPECT_LQP_EQ(actual_lqp, expected_lqp);
+}
+
+TEST_F(SubselectToJoinRuleTest, CorrelatedAggregateToJoin) {
+  // clang-format off
+  const auto subselect_lqp =
+  ProjectionNode::make(expression_vector(mul_(0.5, sum_(y))),
+    AggregateNode::make(expression_vector(), expression_vector(sum_(y)),
+      PredicateNode::make(equals_(x, parameter_a),
+        node_b)));
+  const auto subselect = select_(subselect_lqp, std::make_pair(ParameterID{0}, a));
+
+  const auto input_lqp =
+  ProjectionNode::make(expression_vector(a, b),
+    PredicateNode::make(less_than_(b, subselect),
+      ProjectionNode::make(expression_vector(subselect, a, b),
+        node_a)));
+
+  const auto expected_lqp =
+  ProjectionNode::make(expression_vector(a, b),
+    ProjectionNode::make(expression_vector(a, b),
+      PredicateNode::make(less_than_(b, mul_(0.5, sum_(y))),
+        JoinNode::make(JoinMode::Inner, equals_(a, x),
+          node_a,
+          ProjectionNode::make(expression_vector(mul_(0.5, sum_(y)), x),
+            AggregateNode::make(expression_vector(x), expression_vector(sum_(y)),
+              node_b))))));
+  // clang-format on
+
+  const auto actual_lqp = apply_rule(rule, input_lqp);
+
+  EXPECT_LQP_EQ(actual_lqp, expected_lqp);
+}
+
+TEST_F(SubselectToJoinRuleTest, CorrelatedAggregateWithMultipleCorrelatedPredicatesToJoin) {
+  // clang-format off
+  const auto subselect_lqp =
+  AggregateNode::make(expression_vector(), expression_vector(min_(z)),
+    PredicateNode::make(equals_(y, parameter_b),
+      PredicateNode::make(equals_(x, parameter_a),
+        node_b)));
+  const auto subselect =
+  select_(subselect_lqp, std::make_pair(ParameterID{0}, a), std::make_pair(ParameterID{1}, b));
+
+  const auto input_lqp =
+  PredicateNode::make(greater_than_(subselect, a),
+    ProjectionNode::make(expression_vector(subselect, a, b),
+      node_a));
+
+  // The second correlated predicate is fused into the join by the LQPTranslator
+  const auto expected_lqp =
+  ProjectionNode::make(expression_vector(a, b),
+    PredicateNode::make(greater_than_(min_(z), a),
+      PredicateNode::make(equals_(a, x),
+        JoinNode::make(JoinMode::Inner, equals_(b, y),
+          node_a,
+          AggregateNode::make(expression_vector(y, x), expression_vector(min_(z)),
+            node_b)))));
+  // clang-format on
+
+  const auto actual_lqp = apply_rule(rule, input_lqp);
+
+  EXPECT_LQP_EQ(actual_lqp, expected_lqp);
+}
+
+TEST_F(SubselectToJoinRuleTest, CountIsNotRewritten) {
+  // COUNT returns 0 instead of NULL if no row matches the correlated predicate, which the join cannot reproduce
+
+  // clang-format off
+  const auto subselect_lqp =
+  AggregateNode::make(expression_vector(), expression_vector(count_star_()),
+    PredicateNode::make(equals_(x, parameter_a),
+      node_b));
+  const auto subselect = select_(subselect_lqp, std::make_pair(ParameterID{0}, a));
+
+  const auto input_lqp =
+  PredicateNode::make(less_than_(b, subselect),
+    ProjectionNode::make(expression_vector(subselect, a, b),
+      node_a));
+  // clang-format on
+
+  const auto expected_lqp = input_lqp->deep_copy();
+  const auto actual_lqp = apply_rule(rule, input_lqp);
+
+  EXPECT_LQP_EQ(actual_lqp, expected_lqp);
+}
+
+TEST_F(SubselectToJoinRuleTest, NonEqualityCorrelationIsNotRewritten) {
+  // clang-format off
+  const auto subselect_lqp =
+  PredicateNode::make(equals_(x, parameter_a),
+    PredicateNode::make(not_equals_(y, parameter_b),
+      node_b));
+  const auto subselect =
+  select_(subselect_lqp, std::make_pair(ParameterID{0}, a), std::make_pair(ParameterID{1}, b));
+
+  const auto input_lqp =
+  PredicateNode::make(not_equals_(exists_(subselect), 0),
+    ProjectionNode::make(expression_vector(exists_(subselect), a, b),
+      node_a));
+  // clang-format on
+
+  const auto expected_lqp = input_lqp->deep_copy();
+  const auto actual_lqp = apply_rule(rule, input_lqp);
+
+  EXPECT_LQP_EQ(actual_lqp, expected_lqp);
+}
+
+}  // namespace opossum
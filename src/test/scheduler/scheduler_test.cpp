@@ -1,4 +1,6 @@
+#include <chrono>
 #include <memory>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -185,6 +187,33 @@ TEST_F(SchedulerTest, DiamondDependenciesWithoutScheduler) {
   ASSERT_EQ(counter, 7u);
 }
 
+TEST_F(SchedulerTest, WakeUpIdleWorkers) {
+  // Idle workers block until they are woken up by a new task. With a single queue (4 workers per node), they wait
+  // without a timeout.
+  for (const auto workers_per_node : {4u, 2u}) {
+    Topology::use_fake_numa_topology(4, workers_per_node);
+    CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+    std::atomic_uint counter{0};
+
+    for (auto round = 0; round < 5; ++round) {
+      // Give the workers time to run out of tasks and block
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+      auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+      for (auto job_id = 0; job_id < 4; ++job_id) {
+        jobs.emplace_back(std::make_shared<JobTask>([&]() { counter++; }));
+        jobs.back()->schedule();
+      }
+      CurrentScheduler::wait_for_tasks(jobs);
+    }
+
+    CurrentScheduler::get()->finish();
+
+    EXPECT_EQ(counter, 20u);
+  }
+}
+
 TEST_F(SchedulerTest, MultipleOperators) {
   Topology::use_fake_numa_topology(8, 4);
   CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
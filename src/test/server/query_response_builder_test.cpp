@@ -0,0 +1,130 @@
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "server/postgres_wire_handler.hpp"
+#include "server/query_response_builder.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class QueryResponseBuilderTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    const auto column_definitions =
+        TableColumnDefinitions{{"a", DataType::Int, false},   {"b", DataType::Long, true},
+                               {"c", DataType::Float, false}, {"d", DataType::Double, false},
+                               {"e", DataType::String, true}};
+
+    _table = std::make_shared<Table>(column_definitions, TableType::Data, 2);
+    _table->append({1, int64_t{-5}, 1.5f, 2.25, "hello"});
+    _table->append({-300, NULL_VALUE, -0.5f, 1e10, NULL_VALUE});
+    _table->append({70000, int64_t{1} << 40, 0.0f, -3.0, ""});
+  }
+
+  using Row = std::vector<std::optional<std::string>>;
+
+  // Sends the table and parses the DataRow messages
+  std::vector<Row> send_and_parse(const std::vector<FormatCode>& format_codes) {
+    auto send_count = size_t{0};
+    auto rows = std::vector<Row>{};
+
+    const auto send_data_rows = [&](const ByteBuffer& data_rows) {
+      ++send_count;
+
+      auto packet = InputPacket{};
+      packet.data = data_rows;
+      packet.offset = packet.data.cbegin();
+
+      while (packet.offset != packet.data.cend()) {
+        EXPECT_EQ(PostgresWireHandler::read_value<NetworkMessageType>(packet), NetworkMessageType::DataRow);
+        const auto message_begin = packet.offset;
+        const auto message_length = ntohl(PostgresWireHandler::read_value<uint32_t>(packet));
+        const auto field_count = ntohs(PostgresWireHandler::read_value<uint16_t>(packet));
+        EXPECT_EQ(field_count, _table->column_count());
+
+        auto row = Row{};
+        for (auto field_id = 0; field_id < field_count; ++field_id) {
+          const auto field_length = static_cast<int32_t>(ntohl(PostgresWireHandler::read_value<uint32_t>(packet)));
+          if (field_length == -1) {
+            row.emplace_back(std::nullopt);
+            continue;
+          }
+          const auto value = PostgresWireHandler::read_values<char>(packet, field_length);
+          row.emplace_back(std::string{value.begin(), value.end()});
+        }
+
+        EXPECT_EQ(static_cast<size_t>(packet.offset - message_begin), message_length);
+        rows.emplace_back(row);
+      }
+
+      return boost::make_ready_future();
+    };
+
+    const auto row_count = QueryResponseBuilder::send_query_response(send_data_rows, *_table, format_codes).get();
+    EXPECT_EQ(row_count, 3u);
+
+    // One call per chunk
+    EXPECT_EQ(send_count, 2u);
+
+    return rows;
+  }
+
+  // The big-endian representation of `value`
+  template <typename T>
+  static std::string binary(const T value) {
+    auto bytes = std::string(sizeof(T), '\0');
+    auto bits = uint64_t{0};
+    std::memcpy(&bits, &value, sizeof(T));
+    for (auto byte_id = size_t{0}; byte_id < sizeof(T); ++byte_id) {
+      bytes[byte_id] = static_cast<char>(bits >> ((sizeof(T) - 1 - byte_id) * 8));
+    }
+    return bytes;
+  }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(QueryResponseBuilderTest, TextFormat) {
+  const auto expected_rows = std::vector<Row>{{"1", "-5", "1.5", "2.25", "hello"},
+                                              {"-300", std::nullopt, "-0.5", "10000000000", std::nullopt},
+                                              {"70000", "1099511627776", "0", "-3", ""}};
+
+  EXPECT_EQ(send_and_parse({}), expected_rows);
+  EXPECT_EQ(send_and_parse({FormatCode::Text}), expected_rows);
+
+  ChunkEncoder::encode_all_chunks(_table);
+  EXPECT_EQ(send_and_parse({}), expected_rows);
+}
+
+TEST_F(QueryResponseBuilderTest, BinaryFormat) {
+  const auto expected_rows =
+      std::vector<Row>{{binary(int32_t{1}), binary(int64_t{-5}), binary(1.5f), binary(2.25), "hello"},
+                       {binary(int32_t{-300}), std::nullopt, binary(-0.5f), binary(1e10), std::nullopt},
+                       {binary(int32_t{70000}), binary(int64_t{1} << 40), binary(0.0f), binary(-3.0), ""}};
+
+  EXPECT_EQ(send_and_parse({FormatCode::Binary}), expected_rows);
+
+  ChunkEncoder::encode_all_chunks(_table);
+  EXPECT_EQ(send_and_parse({FormatCode::Binary}), expected_rows);
+}
+
+TEST_F(QueryResponseBuilderTest, FormatPerColumn) {
+  const auto rows = send_and_parse(
+      {FormatCode::Binary, FormatCode::Text, FormatCode::Text, FormatCode::Binary, FormatCode::Binary});
+
+  EXPECT_EQ(rows[0], (Row{binary(int32_t{1}), "-5", "1.5", binary(2.25), "hello"}));
+
+  const auto row_description = QueryResponseBuilder::build_row_description(
+      _table, {FormatCode::Binary, FormatCode::Text, FormatCode::Text, FormatCode::Binary, FormatCode::Binary});
+  EXPECT_EQ(row_description[0].format_code, FormatCode::Binary);
+  EXPECT_EQ(row_description[1].format_code, FormatCode::Text);
+  EXPECT_EQ(row_description[3].format_code, FormatCode::Binary);
+}
+
+}  // namespace opossum
@@ -18,20 +18,33 @@ class ColumnStatisticsTest : public BaseTest {
   void SetUp() override {
     _table_with_different_column_types = load_table("src/test/tables/int_float_double_string.tbl", Chunk::MAX_SIZE);
     auto table_statistics1 = generate_table_statistics(*_table_with_different_column_types);
-    _column_statistics_int = std::dynamic_pointer_cast<ColumnStatistics<int32_t>>(
+    _column_statistics_int_with_histogram = std::dynamic_pointer_cast<ColumnStatistics<int32_t>>(
         std::const_pointer_cast<BaseColumnStatistics>(table_statistics1.column_statistics()[0]));
-    _column_statistics_float = std::dynamic_pointer_cast<ColumnStatistics<float>>(
+    _column_statistics_float_with_histogram = std::dynamic_pointer_cast<ColumnStatistics<float>>(
         std::const_pointer_cast<BaseColumnStatistics>(table_statistics1.column_statistics()[1]));
-    _column_statistics_double = std::dynamic_pointer_cast<ColumnStatistics<double>>(
+    _column_statistics_double_with_histogram = std::dynamic_pointer_cast<ColumnStatistics<double>>(
         std::const_pointer_cast<BaseColumnStatistics>(table_statistics1.column_statistics()[2]));
-    _column_statistics_string = std::dynamic_pointer_cast<ColumnStatistics<std::string>>(
+    _column_statistics_string_with_histogram = std::dynamic_pointer_cast<ColumnStatistics<std::string>>(
         std::const_pointer_cast<BaseColumnStatistics>(table_statistics1.column_statistics()[3]));
 
+    // Most tests cover the estimation that assumes a uniform distribution between min and max
+    _column_statistics_int = without_histogram(_column_statistics_int_with_histogram);
+    _column_statistics_float = without_histogram(_column_statistics_float_with_histogram);
+    _column_statistics_double = without_histogram(_column_statistics_double_with_histogram);
+    _column_statistics_string = without_histogram(_column_statistics_string_with_histogram);
+
     _table_uniform_distribution = load_table("src/test/tables/int_equal_distribution.tbl", Chunk::MAX_SIZE);
     auto table_statistics2 = generate_table_statistics(*_table_uniform_distribution);
     _column_statistics_uniform_columns = table_statistics2.column_statistics();
   }
 
+  template <typename T>
+  static std::shared_ptr<ColumnStatistics<T>> without_histogram(
+      const std::shared_ptr<ColumnStatistics<T>>& statistics) {
+    return std::make_shared<ColumnStatistics<T>>(statistics->null_value_ratio(), statistics->distinct_count(),
+                                                 statistics->min(), statistics->max());
+  }
+
   // For single value scans (i.e. all but BETWEEN)
   template <typename T>
   void predict_selectivities_and_compare(const std::shared_ptr<ColumnStatistics<T>>& column_statistic,
@@ -98,6 +111,10 @@ class ColumnStatisticsTest : public BaseTest {
   std::shared_ptr<ColumnStatistics<float>> _column_statistics_float;
   std::shared_ptr<ColumnStatistics<double>> _column_statistics_double;
   std::shared_ptr<ColumnStatistics<std::string>> _column_statistics_string;
+  std::shared_ptr<ColumnStatistics<int32_t>> _column_statistics_int_with_histogram;
+  std::shared_ptr<ColumnStatistics<float>> _column_statistics_float_with_histogram;
+  std::shared_ptr<ColumnStatistics<double>> _column_statistics_double_with_histogram;
+  std::shared_ptr<ColumnStatistics<std::string>> _column_statistics_string_with_histogram;
   std::shared_ptr<Table> _table_uniform_distribution;
   std::vector<std::shared_ptr<const BaseColumnStatistics>> _column_statistics_uniform_columns;
 
@@ -193,6 +210,91 @@ TEST_F(ColumnStatisticsTest, BetweenTest) {
   predict_selectivities_and_compare(_column_statistics_double, predicate_condition, double_values, selectivities_float);
 }
 
+TEST_F(ColumnStatisticsTest, LessThanWithHistogramTest) {
+  PredicateCondition predicate_condition = PredicateCondition::LessThan;
+
+  // The histograms of the columns are exact, so the estimations are exact as well
+  std::vector<float> selectivities{0.f, 0.f, 1.f / 3.f, 5.f / 6.f, 1.f};
+  predict_selectivities_and_compare(_column_statistics_int_with_histogram, predicate_condition, _int_values,
+                                    selectivities);
+  predict_selectivities_and_compare(_column_statistics_float_with_histogram, predicate_condition, _float_values,
+                                    selectivities);
+  predict_selectivities_and_compare(_column_statistics_double_with_histogram, predicate_condition, _double_values,
+                                    selectivities);
+
+  std::vector<float> selectivities_string{0.f, 0.f, 1.f / 6.f, 5.f / 6.f, 1.f};
+  predict_selectivities_and_compare(_column_statistics_string_with_histogram, predicate_condition, _string_values,
+                                    selectivities_string);
+}
+
+TEST_F(ColumnStatisticsTest, LessEqualThanWithHistogramTest) {
+  PredicateCondition predicate_condition = PredicateCondition::LessThanEquals;
+
+  std::vector<float> selectivities{0.f, 1.f / 6.f, 1.f / 2.f, 1.f, 1.f};
+  predict_selectivities_and_compare(_column_statistics_int_with_histogram, predicate_condition, _int_values,
+                                    selectivities);
+  predict_selectivities_and_compare(_column_statistics_float_with_histogram, predicate_condition, _float_values,
+                                    selectivities);
+  predict_selectivities_and_compare(_column_statistics_double_with_histogram, predicate_condition, _double_values,
+                                    selectivities);
+
+  std::vector<float> selectivities_string{0.f, 1.f / 6.f, 1.f / 3.f, 1.f, 1.f};
+  predict_selectivities_and_compare(_column_statistics_string_with_histogram, predicate_condition, _string_values,
+                                    selectivities_string);
+}
+
+TEST_F(ColumnStatisticsTest, GreaterThanWithHistogramTest) {
+  PredicateCondition predicate_condition = PredicateCondition::GreaterThan;
+
+  std::vector<float> selectivities{1.f, 5.f / 6.f, 1.f / 2.f, 0.f, 0.f};
+  predict_selectivities_and_compare(_column_statistics_int_with_histogram, predicate_condition, _int_values,
+                                    selectivities);
+  predict_selectivities_and_compare(_column_statistics_float_with_histogram, predicate_condition, _float_values,
+                                    selectivities);
+  predict_selectivities_and_compare(_column_statistics_double_with_histogram, predicate_condition, _double_values,
+                                    selectivities);
+
+  std::vector<float> selectivities_string{1.f, 5.f / 6.f, 2.f / 3.f, 0.f, 0.f};
+  predict_selectivities_and_compare(_column_statistics_string_with_histogram, predicate_condition, _string_values,
+                                    selectivities_string);
+}
+
+TEST_F(ColumnStatisticsTest, GreaterEqualThanWithHistogramTest) {
+  PredicateCondition predicate_condition = PredicateCondition::GreaterThanEquals;
+
+  std::vector<float> selectivities{1.f, 1.f, 2.f / 3.f, 1.f / 6.f, 0.f};
+  predict_selectivities_and_compare(_column_statistics_int_with_histogram, predicate_condition, _int_values,
+                                    selectivities);
+  predict_selectivities_and_compare(_column_statistics_float_with_histogram, predicate_condition, _float_values,
+                                    selectivities);
+  predict_selectivities_and_compare(_column_statistics_double_with_histogram, predicate_condition, _double_values,
+                                    selectivities);
+
+  std::vector<float> selectivities_string{1.f, 1.f, 5.f / 6.f, 1.f / 6.f, 0.f};
+  predict_selectivities_and_compare(_column_statistics_string_with_histogram, predicate_condition, _string_values,
+                                    selectivities_string);
+}
+
+TEST_F(ColumnStatisticsTest, BetweenWithHistogramTest) {
+  PredicateCondition predicate_condition = PredicateCondition::Between;
+
+  std::vector<float> selectivities{0.f, 1.f / 3.f, 1.f / 3.f, 1.f, 1.f / 3.f, 1.f / 3.f, 0.f};
+
+  std::vector<std::pair<int32_t, int32_t>> int_values{{-1, 0}, {-1, 2}, {1, 2}, {0, 7}, {5, 6}, {5, 8}, {7, 8}};
+  predict_selectivities_and_compare(_column_statistics_int_with_histogram, predicate_condition, int_values,
+                                    selectivities);
+
+  std::vector<std::pair<float, float>> float_values{{-1.f, 0.f}, {-1.f, 2.f}, {1.f, 2.f}, {0.f, 7.f},
+                                                    {5.f, 6.f},  {5.f, 8.f},  {7.f, 8.f}};
+  predict_selectivities_and_compare(_column_statistics_float_with_histogram, predicate_condition, float_values,
+                                    selectivities);
+
+  std::vector<std::pair<double, double>> double_values{{-1., 0.}, {-1., 2.}, {1., 2.}, {0., 7.},
+                                                       {5., 6.},  {5., 8.},  {7., 8.}};
+  predict_selectivities_and_compare(_column_statistics_double_with_histogram, predicate_condition, double_values,
+                                    selectivities);
+}
+
 TEST_F(ColumnStatisticsTest, StoredProcedureNotEqualsTest) {
   PredicateCondition predicate_condition = PredicateCondition::NotEquals;
 
@@ -267,6 +369,18 @@ TEST_F(ColumnStatisticsTest, StoredProcedureBetweenTest) {
                                                           _double_values, selectivities_float);
 }
 
+TEST_F(ColumnStatisticsTest, StoredProcedureBetweenWithHistogramTest) {
+  PredicateCondition predicate_condition = PredicateCondition::Between;
+
+  std::vector<float> selectivities{0.f, 1.f / 18.f, 1.f / 6.f, 1.f / 3.f, 1.f / 3.f};
+  predict_selectivities_for_stored_procedures_and_compare(_column_statistics_int_with_histogram, predicate_condition,
+                                                          _int_values, selectivities);
+  predict_selectivities_for_stored_procedures_and_compare(_column_statistics_float_with_histogram,
+                                                          predicate_condition, _float_values, selectivities);
+  predict_selectivities_for_stored_procedures_and_compare(_column_statistics_double_with_histogram,
+                                                          predicate_condition, _double_values, selectivities);
+}
+
 TEST_F(ColumnStatisticsTest, TwoColumnsEqualsTest) {
   PredicateCondition predicate_condition = PredicateCondition::Equals;
 
@@ -389,6 +503,20 @@ TEST_F(ColumnStatisticsTest, NonNullRatioOneColumnTest) {
   EXPECT_FLOAT_EQ(result.selectivity, 0.f);
 }
 
+TEST_F(ColumnStatisticsTest, NonNullRatioOneColumnWithHistogramTest) {
+  _column_statistics_float_with_histogram->set_null_value_ratio(0.5f);  // non-null value ratio: 0.5
+
+  auto result = _column_statistics_float_with_histogram->estimate_predicate_with_value(PredicateCondition::LessThan,
+                                                                                       AllTypeVariant(3.f));
+  EXPECT_FLOAT_EQ(result.selectivity, 0.5f * 2.f / 6.f);
+  result = _column_statistics_float_with_histogram->estimate_predicate_with_value(
+      PredicateCondition::GreaterThanEquals, AllTypeVariant(3.f));
+  EXPECT_FLOAT_EQ(result.selectivity, 0.5f * 4.f / 6.f);
+  result = _column_statistics_float_with_histogram->estimate_predicate_with_value(
+      PredicateCondition::Between, AllTypeVariant(4.f), AllTypeVariant(6.f));
+  EXPECT_FLOAT_EQ(result.selectivity, 0.5f * 3.f / 6.f);
+}
+
 TEST_F(ColumnStatisticsTest, NonNullRatioTwoColumnTest) {
   auto stats_0 =
       std::const_pointer_cast<BaseColumnStatistics>(_column_statistics_uniform_columns[0]);  // values from 0 to 5
@@ -0,0 +1,141 @@
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "statistics/column_statistics.hpp"
+#include "statistics/generate_table_statistics.hpp"
+#include "statistics/histogram.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class HistogramTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // 1000 values: 500x the value 1, 100x the value 2, and the values 3 to 402 once each
+    auto value_counts = std::vector<std::pair<int32_t, size_t>>{{1, 500}, {2, 100}};
+    for (auto value = int32_t{3}; value <= 402; ++value) value_counts.emplace_back(value, 1);
+
+    _skewed_histogram = Histogram<int32_t>::from_value_counts(value_counts);
+  }
+
+  std::shared_ptr<Histogram<int32_t>> _skewed_histogram;
+};
+
+TEST_F(HistogramTest, Empty) { EXPECT_EQ(Histogram<int32_t>::from_value_counts({}), nullptr); }
+
+TEST_F(HistogramTest, MostCommonValues) {
+  ASSERT_EQ(_skewed_histogram->most_common_values().size(), 2u);
+  EXPECT_EQ(_skewed_histogram->most_common_values()[0].value, 1);
+  EXPECT_FLOAT_EQ(_skewed_histogram->most_common_values()[0].ratio, 0.5f);
+  EXPECT_EQ(_skewed_histogram->most_common_values()[1].value, 2);
+  EXPECT_FLOAT_EQ(_skewed_histogram->most_common_values()[1].ratio, 0.1f);
+
+  // The remaining 400 values are distributed over equal-height buckets
+  const auto& buckets = _skewed_histogram->buckets();
+  ASSERT_EQ(buckets.size(), Histogram<int32_t>::MAX_BUCKET_COUNT);
+  EXPECT_EQ(buckets.front().min, 3);
+  EXPECT_EQ(buckets.back().max, 402);
+
+  auto total_ratio = 0.6f;
+  auto total_distinct_count = 2.0f;
+  for (const auto& bucket : buckets) {
+    total_ratio += bucket.ratio;
+    total_distinct_count += bucket.distinct_count;
+    EXPECT_NEAR(bucket.distinct_count, 400.0f / 64.0f, 1.0f);
+  }
+  EXPECT_NEAR(total_ratio, 1.0f, 0.0001f);
+  EXPECT_FLOAT_EQ(total_distinct_count, 402.0f);
+}
+
+TEST_F(HistogramTest, UniformDataIsExact) {
+  const auto histogram = Histogram<std::string>::from_value_counts({{"b", 2}, {"a", 2}, {"c", 2}});
+
+  EXPECT_TRUE(histogram->most_common_values().empty());
+  ASSERT_EQ(histogram->buckets().size(), 3u);
+  EXPECT_EQ(histogram->buckets()[0].min, "a");
+  EXPECT_EQ(histogram->buckets()[0].max, "a");
+
+  EXPECT_FLOAT_EQ(histogram->estimate_equals("b"), 1.0f / 3.0f);
+  EXPECT_FLOAT_EQ(histogram->estimate_equals("bb"), 0.0f);
+  EXPECT_FLOAT_EQ(histogram->estimate_range("a", "b"), 2.0f / 3.0f);
+  EXPECT_FLOAT_EQ(histogram->estimate_range("aa", "bb"), 1.0f / 3.0f);
+}
+
+TEST_F(HistogramTest, Estimations) {
+  EXPECT_FLOAT_EQ(_skewed_histogram->estimate_equals(1), 0.5f);
+  EXPECT_FLOAT_EQ(_skewed_histogram->estimate_equals(2), 0.1f);
+  EXPECT_FLOAT_EQ(_skewed_histogram->estimate_equals(200), 0.001f);
+  EXPECT_FLOAT_EQ(_skewed_histogram->estimate_equals(0), 0.0f);
+  EXPECT_FLOAT_EQ(_skewed_histogram->estimate_equals(403), 0.0f);
+
+  EXPECT_FLOAT_EQ(_skewed_histogram->estimate_range(1, 2), 0.6f);
+  EXPECT_NEAR(_skewed_histogram->estimate_range(2, 402), 0.5f, 0.0001f);
+  EXPECT_NEAR(_skewed_histogram->estimate_range(100, 199), 0.1f, 0.0001f);
+  EXPECT_FLOAT_EQ(_skewed_histogram->estimate_range(5, 4), 0.0f);
+
+  EXPECT_FLOAT_EQ(_skewed_histogram->estimate_distinct_count(1, 402), 402.0f);
+  EXPECT_FLOAT_EQ(_skewed_histogram->estimate_distinct_count(2, 51), 50.0f);
+}
+
+TEST_F(HistogramTest, EquiJoin) {
+  // Every value of _skewed_histogram exists once in the other side
+  auto unique_value_counts = std::vector<std::pair<int32_t, size_t>>{};
+  for (auto value = int32_t{1}; value <= 402; ++value) unique_value_counts.emplace_back(value, 1);
+  const auto unique_histogram = Histogram<int32_t>::from_value_counts(unique_value_counts);
+
+  // 1000 matches out of 1000 * 402 pairs
+  EXPECT_FLOAT_EQ(_skewed_histogram->estimate_equi_join(*unique_histogram), 1000.0f / (1000.0f * 402.0f));
+  EXPECT_FLOAT_EQ(unique_histogram->estimate_equi_join(*_skewed_histogram), 1000.0f / (1000.0f * 402.0f));
+
+  // 500 * 500 + 100 * 100 + 400 matches out of 1000 * 1000 pairs
+  EXPECT_NEAR(_skewed_histogram->estimate_equi_join(*_skewed_histogram), 260'400.0f / 1'000'000.0f, 0.00001f);
+}
+
+TEST_F(HistogramTest, Sliced) {
+  const auto sliced_histogram = _skewed_histogram->sliced(2, 102);
+  ASSERT_TRUE(sliced_histogram);
+
+  ASSERT_EQ(sliced_histogram->most_common_values().size(), 1u);
+  EXPECT_FLOAT_EQ(sliced_histogram->most_common_values()[0].ratio, 0.5f);
+  EXPECT_NEAR(sliced_histogram->estimate_range(3, 102), 0.5f, 0.0001f);
+  EXPECT_NEAR(sliced_histogram->estimate_distinct_count(2, 102), 101.0f, 0.01f);
+
+  EXPECT_EQ(_skewed_histogram->sliced(403, 500), nullptr);
+}
+
+TEST_F(HistogramTest, ColumnStatisticsOnSkewedData) {
+  auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, true}}, TableType::Data, 100);
+  for (auto row_id = 0; row_id < 100; ++row_id) table->append({row_id < 80 ? 1 : row_id});
+  table->append({NULL_VALUE});
+
+  const auto table_statistics = generate_table_statistics(*table);
+  const auto column_statistics =
+      std::dynamic_pointer_cast<const ColumnStatistics<int32_t>>(table_statistics.column_statistics()[0]);
+  ASSERT_TRUE(column_statistics->histogram());
+
+  const auto non_null_value_ratio = 100.0f / 101.0f;
+
+  // Without the histogram, every value would be estimated to have a selectivity of 1/21
+  EXPECT_FLOAT_EQ(column_statistics->estimate_predicate_with_value(PredicateCondition::Equals, 1).selectivity,
+                  non_null_value_ratio * 0.8f);
+  EXPECT_FLOAT_EQ(column_statistics->estimate_predicate_with_value(PredicateCondition::NotEquals, 1).selectivity,
+                  non_null_value_ratio * 0.2f);
+  EXPECT_FLOAT_EQ(column_statistics->estimate_predicate_with_value(PredicateCondition::Equals, 90).selectivity,
+                  non_null_value_ratio * 0.01f);
+
+  const auto range_estimate = column_statistics->estimate_predicate_with_value(PredicateCondition::GreaterThan, 1);
+  EXPECT_FLOAT_EQ(range_estimate.selectivity, non_null_value_ratio * 0.2f);
+  EXPECT_FLOAT_EQ(range_estimate.column_statistics->distinct_count(), 20.0f);
+
+  const auto join_estimate =
+      column_statistics->estimate_predicate_with_column(PredicateCondition::Equals, *column_statistics);
+  EXPECT_NEAR(join_estimate.selectivity, non_null_value_ratio * non_null_value_ratio * (0.64f + 20 * 0.0001f),
+              0.00001f);
+}
+
+}  // namespace opossum
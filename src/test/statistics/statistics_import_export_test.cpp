@@ -5,6 +5,7 @@
 
 #include "base_test.hpp"
 #include "statistics/column_statistics.hpp"
+#include "statistics/histogram.hpp"
 #include "statistics/statistics_import_export.hpp"
 #include "statistics/table_statistics.hpp"
 #include "statistics_test_utils.hpp"
@@ -44,4 +45,32 @@ TEST_F(StatisticsImportExportTest, EndToEnd) {
   EXPECT_STRING_COLUMN_STATISTICS(imported_table_statistics.column_statistics().at(4), 0.7f, 53.3f, "abc", "xyz");
 }
 
+TEST_F(StatisticsImportExportTest, Histogram) {
+  const auto histogram = std::make_shared<Histogram<std::string>>(
+      std::vector<MostCommonValue<std::string>>{{"b", 0.5f}},
+      std::vector<HistogramBucket<std::string>>{{"a", "a", 0.1f, 1.0f}, {"c", "x", 0.4f, 20.0f}});
+  const auto column_statistics = ColumnStatistics<std::string>{0.2f, 22.0f, "a", "x", histogram};
+
+  const auto imported_column_statistics = std::dynamic_pointer_cast<ColumnStatistics<std::string>>(
+      import_column_statistics(export_column_statistics(column_statistics)));
+  ASSERT_TRUE(imported_column_statistics);
+
+  const auto& imported_histogram = imported_column_statistics->histogram();
+  ASSERT_TRUE(imported_histogram);
+  ASSERT_EQ(imported_histogram->most_common_values().size(), 1u);
+  EXPECT_EQ(imported_histogram->most_common_values()[0].value, "b");
+  EXPECT_FLOAT_EQ(imported_histogram->most_common_values()[0].ratio, 0.5f);
+  ASSERT_EQ(imported_histogram->buckets().size(), 2u);
+  EXPECT_EQ(imported_histogram->buckets()[1].min, "c");
+  EXPECT_EQ(imported_histogram->buckets()[1].max, "x");
+  EXPECT_FLOAT_EQ(imported_histogram->buckets()[1].ratio, 0.4f);
+  EXPECT_FLOAT_EQ(imported_histogram->buckets()[1].distinct_count, 20.0f);
+
+  // Statistics without a histogram stay without one
+  const auto plain_column_statistics = ColumnStatistics<int32_t>{0.0f, 10.0f, 1, 10};
+  const auto imported_plain_column_statistics = std::dynamic_pointer_cast<ColumnStatistics<int32_t>>(
+      import_column_statistics(export_column_statistics(plain_column_statistics)));
+  EXPECT_FALSE(imported_plain_column_statistics->histogram());
+}
+
 }  // namespace opossum
@@ -0,0 +1,114 @@
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "concurrency/transaction_context.hpp"
+#include "concurrency/transaction_manager.hpp"
+#include "operators/delete.hpp"
+#include "operators/get_table.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/validate.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/run_length_segment.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "tasks/mvcc_garbage_collection_task.hpp"
+
+namespace opossum {
+
+class MvccGarbageCollectionTaskTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // Four dictionary-encoded chunks with three rows each
+    _table = load_table("src/test/tables/compression_input.tbl", 3u);
+    ChunkEncoder::encode_all_chunks(_table);
+    StorageManager::get().add_table(_table_name, _table);
+  }
+
+  void _delete(const int32_t b) {
+    const auto transaction_context = TransactionManager::get().new_transaction_context();
+    const auto get_table = std::make_shared<GetTable>(_table_name);
+    const auto validate = std::make_shared<Validate>(get_table);
+    const auto table_scan =
+        std::make_shared<TableScan>(validate, OperatorScanPredicate{ColumnID{1}, PredicateCondition::Equals, b});
+    const auto delete_operator = std::make_shared<Delete>(_table_name, table_scan);
+
+    for (const auto& op : {std::static_pointer_cast<AbstractOperator>(get_table),
+                           std::static_pointer_cast<AbstractOperator>(validate),
+                           std::static_pointer_cast<AbstractOperator>(table_scan),
+                           std::static_pointer_cast<AbstractOperator>(delete_operator)}) {
+      op->set_transaction_context(transaction_context);
+      op->execute();
+    }
+
+    transaction_context->commit();
+  }
+
+  std::shared_ptr<const Table> _validated_table(const std::shared_ptr<TransactionContext>& transaction_context) {
+    const auto get_table = std::make_shared<GetTable>(_table_name);
+    const auto validate = std::make_shared<Validate>(get_table);
+    validate->set_transaction_context(transaction_context);
+    get_table->execute();
+    validate->execute();
+    return validate->get_output();
+  }
+
+  const std::string _table_name{"mvcc_garbage_collection_test_table"};
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(MvccGarbageCollectionTaskTest, MovesLiveRowsAndCompactsDeadChunks) {
+  // Two thirds of the first and the third chunk, one third of the last chunk
+  _delete(3);
+  const auto row_count = _table->row_count();
+
+  const auto task = std::make_shared<MvccGarbageCollectionTask>(_table_name);
+  task->execute();
+
+  EXPECT_EQ(task->moved_row_count(), 2u);
+  EXPECT_EQ(task->compacted_chunk_count(), 2u);
+  EXPECT_GT(task->reclaimed_bytes(), 0u);
+
+  // RowIDs remain stable, the moved rows are appended
+  EXPECT_EQ(_table->row_count(), row_count + 2u);
+
+  const auto expected_table = std::make_shared<Table>(_table->column_definitions(), TableType::Data);
+  for (const auto& [a, b] : {std::pair<std::string, int32_t>{"hurz", 2}, {"foo", 1}, {"foo", 2}, {"bar", 1},
+                             {"hurz", 2}, {"bar", 1}, {"bar", 1}}) {
+    expected_table->append({a, b});
+  }
+  EXPECT_TABLE_EQ_UNORDERED(_validated_table(TransactionManager::get().new_transaction_context()), expected_table);
+
+  for (const auto chunk_id : {ChunkID{0}, ChunkID{2}}) {
+    const auto segment = std::dynamic_pointer_cast<const RunLengthSegment<std::string>>(
+        _table->get_chunk(chunk_id)->get_segment(ColumnID{0}));
+    ASSERT_NE(segment, nullptr);
+    EXPECT_EQ(segment->size(), 3u);
+    EXPECT_EQ(segment->values()->size(), 1u);
+  }
+
+  // Compacted chunks are not touched again
+  const auto second_task = std::make_shared<MvccGarbageCollectionTask>(_table_name);
+  second_task->execute();
+  EXPECT_EQ(second_task->moved_row_count(), 0u);
+  EXPECT_EQ(second_task->compacted_chunk_count(), 0u);
+}
+
+TEST_F(MvccGarbageCollectionTaskTest, KeepsRowsOfActiveSnapshots) {
+  const auto transaction_context = TransactionManager::get().new_transaction_context();
+  const auto expected_table = _validated_table(transaction_context);
+
+  _delete(3);
+
+  const auto task = std::make_shared<MvccGarbageCollectionTask>(_table_name);
+  task->execute();
+
+  EXPECT_EQ(task->moved_row_count(), 0u);
+  EXPECT_EQ(task->compacted_chunk_count(), 0u);
+  EXPECT_TABLE_EQ_UNORDERED(_validated_table(transaction_context), expected_table);
+}
+
+}  // namespace opossum